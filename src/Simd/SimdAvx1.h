@@ -31,6 +31,9 @@ namespace Simd
 #ifdef SIMD_AVX_ENABLE    
     namespace Avx
     {
+        void Gemm32fNN(size_t M, size_t N, size_t K, const float * alpha, const float * A, size_t lda,
+            const float * B, size_t ldb, const float * beta, float * C, size_t ldc);
+
 		void NeuralProductSum(const float * a, const float * b, size_t size, float * sum);
 
         void NeuralAddVectorMultipliedByValue(const float * src, size_t size, const float * value, float * dst);
@@ -53,6 +56,9 @@ namespace Simd
 
         void NeuralAdaptiveGradientUpdate(const float * delta, size_t size, size_t batch, const float * alpha, const float * epsilon, float * gradient, float * weight);
 
+        void NeuralAdamUpdate(const float * delta, size_t size, size_t batch, const float * alpha, const float * beta1, const float * beta2,
+            const float * epsilon, const float * decay, float * moment1, float * moment2, float * weight);
+
         void NeuralAddConvolution3x3(const float * src, size_t srcStride, size_t width, size_t height, const float * weights, float * dst, size_t dstStride);
 
         void NeuralAddConvolution5x5(const float * src, size_t srcStride, size_t width, size_t height, const float * weights, float * dst, size_t dstStride);
@@ -65,6 +71,22 @@ namespace Simd
 
         void NeuralAddConvolution5x5Sum(const float * src, size_t srcStride, const float * dst, size_t dstStride, size_t width, size_t height, float * sums);
 
+        void NeuralConvolutionForward(const float * src, size_t srcWidth, size_t srcHeight, size_t srcDepth, const float * weight,
+            size_t kernelX, size_t kernelY, size_t padX, size_t padY, size_t strideX, size_t strideY, size_t dilationX, size_t dilationY,
+            void * buffer, size_t * size, float * dst, size_t dstWidth, size_t dstHeight, size_t dstDepth, int add);
+
+        void NeuralConvolutionBackward(const float * src, size_t srcWidth, size_t srcHeight, size_t srcDepth, const float * weight,
+            size_t kernelX, size_t kernelY, size_t padX, size_t padY, size_t strideX, size_t strideY, size_t dilationX, size_t dilationY,
+            void * buffer, size_t * size, float * dst, size_t dstWidth, size_t dstHeight, size_t dstDepth, int add);
+
+        void NeuralConvolutionSum(const float * src, size_t srcWidth, size_t srcHeight, size_t srcDepth, const float * dst, size_t dstWidth, size_t dstHeight, size_t dstDepth,
+            size_t kernelX, size_t kernelY, size_t padX, size_t padY, size_t strideX, size_t strideY, size_t dilationX, size_t dilationY,
+            void * buffer, size_t * size, float * sums);
+
+        void NeuralWinograd2x2p3x3SetInput(const float * src, size_t srcWidth, size_t srcHeight, size_t srcDepth, float * dst);
+
+        void NeuralWinograd2x2p3x3SetOutput(const float * src, float * dst, size_t dstWidth, size_t dstHeight, size_t dstDepth);
+
         void NeuralMax2x2(const float * src, size_t srcStride, size_t width, size_t height, float * dst, size_t dstStride);
 
         void SquaredDifferenceSum32f(const float * a, const float * b, size_t size, float * sum);
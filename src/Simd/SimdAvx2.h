@@ -100,6 +100,9 @@ namespace Simd
 
         void BgrToYuv444p(const uint8_t * bgr, size_t width, size_t height, size_t bgrStride, uint8_t * y, size_t yStride, uint8_t * u, size_t uStride, uint8_t * v, size_t vStride);
 
+        void BilateralFilter(const uint8_t * src, size_t srcStride, size_t width, size_t height, size_t channelCount,
+            size_t radius, float sigmaSpace, float sigmaRange, uint8_t * dst, size_t dstStride);
+
         void Binarization(const uint8_t * src, size_t srcStride, size_t width, size_t height, 
             uint8_t value, uint8_t positive, uint8_t negative, uint8_t * dst, size_t dstStride, SimdCompareType compareType);
 
@@ -137,6 +140,12 @@ namespace Simd
         void DetectionHaarDetect32fi(const void * hid, const uint8_t * mask, size_t maskStride,
             ptrdiff_t left, ptrdiff_t top, ptrdiff_t right, ptrdiff_t bottom, uint8_t * dst, size_t dstStride);
 
+        void DetectionHaarDetect16ip(const void * hid, const uint8_t * mask, size_t maskStride,
+            ptrdiff_t left, ptrdiff_t top, ptrdiff_t right, ptrdiff_t bottom, uint8_t * dst, size_t dstStride);
+
+        void DetectionHaarDetect16ii(const void * hid, const uint8_t * mask, size_t maskStride,
+            ptrdiff_t left, ptrdiff_t top, ptrdiff_t right, ptrdiff_t bottom, uint8_t * dst, size_t dstStride);
+
         void DetectionLbpDetect32fp(const void * hid, const uint8_t * mask, size_t maskStride,
             ptrdiff_t left, ptrdiff_t top, ptrdiff_t right, ptrdiff_t bottom, uint8_t * dst, size_t dstStride);
 
@@ -174,9 +183,15 @@ namespace Simd
 
         void FillBgra(uint8_t * dst, size_t stride, size_t width, size_t height, uint8_t blue, uint8_t green, uint8_t red, uint8_t alpha);
 
+        void Filter2D(const uint8_t * src, size_t srcStride, size_t width, size_t height, SimdPixelFormatType format,
+            const float * kernel, size_t size, SimdBorderType border, uint8_t * dst, size_t dstStride);
+
         void GaussianBlur3x3(const uint8_t * src, size_t srcStride, size_t width, size_t height, 
             size_t channelCount, uint8_t * dst, size_t dstStride);
 
+        void Gemm32fNN(size_t M, size_t N, size_t K, const float * alpha, const float * A, size_t lda,
+            const float * B, size_t ldb, const float * beta, float * C, size_t ldc);
+
         void GrayToBgr(const uint8_t *gray, size_t width, size_t height, size_t grayStride, uint8_t *bgr, size_t bgrStride);
 
         void GrayToBgra(const uint8_t *gray, size_t width, size_t height, size_t grayStride, uint8_t *bgra, size_t bgraStride, uint8_t alpha);
@@ -190,6 +205,9 @@ namespace Simd
         void AbsSecondDerivativeHistogram(const uint8_t *src, size_t width, size_t height, size_t stride,
             size_t step, size_t indent, uint32_t * histogram);
 
+        void ClaheApply(const uint8_t * src, size_t srcStride, size_t width, size_t height, size_t tilesX, size_t tilesY,
+            const uint8_t * luts, size_t rowBegin, size_t rowEnd, uint8_t * dst, size_t dstStride);
+
         void HogDirectionHistograms(const uint8_t * src, size_t stride, size_t width, size_t height, 
             size_t cellX, size_t cellY, size_t quantization, float * histograms);
 
@@ -245,6 +263,22 @@ namespace Simd
 
         void NeuralAddConvolution5x5(const float * src, size_t srcStride, size_t width, size_t height, const float * weights, float * dst, size_t dstStride);
 
+        void NeuralConvolutionForward(const float * src, size_t srcWidth, size_t srcHeight, size_t srcDepth, const float * weight,
+            size_t kernelX, size_t kernelY, size_t padX, size_t padY, size_t strideX, size_t strideY, size_t dilationX, size_t dilationY,
+            void * buffer, size_t * size, float * dst, size_t dstWidth, size_t dstHeight, size_t dstDepth, int add);
+
+        void NeuralConvolutionBackward(const float * src, size_t srcWidth, size_t srcHeight, size_t srcDepth, const float * weight,
+            size_t kernelX, size_t kernelY, size_t padX, size_t padY, size_t strideX, size_t strideY, size_t dilationX, size_t dilationY,
+            void * buffer, size_t * size, float * dst, size_t dstWidth, size_t dstHeight, size_t dstDepth, int add);
+
+        void NeuralConvolutionSum(const float * src, size_t srcWidth, size_t srcHeight, size_t srcDepth, const float * dst, size_t dstWidth, size_t dstHeight, size_t dstDepth,
+            size_t kernelX, size_t kernelY, size_t padX, size_t padY, size_t strideX, size_t strideY, size_t dilationX, size_t dilationY,
+            void * buffer, size_t * size, float * sums);
+
+        void NeuralQuantize8u(const float * src, size_t size, const float * scale, const float * shift, uint8_t * dst);
+
+        void NeuralProductSum8u8i(const uint8_t * src, const int8_t * weight, size_t size, size_t count, int32_t * sums);
+
         void NeuralAddConvolution5x5Sum(const float * src, size_t srcStride, const float * dst, size_t dstStride, size_t width, size_t height, float * sums);
 
         void OperationBinary8u(const uint8_t * a, size_t aStride, const uint8_t * b, size_t bStride,
@@ -303,6 +337,12 @@ namespace Simd
 
         void SobelDyAbsSum(const uint8_t * src, size_t stride, size_t width, size_t height, uint64_t * sum);
 
+        void SobelGradient(const uint8_t * src, size_t srcStride, size_t width, size_t height, uint8_t * dx, size_t dxStride, 
+            uint8_t * dy, size_t dyStride, uint8_t * magnitude, size_t magnitudeStride, size_t quantization, uint8_t * direction, size_t directionStride);
+
+        void SobelGradient32f(const uint8_t * src, size_t srcStride, size_t width, size_t height, 
+            uint8_t * magnitude, size_t magnitudeStride, uint8_t * direction, size_t directionStride);
+
         void ContourMetrics(const uint8_t * src, size_t srcStride, size_t width, size_t height, uint8_t * dst, size_t dstStride);
 
         void ContourMetricsMasked(const uint8_t * src, size_t srcStride, size_t width, size_t height, 
@@ -323,6 +363,9 @@ namespace Simd
         void GetMoments(const uint8_t * mask, size_t stride, size_t width, size_t height, uint8_t index, 
             uint64_t * area, uint64_t * x, uint64_t * y, uint64_t * xx, uint64_t * xy, uint64_t * yy);
 
+        void GetImageStatistics(const uint8_t * src, size_t srcStride, size_t width, size_t height, const uint8_t * mask, size_t maskStride,
+            uint8_t index, uint32_t flags, size_t rowBegin, size_t rowEnd, SimdImageStatistics * statistics);
+
         void GetRowSums(const uint8_t * src, size_t stride, size_t width, size_t height, uint32_t * sums);
 
         void GetColSums(const uint8_t * src, size_t stride, size_t width, size_t height, uint32_t * sums);
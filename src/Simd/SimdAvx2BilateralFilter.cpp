@@ -0,0 +1,137 @@
+/*
+* Simd Library (http://simd.sourceforge.net).
+*
+* Copyright (c) 2011-2017 Yermalayeu Ihar.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy 
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell 
+* copies of the Software, and to permit persons to whom the Software is 
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in 
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE 
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+#include "Simd/SimdMemory.h"
+#include "Simd/SimdStore.h"
+#include "Simd/SimdBase.h"
+#include "Simd/SimdBilateralFilter.h"
+
+namespace Simd
+{
+#ifdef SIMD_AVX2_ENABLE    
+    namespace Avx2
+    {
+        SIMD_INLINE __m256i BilateralFilterLoad1(const uint8_t * src)
+        {
+            return _mm256_cvtepu8_epi32(_mm_loadl_epi64((__m128i*)src));
+        }
+
+        SIMD_INLINE __m256i BilateralFilterRound(__m256 sum, __m256 weight)
+        {
+            return _mm256_cvttps_epi32(_mm256_add_ps(_mm256_div_ps(sum, weight), _mm256_set1_ps(0.5f)));
+        }
+
+        SIMD_INLINE void BilateralFilter1(const Base::BilateralFilterParam & param, const uint8_t * src, uint8_t * dst)
+        {
+            __m256 sum = _mm256_setzero_ps(), weight = _mm256_setzero_ps();
+            __m256i center = BilateralFilterLoad1(src);
+            for (size_t k = 0; k < param.offsets.size(); ++k)
+            {
+                __m256i value = BilateralFilterLoad1(src + param.offsets[k]);
+                __m256i index = _mm256_abs_epi32(_mm256_sub_epi32(value, center));
+                __m256 w = _mm256_mul_ps(_mm256_i32gather_ps(param.range.data(), index, 4), _mm256_set1_ps(param.space[k]));
+                weight = _mm256_add_ps(weight, w);
+                sum = _mm256_add_ps(sum, _mm256_mul_ps(w, _mm256_cvtepi32_ps(value)));
+            }
+            __m256i result = BilateralFilterRound(sum, weight);
+            result = _mm256_packus_epi16(_mm256_packs_epi32(result, K_ZERO), K_ZERO);
+            __m128i lo = _mm256_castsi256_si128(result), hi = _mm256_extracti128_si256(result, 1);
+            _mm_storel_epi64((__m128i*)dst, _mm_unpacklo_epi32(lo, hi));
+        }
+
+        const __m256i K32_BGR_INDEX = SIMD_MM256_SETR_EPI32(0, 3, 6, 9, 12, 15, 18, 21);
+        const __m256i K8_SHUFFLE_BGR = SIMD_MM256_SETR_EPI8(
+            0x0, 0x1, 0x2, 0x4, 0x5, 0x6, 0x8, 0x9, 0xA, 0xC, 0xD, 0xE, -1, -1, -1, -1,
+            0x0, 0x1, 0x2, 0x4, 0x5, 0x6, 0x8, 0x9, 0xA, 0xC, 0xD, 0xE, -1, -1, -1, -1);
+
+        SIMD_INLINE __m256i BilateralFilterLoad3(const uint8_t * src)
+        {
+            return _mm256_i32gather_epi32((int*)src, K32_BGR_INDEX, 1);
+        }
+
+        SIMD_INLINE __m256i BilateralFilterChannel(__m256i bgr, int channel)
+        {
+            return _mm256_and_si256(_mm256_srlv_epi32(bgr, _mm256_set1_epi32(8 * channel)), K32_000000FF);
+        }
+
+        SIMD_INLINE void BilateralFilter3(const Base::BilateralFilterParam & param, const uint8_t * src, uint8_t * dst)
+        {
+            __m256 sum0 = _mm256_setzero_ps(), sum1 = _mm256_setzero_ps(), sum2 = _mm256_setzero_ps(), weight = _mm256_setzero_ps();
+            __m256i center = BilateralFilterLoad3(src);
+            __m256i c0 = BilateralFilterChannel(center, 0), c1 = BilateralFilterChannel(center, 1), c2 = BilateralFilterChannel(center, 2);
+            for (size_t k = 0; k < param.offsets.size(); ++k)
+            {
+                __m256i value = BilateralFilterLoad3(src + param.offsets[k]);
+                __m256i v0 = BilateralFilterChannel(value, 0), v1 = BilateralFilterChannel(value, 1), v2 = BilateralFilterChannel(value, 2);
+                __m256i index = _mm256_add_epi32(_mm256_abs_epi32(_mm256_sub_epi32(v0, c0)), 
+                    _mm256_add_epi32(_mm256_abs_epi32(_mm256_sub_epi32(v1, c1)), _mm256_abs_epi32(_mm256_sub_epi32(v2, c2))));
+                __m256 w = _mm256_mul_ps(_mm256_i32gather_ps(param.range.data(), index, 4), _mm256_set1_ps(param.space[k]));
+                weight = _mm256_add_ps(weight, w);
+                sum0 = _mm256_add_ps(sum0, _mm256_mul_ps(w, _mm256_cvtepi32_ps(v0)));
+                sum1 = _mm256_add_ps(sum1, _mm256_mul_ps(w, _mm256_cvtepi32_ps(v1)));
+                sum2 = _mm256_add_ps(sum2, _mm256_mul_ps(w, _mm256_cvtepi32_ps(v2)));
+            }
+            __m256i r0 = BilateralFilterRound(sum0, weight);
+            __m256i r1 = BilateralFilterRound(sum1, weight);
+            __m256i r2 = BilateralFilterRound(sum2, weight);
+            __m256i bgr = _mm256_or_si256(r0, _mm256_or_si256(_mm256_slli_epi32(r1, 8), _mm256_slli_epi32(r2, 16)));
+            uint8_t SIMD_ALIGNED(32) buffer[32];
+            _mm256_store_si256((__m256i*)buffer, _mm256_shuffle_epi8(bgr, K8_SHUFFLE_BGR));
+            memcpy(dst, buffer, 12);
+            memcpy(dst + 12, buffer + 16, 12);
+        }
+
+        void BilateralFilter(const uint8_t * src, size_t srcStride, size_t width, size_t height, size_t channelCount,
+            size_t radius, float sigmaSpace, float sigmaRange, uint8_t * dst, size_t dstStride)
+        {
+            if (width < F)
+            {
+                Base::BilateralFilter(src, srcStride, width, height, channelCount, radius, sigmaSpace, sigmaRange, dst, dstStride);
+                return;
+            }
+
+            Base::BilateralFilterParam param(src, srcStride, width, height, channelCount, radius, sigmaSpace, sigmaRange);
+            size_t alignedWidth = AlignLo(width, F);
+            for (size_t row = 0; row < height; ++row)
+            {
+                const uint8_t * s = param.Row(row);
+                if (channelCount == 1)
+                {
+                    for (size_t col = 0; col < alignedWidth; col += F)
+                        BilateralFilter1(param, s + col, dst + col);
+                    if (alignedWidth != width)
+                        BilateralFilter1(param, s + width - F, dst + width - F);
+                }
+                else
+                {
+                    for (size_t col = 0; col < alignedWidth; col += F)
+                        BilateralFilter3(param, s + 3 * col, dst + 3 * col);
+                    if (alignedWidth != width)
+                        BilateralFilter3(param, s + 3 * (width - F), dst + 3 * (width - F));
+                }
+                dst += dstStride;
+            }
+        }
+    }
+#endif// SIMD_AVX2_ENABLE
+}
@@ -223,6 +223,157 @@ namespace Simd
             }
         }
 
+        /*
+        * HAAR cascade evaluation with compaction of surviving windows:
+        * the first HAAR_DENSE_STAGES stages are evaluated for groups of 8 neighboring windows (contiguous loads);
+        * surviving windows are compacted into a queue and the next stages are evaluated for 8 queued windows at once 
+        * (gathers over integral image), the queue is compacted after every stage.
+        */
+        const int HAAR_DENSE_STAGES = 2;
+
+        const __m256i K32_LANES = SIMD_MM256_SETR_EPI32(0, 1, 2, 3, 4, 5, 6, 7);
+
+        struct HaarCompaction
+        {
+            int32_t SIMD_ALIGNED(32) permute[256][8];
+            int count[256];
+
+            HaarCompaction()
+            {
+                for (int mask = 0; mask < 256; ++mask)
+                {
+                    int n = 0;
+                    for (int j = 0; j < 8; ++j)
+                        if (mask & (1 << j))
+                            permute[mask][n++] = j;
+                    count[mask] = n;
+                    for (; n < 8; ++n)
+                        permute[mask][n] = 0;
+                }
+            }
+        };
+        const HaarCompaction g_haarCompaction;
+
+        struct HaarQueue
+        {
+            int32_t * offset;
+            float * norm;
+            int32_t * index;
+            size_t count;
+
+            HaarQueue(size_t size)
+                : count(0)
+            {
+                size_t aligned = Simd::AlignHi(size, F) + F;
+                _p = Allocate(3 * aligned * sizeof(int32_t));
+                offset = (int32_t*)_p;
+                norm = (float*)(offset + aligned);
+                index = (int32_t*)(norm + aligned);
+            }
+
+            ~HaarQueue()
+            {
+                Free(_p);
+            }
+
+            SIMD_INLINE void Push(const __m256i & offsets, const __m256 & norms, const __m256i & indexes, int mask)
+            {
+                __m256i permute = _mm256_load_si256((__m256i*)g_haarCompaction.permute[mask]);
+                _mm256_storeu_si256((__m256i*)(offset + count), _mm256_permutevar8x32_epi32(offsets, permute));
+                _mm256_storeu_ps(norm + count, _mm256_permutevar8x32_ps(norms, permute));
+                _mm256_storeu_si256((__m256i*)(index + count), _mm256_permutevar8x32_epi32(indexes, permute));
+                count += g_haarCompaction.count[mask];
+            }
+
+        private:
+            void * _p;
+        };
+
+        SIMD_INLINE int AliveMask(const __m256i & result)
+        {
+            return _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(result, _mm256_setzero_si256()))) ^ 0xFF;
+        }
+
+        void DetectDense32f(const HidHaarCascade & hid, size_t offset, const __m256 & norm, __m256i & result)
+        {
+            typedef HidHaarCascade Hid;
+            const float * leaves = hid.leaves.data();
+            const Hid::Node * node = hid.nodes.data();
+            const Hid::Stage * stages = hid.stages.data();
+            for (int i = 0, n = std::min((int)hid.stages.size(), HAAR_DENSE_STAGES); i < n; ++i)
+            {
+                const Hid::Stage & stage = stages[i];
+                if (stage.canSkip)
+                    continue;
+                const Hid::Node * end = node + stage.ntrees;
+                __m256 stageSum = _mm256_setzero_ps();
+                for (; node < end; ++node, leaves += 2)
+                {
+                    const Hid::Feature & feature = hid.features[node->featureIdx];
+                    __m256 sum = _mm256_add_ps(WeightedSum32f(feature.rect[0], offset), WeightedSum32f(feature.rect[1], offset));
+                    if (stage.hasThree && feature.rect[2].p0)
+                        sum = _mm256_add_ps(sum, WeightedSum32f(feature.rect[2], offset));
+                    StageSum32f(leaves, node->threshold, sum, norm, stageSum);
+                }
+                result = _mm256_andnot_si256(_mm256_castps_si256(_mm256_cmp_ps(_mm256_broadcast_ss(&stage.threshold), stageSum, _CMP_GT_OQ)), result);
+                if (_mm256_testz_si256(result, result))
+                    return;
+            }
+        }
+
+        SIMD_INLINE __m256 WeightedSum32f(const WeightedRect & rect, const __m256i & offset)
+        {
+            __m256i s0 = _mm256_i32gather_epi32((const int*)rect.p0, offset, 4);
+            __m256i s1 = _mm256_i32gather_epi32((const int*)rect.p1, offset, 4);
+            __m256i s2 = _mm256_i32gather_epi32((const int*)rect.p2, offset, 4);
+            __m256i s3 = _mm256_i32gather_epi32((const int*)rect.p3, offset, 4);
+            __m256i sum = _mm256_sub_epi32(_mm256_sub_epi32(s0, s1), _mm256_sub_epi32(s2, s3));
+            return _mm256_mul_ps(_mm256_cvtepi32_ps(sum), _mm256_broadcast_ss(&rect.weight));
+        }
+
+        void DetectSparse32f(const HidHaarCascade & hid, HaarQueue & queue, uint32_t * result)
+        {
+            typedef HidHaarCascade Hid;
+            for (int i = HAAR_DENSE_STAGES, n = (int)hid.stages.size(); i < n && queue.count; ++i)
+            {
+                const Hid::Stage & stage = hid.stages[i];
+                if (stage.canSkip)
+                    continue;
+                const Hid::Node * begin = hid.nodes.data() + stage.first, * end = begin + stage.ntrees;
+                const float * leaves = hid.leaves.data() + stage.first * 2;
+                __m256 threshold = _mm256_broadcast_ss(&stage.threshold);
+                size_t count = queue.count;
+                queue.count = 0;
+                for (size_t j = 0; j < count; j += F)
+                {
+                    int valid = count - j >= F ? 0xFF : (1 << (count - j)) - 1;
+                    __m256i offset = _mm256_loadu_si256((__m256i*)(queue.offset + j));
+                    if (valid != 0xFF)
+                    {
+                        __m256i lanes = _mm256_cmpgt_epi32(_mm256_set1_epi32(int(count - j)), K32_LANES);
+                        offset = _mm256_blendv_epi8(_mm256_set1_epi32(queue.offset[j]), offset, lanes);
+                    }
+                    __m256 norm = _mm256_loadu_ps(queue.norm + j);
+                    __m256i index = _mm256_loadu_si256((__m256i*)(queue.index + j));
+                    __m256 stageSum = _mm256_setzero_ps();
+                    const float * leave = leaves;
+                    for (const Hid::Node * node = begin; node < end; ++node, leave += 2)
+                    {
+                        const Hid::Feature & feature = hid.features[node->featureIdx];
+                        __m256 sum = _mm256_add_ps(WeightedSum32f(feature.rect[0], offset), WeightedSum32f(feature.rect[1], offset));
+                        if (stage.hasThree && feature.rect[2].p0)
+                            sum = _mm256_add_ps(sum, WeightedSum32f(feature.rect[2], offset));
+                        StageSum32f(leave, node->threshold, sum, norm, stageSum);
+                    }
+                    int alive = ~_mm256_movemask_ps(_mm256_cmp_ps(threshold, stageSum, _CMP_GT_OQ)) & valid;
+                    for (int k = 0, dead = valid & ~alive; dead; ++k, dead >>= 1)
+                        if (dead & 1)
+                            result[queue.index[j + k]] = 0;
+                    queue.Push(offset, norm, index, alive);
+                }
+            }
+        }
+
         void DetectionHaarDetect32fp(const HidHaarCascade & hid, const Image & mask, const Rect & rect, Image & dst)
         {
             typedef HidHaarCascade Hid;
@@ -232,6 +383,7 @@ namespace Simd
             size_t evenWidth = Simd::AlignLo(width, 2);
 
             Buffer<uint32_t> buffer(width);
+            HaarQueue queue(width);
             for (ptrdiff_t row = rect.top; row < rect.bottom; row += 1)
             {
                 size_t col = 0;
@@ -240,15 +392,21 @@ namespace Simd
 
                 UnpackMask32i(mask.data + row*mask.stride + rect.left, width, buffer.m, K8_01);
                 memset(buffer.d, 0, width*sizeof(uint32_t));
+                queue.count = 0;
                 for (; col < alignedWidth; col += 8)
                 {
                     __m256i result = _mm256_loadu_si256((__m256i*)(buffer.m + col));
                     if (_mm256_testz_si256(result, K32_00000001))
                         continue;
                     __m256 norm = Norm32fp(hid, pq_offset + col);
-                    Detect32f(hid, p_offset + col, norm, result);
+                    DetectDense32f(hid, p_offset + col, norm, result);
                     _mm256_storeu_si256((__m256i*)(buffer.d + col), result);
+                    int alive = AliveMask(result);
+                    if (alive)
+                        queue.Push(_mm256_add_epi32(_mm256_set1_epi32(int(p_offset + col)), K32_LANES), norm,
+                            _mm256_add_epi32(_mm256_set1_epi32(int(col)), K32_LANES), alive);
                 }
+                DetectSparse32f(hid, queue, buffer.d);
                 if (evenWidth > alignedWidth + 2)
                 {
                     col = evenWidth - 8;
@@ -292,6 +450,7 @@ namespace Simd
             size_t evenWidth = Simd::AlignLo(width, 2);
 
             Buffer<uint16_t> buffer(evenWidth);
+            HaarQueue queue(evenWidth / 2);
             for (ptrdiff_t row = rect.top; row < rect.bottom; row += step)
             {
                 size_t col = 0;
@@ -300,15 +459,21 @@ namespace Simd
 
                 UnpackMask16i(mask.data + row*mask.stride + rect.left, evenWidth, buffer.m, K16_0001);
                 memset(buffer.d, 0, evenWidth*sizeof(uint16_t));
+                queue.count = 0;
                 for (; col < alignedWidth; col += HA)
                 {
                     __m256i result = _mm256_loadu_si256((__m256i*)(buffer.m + col));
                     if (_mm256_testz_si256(result, K32_00000001))
                         continue;
                     __m256 norm = Norm32fi(hid, pq_offset + col);
-                    Detect32f(hid, p_offset + col / 2, norm, result);
+                    DetectDense32f(hid, p_offset + col / 2, norm, result);
                     _mm256_storeu_si256((__m256i*)(buffer.d + col), result);
+                    int alive = AliveMask(result);
+                    if (alive)
+                        queue.Push(_mm256_add_epi32(_mm256_set1_epi32(int(p_offset + col / 2)), K32_LANES), norm,
+                            _mm256_add_epi32(_mm256_set1_epi32(int(col / 2)), K32_LANES), alive);
                 }
+                DetectSparse32f(hid, queue, (uint32_t*)buffer.d);
                 if (evenWidth > alignedWidth)
                 {
                     col = evenWidth - HA;
@@ -343,6 +508,208 @@ namespace Simd
                 Image(hid.sum.width - 1, hid.sum.height - 1, dstStride, Image::Gray8, dst).Ref());
         }
 
+        SIMD_INLINE __m256i Norm16ip(const HidHaarCascade & hid, size_t offset)
+        {
+            __m256 scale = _mm256_broadcast_ss(&hid.normScale), half = _mm256_set1_ps(0.5f);
+            __m256i lo = _mm256_cvttps_epi32(_mm256_add_ps(_mm256_mul_ps(Norm32fp(hid, offset + 0), scale), half));
+            __m256i hi = _mm256_cvttps_epi32(_mm256_add_ps(_mm256_mul_ps(Norm32fp(hid, offset + 8), scale), half));
+            return PackI32ToI16(lo, hi);
+        }
+
+        SIMD_INLINE __m256i Norm16ii(const HidHaarCascade & hid, size_t offset)
+        {
+            __m256 scale = _mm256_broadcast_ss(&hid.normScale), half = _mm256_set1_ps(0.5f);
+            __m256i lo = _mm256_cvttps_epi32(_mm256_add_ps(_mm256_mul_ps(Norm32fi(hid, offset + 0), scale), half));
+            __m256i hi = _mm256_cvttps_epi32(_mm256_add_ps(_mm256_mul_ps(Norm32fi(hid, offset + 16), scale), half));
+            return PackI32ToI16(lo, hi);
+        }
+
+        SIMD_INLINE __m256i WeightedSum16i(const WeightedRect16 & rect, size_t offset)
+        {
+            __m256i s0 = _mm256_loadu_si256((__m256i*)(rect.p0 + offset));
+            __m256i s1 = _mm256_loadu_si256((__m256i*)(rect.p1 + offset));
+            __m256i s2 = _mm256_loadu_si256((__m256i*)(rect.p2 + offset));
+            __m256i s3 = _mm256_loadu_si256((__m256i*)(rect.p3 + offset));
+            __m256i sum = _mm256_sub_epi16(_mm256_sub_epi16(s0, s1), _mm256_sub_epi16(s2, s3));
+            return _mm256_mullo_epi16(sum, _mm256_set1_epi16(rect.weight));
+        }
+
+        SIMD_INLINE void StageSum16i(const int16_t * leaves, int16_t threshold, const __m256i & sum, const __m256i & norm, __m256i & stageSum)
+        {
+            __m256i mask = _mm256_cmpgt_epi16(sum, _mm256_mulhi_epi16(_mm256_set1_epi16(threshold), norm));
+            stageSum = _mm256_add_epi16(stageSum, _mm256_blendv_epi8(_mm256_set1_epi16(leaves[0]), _mm256_set1_epi16(leaves[1]), mask));
+        }
+
+        void Detect16i(const HidHaarCascade & hid, size_t offset, const __m256i & norm, __m256i & result)
+        {
+            typedef HidHaarCascade Hid;
+            const int16_t * leaves = hid.leaves16.data();
+            const Hid::Node * node = hid.nodes.data();
+            const Hid::Stage * stages = hid.stages.data();
+            for (int i = 0, n = (int)hid.stages.size(); i < n; ++i)
+            {
+                const Hid::Stage & stage = stages[i];
+                if (stage.canSkip)
+                    continue;
+                const Hid::Node * end = node + stage.ntrees;
+                __m256i stageSum = _mm256_setzero_si256();
+                if (stage.hasThree)
+                {
+                    for (; node < end; ++node, leaves += 2)
+                    {
+                        const Hid::Feature16 & feature = hid.features16[node->featureIdx];
+                        __m256i sum = _mm256_add_epi16(WeightedSum16i(feature.rect[0], offset), WeightedSum16i(feature.rect[1], offset));
+                        if (feature.rect[2].p0)
+                            sum = _mm256_add_epi16(sum, WeightedSum16i(feature.rect[2], offset));
+                        StageSum16i(leaves, node->threshold16, sum, norm, stageSum);
+                    }
+                }
+                else
+                {
+                    for (; node < end; ++node, leaves += 2)
+                    {
+                        const Hid::Feature16 & feature = hid.features16[node->featureIdx];
+                        __m256i sum = _mm256_add_epi16(WeightedSum16i(feature.rect[0], offset), WeightedSum16i(feature.rect[1], offset));
+                        StageSum16i(leaves, node->threshold16, sum, norm, stageSum);
+                    }
+                }
+                result = _mm256_andnot_si256(_mm256_cmpgt_epi16(_mm256_set1_epi16(stage.threshold16), stageSum), result);
+                int resultCount = ResultCount(result);
+                if (resultCount == 0)
+                {
+                    return;
+                }
+                else if (resultCount == 1)
+                {
+                    uint16_t SIMD_ALIGNED(32) _result[HA];
+                    int16_t SIMD_ALIGNED(32) _norm[HA];
+                    _mm256_store_si256((__m256i*)_result, result);
+                    _mm256_store_si256((__m256i*)_norm, norm);
+                    for (int j = 0; j < HA; ++j)
+                    {
+                        if (_result[j])
+                        {
+                            _result[j] = Base::Detect16i(hid, offset + j, i + 1, _norm[j]) > 0 ? 1 : 0;
+                            break;
+                        }
+                    }
+                    result = _mm256_load_si256((__m256i*)_result);
+                    return;
+                }
+            }
+        }
+
+        void DetectionHaarDetect16ip(const HidHaarCascade & hid, const Image & mask, const Rect & rect, Image & dst)
+        {
+            size_t width = rect.Width();
+            size_t alignedWidth = Simd::AlignLo(width, HA);
+            size_t evenWidth = Simd::AlignLo(width, 2);
+            Buffer<uint16_t> buffer(width);
+            for (ptrdiff_t row = rect.top; row < rect.bottom; row += 1)
+            {
+                size_t col = 0;
+                size_t p_offset = row * hid.isum16[0].stride / sizeof(uint16_t) + rect.left;
+                size_t pq_offset = row * hid.sqsum.stride / sizeof(uint32_t) + rect.left;
+                UnpackMask16i(mask.data + row*mask.stride + rect.left, width, buffer.m, K8_01);
+                memset(buffer.d, 0, width*sizeof(uint16_t));
+                for (; col < alignedWidth; col += HA)
+                {
+                    __m256i result = _mm256_loadu_si256((__m256i*)(buffer.m + col));
+                    if (_mm256_testz_si256(result, K16_0001))
+                        continue;
+                    __m256i norm = Norm16ip(hid, pq_offset + col);
+                    Detect16i(hid, p_offset + col, norm, result);
+                    _mm256_storeu_si256((__m256i*)(buffer.d + col), result);
+                }
+                if (alignedWidth && evenWidth > alignedWidth + 2)
+                {
+                    col = evenWidth - HA;
+                    __m256i result = _mm256_loadu_si256((__m256i*)(buffer.m + col));
+                    if (!_mm256_testz_si256(result, K16_0001))
+                    {
+                        __m256i norm = Norm16ip(hid, pq_offset + col);
+                        Detect16i(hid, p_offset + col, norm, result);
+                        _mm256_storeu_si256((__m256i*)(buffer.d + col), result);
+                    }
+                    col += HA;
+                }
+                for (; col < width; ++col)
+                {
+                    if (buffer.m[col] == 0)
+                        continue;
+                    int norm = Base::Norm16i(hid, pq_offset + col);
+                    buffer.d[col] = Base::Detect16i(hid, p_offset + col, 0, norm) > 0 ? 1 : 0;
+                }
+                PackResult16i(buffer.d, width, dst.data + row*dst.stride + rect.left);
+            }
+        }
+
+        void DetectionHaarDetect16ip(const void * _hid, const uint8_t * mask, size_t maskStride,
+            ptrdiff_t left, ptrdiff_t top, ptrdiff_t right, ptrdiff_t bottom, uint8_t * dst, size_t dstStride)
+        {
+            const HidHaarCascade & hid = *(HidHaarCascade*)_hid;
+            return DetectionHaarDetect16ip(hid,
+                Image(hid.sum.width - 1, hid.sum.height - 1, maskStride, Image::Gray8, (uint8_t*)mask),
+                Rect(left, top, right, bottom),
+                Image(hid.sum.width - 1, hid.sum.height - 1, dstStride, Image::Gray8, dst).Ref());
+        }
+
+        void DetectionHaarDetect16ii(const HidHaarCascade & hid, const Image & mask, const Rect & rect, Image & dst)
+        {
+            const size_t step = 2;
+            size_t width = rect.Width();
+            size_t alignedWidth = Simd::AlignLo(width, A);
+            size_t evenWidth = Simd::AlignLo(width, 2);
+
+            for (ptrdiff_t row = rect.top; row < rect.bottom; row += step)
+            {
+                size_t col = 0;
+                size_t p_offset = row * hid.isum16[0].stride / sizeof(uint16_t) + rect.left/2;
+                size_t pq_offset = row * hid.sqsum.stride / sizeof(uint32_t) + rect.left;
+                const uint8_t * m = mask.data + row*mask.stride + rect.left;
+                uint8_t * d = dst.data + row*dst.stride + rect.left;
+                for (; col < alignedWidth; col += A)
+                {
+                    __m256i result = _mm256_and_si256(_mm256_loadu_si256((__m256i*)(m + col)), K16_0001);
+                    if (_mm256_testz_si256(result, K16_0001))
+                        continue;
+                    __m256i norm = Norm16ii(hid, pq_offset + col);
+                    Detect16i(hid, p_offset + col / 2, norm, result);
+                    _mm256_storeu_si256((__m256i*)(d + col), result);
+                }
+                if (alignedWidth && evenWidth > alignedWidth + 2)
+                {
+                    col = evenWidth - A;
+                    __m256i result = _mm256_and_si256(_mm256_loadu_si256((__m256i*)(m + col)), K16_0001);
+                    if (!_mm256_testz_si256(result, K16_0001))
+                    {
+                        __m256i norm = Norm16ii(hid, pq_offset + col);
+                        Detect16i(hid, p_offset + col / 2, norm, result);
+                        _mm256_storeu_si256((__m256i*)(d + col), result);
+                    }
+                    col += A;
+                }
+                for (; col < width; col += step)
+                {
+                    if (mask.At<uint8_t>(col + rect.left, row) == 0)
+                        continue;
+                    int norm = Base::Norm16i(hid, pq_offset + col);
+                    if (Base::Detect16i(hid, p_offset + col / 2, 0, norm) > 0)
+                        dst.At<uint8_t>(col + rect.left, row) = 1;
+                }
+            }
+        }
+
+        void DetectionHaarDetect16ii(const void * _hid, const uint8_t * mask, size_t maskStride,
+            ptrdiff_t left, ptrdiff_t top, ptrdiff_t right, ptrdiff_t bottom, uint8_t * dst, size_t dstStride)
+        {
+            const HidHaarCascade & hid = *(HidHaarCascade*)_hid;
+            return DetectionHaarDetect16ii(hid,
+                Image(hid.sum.width - 1, hid.sum.height - 1, maskStride, Image::Gray8, (uint8_t*)mask),
+                Rect(left, top, right, bottom),
+                Image(hid.sum.width - 1, hid.sum.height - 1, dstStride, Image::Gray8, dst).Ref());
+        }
+
         const __m256i K8_SHUFFLE_BITS = SIMD_MM256_SETR_EPI8(
             0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
             0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00);
@@ -0,0 +1,362 @@
+/*
+* Simd Library (http://simd.sourceforge.net).
+*
+* Copyright (c) 2011-2017 Yermalayeu Ihar.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy 
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell 
+* copies of the Software, and to permit persons to whom the Software is 
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in 
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE 
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+#include "Simd/SimdMemory.h"
+#include "Simd/SimdStore.h"
+#include "Simd/SimdSse2.h"
+#include "Simd/SimdFilter2D.h"
+
+namespace Simd
+{
+#ifdef SIMD_AVX2_ENABLE    
+    namespace Avx2
+    {
+        SIMD_INLINE void Filter2DMadd8u(const uint8_t * src, const int16_t * weights, __m256i * sums)
+        {
+            __m256i w = _mm256_set1_epi32(*(int32_t*)weights);
+            __m256i s0 = _mm256_loadu_si256((__m256i*)src);
+            __m256i s1 = _mm256_loadu_si256((__m256i*)(src + 1));
+            __m256i lo0 = _mm256_unpacklo_epi8(s0, K_ZERO), lo1 = _mm256_unpacklo_epi8(s1, K_ZERO);
+            __m256i hi0 = _mm256_unpackhi_epi8(s0, K_ZERO), hi1 = _mm256_unpackhi_epi8(s1, K_ZERO);
+            sums[0] = _mm256_add_epi32(sums[0], _mm256_madd_epi16(_mm256_unpacklo_epi16(lo0, lo1), w));
+            sums[1] = _mm256_add_epi32(sums[1], _mm256_madd_epi16(_mm256_unpackhi_epi16(lo0, lo1), w));
+            sums[2] = _mm256_add_epi32(sums[2], _mm256_madd_epi16(_mm256_unpacklo_epi16(hi0, hi1), w));
+            sums[3] = _mm256_add_epi32(sums[3], _mm256_madd_epi16(_mm256_unpackhi_epi16(hi0, hi1), w));
+        }
+
+        SIMD_INLINE void Filter2DMadd16i(const int16_t * src0, const int16_t * src1, const int16_t * weights, __m256i * sums)
+        {
+            __m256i w = _mm256_set1_epi32(*(int32_t*)weights);
+            __m256i s0 = _mm256_loadu_si256((__m256i*)src0);
+            __m256i s1 = _mm256_loadu_si256((__m256i*)src1);
+            sums[0] = _mm256_add_epi32(sums[0], _mm256_madd_epi16(_mm256_unpacklo_epi16(s0, s1), w));
+            sums[1] = _mm256_add_epi32(sums[1], _mm256_madd_epi16(_mm256_unpackhi_epi16(s0, s1), w));
+        }
+
+        SIMD_INLINE __m256i Filter2DDescale(__m256i sum, __m256i round, __m128i shift)
+        {
+            return _mm256_sra_epi32(_mm256_add_epi32(sum, round), shift);
+        }
+
+        SIMD_INLINE __m256i Filter2DDescale(const __m256i * sums, __m256i round, __m128i shift)
+        {
+            return _mm256_packs_epi32(Filter2DDescale(sums[0], round, shift), Filter2DDescale(sums[1], round, shift));
+        }
+
+        SIMD_INLINE __m256i Filter2DRound(int shift)
+        {
+            return _mm256_set1_epi32(shift ? 1 << (shift - 1) : 0);
+        }
+
+        SIMD_INLINE __m256i Filter2DDirect8u(const uint8_t * const * rows, const int16_t * weights, size_t size, size_t x, __m256i round, __m128i shift)
+        {
+            size_t pairs = AlignHi(size, 2);
+            __m256i sums[4] = { _mm256_setzero_si256(), _mm256_setzero_si256(), _mm256_setzero_si256(), _mm256_setzero_si256() };
+            for (size_t ky = 0; ky < size; ++ky)
+            {
+                const uint8_t * r = rows[ky] + x;
+                const int16_t * w = weights + ky*pairs;
+                for (size_t kx = 0; kx < size; kx += 2)
+                    Filter2DMadd8u(r + kx, w + kx, sums);
+            }
+            return _mm256_packus_epi16(Filter2DDescale(sums + 0, round, shift), Filter2DDescale(sums + 2, round, shift));
+        }
+
+        SIMD_INLINE void Filter2DHor8u(const uint8_t * src, const int16_t * weights, size_t size, size_t x, __m256i round, __m128i shift, int16_t * dst)
+        {
+            __m256i sums[4] = { _mm256_setzero_si256(), _mm256_setzero_si256(), _mm256_setzero_si256(), _mm256_setzero_si256() };
+            for (size_t kx = 0; kx < size; kx += 2)
+                Filter2DMadd8u(src + x + kx, weights + kx, sums);
+            __m256i lo = Filter2DDescale(sums + 0, round, shift);
+            __m256i hi = Filter2DDescale(sums + 2, round, shift);
+            _mm256_storeu_si256((__m256i*)(dst + x), _mm256_permute2x128_si256(lo, hi, 0x20));
+            _mm256_storeu_si256((__m256i*)(dst + x + HA), _mm256_permute2x128_si256(lo, hi, 0x31));
+        }
+
+        SIMD_INLINE __m256i Filter2DVer8u(const int16_t * const * rows, const int16_t * weights, size_t size, size_t x, __m256i round, __m128i shift)
+        {
+            __m256i lo[2] = { _mm256_setzero_si256(), _mm256_setzero_si256() };
+            __m256i hi[2] = { _mm256_setzero_si256(), _mm256_setzero_si256() };
+            for (size_t ky = 0; ky < size; ky += 2)
+            {
+                Filter2DMadd16i(rows[ky] + x, rows[ky + 1] + x, weights + ky, lo);
+                Filter2DMadd16i(rows[ky] + x + HA, rows[ky + 1] + x + HA, weights + ky, hi);
+            }
+            return PackU16ToU8(Filter2DDescale(lo, round, shift), Filter2DDescale(hi, round, shift));
+        }
+
+        // Weights of the kernel with small weights fit 8-bit integer and all sums fit 16-bit integer (see Base::Filter2DKernel).
+        SIMD_INLINE void Filter2DHor8uSmall(const uint8_t * src, const int16_t * weights, size_t size, size_t x, int16_t * dst)
+        {
+            __m256i lo = _mm256_setzero_si256(), hi = _mm256_setzero_si256();
+            for (size_t kx = 0; kx < size; kx += 2)
+            {
+                __m256i w = _mm256_set1_epi16(int16_t((weights[kx] & 0xFF) | (weights[kx + 1] << 8)));
+                __m256i s0 = _mm256_loadu_si256((__m256i*)(src + x + kx));
+                __m256i s1 = _mm256_loadu_si256((__m256i*)(src + x + kx + 1));
+                lo = _mm256_add_epi16(lo, _mm256_maddubs_epi16(_mm256_unpacklo_epi8(s0, s1), w));
+                hi = _mm256_add_epi16(hi, _mm256_maddubs_epi16(_mm256_unpackhi_epi8(s0, s1), w));
+            }
+            _mm256_storeu_si256((__m256i*)(dst + x), _mm256_permute2x128_si256(lo, hi, 0x20));
+            _mm256_storeu_si256((__m256i*)(dst + x + HA), _mm256_permute2x128_si256(lo, hi, 0x31));
+        }
+
+        SIMD_INLINE __m256i Filter2DVer8uSmall(const int16_t * const * rows, const int16_t * weights, size_t size, size_t x, __m256i round, __m128i shift)
+        {
+            __m256i sum = _mm256_setzero_si256();
+            for (size_t ky = 0; ky < size; ++ky)
+                sum = _mm256_add_epi16(sum, _mm256_mullo_epi16(_mm256_loadu_si256((__m256i*)(rows[ky] + x)), _mm256_set1_epi16(weights[ky])));
+            return _mm256_sra_epi16(_mm256_add_epi16(sum, round), shift);
+        }
+
+        SIMD_INLINE __m256 Filter2DDirect32f(const float * const * rows, const float * weights, size_t size, size_t x)
+        {
+            __m256 sum = _mm256_setzero_ps();
+            for (size_t ky = 0; ky < size; ++ky)
+            {
+                const float * r = rows[ky] + x;
+                const float * w = weights + ky*size;
+                for (size_t kx = 0; kx < size; ++kx)
+                    sum = _mm256_fmadd_ps(_mm256_loadu_ps(r + kx), _mm256_set1_ps(w[kx]), sum);
+            }
+            return sum;
+        }
+
+        SIMD_INLINE __m256 Filter2DHor32f(const float * src, const float * weights, size_t size, size_t x)
+        {
+            __m256 sum = _mm256_setzero_ps();
+            for (size_t kx = 0; kx < size; ++kx)
+                sum = _mm256_fmadd_ps(_mm256_loadu_ps(src + x + kx), _mm256_set1_ps(weights[kx]), sum);
+            return sum;
+        }
+
+        SIMD_INLINE __m256 Filter2DVer32f(const float * const * rows, const float * weights, size_t size, size_t x)
+        {
+            __m256 sum = _mm256_setzero_ps();
+            for (size_t ky = 0; ky < size; ++ky)
+                sum = _mm256_fmadd_ps(_mm256_loadu_ps(rows[ky] + x), _mm256_set1_ps(weights[ky]), sum);
+            return sum;
+        }
+
+        SIMD_INLINE __m256i Filter2DConvert32fTo16i(const float * src, __m256 min, __m256 max)
+        {
+            __m256i lo = _mm256_cvtps_epi32(_mm256_min_ps(_mm256_max_ps(_mm256_loadu_ps(src + 0), min), max));
+            __m256i hi = _mm256_cvtps_epi32(_mm256_min_ps(_mm256_max_ps(_mm256_loadu_ps(src + F), min), max));
+            return PackI32ToI16(lo, hi);
+        }
+
+        struct Filter2DRows
+        {
+            static void Direct8u(const uint8_t * const * rows, const int16_t * weights, size_t size, size_t width, int shift, uint8_t * dst)
+            {
+                __m256i _round = Filter2DRound(shift);
+                __m128i _shift = _mm_cvtsi32_si128(shift);
+                size_t alignedWidth = AlignLo(width, A);
+                for (size_t x = 0; x < alignedWidth; x += A)
+                    _mm256_storeu_si256((__m256i*)(dst + x), Filter2DDirect8u(rows, weights, size, x, _round, _shift));
+                if (alignedWidth != width)
+                    _mm256_storeu_si256((__m256i*)(dst + width - A), Filter2DDirect8u(rows, weights, size, width - A, _round, _shift));
+            }
+
+            static void Hor8u(const uint8_t * src, const int16_t * weights, size_t size, size_t width, int shift, int16_t * dst)
+            {
+                __m256i _round = Filter2DRound(shift);
+                __m128i _shift = _mm_cvtsi32_si128(shift);
+                size_t alignedWidth = AlignLo(width, A);
+                for (size_t x = 0; x < alignedWidth; x += A)
+                    Filter2DHor8u(src, weights, size, x, _round, _shift, dst);
+                if (alignedWidth != width)
+                    Filter2DHor8u(src, weights, size, width - A, _round, _shift, dst);
+            }
+
+            static void Ver8u(const int16_t * const * rows, const int16_t * weights, size_t size, size_t width, int shift, uint8_t * dst)
+            {
+                __m256i _round = Filter2DRound(shift);
+                __m128i _shift = _mm_cvtsi32_si128(shift);
+                size_t alignedWidth = AlignLo(width, A);
+                for (size_t x = 0; x < alignedWidth; x += A)
+                    _mm256_storeu_si256((__m256i*)(dst + x), Filter2DVer8u(rows, weights, size, x, _round, _shift));
+                if (alignedWidth != width)
+                    _mm256_storeu_si256((__m256i*)(dst + width - A), Filter2DVer8u(rows, weights, size, width - A, _round, _shift));
+            }
+
+            static void Hor8uSmall(const uint8_t * src, const int16_t * weights, size_t size, size_t width, int16_t * dst)
+            {
+                size_t alignedWidth = AlignLo(width, A);
+                for (size_t x = 0; x < alignedWidth; x += A)
+                    Filter2DHor8uSmall(src, weights, size, x, dst);
+                if (alignedWidth != width)
+                    Filter2DHor8uSmall(src, weights, size, width - A, dst);
+            }
+
+            static void Ver8uSmall(const int16_t * const * rows, const int16_t * weights, size_t size, size_t width, int shift, uint8_t * dst)
+            {
+                __m256i _round = _mm256_set1_epi16(shift ? 1 << (shift - 1) : 0);
+                __m128i _shift = _mm_cvtsi32_si128(shift);
+                size_t alignedWidth = AlignLo(width, A);
+                for (size_t x = 0; x < alignedWidth; x += A)
+                    _mm256_storeu_si256((__m256i*)(dst + x), PackU16ToU8(
+                        Filter2DVer8uSmall(rows, weights, size, x, _round, _shift), Filter2DVer8uSmall(rows, weights, size, x + HA, _round, _shift)));
+                if (alignedWidth != width)
+                    _mm256_storeu_si256((__m256i*)(dst + width - A), PackU16ToU8(
+                        Filter2DVer8uSmall(rows, weights, size, width - A, _round, _shift), Filter2DVer8uSmall(rows, weights, size, width - HA, _round, _shift)));
+            }
+
+            static void Direct32f(const float * const * rows, const float * weights, size_t size, size_t width, float * dst)
+            {
+                size_t alignedWidth = AlignLo(width, F);
+                for (size_t x = 0; x < alignedWidth; x += F)
+                    _mm256_storeu_ps(dst + x, Filter2DDirect32f(rows, weights, size, x));
+                if (alignedWidth != width)
+                    _mm256_storeu_ps(dst + width - F, Filter2DDirect32f(rows, weights, size, width - F));
+            }
+
+            static void Hor32f(const float * src, const float * weights, size_t size, size_t width, float * dst)
+            {
+                size_t alignedWidth = AlignLo(width, F);
+                for (size_t x = 0; x < alignedWidth; x += F)
+                    _mm256_storeu_ps(dst + x, Filter2DHor32f(src, weights, size, x));
+                if (alignedWidth != width)
+                    _mm256_storeu_ps(dst + width - F, Filter2DHor32f(src, weights, size, width - F));
+            }
+
+            static void Ver32f(const float * const * rows, const float * weights, size_t size, size_t width, float * dst)
+            {
+                size_t alignedWidth = AlignLo(width, F);
+                for (size_t x = 0; x < alignedWidth; x += F)
+                    _mm256_storeu_ps(dst + x, Filter2DVer32f(rows, weights, size, x));
+                if (alignedWidth != width)
+                    _mm256_storeu_ps(dst + width - F, Filter2DVer32f(rows, weights, size, width - F));
+            }
+
+            static void Convert32fTo16i(const float * src, size_t width, int16_t * dst)
+            {
+                __m256 min = _mm256_set1_ps(-32768.0f), max = _mm256_set1_ps(32767.0f);
+                size_t alignedWidth = AlignLo(width, HA);
+                for (size_t x = 0; x < alignedWidth; x += HA)
+                    _mm256_storeu_si256((__m256i*)(dst + x), Filter2DConvert32fTo16i(src + x, min, max));
+                if (alignedWidth != width)
+                    _mm256_storeu_si256((__m256i*)(dst + width - HA), Filter2DConvert32fTo16i(src + width - HA, min, max));
+            }
+        };
+
+        SIMD_INLINE void Filter2DEdge3x3(const uint8_t * src, size_t width, size_t x, SimdBorderType border, uint8_t * dst)
+        {
+            for (size_t i = 0; i < A + 2; ++i)
+            {
+                ptrdiff_t sx = Base::Filter2DIndex(ptrdiff_t(x + i) - 1, width, border);
+                dst[i] = sx < 0 ? 0 : src[sx];
+            }
+        }
+
+        // Horizontal sums are stored in order of _mm256_maddubs_epi16 output (it is restored by _mm256_packus_epi16 in Filter2DVer3x3).
+        SIMD_INLINE void Filter2DHor3x3(const uint8_t * src, const __m256i * weights, int16_t * dst)
+        {
+            __m256i s0 = _mm256_loadu_si256((__m256i*)(src + 0));
+            __m256i s1 = _mm256_loadu_si256((__m256i*)(src + 1));
+            __m256i s2 = _mm256_loadu_si256((__m256i*)(src + 2));
+            __m256i lo = _mm256_maddubs_epi16(_mm256_unpacklo_epi8(s0, s1), weights[0]);
+            __m256i hi = _mm256_maddubs_epi16(_mm256_unpackhi_epi8(s0, s1), weights[0]);
+            _mm256_storeu_si256((__m256i*)dst + 0, _mm256_add_epi16(lo, _mm256_maddubs_epi16(_mm256_unpacklo_epi8(s2, K_ZERO), weights[1])));
+            _mm256_storeu_si256((__m256i*)dst + 1, _mm256_add_epi16(hi, _mm256_maddubs_epi16(_mm256_unpackhi_epi8(s2, K_ZERO), weights[1])));
+        }
+
+        SIMD_INLINE __m256i Filter2DVer3x3(const int16_t * const * rows, const __m256i * weights, size_t offset, __m256i round, __m128i shift)
+        {
+            __m256i sum = _mm256_mullo_epi16(_mm256_loadu_si256((__m256i*)(rows[0] + offset)), weights[0]);
+            sum = _mm256_add_epi16(sum, _mm256_mullo_epi16(_mm256_loadu_si256((__m256i*)(rows[1] + offset)), weights[1]));
+            sum = _mm256_add_epi16(sum, _mm256_mullo_epi16(_mm256_loadu_si256((__m256i*)(rows[2] + offset)), weights[2]));
+            return _mm256_sra_epi16(_mm256_add_epi16(sum, round), shift);
+        }
+
+        /*
+        * Separable 3x3 filter with small weights (see Base::Filter2DKernel) for 8-bit gray images: in contrast to Base::Filter2DRun
+        * the source rows are read directly (only the first and the last blocks are extrapolated) and weights are kept in registers.
+        * It gives exactly the same result as Base::Filter2DRun.
+        */
+        void Filter2DSmall3x3(const uint8_t * src, size_t srcStride, size_t width, size_t height, const Base::Filter2DKernel & kernel,
+            SimdBorderType border, uint8_t * dst, size_t dstStride)
+        {
+            assert(kernel.size == 3 && kernel.small && width >= A);
+
+            const int16_t * row = kernel.row16, * col = kernel.col16;
+            __m256i hor[2] = { _mm256_set1_epi16(int16_t((row[0] & 0xFF) | (row[1] << 8))), _mm256_set1_epi16(int16_t(row[2] & 0xFF)) };
+            __m256i ver[3] = { _mm256_set1_epi16(col[0]), _mm256_set1_epi16(col[1]), _mm256_set1_epi16(col[2]) };
+            __m256i round = _mm256_set1_epi16(kernel.shift ? 1 << (kernel.shift - 1) : 0);
+            __m128i shift = _mm_cvtsi32_si128(kernel.shift);
+
+            size_t body = AlignHi(width, A) - A;
+            Base::Filter2DRing<int16_t> ring(3, body + A);
+            uint8_t edge[A + 2];
+            const int16_t * rows[3];
+            bool fresh;
+            for (size_t y = 0; y < height; ++y)
+            {
+                for (size_t ky = 0; ky < 3; ++ky)
+                {
+                    ptrdiff_t sy = Base::Filter2DIndex(ptrdiff_t(y + ky) - 1, height, border);
+                    int16_t * sums = ring.Get(sy, fresh);
+                    if (fresh)
+                    {
+                        const uint8_t * s = src + sy*srcStride;
+                        if (body)
+                        {
+                            Filter2DEdge3x3(s, width, 0, border, edge);
+                            Filter2DHor3x3(edge, hor, sums);
+                        }
+                        for (size_t x = A; x < body; x += A)
+                            Filter2DHor3x3(s + x - 1, hor, sums + x);
+                        Filter2DEdge3x3(s, width, width - A, border, edge);
+                        Filter2DHor3x3(edge, hor, sums + body);
+                    }
+                    rows[ky] = sums;
+                }
+                uint8_t * d = dst + y*dstStride;
+                for (size_t x = 0; x < body; x += A)
+                    _mm256_storeu_si256((__m256i*)(d + x), _mm256_packus_epi16(Filter2DVer3x3(rows, ver, x, round, shift), Filter2DVer3x3(rows, ver, x + HA, round, shift)));
+                _mm256_storeu_si256((__m256i*)(d + width - A), _mm256_packus_epi16(Filter2DVer3x3(rows, ver, body, round, shift), Filter2DVer3x3(rows, ver, body + HA, round, shift)));
+            }
+        }
+
+        void Filter2D(const uint8_t * src, size_t srcStride, size_t width, size_t height, SimdPixelFormatType format,
+            const float * kernel, size_t size, SimdBorderType border, uint8_t * dst, size_t dstStride)
+        {
+            if (width < A)
+                Sse2::Filter2D(src, srcStride, width, height, format, kernel, size, border, dst, dstStride);
+            else
+            {
+                if (format == SimdPixelFormatGray8 && size == 3)
+                {
+                    Base::Filter2DKernel prepared(kernel, size);
+                    if (prepared.small)
+                    {
+                        Filter2DSmall3x3(src, srcStride, width, height, prepared, border, dst, dstStride);
+                        return;
+                    }
+                }
+                Base::Filter2DRun<Filter2DRows>(src, srcStride, width, height, format, kernel, size, border, dst, dstStride);
+            }
+        }
+    }
+#endif// SIMD_AVX2_ENABLE
+}
@@ -24,6 +24,7 @@
 #include "Simd/SimdMemory.h"
 #include "Simd/SimdStore.h"
 #include "Simd/SimdCompare.h"
+#include "Simd/SimdClahe.h"
 
 namespace Simd
 {
@@ -275,6 +276,75 @@ namespace Simd
                 assert(0);
             }
         }
+
+        SIMD_INLINE __m256i ClaheLookup(const uint8_t * lut, __m256i lo, __m256i hi, __m256i wx)
+        {
+            __m256i _lo = _mm256_and_si256(_mm256_i32gather_epi32((int*)lut, lo, 1), K32_000000FF);
+            __m256i _hi = _mm256_and_si256(_mm256_i32gather_epi32((int*)lut, hi, 1), K32_000000FF);
+            return _mm256_madd_epi16(_mm256_or_si256(_lo, _mm256_slli_epi32(_hi, 16)), wx);
+        }
+
+        const __m256i K8_SHUFFLE_CLAHE = SIMD_MM256_SETR_EPI8(
+            0x0, 0x4, 0x8, 0xC, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+            0x0, 0x4, 0x8, 0xC, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1);
+        const __m256i K32_PERMUTE_CLAHE = SIMD_MM256_SETR_EPI32(0, 4, 1, 5, 2, 6, 3, 7);
+
+        void ClaheApply(const uint8_t * src, size_t srcStride, size_t width, size_t height, size_t tilesX, size_t tilesY,
+            const uint8_t * luts, size_t rowBegin, size_t rowEnd, uint8_t * dst, size_t dstStride)
+        {
+            assert(tilesX > 0 && tilesY > 0 && width >= tilesX && height >= tilesY && rowEnd <= height);
+
+            Base::ClaheAxis axisX(width, tilesX), axisY(height, tilesY);
+            size_t alignedWidth = AlignLo(width, F), lutsSize = tilesX*HISTOGRAM_SIZE;
+            std::vector<int32_t> lo(alignedWidth), hi(alignedWidth), wx(alignedWidth);
+            for (size_t col = 0; col < alignedWidth; ++col)
+            {
+                lo[col] = axisX.lo[col] * HISTOGRAM_SIZE;
+                hi[col] = axisX.hi[col] * HISTOGRAM_SIZE;
+                wx[col] = (256 - axisX.weight[col]) | (axisX.weight[col] << 16);
+            }
+
+            // Gathers read 4 bytes so the rows of LUTs are copied to buffer with padding.
+            std::vector<uint8_t> buffer(2 * lutsSize + 4);
+            uint8_t * top = buffer.data(), * bottom = top + lutsSize;
+            int topIndex = -1, bottomIndex = -1;
+            for (size_t row = rowBegin; row < rowEnd; ++row)
+            {
+                if (axisY.lo[row] != topIndex)
+                {
+                    topIndex = axisY.lo[row];
+                    memcpy(top, luts + topIndex*lutsSize, lutsSize);
+                }
+                if (axisY.hi[row] != bottomIndex)
+                {
+                    bottomIndex = axisY.hi[row];
+                    memcpy(bottom, luts + bottomIndex*lutsSize, lutsSize);
+                }
+                const uint8_t * s = src + row*srcStride;
+                uint8_t * d = dst + row*dstStride;
+                int wy = axisY.weight[row];
+                __m256i wy0 = _mm256_set1_epi32(256 - wy), wy1 = _mm256_set1_epi32(wy);
+                size_t col = 0;
+                for (; col < alignedWidth; col += F)
+                {
+                    __m256i value = _mm256_cvtepu8_epi32(_mm_loadl_epi64((__m128i*)(s + col)));
+                    __m256i _lo = _mm256_add_epi32(_mm256_loadu_si256((__m256i*)(lo.data() + col)), value);
+                    __m256i _hi = _mm256_add_epi32(_mm256_loadu_si256((__m256i*)(hi.data() + col)), value);
+                    __m256i _wx = _mm256_loadu_si256((__m256i*)(wx.data() + col));
+                    __m256i _top = ClaheLookup(top, _lo, _hi, _wx);
+                    __m256i _bottom = ClaheLookup(bottom, _lo, _hi, _wx);
+                    __m256i result = _mm256_add_epi32(_mm256_mullo_epi32(_top, wy0), _mm256_mullo_epi32(_bottom, wy1));
+                    result = _mm256_srli_epi32(_mm256_add_epi32(result, _mm256_set1_epi32(0x8000)), 16);
+                    result = _mm256_permutevar8x32_epi32(_mm256_shuffle_epi8(result, K8_SHUFFLE_CLAHE), K32_PERMUTE_CLAHE);
+                    _mm_storel_epi64((__m128i*)(d + col), _mm256_castsi256_si128(result));
+                }
+                for (; col < width; ++col)
+                {
+                    size_t _lo = axisX.lo[col] * HISTOGRAM_SIZE + s[col], _hi = axisX.hi[col] * HISTOGRAM_SIZE + s[col];
+                    d[col] = (uint8_t)Base::ClaheInterpolate(top[_lo], top[_hi], bottom[_lo], bottom[_hi], axisX.weight[col], wy);
+                }
+            }
+        }
     }
 #endif// SIMD_AVX2_ENABLE
 }
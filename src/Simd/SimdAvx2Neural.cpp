@@ -25,6 +25,9 @@
 #include "Simd/SimdExtract.h"
 #include "Simd/SimdStore.h"
 #include "Simd/SimdStream.h"
+#include "Simd/SimdNeural.h"
+#include "Simd/SimdSse2.h"
+#include "Simd/SimdAvx2.h"
 
 namespace Simd
 {
@@ -388,6 +391,108 @@ namespace Simd
             else
                 NeuralAddConvolution5x5Sum<false>(src, srcStride, dst, dstStride, width, height, sums);
         }
+
+        void NeuralConvolutionForward(const float * src, size_t srcWidth, size_t srcHeight, size_t srcDepth, const float * weight,
+            size_t kernelX, size_t kernelY, size_t padX, size_t padY, size_t strideX, size_t strideY, size_t dilationX, size_t dilationY,
+            void * buffer, size_t * size, float * dst, size_t dstWidth, size_t dstHeight, size_t dstDepth, int add)
+        {
+            Base::NeuralConvolutionShape shape(srcWidth, srcHeight, srcDepth, kernelX, kernelY, padX, padY, strideX, strideY, dilationX, dilationY, dstWidth, dstHeight, dstDepth);
+            Base::NeuralConvolutionForwardRun<Gemm32fNN>(shape, src, weight, buffer, size, dst, add);
+        }
+
+        void NeuralConvolutionBackward(const float * src, size_t srcWidth, size_t srcHeight, size_t srcDepth, const float * weight,
+            size_t kernelX, size_t kernelY, size_t padX, size_t padY, size_t strideX, size_t strideY, size_t dilationX, size_t dilationY,
+            void * buffer, size_t * size, float * dst, size_t dstWidth, size_t dstHeight, size_t dstDepth, int add)
+        {
+            Base::NeuralConvolutionShape shape(dstWidth, dstHeight, dstDepth, kernelX, kernelY, padX, padY, strideX, strideY, dilationX, dilationY, srcWidth, srcHeight, srcDepth);
+            Base::NeuralConvolutionBackwardRun<Gemm32fNN>(shape, src, weight, buffer, size, dst, add);
+        }
+
+        void NeuralConvolutionSum(const float * src, size_t srcWidth, size_t srcHeight, size_t srcDepth, const float * dst, size_t dstWidth, size_t dstHeight, size_t dstDepth,
+            size_t kernelX, size_t kernelY, size_t padX, size_t padY, size_t strideX, size_t strideY, size_t dilationX, size_t dilationY,
+            void * buffer, size_t * size, float * sums)
+        {
+            Base::NeuralConvolutionShape shape(srcWidth, srcHeight, srcDepth, kernelX, kernelY, padX, padY, strideX, strideY, dilationX, dilationY, dstWidth, dstHeight, dstDepth);
+            Base::NeuralConvolutionSumRun<Gemm32fNN>(shape, src, dst, buffer, size, sums);
+        }
+
+        const __m256i K32_PERMUTE_FOR_PACK = SIMD_MM256_SETR_EPI32(0, 4, 1, 5, 2, 6, 3, 7);
+
+        SIMD_INLINE __m256i NeuralQuantize32i(const float * src, __m256 scale, __m256 shift)
+        {
+            return _mm256_cvtps_epi32(_mm256_add_ps(_mm256_mul_ps(_mm256_loadu_ps(src), scale), shift));
+        }
+
+        SIMD_INLINE __m256i NeuralQuantize8u(const float * src, __m256 scale, __m256 shift)
+        {
+            __m256i lo = _mm256_packs_epi32(NeuralQuantize32i(src + 0 * F, scale, shift), NeuralQuantize32i(src + 1 * F, scale, shift));
+            __m256i hi = _mm256_packs_epi32(NeuralQuantize32i(src + 2 * F, scale, shift), NeuralQuantize32i(src + 3 * F, scale, shift));
+            return _mm256_permutevar8x32_epi32(_mm256_packus_epi16(lo, hi), K32_PERMUTE_FOR_PACK);
+        }
+
+        void NeuralQuantize8u(const float * src, size_t size, const float * scale, const float * shift, uint8_t * dst)
+        {
+            size_t alignedSize = AlignLo(size, A);
+            __m256 _scale = _mm256_set1_ps(scale[0]);
+            __m256 _shift = _mm256_set1_ps(shift[0]);
+            for (size_t i = 0; i < alignedSize; i += A)
+                _mm256_storeu_si256((__m256i*)(dst + i), NeuralQuantize8u(src + i, _scale, _shift));
+            if (alignedSize != size)
+                Sse2::NeuralQuantize8u(src + alignedSize, size - alignedSize, scale, shift, dst + alignedSize);
+        }
+
+        SIMD_INLINE __m256i NeuralProductSum8u8i(__m256i src, const int8_t * weight)
+        {
+            return _mm256_madd_epi16(_mm256_maddubs_epi16(src, _mm256_loadu_si256((__m256i*)weight)), K16_0001);
+        }
+
+        SIMD_INLINE void NeuralProductSum8u8i4(const uint8_t * src, const int8_t * weight, size_t size, size_t alignedSize, int32_t * sums)
+        {
+            const int8_t * w0 = weight + 0 * size;
+            const int8_t * w1 = weight + 1 * size;
+            const int8_t * w2 = weight + 2 * size;
+            const int8_t * w3 = weight + 3 * size;
+            __m256i s0 = _mm256_setzero_si256();
+            __m256i s1 = _mm256_setzero_si256();
+            __m256i s2 = _mm256_setzero_si256();
+            __m256i s3 = _mm256_setzero_si256();
+            for (size_t k = 0; k < alignedSize; k += A)
+            {
+                __m256i _src = _mm256_loadu_si256((__m256i*)(src + k));
+                s0 = _mm256_add_epi32(s0, NeuralProductSum8u8i(_src, w0 + k));
+                s1 = _mm256_add_epi32(s1, NeuralProductSum8u8i(_src, w1 + k));
+                s2 = _mm256_add_epi32(s2, NeuralProductSum8u8i(_src, w2 + k));
+                s3 = _mm256_add_epi32(s3, NeuralProductSum8u8i(_src, w3 + k));
+            }
+            __m256i sum = _mm256_hadd_epi32(_mm256_hadd_epi32(s0, s1), _mm256_hadd_epi32(s2, s3));
+            _mm_storeu_si128((__m128i*)sums, _mm_add_epi32(_mm256_castsi256_si128(sum), _mm256_extracti128_si256(sum, 1)));
+            for (size_t k = alignedSize; k < size; ++k)
+            {
+                sums[0] += src[k] * w0[k];
+                sums[1] += src[k] * w1[k];
+                sums[2] += src[k] * w2[k];
+                sums[3] += src[k] * w3[k];
+            }
+        }
+
+        SIMD_INLINE void NeuralProductSum8u8i1(const uint8_t * src, const int8_t * weight, size_t size, size_t alignedSize, int32_t * sums)
+        {
+            __m256i sum = _mm256_setzero_si256();
+            for (size_t k = 0; k < alignedSize; k += A)
+                sum = _mm256_add_epi32(sum, NeuralProductSum8u8i(_mm256_loadu_si256((__m256i*)(src + k)), weight + k));
+            sums[0] = (int32_t)ExtractSum<uint32_t>(sum);
+            for (size_t k = alignedSize; k < size; ++k)
+                sums[0] += src[k] * weight[k];
+        }
+
+        void NeuralProductSum8u8i(const uint8_t * src, const int8_t * weight, size_t size, size_t count, int32_t * sums)
+        {
+            size_t alignedSize = AlignLo(size, A), alignedCount = AlignLo(count, 4), i = 0;
+            for (; i < alignedCount; i += 4)
+                NeuralProductSum8u8i4(src, weight + i*size, size, alignedSize, sums + i);
+            for (; i < count; ++i)
+                NeuralProductSum8u8i1(src, weight + i*size, size, alignedSize, sums + i);
+        }
     }
 #endif// SIMD_AVX2_ENABLE
 }
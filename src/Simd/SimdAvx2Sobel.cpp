@@ -26,6 +26,7 @@
 #include "Simd/SimdSet.h"
 #include "Simd/SimdStore.h"
 #include "Simd/SimdCompare.h"
+#include "Simd/SimdBase.h"
 
 namespace Simd
 {
@@ -302,6 +303,222 @@ namespace Simd
                 SobelDyAbsSum<false>(src, stride, width, height, sum);
         }
 
+        SIMD_INLINE __m256i SobelDirection32(__m256i dxdy, const __m256i * table, size_t size)
+        {
+            __m256i best = K_ZERO, index = K_ZERO;
+            for (size_t i = 0; i < size; ++i)
+            {
+                __m256i dot = _mm256_madd_epi16(dxdy, table[i]);
+                __m256i neg = _mm256_sub_epi32(K_ZERO, dot);
+                __m256i isPos = _mm256_cmpgt_epi32(dot, best);
+                __m256i isNeg = _mm256_cmpgt_epi32(neg, best);
+                best = _mm256_max_epi32(best, _mm256_abs_epi32(dot));
+                index = _mm256_blendv_epi8(_mm256_blendv_epi8(index, _mm256_set1_epi32(int(i + size)), isNeg), _mm256_set1_epi32((int)i), isPos);
+            }
+            return index;
+        }
+
+        SIMD_INLINE __m256i SobelDirection(__m256i dx, __m256i dy, const __m256i * table, size_t size)
+        {
+            __m256i lo = SobelDirection32(_mm256_unpacklo_epi16(dx, dy), table, size);
+            __m256i hi = SobelDirection32(_mm256_unpackhi_epi16(dx, dy), table, size);
+            return _mm256_packs_epi32(lo, hi);
+        }
+
+        SIMD_INLINE void SobelGradient(__m256i a[3][3], __m256i dx[2], __m256i dy[2])
+        {
+            __m256i lo = BinomialSum16(SubUnpackedU8<0>(a[0][2], a[0][0]), SubUnpackedU8<0>(a[1][2], a[1][0]), SubUnpackedU8<0>(a[2][2], a[2][0]));
+            __m256i hi = BinomialSum16(SubUnpackedU8<1>(a[0][2], a[0][0]), SubUnpackedU8<1>(a[1][2], a[1][0]), SubUnpackedU8<1>(a[2][2], a[2][0]));
+            dx[0] = _mm256_permute2x128_si256(lo, hi, 0x20);
+            dx[1] = _mm256_permute2x128_si256(lo, hi, 0x31);
+            lo = BinomialSum16(SubUnpackedU8<0>(a[2][0], a[0][0]), SubUnpackedU8<0>(a[2][1], a[0][1]), SubUnpackedU8<0>(a[2][2], a[0][2]));
+            hi = BinomialSum16(SubUnpackedU8<1>(a[2][0], a[0][0]), SubUnpackedU8<1>(a[2][1], a[0][1]), SubUnpackedU8<1>(a[2][2], a[0][2]));
+            dy[0] = _mm256_permute2x128_si256(lo, hi, 0x20);
+            dy[1] = _mm256_permute2x128_si256(lo, hi, 0x31);
+        }
+
+        template<bool align> SIMD_INLINE void SobelGradient(__m256i a[3][3], size_t col, int16_t * dx, int16_t * dy,
+            uint16_t * magnitude, const __m256i * table, size_t size, uint8_t * direction)
+        {
+            __m256i _dx[2], _dy[2];
+            SobelGradient(a, _dx, _dy);
+            if (dx)
+            {
+                Store<align>((__m256i*)(dx + col) + 0, _dx[0]);
+                Store<align>((__m256i*)(dx + col) + 1, _dx[1]);
+            }
+            if (dy)
+            {
+                Store<align>((__m256i*)(dy + col) + 0, _dy[0]);
+                Store<align>((__m256i*)(dy + col) + 1, _dy[1]);
+            }
+            if (magnitude)
+            {
+                Store<align>((__m256i*)(magnitude + col) + 0, _mm256_add_epi16(_mm256_abs_epi16(_dx[0]), _mm256_abs_epi16(_dy[0])));
+                Store<align>((__m256i*)(magnitude + col) + 1, _mm256_add_epi16(_mm256_abs_epi16(_dx[1]), _mm256_abs_epi16(_dy[1])));
+            }
+            if (direction)
+            {
+                __m256i lo = SobelDirection(_dx[0], _dy[0], table, size);
+                __m256i hi = SobelDirection(_dx[1], _dy[1], table, size);
+                Store<align>((__m256i*)(direction + col), PackU16ToU8(lo, hi));
+            }
+        }
+
+        template <bool align> void SobelGradient(const uint8_t * src, size_t srcStride, size_t width, size_t height, int16_t * dx, size_t dxStride,
+            int16_t * dy, size_t dyStride, uint16_t * magnitude, size_t magnitudeStride, size_t quantization, uint8_t * direction, size_t directionStride)
+        {
+            assert(width > A);
+
+            size_t size = quantization/2;
+            __m256i table[Base::SOBEL_DIRECTION_TABLE_SIZE/2];
+            if (direction)
+            {
+                int16_t buffer[Base::SOBEL_DIRECTION_TABLE_SIZE];
+                Base::SobelDirectionTable(quantization, buffer);
+                for (size_t i = 0; i < size; ++i)
+                    table[i] = _mm256_set1_epi32(int32_t(uint16_t(buffer[2*i + 0]) | uint32_t(uint16_t(buffer[2*i + 1])) << 16));
+            }
+
+            size_t bodyWidth = Simd::AlignHi(width, A) - A;
+            const uint8_t *src0, *src1, *src2;
+            __m256i a[3][3];
+
+            for (size_t row = 0; row < height; ++row)
+            {
+                src0 = src + srcStride*(row - 1);
+                src1 = src0 + srcStride;
+                src2 = src1 + srcStride;
+                if (row == 0)
+                    src0 = src1;
+                if (row == height - 1)
+                    src2 = src1;
+
+                LoadNose3<align, 1>(src0 + 0, a[0]);
+                LoadNose3<align, 1>(src1 + 0, a[1]);
+                LoadNose3<align, 1>(src2 + 0, a[2]);
+                SobelGradient<align>(a, 0, dx, dy, magnitude, table, size, direction);
+                for (size_t col = A; col < bodyWidth; col += A)
+                {
+                    LoadBody3<align, 1>(src0 + col, a[0]);
+                    LoadBody3<align, 1>(src1 + col, a[1]);
+                    LoadBody3<align, 1>(src2 + col, a[2]);
+                    SobelGradient<align>(a, col, dx, dy, magnitude, table, size, direction);
+                }
+                LoadTail3<false, 1>(src0 + width - A, a[0]);
+                LoadTail3<false, 1>(src1 + width - A, a[1]);
+                LoadTail3<false, 1>(src2 + width - A, a[2]);
+                SobelGradient<false>(a, width - A, dx, dy, magnitude, table, size, direction);
+
+                if (dx)
+                    dx += dxStride;
+                if (dy)
+                    dy += dyStride;
+                if (magnitude)
+                    magnitude += magnitudeStride;
+                if (direction)
+                    direction += directionStride;
+            }
+        }
+
+        SIMD_INLINE bool AlignedOrEmpty(const uint8_t * data, size_t stride)
+        {
+            return data == NULL || (Aligned(data) && Aligned(stride));
+        }
+
+        void SobelGradient(const uint8_t * src, size_t srcStride, size_t width, size_t height, uint8_t * dx, size_t dxStride,
+            uint8_t * dy, size_t dyStride, uint8_t * magnitude, size_t magnitudeStride, size_t quantization, uint8_t * direction, size_t directionStride)
+        {
+            assert(dxStride%sizeof(int16_t) == 0 && dyStride%sizeof(int16_t) == 0 && magnitudeStride%sizeof(uint16_t) == 0);
+
+            if (AlignedOrEmpty(src, srcStride) && AlignedOrEmpty(dx, dxStride) && AlignedOrEmpty(dy, dyStride) && 
+                AlignedOrEmpty(magnitude, magnitudeStride) && AlignedOrEmpty(direction, directionStride))
+                SobelGradient<true>(src, srcStride, width, height, (int16_t*)dx, dxStride/sizeof(int16_t), (int16_t*)dy, dyStride/sizeof(int16_t),
+                    (uint16_t*)magnitude, magnitudeStride/sizeof(uint16_t), quantization, direction, directionStride);
+            else
+                SobelGradient<false>(src, srcStride, width, height, (int16_t*)dx, dxStride/sizeof(int16_t), (int16_t*)dy, dyStride/sizeof(int16_t),
+                    (uint16_t*)magnitude, magnitudeStride/sizeof(uint16_t), quantization, direction, directionStride);
+        }
+
+        template<bool align> SIMD_INLINE void SobelGradient32f(__m256 dx, __m256 dy, float * magnitude, float * direction)
+        {
+            if (magnitude)
+                Avx::Store<align>(magnitude, _mm256_sqrt_ps(_mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy))));
+            if (direction)
+                Avx::Store<align>(direction, Atan2(dy, dx));
+        }
+
+        template<bool align> SIMD_INLINE void SobelGradient32f(__m256i a[3][3], size_t col, float * magnitude, float * direction)
+        {
+            __m256i dx[2], dy[2];
+            SobelGradient(a, dx, dy);
+            for (size_t i = 0; i < 2; ++i)
+            {
+                size_t offset = col + i*HA;
+                SobelGradient32f<align>(_mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(_mm256_extracti128_si256(dx[i], 0))), 
+                    _mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(_mm256_extracti128_si256(dy[i], 0))), 
+                    magnitude ? magnitude + offset : NULL, direction ? direction + offset : NULL);
+                SobelGradient32f<align>(_mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(_mm256_extracti128_si256(dx[i], 1))), 
+                    _mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(_mm256_extracti128_si256(dy[i], 1))), 
+                    magnitude ? magnitude + offset + F : NULL, direction ? direction + offset + F : NULL);
+            }
+        }
+
+        template <bool align> void SobelGradient32f(const uint8_t * src, size_t srcStride, size_t width, size_t height,
+            float * magnitude, size_t magnitudeStride, float * direction, size_t directionStride)
+        {
+            assert(width > A);
+
+            size_t bodyWidth = Simd::AlignHi(width, A) - A;
+            const uint8_t *src0, *src1, *src2;
+            __m256i a[3][3];
+
+            for (size_t row = 0; row < height; ++row)
+            {
+                src0 = src + srcStride*(row - 1);
+                src1 = src0 + srcStride;
+                src2 = src1 + srcStride;
+                if (row == 0)
+                    src0 = src1;
+                if (row == height - 1)
+                    src2 = src1;
+
+                LoadNose3<align, 1>(src0 + 0, a[0]);
+                LoadNose3<align, 1>(src1 + 0, a[1]);
+                LoadNose3<align, 1>(src2 + 0, a[2]);
+                SobelGradient32f<align>(a, 0, magnitude, direction);
+                for (size_t col = A; col < bodyWidth; col += A)
+                {
+                    LoadBody3<align, 1>(src0 + col, a[0]);
+                    LoadBody3<align, 1>(src1 + col, a[1]);
+                    LoadBody3<align, 1>(src2 + col, a[2]);
+                    SobelGradient32f<align>(a, col, magnitude, direction);
+                }
+                LoadTail3<false, 1>(src0 + width - A, a[0]);
+                LoadTail3<false, 1>(src1 + width - A, a[1]);
+                LoadTail3<false, 1>(src2 + width - A, a[2]);
+                SobelGradient32f<false>(a, width - A, magnitude, direction);
+
+                if (magnitude)
+                    magnitude += magnitudeStride;
+                if (direction)
+                    direction += directionStride;
+            }
+        }
+
+        void SobelGradient32f(const uint8_t * src, size_t srcStride, size_t width, size_t height,
+            uint8_t * magnitude, size_t magnitudeStride, uint8_t * direction, size_t directionStride)
+        {
+            assert(magnitudeStride%sizeof(float) == 0 && directionStride%sizeof(float) == 0);
+
+            if (AlignedOrEmpty(src, srcStride) && AlignedOrEmpty(magnitude, magnitudeStride) && AlignedOrEmpty(direction, directionStride))
+                SobelGradient32f<true>(src, srcStride, width, height, (float*)magnitude, magnitudeStride/sizeof(float),
+                    (float*)direction, directionStride/sizeof(float));
+            else
+                SobelGradient32f<false>(src, srcStride, width, height, (float*)magnitude, magnitudeStride/sizeof(float),
+                    (float*)direction, directionStride/sizeof(float));
+        }
+
         SIMD_INLINE __m256i ContourMetrics(__m256i dx, __m256i dy)
         {
             return _mm256_add_epi16(_mm256_slli_epi16(_mm256_add_epi16(dx, dy), 1), _mm256_and_si256(_mm256_cmpgt_epi16(dy, dx), K16_0001)); 
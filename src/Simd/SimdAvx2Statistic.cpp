@@ -25,6 +25,8 @@
 #include "Simd/SimdStore.h"
 #include "Simd/SimdExtract.h"
 #include "Simd/SimdSet.h"
+#include "Simd/SimdLoad.h"
+#include "Simd/SimdStatistic.h"
 
 namespace Simd
 {
@@ -256,6 +258,155 @@ namespace Simd
                 GetMoments<false>(mask, stride, width, height, index, area, x, y, xx, xy, yy);
         }
 
+        template<bool align> SIMD_INLINE __m256i ImageStatisticsMask(const uint8_t * mask, __m256i index, __m256i tail)
+        {
+            return mask ? _mm256_and_si256(_mm256_cmpeq_epi8(Load<align>((__m256i*)mask), index), tail) : tail;
+        }
+
+        const __m256i K16_IMAGE_STATISTICS_COL = SIMD_MM256_SETR_EPI16(0, 1, 2, 3, 4, 5, 6, 7, 16, 17, 18, 19, 20, 21, 22, 23);
+
+        SIMD_INLINE void ImageStatisticsMoments(__m256i mask, size_t col, __m256i & count, __m256i & x, __m256i & xx)
+        {
+            count = _mm256_add_epi64(count, _mm256_sad_epu8(_mm256_and_si256(mask, K8_01), K_ZERO));
+            __m256i lo = _mm256_add_epi16(K16_IMAGE_STATISTICS_COL, _mm256_set1_epi16((short)col));
+            __m256i hi = _mm256_and_si256(_mm256_add_epi16(lo, K16_0008), _mm256_unpackhi_epi8(mask, mask));
+            lo = _mm256_and_si256(lo, _mm256_unpacklo_epi8(mask, mask));
+            x = _mm256_add_epi32(x, _mm256_add_epi32(_mm256_madd_epi16(lo, K16_0001), _mm256_madd_epi16(hi, K16_0001)));
+            xx = _mm256_add_epi64(xx, _mm256_add_epi64(HorizontalSum32(_mm256_madd_epi16(lo, lo)), HorizontalSum32(_mm256_madd_epi16(hi, hi))));
+        }
+
+        template<bool align> SIMD_INLINE void ImageStatisticsSums(const uint8_t * src, __m256i mask, 
+            __m256i & min, __m256i & max, __m256i & sum, __m256i & squareSum)
+        {
+            __m256i value = _mm256_and_si256(Load<align>((__m256i*)src), mask);
+            min = _mm256_min_epu8(min, _mm256_or_si256(value, _mm256_andnot_si256(mask, K_INV_ZERO)));
+            max = _mm256_max_epu8(max, value);
+            sum = _mm256_add_epi64(sum, _mm256_sad_epu8(value, K_ZERO));
+            __m256i lo = _mm256_unpacklo_epi8(value, K_ZERO), hi = _mm256_unpackhi_epi8(value, K_ZERO);
+            squareSum = _mm256_add_epi32(squareSum, _mm256_add_epi32(_mm256_madd_epi16(lo, lo), _mm256_madd_epi16(hi, hi)));
+        }
+
+        template<int part> SIMD_INLINE __m256i ImageStatisticsLaplaceAbs(__m256i a[3][3])
+        {
+            return _mm256_abs_epi16(_mm256_sub_epi16(_mm256_mullo_epi16(K16_0008, UnpackU8<part>(a[1][1])),
+                _mm256_add_epi16(_mm256_add_epi16(_mm256_maddubs_epi16(UnpackU8<part>(a[0][0], a[0][1]), K8_01),
+                _mm256_maddubs_epi16(UnpackU8<part>(a[0][2], a[1][0]), K8_01)),
+                _mm256_add_epi16(_mm256_maddubs_epi16(UnpackU8<part>(a[1][2], a[2][0]), K8_01),
+                _mm256_maddubs_epi16(UnpackU8<part>(a[2][1], a[2][2]), K8_01)))));
+        }
+
+        SIMD_INLINE void ImageStatisticsLaplace(__m256i a[3][3], __m256i mask, __m256i & sum)
+        {
+            __m256i lo = _mm256_and_si256(ImageStatisticsLaplaceAbs<0>(a), _mm256_unpacklo_epi8(mask, mask));
+            __m256i hi = _mm256_and_si256(ImageStatisticsLaplaceAbs<1>(a), _mm256_unpackhi_epi8(mask, mask));
+            sum = _mm256_add_epi32(sum, _mm256_add_epi32(_mm256_madd_epi16(lo, K16_0001), _mm256_madd_epi16(hi, K16_0001)));
+        }
+
+        template <bool align> void GetImageStatistics(const uint8_t * src, size_t srcStride, size_t width, size_t height, const uint8_t * mask, size_t maskStride,
+            uint8_t index, uint32_t flags, size_t rowBegin, size_t rowEnd, SimdImageStatistics * statistics)
+        {
+            assert(width > A && width < SHRT_MAX && rowEnd <= height);
+            if (align)
+                assert(Aligned(src) && Aligned(srcStride) && (mask == NULL || (Aligned(mask) && Aligned(maskStride))));
+
+            SimdImageStatistics & s = *statistics;
+            memset(&s, 0, sizeof(s));
+            Base::ImageStatisticsHistograms histograms;
+            if (flags & SimdImageStatisticsHistogram)
+                memset(histograms, 0, sizeof(histograms));
+
+            size_t bodyWidth = AlignHi(width, A) - A, tail = width - A;
+            const __m256i tailMask = SetMask<uint8_t>(0, A - width + bodyWidth, 0xFF);
+            const __m256i _index = _mm256_set1_epi8(index);
+            __m256i min = K_INV_ZERO, max = K_ZERO, sum = _mm256_setzero_si256(), squareSum = _mm256_setzero_si256(), laplace = _mm256_setzero_si256();
+            __m256i a[3][3];
+            for (size_t row = rowBegin; row < rowEnd; ++row)
+            {
+                const uint8_t * s0 = row ? src + (row - 1)*srcStride : src + row*srcStride;
+                const uint8_t * s1 = src + row*srcStride;
+                const uint8_t * s2 = row < height - 1 ? src + (row + 1)*srcStride : s1;
+                const uint8_t * m = mask ? mask + row*maskStride : NULL;
+
+                if (m)
+                {
+                    __m256i rowCount = _mm256_setzero_si256(), rowX = _mm256_setzero_si256(), rowXX = _mm256_setzero_si256();
+                    for (size_t col = 0; col < bodyWidth; col += A)
+                        ImageStatisticsMoments(ImageStatisticsMask<align>(m + col, _index, K_INV_ZERO), col, rowCount, rowX, rowXX);
+                    ImageStatisticsMoments(ImageStatisticsMask<false>(m + tail, _index, tailMask), tail, rowCount, rowX, rowXX);
+                    uint64_t count = ExtractSum<uint64_t>(rowCount);
+                    s.count += count;
+                    if (flags & SimdImageStatisticsMoments)
+                        Base::ImageStatisticsMoments(row, count, ExtractSum<uint64_t>(HorizontalSum32(rowX)), ExtractSum<uint64_t>(rowXX), s);
+                }
+                else
+                {
+                    s.count += width;
+                    if (flags & SimdImageStatisticsMoments)
+                        Base::ImageStatisticsMoments(row, width, uint64_t(width)*(width - 1) / 2, uint64_t(width)*(width - 1)*(2 * width - 1) / 6, s);
+                }
+
+                if (flags & (SimdImageStatisticsMinMax | SimdImageStatisticsSums))
+                {
+                    __m256i rowSquareSum = _mm256_setzero_si256();
+                    for (size_t col = 0; col < bodyWidth; col += A)
+                        ImageStatisticsSums<align>(s1 + col, ImageStatisticsMask<align>(m ? m + col : NULL, _index, K_INV_ZERO), min, max, sum, rowSquareSum);
+                    ImageStatisticsSums<false>(s1 + tail, ImageStatisticsMask<false>(m ? m + tail : NULL, _index, tailMask), min, max, sum, rowSquareSum);
+                    squareSum = _mm256_add_epi64(squareSum, HorizontalSum32(rowSquareSum));
+                }
+
+                if (flags & SimdImageStatisticsHistogram)
+                    Base::ImageStatisticsHistogram(s1, m, index, width, histograms);
+
+                if (flags & SimdImageStatisticsLaplaceAbsSum)
+                {
+                    __m256i rowSum = _mm256_setzero_si256();
+                    LoadNose3<align, 1>(s0, a[0]);
+                    LoadNose3<align, 1>(s1, a[1]);
+                    LoadNose3<align, 1>(s2, a[2]);
+                    ImageStatisticsLaplace(a, ImageStatisticsMask<align>(m, _index, K_INV_ZERO), rowSum);
+                    for (size_t col = A; col < bodyWidth; col += A)
+                    {
+                        LoadBody3<align, 1>(s0 + col, a[0]);
+                        LoadBody3<align, 1>(s1 + col, a[1]);
+                        LoadBody3<align, 1>(s2 + col, a[2]);
+                        ImageStatisticsLaplace(a, ImageStatisticsMask<align>(m ? m + col : NULL, _index, K_INV_ZERO), rowSum);
+                    }
+                    LoadTail3<false, 1>(s0 + tail, a[0]);
+                    LoadTail3<false, 1>(s1 + tail, a[1]);
+                    LoadTail3<false, 1>(s2 + tail, a[2]);
+                    ImageStatisticsLaplace(a, ImageStatisticsMask<false>(m ? m + tail : NULL, _index, tailMask), rowSum);
+                    laplace = _mm256_add_epi64(laplace, HorizontalSum32(rowSum));
+                }
+            }
+
+            int _min = UCHAR_MAX, _max = 0;
+            if (flags & (SimdImageStatisticsMinMax | SimdImageStatisticsSums))
+            {
+                uint8_t minBuffer[A], maxBuffer[A];
+                _mm256_storeu_si256((__m256i*)minBuffer, min);
+                _mm256_storeu_si256((__m256i*)maxBuffer, max);
+                for (size_t i = 0; i < A; ++i)
+                {
+                    _min = Base::MinU8(minBuffer[i], _min);
+                    _max = Base::MaxU8(maxBuffer[i], _max);
+                }
+                s.sum = ExtractSum<uint64_t>(sum);
+                s.squareSum = ExtractSum<uint64_t>(squareSum);
+            }
+            if (flags & SimdImageStatisticsLaplaceAbsSum)
+                s.laplaceAbsSum = ExtractSum<uint64_t>(laplace);
+            Base::ImageStatisticsFinalize(flags, _min, _max, histograms, s);
+        }
+
+        void GetImageStatistics(const uint8_t * src, size_t srcStride, size_t width, size_t height, const uint8_t * mask, size_t maskStride,
+            uint8_t index, uint32_t flags, size_t rowBegin, size_t rowEnd, SimdImageStatistics * statistics)
+        {
+            if (Aligned(src) && Aligned(srcStride) && (mask == NULL || (Aligned(mask) && Aligned(maskStride))))
+                GetImageStatistics<true>(src, srcStride, width, height, mask, maskStride, index, flags, rowBegin, rowEnd, statistics);
+            else
+                GetImageStatistics<false>(src, srcStride, width, height, mask, maskStride, index, flags, rowBegin, rowEnd, statistics);
+        }
+
         template <bool align> void GetRowSums(const uint8_t * src, size_t stride, size_t width, size_t height, uint32_t * sums)
         {
             size_t alignedWidth = AlignLo(width, A);
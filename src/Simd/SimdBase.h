@@ -120,6 +120,9 @@ namespace Simd
 
         void BgrToYuv444p(const uint8_t * bgr, size_t width, size_t height, size_t bgrStride, uint8_t * y, size_t yStride, uint8_t * u, size_t uStride, uint8_t * v, size_t vStride);
 
+        void BilateralFilter(const uint8_t * src, size_t srcStride, size_t width, size_t height, size_t channelCount,
+            size_t radius, float sigmaSpace, float sigmaRange, uint8_t * dst, size_t dstStride);
+
         void Binarization(const uint8_t * src, size_t srcStride, size_t width, size_t height, 
             uint8_t value, uint8_t positive, uint8_t negative, uint8_t * dst, size_t dstStride, SimdCompareType compareType);
 
@@ -160,6 +163,10 @@ namespace Simd
 
         void * DetectionLoadA(const char * path);
 
+        int DetectionSaveBinary(const void * data, const char * path);
+
+        void * DetectionLoadBinary(const char * path);
+
         void DetectionInfo(const void * data, size_t * width, size_t * height, SimdDetectionInfoFlags * flags);
 
         void * DetectionInit(const void * data, uint8_t * sum, size_t sumStride, size_t width, size_t height,
@@ -173,6 +180,12 @@ namespace Simd
         void DetectionHaarDetect32fi(const void * hid, const uint8_t * mask, size_t maskStride,
             ptrdiff_t left, ptrdiff_t top, ptrdiff_t right, ptrdiff_t bottom, uint8_t * dst, size_t dstStride);
 
+        void DetectionHaarDetect16ip(const void * hid, const uint8_t * mask, size_t maskStride,
+            ptrdiff_t left, ptrdiff_t top, ptrdiff_t right, ptrdiff_t bottom, uint8_t * dst, size_t dstStride);
+
+        void DetectionHaarDetect16ii(const void * hid, const uint8_t * mask, size_t maskStride,
+            ptrdiff_t left, ptrdiff_t top, ptrdiff_t right, ptrdiff_t bottom, uint8_t * dst, size_t dstStride);
+
         void DetectionLbpDetect32fp(const void * hid, const uint8_t * mask, size_t maskStride,
             ptrdiff_t left, ptrdiff_t top, ptrdiff_t right, ptrdiff_t bottom, uint8_t * dst, size_t dstStride);
 
@@ -185,6 +198,11 @@ namespace Simd
         void DetectionLbpDetect16ii(const void * hid, const uint8_t * mask, size_t maskStride,
             ptrdiff_t left, ptrdiff_t top, ptrdiff_t right, ptrdiff_t bottom, uint8_t * dst, size_t dstStride);
 
+        size_t DetectionStageNumber(const void * hid);
+
+        void DetectionCountStages(const void * hid, const uint8_t * mask, size_t maskStride,
+            ptrdiff_t left, ptrdiff_t top, ptrdiff_t right, ptrdiff_t bottom, size_t * counts);
+
         void DetectionFree(void * ptr);
 
         void EdgeBackgroundGrowRangeSlow(const uint8_t * value, size_t valueStride, size_t width, size_t height,
@@ -217,13 +235,22 @@ namespace Simd
 
         void FillBgra(uint8_t * dst, size_t stride, size_t width, size_t height, uint8_t blue, uint8_t green, uint8_t red, uint8_t alpha);
 
+        void Filter2D(const uint8_t * src, size_t srcStride, size_t width, size_t height, SimdPixelFormatType format,
+            const float * kernel, size_t size, SimdBorderType border, uint8_t * dst, size_t dstStride);
+
         void GaussianBlur3x3(const uint8_t * src, size_t srcStride, size_t width, size_t height, 
             size_t channelCount, uint8_t * dst, size_t dstStride);
 
+        void Gemm32fNN(size_t M, size_t N, size_t K, const float * alpha, const float * A, size_t lda,
+            const float * B, size_t ldb, const float * beta, float * C, size_t ldc);
+
         void GrayToBgr(const uint8_t *gray, size_t width, size_t height, size_t grayStride, uint8_t *bgr, size_t bgrStride);
 
         void GrayToBgra(const uint8_t *gray, size_t width, size_t height, size_t grayStride, uint8_t *bgra, size_t bgraStride, uint8_t alpha);
 
+        void GuidedFilter(const uint8_t * src, size_t srcStride, size_t width, size_t height, size_t channelCount,
+            size_t radius, float eps, uint8_t * dst, size_t dstStride);
+
         void AbsSecondDerivativeHistogram(const uint8_t *src, size_t width, size_t height, size_t stride,
             size_t step, size_t indent, uint32_t * histogram);
 
@@ -243,12 +270,22 @@ namespace Simd
 
         void NormalizeHistogram(const uint8_t * src, size_t srcStride, size_t width, size_t height, uint8_t * dst, size_t dstStride);
 
+        void ClaheLuts(const uint8_t * src, size_t srcStride, size_t width, size_t height, size_t tilesX, size_t tilesY, 
+            float clipLimit, size_t tileRowBegin, size_t tileRowEnd, uint8_t * luts);
+
+        void ClaheApply(const uint8_t * src, size_t srcStride, size_t width, size_t height, size_t tilesX, size_t tilesY, 
+            const uint8_t * luts, size_t rowBegin, size_t rowEnd, uint8_t * dst, size_t dstStride);
+
         void Int16ToGray(const uint8_t * src, size_t width, size_t height, size_t srcStride, uint8_t * dst, size_t dstStride);
 
         void Integral(const uint8_t * src, size_t srcStride, size_t width, size_t height, 
             uint8_t * sum, size_t sumStride, uint8_t * sqsum, size_t sqsumStride, uint8_t * tilted, size_t tiltedStride, 
             SimdPixelFormatType sumFormat, SimdPixelFormatType sqsumFormat);
 
+        void IntegralUpdate(const uint8_t * src, size_t srcStride, size_t width, size_t height, const ptrdiff_t * rects, size_t rectNumber,
+            uint8_t * sum, size_t sumStride, uint8_t * sqsum, size_t sqsumStride, uint8_t * tilted, size_t tiltedStride,
+            SimdPixelFormatType sumFormat, SimdPixelFormatType sqsumFormat);
+
         void InterferenceIncrement(uint8_t * statistic, size_t stride, size_t width, size_t height, uint8_t increment, int16_t saturation);
 
         void InterferenceIncrementMasked(uint8_t * statistic, size_t statisticStride, size_t width, size_t height, 
@@ -277,6 +314,8 @@ namespace Simd
 
 		void MeanFilter3x3(const uint8_t * src, size_t srcStride, size_t width, size_t height, size_t channelCount, uint8_t * dst, size_t dstStride);
 
+        void * MapFile(const char * path, size_t * size);
+
         void MedianFilterRhomb3x3(const uint8_t * src, size_t srcStride, size_t width, size_t height, 
             size_t channelCount, uint8_t * dst, size_t dstStride);
 
@@ -317,6 +356,9 @@ namespace Simd
 
         void NeuralAdaptiveGradientUpdate(const float * delta, size_t size, size_t batch, const float * alpha, const float * epsilon, float * gradient, float * weight);
 
+        void NeuralAdamUpdate(const float * delta, size_t size, size_t batch, const float * alpha, const float * beta1, const float * beta2,
+            const float * epsilon, const float * decay, float * moment1, float * moment2, float * weight);
+
         void NeuralAddConvolution3x3(const float * src, size_t srcStride, size_t width, size_t height, const float * weights, float * dst, size_t dstStride);
 
         void NeuralAddConvolution5x5(const float * src, size_t srcStride, size_t width, size_t height, const float * weights, float * dst, size_t dstStride);
@@ -329,6 +371,28 @@ namespace Simd
 
         void NeuralAddConvolution5x5Sum(const float * src, size_t srcStride, const float * dst, size_t dstStride, size_t width, size_t height, float * sums);
 
+        void NeuralConvolutionForward(const float * src, size_t srcWidth, size_t srcHeight, size_t srcDepth, const float * weight,
+            size_t kernelX, size_t kernelY, size_t padX, size_t padY, size_t strideX, size_t strideY, size_t dilationX, size_t dilationY,
+            void * buffer, size_t * size, float * dst, size_t dstWidth, size_t dstHeight, size_t dstDepth, int add);
+
+        void NeuralConvolutionBackward(const float * src, size_t srcWidth, size_t srcHeight, size_t srcDepth, const float * weight,
+            size_t kernelX, size_t kernelY, size_t padX, size_t padY, size_t strideX, size_t strideY, size_t dilationX, size_t dilationY,
+            void * buffer, size_t * size, float * dst, size_t dstWidth, size_t dstHeight, size_t dstDepth, int add);
+
+        void NeuralConvolutionSum(const float * src, size_t srcWidth, size_t srcHeight, size_t srcDepth, const float * dst, size_t dstWidth, size_t dstHeight, size_t dstDepth,
+            size_t kernelX, size_t kernelY, size_t padX, size_t padY, size_t strideX, size_t strideY, size_t dilationX, size_t dilationY,
+            void * buffer, size_t * size, float * sums);
+
+        void NeuralWinograd2x2p3x3SetFilter(const float * src, size_t size, float * dst);
+
+        void NeuralWinograd2x2p3x3SetInput(const float * src, size_t srcWidth, size_t srcHeight, size_t srcDepth, float * dst);
+
+        void NeuralWinograd2x2p3x3SetOutput(const float * src, float * dst, size_t dstWidth, size_t dstHeight, size_t dstDepth);
+
+        void NeuralQuantize8u(const float * src, size_t size, const float * scale, const float * shift, uint8_t * dst);
+
+        void NeuralProductSum8u8i(const uint8_t * src, const int8_t * weight, size_t size, size_t count, int32_t * sums);
+
         void NeuralMax2x2(const float * src, size_t srcStride, size_t width, size_t height, float * dst, size_t dstStride);
 
         void OperationBinary8u(const uint8_t * a, size_t aStride, const uint8_t * b, size_t bStride,
@@ -396,6 +460,14 @@ namespace Simd
 
         void SobelDyAbsSum(const uint8_t * src, size_t stride, size_t width, size_t height, uint64_t * sum);
 
+        void SobelGradient(const uint8_t * src, size_t srcStride, size_t width, size_t height, uint8_t * dx, size_t dxStride, 
+            uint8_t * dy, size_t dyStride, uint8_t * magnitude, size_t magnitudeStride, size_t quantization, uint8_t * direction, size_t directionStride);
+
+        void SobelGradient32f(const uint8_t * src, size_t srcStride, size_t width, size_t height, 
+            uint8_t * magnitude, size_t magnitudeStride, uint8_t * direction, size_t directionStride);
+
+        void SobelDirectionTable(size_t quantization, int16_t * table);
+
         void ContourMetrics(const uint8_t * src, size_t srcStride, size_t width, size_t height, uint8_t * dst, size_t dstStride);
 
         void ContourMetricsMasked(const uint8_t * src, size_t srcStride, size_t width, size_t height, 
@@ -420,6 +492,9 @@ namespace Simd
         void GetMoments(const uint8_t * mask, size_t stride, size_t width, size_t height, uint8_t index, 
             uint64_t * area, uint64_t * x, uint64_t * y, uint64_t * xx, uint64_t * xy, uint64_t * yy);
 
+        void GetImageStatistics(const uint8_t * src, size_t srcStride, size_t width, size_t height, const uint8_t * mask, size_t maskStride,
+            uint8_t index, uint32_t flags, size_t rowBegin, size_t rowEnd, SimdImageStatistics * statistics);
+
         void GetRowSums(const uint8_t * src, size_t stride, size_t width, size_t height, uint32_t * sums);
 
         void GetColSums(const uint8_t * src, size_t stride, size_t width, size_t height, uint32_t * sums);
@@ -451,6 +526,8 @@ namespace Simd
         void TexturePerformCompensation(const uint8_t * src, size_t srcStride, size_t width, size_t height, 
             int shift, uint8_t * dst, size_t dstStride);
 
+        void UnmapFile(void * data, size_t size);
+
         void Yuv420pToBgr(const uint8_t * y, size_t yStride, const uint8_t * u, size_t uStride, const uint8_t * v, size_t vStride, 
             size_t width, size_t height, uint8_t * bgr, size_t bgrStride);
 
@@ -0,0 +1,149 @@
+/*
+* Simd Library (http://simd.sourceforge.net).
+*
+* Copyright (c) 2011-2017 Yermalayeu Ihar.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy 
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell 
+* copies of the Software, and to permit persons to whom the Software is 
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in 
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE 
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+#include "Simd/SimdBilateralFilter.h"
+
+#include <float.h>
+
+namespace Simd
+{
+    namespace Base
+    {
+        /*
+        * Weights are rounded to 8 significant bits (too small ones are set to 0). So all products of weights and pixel values are exact
+        * and the result does not depend on contraction of multiplication and addition (FMA) in optimized implementations.
+        */
+        SIMD_INLINE float BilateralFilterWeight(float value)
+        {
+            if (value < 1.0e-18f)
+                return 0.0f;
+            int exponent;
+            double mantissa = ::frexp(double(value), &exponent);
+            return float(::ldexp(::floor(mantissa*256.0 + 0.5) / 256.0, exponent));
+        }
+
+        BilateralFilterParam::BilateralFilterParam(const uint8_t * src, size_t srcStride, size_t width, size_t height,
+            size_t channelCount_, size_t radius_, float sigmaSpace, float sigmaRange)
+            : channelCount(channelCount_)
+            , radius(radius_)
+        {
+            assert(channelCount == 1 || channelCount == 3);
+
+            stride = AlignHi((width + 2 * radius)*channelCount + SIMD_ALIGN, SIMD_ALIGN);
+            _padded = (uint8_t*)Allocate(stride*(height + 2 * radius));
+            for (size_t row = 0; row < height + 2 * radius; ++row)
+            {
+                const uint8_t * s = src + RestrictRange(int(row) - int(radius), 0, int(height) - 1)*srcStride;
+                uint8_t * d = _padded + row*stride;
+                for (size_t i = 0; i < radius; ++i)
+                {
+                    for (size_t c = 0; c < channelCount; ++c)
+                    {
+                        d[i*channelCount + c] = s[c];
+                        d[(radius + width + i)*channelCount + c] = s[(width - 1)*channelCount + c];
+                    }
+                }
+                memcpy(d + radius*channelCount, s, width*channelCount);
+                memset(d + (width + 2 * radius)*channelCount, 0, stride - (width + 2 * radius)*channelCount);
+            }
+
+            // Sigmas are clamped by minimal positive value: zero sigma means that only equal (or central) pixels have non-zero weight.
+            sigmaSpace = Simd::Max(sigmaSpace, FLT_EPSILON);
+            sigmaRange = Simd::Max(sigmaRange, FLT_EPSILON);
+
+            float space2 = -0.5f / (sigmaSpace*sigmaSpace);
+            for (int dy = -int(radius); dy <= int(radius); ++dy)
+            {
+                for (int dx = -int(radius); dx <= int(radius); ++dx)
+                {
+                    if (dx*dx + dy*dy > int(radius*radius))
+                        continue;
+                    offsets.push_back(dy*int(stride) + dx*int(channelCount));
+                    space.push_back(BilateralFilterWeight(::exp(float(dx*dx + dy*dy)*space2)));
+                }
+            }
+
+            float range2 = -0.5f / (sigmaRange*sigmaRange);
+            range.resize(255 * channelCount + 1);
+            for (size_t i = 0; i < range.size(); ++i)
+            {
+                float d = float(i) / float(channelCount);
+                range[i] = BilateralFilterWeight(::exp(d*d*range2));
+            }
+        }
+
+        SIMD_INLINE void BilateralFilter1(const BilateralFilterParam & param, const uint8_t * src, uint8_t * dst)
+        {
+            float sum = 0, weight = 0;
+            int center = src[0];
+            for (size_t k = 0; k < param.offsets.size(); ++k)
+            {
+                int value = src[param.offsets[k]];
+                float w = param.range[Abs(value - center)] * param.space[k];
+                weight += w;
+                sum += w*float(value);
+            }
+            dst[0] = BilateralFilterRound(sum / weight);
+        }
+
+        SIMD_INLINE void BilateralFilter3(const BilateralFilterParam & param, const uint8_t * src, uint8_t * dst)
+        {
+            float sum0 = 0, sum1 = 0, sum2 = 0, weight = 0;
+            int c0 = src[0], c1 = src[1], c2 = src[2];
+            for (size_t k = 0; k < param.offsets.size(); ++k)
+            {
+                const uint8_t * s = src + param.offsets[k];
+                int v0 = s[0], v1 = s[1], v2 = s[2];
+                float w = param.range[Abs(v0 - c0) + Abs(v1 - c1) + Abs(v2 - c2)] * param.space[k];
+                weight += w;
+                sum0 += w*float(v0);
+                sum1 += w*float(v1);
+                sum2 += w*float(v2);
+            }
+            dst[0] = BilateralFilterRound(sum0 / weight);
+            dst[1] = BilateralFilterRound(sum1 / weight);
+            dst[2] = BilateralFilterRound(sum2 / weight);
+        }
+
+        void BilateralFilter(const uint8_t * src, size_t srcStride, size_t width, size_t height, size_t channelCount,
+            size_t radius, float sigmaSpace, float sigmaRange, uint8_t * dst, size_t dstStride)
+        {
+            BilateralFilterParam param(src, srcStride, width, height, channelCount, radius, sigmaSpace, sigmaRange);
+            for (size_t row = 0; row < height; ++row)
+            {
+                const uint8_t * s = param.Row(row);
+                if (channelCount == 1)
+                {
+                    for (size_t col = 0; col < width; ++col)
+                        BilateralFilter1(param, s + col, dst + col);
+                }
+                else
+                {
+                    for (size_t col = 0; col < width; ++col)
+                        BilateralFilter3(param, s + 3 * col, dst + 3 * col);
+                }
+                dst += dstStride;
+            }
+        }
+    }
+}
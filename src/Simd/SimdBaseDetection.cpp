@@ -23,12 +23,14 @@
 */
 #include "Simd/SimdMemory.h"
 #include "Simd/SimdDetection.h"
+#include "Simd/SimdBase.h"
 #include "Simd/SimdBase_tinyxml2.h"
 
 #include <exception>
 #include <stdexcept>
 #include <iostream>
 #include <sstream>
+#include <cstdio>
 
 #define SIMD_EX(message) \
 { \
@@ -147,6 +149,66 @@ namespace Simd
             const char * rect = "rect";
         }
 
+        // Estimates the shift of 16-bit integral images for every HAAR feature and the shift of normalization factor (see HidHaarCascade).
+        // A weighted sum of feature has to fit in 16-bit integer on shifted integral images, so does its scaled node threshold.
+        static bool HaarInt16(const Data & data, std::vector<int> & shifts, int & normShift)
+        {
+            const int width = data.origWinSize.x, height = data.origWinSize.y;
+            normShift = 0;
+            while (double(width - 2)*double(height - 2)*127.5 / (1 << normShift) + 0.5 > SHRT_MAX)
+                normShift++;
+
+            std::vector<double> thresholds(data.haarFeatures.size(), 0.0);
+            for (size_t i = 0; i < data.nodes.size(); ++i)
+            {
+                double & threshold = thresholds[data.nodes[i].featureIdx];
+                threshold = std::max<double>(threshold, std::abs(data.nodes[i].threshold));
+            }
+
+            shifts.resize(data.haarFeatures.size());
+            std::vector<double> weights(width*height);
+            for (size_t i = 0; i < data.haarFeatures.size(); ++i)
+            {
+                const Data::HaarFeature & feature = data.haarFeatures[i];
+                double positive = 0, negative = 0, total = 0;
+                std::fill(weights.begin(), weights.end(), 0.0);
+                for (int j = 0; j < Data::HaarFeature::RECT_NUM; ++j)
+                {
+                    const Data::WeightedRect & rect = feature.rect[j];
+                    if (rect.weight != (int16_t)rect.weight || std::abs(rect.weight) > 127)
+                        return false;
+                    total += std::abs(rect.weight);
+                    if (feature.tilted)
+                    {
+                        double area = 2.0*rect.r.width*rect.r.height + 2.0*(rect.r.width + rect.r.height);
+                        positive += std::abs(rect.weight)*area;
+                        negative += std::abs(rect.weight)*area;
+                    }
+                    else
+                    {
+                        for (int y = rect.r.y; y < rect.r.y + rect.r.height && y < height; ++y)
+                            for (int x = rect.r.x; x < rect.r.x + rect.r.width && x < width; ++x)
+                                weights[y*width + x] += rect.weight;
+                    }
+                }
+                for (size_t k = 0; k < weights.size(); ++k)
+                {
+                    positive += std::max(weights[k], 0.0);
+                    negative += std::max(-weights[k], 0.0);
+                }
+                double range = std::max(positive, negative)*255.0;
+
+                int shift = 0;
+                while (shift <= HidHaarCascade::INT16_SHIFT_MAX && (range / (1 << shift) + (shift ? 2 * total : 0) > SHRT_MAX ||
+                    thresholds[i] * (1 << (16 + normShift - shift)) + 0.5 > SHRT_MAX))
+                    shift++;
+                if (shift > HidHaarCascade::INT16_SHIFT_MAX)
+                    return false;
+                shifts[i] = shift;
+            }
+            return true;
+        }
+
         void * DetectionLoadA(const char * path)
         {
             static const float THRESHOLD_EPS = 1e-5f;
@@ -287,6 +349,9 @@ namespace Simd
                             data->hasTilted = true;
                         data->haarFeatures.push_back(feature);
                     }
+                    std::vector<int> shifts;
+                    int normShift;
+                    data->canInt16 = data->isStumpBased && HaarInt16(*data, shifts, normShift);
                 }
 
                 if (data->featureType == SimdDetectionInfoFeatureLbp)
@@ -316,6 +381,270 @@ namespace Simd
             return data;
         }
 
+        namespace Binary
+        {
+            /*
+            * Binary cascade file: header and sections with arrays of cascade data.
+            * Sections are stored by offsets from the file beginning (the file is relocatable) and are aligned by ALIGN bytes,
+            * so the arrays can be used directly from read only memory mapped file.
+            */
+            const char MAGIC[8] = { 'S', 'i', 'm', 'd', 'C', 'a', 's', 'c' };
+            const uint32_t VERSION = 1;
+            const uint32_t ENDIANNESS = 0x01020304;
+            const size_t ALIGN = 64;
+
+            enum Section
+            {
+                Stages,
+                Classifiers,
+                Nodes,
+                Leaves,
+                Subsets,
+                HaarFeatures,
+                LbpFeatures,
+                SectionSize
+            };
+
+            struct Header
+            {
+                char magic[8];
+                uint32_t version;
+                uint32_t endianness;
+                int32_t featureType;
+                int32_t stageType;
+                int32_t ncategories;
+                int32_t width;
+                int32_t height;
+                uint8_t isStumpBased;
+                uint8_t hasTilted;
+                uint8_t canInt16;
+                uint8_t reserved;
+                uint32_t itemSize[SectionSize];
+                uint64_t offset[SectionSize];
+                uint64_t count[SectionSize];
+                uint64_t fileSize;
+            };
+
+            template<class T> void SetSection(Header & header, Section section, const Array<T> & array, uint64_t & offset)
+            {
+                header.itemSize[section] = sizeof(T);
+                header.count[section] = array.size();
+                header.offset[section] = offset;
+                offset = AlignHi(size_t(offset + array.size()*sizeof(T)), ALIGN);
+            }
+
+            template<class T> void WriteSection(FILE * file, const Header & header, Section section, const Array<T> & array)
+            {
+                static const uint8_t zero[ALIGN] = { 0 };
+                size_t size = array.size()*sizeof(T), pad = AlignHi(size, ALIGN) - size;
+                if (fseek(file, (long)header.offset[section], SEEK_SET) || 
+                    (size && fwrite(array.data(), 1, size, file) != size) || 
+                    (pad && fwrite(zero, 1, pad, file) != pad))
+                    SIMD_EX("Can't write cascade section!");
+            }
+
+            // Padding bytes after HaarFeature::tilted are zeroed to make saved files deterministic.
+            void WriteSection(FILE * file, const Header & header, Section section, const Array<Data::HaarFeature> & array)
+            {
+                std::vector<Data::HaarFeature> features(array.size());
+                if (features.size())
+                    memset((void*)features.data(), 0, features.size()*sizeof(Data::HaarFeature));
+                for (size_t i = 0; i < array.size(); ++i)
+                {
+                    features[i].tilted = array[i].tilted;
+                    for (int j = 0; j < Data::HaarFeature::RECT_NUM; ++j)
+                        features[i].rect[j] = array[i].rect[j];
+                }
+                Array<Data::HaarFeature> packed;
+                packed.Refer(features.data(), features.size());
+                WriteSection<Data::HaarFeature>(file, header, section, packed);
+            }
+
+            template<class T> void ReferSection(const Header & header, Section section, const uint8_t * file, Array<T> & array)
+            {
+                uint64_t offset = header.offset[section], count = header.count[section];
+                if (header.itemSize[section] != sizeof(T) || offset % ALIGN || offset < sizeof(Header) ||
+                    offset > header.fileSize || count > (header.fileSize - offset) / sizeof(T))
+                    SIMD_EX("Invalid section of binary cascade!");
+                array.Refer((const T*)(file + offset), (size_t)count);
+            }
+
+            SIMD_INLINE bool Inside(const Data::Rect & r, const Size & size)
+            {
+                return r.x >= 0 && r.y >= 0 && r.width >= 0 && r.height >= 0 && 
+                    (int64_t)r.x + r.width <= size.x && (int64_t)r.y + r.height <= size.y;
+            }
+
+            SIMD_INLINE bool InsideTilted(const Data::Rect & r, const Size & size)
+            {
+                return r.y >= 0 && r.width >= 0 && r.height >= 0 && (int64_t)r.x - r.height >= 0 &&
+                    (int64_t)r.x + r.width <= size.x && (int64_t)r.y + r.width + r.height <= size.y;
+            }
+
+            // Checks all cross references of the cascade: the arrays are used directly from the mapped file without other checks.
+            void Validate(const Data & data)
+            {
+                if (!data.isStumpBased)
+                    SIMD_EX("Tree classifier cascades are not supported!");
+                size_t nodes = data.nodes.size();
+                if (data.classifiers.size() != nodes || data.leaves.size() != 2 * nodes)
+                    SIMD_EX("Invalid classifiers or leaves of binary cascade!");
+                for (size_t i = 0; i < data.classifiers.size(); ++i)
+                    if (data.classifiers[i].nodeCount != 1)
+                        SIMD_EX("Invalid classifier of binary cascade!");
+                int64_t first = 0;
+                for (size_t i = 0; i < data.stages.size(); ++i)
+                {
+                    const Data::Stage & stage = data.stages[i];
+                    if (stage.first != first || stage.ntrees < 0 || first + stage.ntrees > (int64_t)nodes)
+                        SIMD_EX("Invalid stage of binary cascade!");
+                    first += stage.ntrees;
+                }
+                size_t features = data.featureType == SimdDetectionInfoFeatureHaar ? data.haarFeatures.size() : data.lbpFeatures.size();
+                for (size_t i = 0; i < nodes; ++i)
+                {
+                    const Data::DTreeNode & node = data.nodes[i];
+                    if (node.featureIdx < 0 || (size_t)node.featureIdx >= features || 
+                        node.left > 0 || node.left < -1 || node.right > 0 || node.right < -1)
+                        SIMD_EX("Invalid node of binary cascade!");
+                }
+                if (data.featureType == SimdDetectionInfoFeatureHaar)
+                {
+                    for (size_t i = 0; i < data.haarFeatures.size(); ++i)
+                    {
+                        const Data::HaarFeature & feature = data.haarFeatures[i];
+                        for (int j = 0; j < Data::HaarFeature::RECT_NUM; ++j)
+                            if (!(feature.tilted ? InsideTilted(feature.rect[j].r, data.origWinSize) : Inside(feature.rect[j].r, data.origWinSize)))
+                                SIMD_EX("Invalid HAAR feature of binary cascade!");
+                    }
+                }
+                else
+                {
+                    // LBP code is 8-bit: the subset of every node has to contain 256 bits.
+                    size_t subsetSize = (data.ncategories + 31) / 32;
+                    if (data.ncategories < 256 || data.subsets.size() != nodes*subsetSize)
+                        SIMD_EX("Invalid subsets of binary cascade!");
+                    for (size_t i = 0; i < data.lbpFeatures.size(); ++i)
+                    {
+                        Data::Rect r = data.lbpFeatures[i].rect;
+                        r.width *= 3, r.height *= 3;
+                        if (!Inside(r, data.origWinSize))
+                            SIMD_EX("Invalid LBP feature of binary cascade!");
+                    }
+                }
+            }
+        }
+
+        int DetectionSaveBinary(const void * _data, const char * path)
+        {
+            const Data * data = (const Data*)_data;
+            if (data == NULL || path == NULL)
+                return 0;
+
+            FILE * file = NULL;
+            try
+            {
+                Binary::Header header;
+                memset(&header, 0, sizeof(header));
+                memcpy(header.magic, Binary::MAGIC, sizeof(header.magic));
+                header.version = Binary::VERSION;
+                header.endianness = Binary::ENDIANNESS;
+                header.featureType = data->featureType;
+                header.stageType = data->stageType;
+                header.ncategories = data->ncategories;
+                header.width = (int32_t)data->origWinSize.x;
+                header.height = (int32_t)data->origWinSize.y;
+                header.isStumpBased = data->isStumpBased ? 1 : 0;
+                header.hasTilted = data->hasTilted ? 1 : 0;
+                header.canInt16 = data->canInt16 ? 1 : 0;
+
+                uint64_t offset = AlignHi(sizeof(header), Binary::ALIGN);
+                Binary::SetSection(header, Binary::Stages, data->stages, offset);
+                Binary::SetSection(header, Binary::Classifiers, data->classifiers, offset);
+                Binary::SetSection(header, Binary::Nodes, data->nodes, offset);
+                Binary::SetSection(header, Binary::Leaves, data->leaves, offset);
+                Binary::SetSection(header, Binary::Subsets, data->subsets, offset);
+                Binary::SetSection(header, Binary::HaarFeatures, data->haarFeatures, offset);
+                Binary::SetSection(header, Binary::LbpFeatures, data->lbpFeatures, offset);
+                header.fileSize = offset;
+
+                file = fopen(path, "wb");
+                if (file == NULL)
+                    SIMD_EX("Can't open file '" << path << "' for writing!");
+                if (fwrite(&header, 1, sizeof(header), file) != sizeof(header))
+                    SIMD_EX("Can't write cascade header!");
+                Binary::WriteSection(file, header, Binary::Stages, data->stages);
+                Binary::WriteSection(file, header, Binary::Classifiers, data->classifiers);
+                Binary::WriteSection(file, header, Binary::Nodes, data->nodes);
+                Binary::WriteSection(file, header, Binary::Leaves, data->leaves);
+                Binary::WriteSection(file, header, Binary::Subsets, data->subsets);
+                Binary::WriteSection(file, header, Binary::HaarFeatures, data->haarFeatures);
+                Binary::WriteSection(file, header, Binary::LbpFeatures, data->lbpFeatures);
+                if (fclose(file))
+                {
+                    file = NULL;
+                    SIMD_EX("Can't close file '" << path << "'!");
+                }
+            }
+            catch (...)
+            {
+                if (file)
+                    fclose(file);
+                return 0;
+            }
+            return 1;
+        }
+
+        void * DetectionLoadBinary(const char * path)
+        {
+            Data * data = NULL;
+            try
+            {
+                size_t size = 0;
+                void * mapped = MapFile(path, &size);
+                if (mapped == NULL)
+                    SIMD_EX("Can't map file '" << path << "'!");
+
+                data = new Data();
+                data->mapped = mapped;
+                data->mappedSize = size;
+
+                const uint8_t * file = (const uint8_t*)mapped;
+                const Binary::Header & header = *(const Binary::Header*)file;
+                if (size < sizeof(header) || memcmp(header.magic, Binary::MAGIC, sizeof(header.magic)) != 0)
+                    SIMD_EX("File '" << path << "' is not a binary cascade!");
+                if (header.version != Binary::VERSION || header.endianness != Binary::ENDIANNESS || header.fileSize > size)
+                    SIMD_EX("Unsupported version or byte order of binary cascade '" << path << "'!");
+
+                data->featureType = (SimdDetectionInfoFlags)header.featureType;
+                data->stageType = header.stageType;
+                data->ncategories = header.ncategories;
+                data->origWinSize = Size(header.width, header.height);
+                data->isStumpBased = header.isStumpBased != 0;
+                data->hasTilted = header.hasTilted != 0;
+                data->canInt16 = header.canInt16 != 0;
+                if (data->featureType != SimdDetectionInfoFeatureHaar && data->featureType != SimdDetectionInfoFeatureLbp)
+                    SIMD_EX("Invalid cascade feature type!");
+                if (data->origWinSize.x <= 0 || data->origWinSize.y <= 0)
+                    SIMD_EX("Invalid cascade width or height!");
+
+                Binary::ReferSection(header, Binary::Stages, file, data->stages);
+                Binary::ReferSection(header, Binary::Classifiers, file, data->classifiers);
+                Binary::ReferSection(header, Binary::Nodes, file, data->nodes);
+                Binary::ReferSection(header, Binary::Leaves, file, data->leaves);
+                Binary::ReferSection(header, Binary::Subsets, file, data->subsets);
+                Binary::ReferSection(header, Binary::HaarFeatures, file, data->haarFeatures);
+                Binary::ReferSection(header, Binary::LbpFeatures, file, data->lbpFeatures);
+                Binary::Validate(*data);
+            }
+            catch (...)
+            {
+                delete data;
+                data = NULL;
+            }
+            return data;
+        }
+
         void DetectionInfo(const void * _data, size_t * width, size_t * height, SimdDetectionInfoFlags * flags)
         {
             Data * data = (Data*)_data;
@@ -339,7 +668,10 @@ namespace Simd
 
             HidHaarCascade * hid = new HidHaarCascade();
 
+            hid->isInt16 = false;
             hid->isThroughColumn = false;
+            hid->featureType = data.featureType;
+            hid->hasTilted = false;
             hid->isStumpBased = data.isStumpBased;
             hid->origWinSize = data.origWinSize;
 
@@ -421,6 +753,35 @@ namespace Simd
             hid->tilted = tilted;
         }
 
+        template<class T, class R> SIMD_INLINE void SetRectPtrs(const Image & sum, const Image & tilted, bool throughColumn, 
+            const Data::HaarFeature & df, const Data::Rect & dr, R & hr)
+        {
+            if (hr.weight != 0)
+            {
+                if (df.tilted)
+                {
+                    hr.p0 = SumElemPtr<T>(tilted, dr.y, dr.x, throughColumn);
+                    hr.p1 = SumElemPtr<T>(tilted, dr.y + dr.height, dr.x - dr.height, throughColumn);
+                    hr.p2 = SumElemPtr<T>(tilted, dr.y + dr.width, dr.x + dr.width, throughColumn);
+                    hr.p3 = SumElemPtr<T>(tilted, dr.y + dr.width + dr.height, dr.x + dr.width - dr.height, throughColumn);
+                }
+                else
+                {
+                    hr.p0 = SumElemPtr<T>(sum, dr.y, dr.x, throughColumn);
+                    hr.p1 = SumElemPtr<T>(sum, dr.y, dr.x + dr.width, throughColumn);
+                    hr.p2 = SumElemPtr<T>(sum, dr.y + dr.height, dr.x, throughColumn);
+                    hr.p3 = SumElemPtr<T>(sum, dr.y + dr.height, dr.x + dr.width, throughColumn);
+                }
+            }
+            else
+            {
+                hr.p0 = NULL;
+                hr.p1 = NULL;
+                hr.p2 = NULL;
+                hr.p3 = NULL;
+            }
+        }
+
         template<class T> SIMD_INLINE void UpdateFeaturePtrs(HidHaarCascade * hid, const Data & data)
         {
             Image sum = hid->isThroughColumn ? hid->isum : hid->sum;
@@ -430,38 +791,63 @@ namespace Simd
                 const Data::HaarFeature & df = data.haarFeatures[i];
                 HidHaarCascade::Feature & hf = hid->features[i];
                 for (int j = 0; j < Data::HaarFeature::RECT_NUM; ++j)
+                    SetRectPtrs<T>(sum, tilted, hid->isThroughColumn, df, df.rect[j].r, hf.rect[j]);
+            }
+        }
+
+        static void InitHaar16(HidHaarCascade * hid, const Data & data)
+        {
+            std::vector<int> shifts;
+            int normShift;
+            if (!HaarInt16(data, shifts, normShift))
+                return;
+
+            hid->isInt16 = true;
+            hid->normScale = 1.0f / float(1 << normShift);
+            for (size_t i = 0; i < hid->nodes.size(); ++i)
+            {
+                HidHaarCascade::Node & node = hid->nodes[i];
+                node.threshold16 = (int16_t)Simd::Round(node.threshold*double(1 << (16 + normShift - shifts[node.featureIdx])));
+            }
+
+            hid->leaves16.resize(hid->leaves.size());
+            for (size_t i = 0; i < hid->stages.size(); ++i)
+            {
+                HidHaarCascade::Stage & stage = hid->stages[i];
+                float min = 0, max = 0;
+                for (int j = stage.first, n = stage.first + stage.ntrees; j < n; ++j)
                 {
-                    const Data::Rect & dr = df.rect[j].r;
-                    WeightedRect & hr = hf.rect[j];
-                    if (hr.weight != 0.0)
-                    {
-                        if (df.tilted)
-                        {
-                            hr.p0 = SumElemPtr<T>(tilted, dr.y, dr.x, hid->isThroughColumn);
-                            hr.p1 = SumElemPtr<T>(tilted, dr.y + dr.height, dr.x - dr.height, hid->isThroughColumn);
-                            hr.p2 = SumElemPtr<T>(tilted, dr.y + dr.width, dr.x + dr.width, hid->isThroughColumn);
-                            hr.p3 = SumElemPtr<T>(tilted, dr.y + dr.width + dr.height, dr.x + dr.width - dr.height, hid->isThroughColumn);
-                        }
-                        else
-                        {
-                            hr.p0 = SumElemPtr<T>(sum, dr.y, dr.x, hid->isThroughColumn);
-                            hr.p1 = SumElemPtr<T>(sum, dr.y, dr.x + dr.width, hid->isThroughColumn);
-                            hr.p2 = SumElemPtr<T>(sum, dr.y + dr.height, dr.x, hid->isThroughColumn);
-                            hr.p3 = SumElemPtr<T>(sum, dr.y + dr.height, dr.x + dr.width, hid->isThroughColumn);
-                        }
-                    }
-                    else
-                    {
-                        hr.p0 = NULL;
-                        hr.p1 = NULL;
-                        hr.p2 = NULL;
-                        hr.p3 = NULL;
-                    }
+                    min += std::min(hid->leaves[2 * j + 0], hid->leaves[2 * j + 1]);
+                    max += std::max(hid->leaves[2 * j + 0], hid->leaves[2 * j + 1]);
+                }
+                float k = float(SHRT_MAX)*0.9f / std::max(std::abs(min), std::abs(max));
+                stage.threshold16 = (int16_t)Simd::RestrictRange(Simd::Round(stage.threshold*k), SHRT_MIN, SHRT_MAX);
+                for (int j = stage.first * 2, n = (stage.first + stage.ntrees) * 2; j < n; ++j)
+                    hid->leaves16[j] = (int16_t)Simd::Round(hid->leaves[j] * k);
+            }
+
+            hid->isum16[0].Recreate(hid->sum.Size(), Image::Int16);
+            for (size_t i = 0; i < shifts.size(); ++i)
+            {
+                Image & image = data.haarFeatures[i].tilted ? hid->itilted16[shifts[i]] : hid->isum16[shifts[i]];
+                if (image.format == Image::None)
+                    image.Recreate(hid->sum.Size(), Image::Int16);
+            }
+
+            hid->features16.resize(hid->features.size());
+            for (size_t i = 0; i < hid->features16.size(); i++)
+            {
+                const Data::HaarFeature & df = data.haarFeatures[i];
+                HidHaarCascade::Feature16 & hf = hid->features16[i];
+                for (int j = 0; j < Data::HaarFeature::RECT_NUM; ++j)
+                {
+                    hf.rect[j].weight = (int16_t)df.rect[j].weight;
+                    SetRectPtrs<uint16_t>(hid->isum16[shifts[i]], hid->itilted16[shifts[i]], hid->isThroughColumn, df, df.rect[j].r, hf.rect[j]);
                 }
             }
         }
 
-        HidHaarCascade * InitHaar(const Data & data, const Image & sum, const Image & sqsum, const Image & tilted, bool throughColumn)
+        HidHaarCascade * InitHaar(const Data & data, const Image & sum, const Image & sqsum, const Image & tilted, bool throughColumn, bool int16)
         {
             if (!data.isStumpBased)
                 SIMD_EX("Can't use tree classfier for vector haar classifier!");
@@ -476,6 +862,8 @@ namespace Simd
                     hid->itilted.Recreate(tilted.width, tilted.height, Image::Int32, NULL, Image::PixelSize(Image::Int32));
             }
             UpdateFeaturePtrs<uint32_t>(hid, data);
+            if (int16 && data.canInt16)
+                InitHaar16(hid, data);
             return hid;
         }
 
@@ -623,7 +1011,8 @@ namespace Simd
                     Image(width, height, sumStride, Image::Int32, sum),
                     Image(width, height, sqsumStride, Image::Int32, sqsum),
                     Image(width, height, tiltedStride, Image::Int32, tilted),
-                    throughColumn != 0);
+                    throughColumn != 0,
+                    int16 != 0);
             case SimdDetectionInfoFeatureLbp:
                 return InitLbp(data,
                     Image(width, height, sumStride, Image::Int32, sum),
@@ -652,7 +1041,7 @@ namespace Simd
             }
         }
 
-        void Prepare16i(const Image & src, bool throughColumn, Image & dst)
+        void Prepare16i(const Image & src, bool throughColumn, Image & dst, int shift = 0)
         {
             assert(Simd::EqualSize(src, dst) && src.format == Image::Int32 && dst.format == Image::Int16);
 
@@ -664,11 +1053,11 @@ namespace Simd
 
                     uint16_t * evenDst = &dst.At<uint16_t>(0, row);
                     for (size_t col = 0; col < src.width; col += 2)
-                        evenDst[col >> 1] = (uint16_t)s[col];
+                        evenDst[col >> 1] = (uint16_t)(s[col] >> shift);
 
                     uint16_t * oddDst = &dst.At<uint16_t>((dst.width + 1) >> 1, row);
                     for (size_t col = 1; col < src.width; col += 2)
-                        oddDst[col >> 1] = (uint16_t)s[col];
+                        oddDst[col >> 1] = (uint16_t)(s[col] >> shift);
                 }
             }
             else
@@ -678,7 +1067,7 @@ namespace Simd
                     const uint32_t * s = &src.At<uint32_t>(0, row);
                     uint16_t * d = &dst.At<uint16_t>(0, row);
                     for (size_t col = 0; col < src.width; ++col)
-                        d[col] = (uint16_t)s[col];
+                        d[col] = (uint16_t)(s[col] >> shift);
                 }
             }
         }
@@ -686,12 +1075,25 @@ namespace Simd
         void DetectionPrepare(void * _hid)
         {
             HidBase * hidBase = (HidBase*)_hid;
-            if (hidBase->featureType == SimdDetectionInfoFeatureHaar && hidBase->isThroughColumn)
+            if (hidBase->featureType == SimdDetectionInfoFeatureHaar)
             {
                 HidHaarCascade * hid = (HidHaarCascade*)hidBase;
-                PrepareThroughColumn32i(hid->sum, hid->isum);
-                if (hid->hasTilted)
-                    PrepareThroughColumn32i(hid->tilted, hid->itilted);
+                if (hid->isThroughColumn)
+                {
+                    PrepareThroughColumn32i(hid->sum, hid->isum);
+                    if (hid->hasTilted)
+                        PrepareThroughColumn32i(hid->tilted, hid->itilted);
+                }
+                if (hid->isInt16)
+                {
+                    for (int shift = 0; shift <= HidHaarCascade::INT16_SHIFT_MAX; ++shift)
+                    {
+                        if (hid->isum16[shift].format != Image::None)
+                            Prepare16i(hid->sum, hid->isThroughColumn, hid->isum16[shift], shift);
+                        if (hid->itilted16[shift].format != Image::None)
+                            Prepare16i(hid->tilted, hid->isThroughColumn, hid->itilted16[shift], shift);
+                    }
+                }
             }
             else if (hidBase->featureType == SimdDetectionInfoFeatureLbp)
             {
@@ -801,6 +1203,87 @@ namespace Simd
                 Image(hid.sum.width - 1, hid.sum.height - 1, dstStride, Image::Gray8, dst).Ref());
         }
 
+        int Detect16i(const HidHaarCascade & hid, size_t offset, int startStage, int norm)
+        {
+            typedef HidHaarCascade Hid;
+            const Hid::Stage * stages = hid.stages.data();
+            const Hid::Node * node = hid.nodes.data() + stages[startStage].first;
+            const int16_t * leaves = hid.leaves16.data() + stages[startStage].first * 2;
+            for (int i = startStage, n = (int)hid.stages.size(); i < n; ++i)
+            {
+                const Hid::Stage & stage = stages[i];
+                if (stage.canSkip)
+                    continue;
+                const Hid::Node * end = node + stage.ntrees;
+                int stageSum = 0;
+                for (; node < end; ++node, leaves += 2)
+                {
+                    const Hid::Feature16 & feature = hid.features16[node->featureIdx];
+                    int sum = WeightedSum16i(feature.rect[0], offset) + WeightedSum16i(feature.rect[1], offset);
+                    if (feature.rect[2].p0)
+                        sum += WeightedSum16i(feature.rect[2], offset);
+                    stageSum += leaves[int16_t(sum) > ((node->threshold16*norm) >> 16)];
+                }
+                if (stageSum < stage.threshold16)
+                    return -i;
+            }
+            return 1;
+        }
+
+        void DetectionHaarDetect16ip(const HidHaarCascade & hid, const Image & mask, const Rect & rect, Image & dst)
+        {
+            for (ptrdiff_t row = rect.top; row < rect.bottom; row += 1)
+            {
+                size_t p_offset = row * hid.isum16[0].stride / sizeof(uint16_t);
+                size_t pq_offset = row * hid.sqsum.stride / sizeof(uint32_t);
+                for (ptrdiff_t col = rect.left; col < rect.right; col += 1)
+                {
+                    if (mask.At<uint8_t>(col, row) == 0)
+                        continue;
+                    int norm = Norm16i(hid, pq_offset + col);
+                    if (Detect16i(hid, p_offset + col, 0, norm) > 0)
+                        dst.At<uint8_t>(col, row) = 1;
+                }
+            }
+        }
+
+        void DetectionHaarDetect16ip(const void * _hid, const uint8_t * mask, size_t maskStride,
+            ptrdiff_t left, ptrdiff_t top, ptrdiff_t right, ptrdiff_t bottom, uint8_t * dst, size_t dstStride)
+        {
+            const HidHaarCascade & hid = *(HidHaarCascade*)_hid;
+            return DetectionHaarDetect16ip(hid,
+                Image(hid.sum.width - 1, hid.sum.height - 1, maskStride, Image::Gray8, (uint8_t*)mask),
+                Rect(left, top, right, bottom),
+                Image(hid.sum.width - 1, hid.sum.height - 1, dstStride, Image::Gray8, dst).Ref());
+        }
+
+        void DetectionHaarDetect16ii(const HidHaarCascade & hid, const Image & mask, const Rect & rect, Image & dst)
+        {
+            for (ptrdiff_t row = rect.top; row < rect.bottom; row += 2)
+            {
+                size_t p_offset = row * hid.isum16[0].stride / sizeof(uint16_t);
+                size_t pq_offset = row * hid.sqsum.stride / sizeof(uint32_t);
+                for (ptrdiff_t col = rect.left; col < rect.right; col += 2)
+                {
+                    if (mask.At<uint8_t>(col, row) == 0)
+                        continue;
+                    int norm = Norm16i(hid, pq_offset + col);
+                    if (Detect16i(hid, p_offset + col / 2, 0, norm) > 0)
+                        dst.At<uint8_t>(col, row) = 1;
+                }
+            }
+        }
+
+        void DetectionHaarDetect16ii(const void * _hid, const uint8_t * mask, size_t maskStride,
+            ptrdiff_t left, ptrdiff_t top, ptrdiff_t right, ptrdiff_t bottom, uint8_t * dst, size_t dstStride)
+        {
+            const HidHaarCascade & hid = *(HidHaarCascade*)_hid;
+            return DetectionHaarDetect16ii(hid,
+                Image(hid.sum.width - 1, hid.sum.height - 1, maskStride, Image::Gray8, (uint8_t*)mask),
+                Rect(left, top, right, bottom),
+                Image(hid.sum.width - 1, hid.sum.height - 1, dstStride, Image::Gray8, dst).Ref());
+        }
+
         void DetectionLbpDetect32fp(const HidLbpCascade<float, int> & hid, const Image & mask, const Rect & rect, Image & dst)
         {
             for (ptrdiff_t row = rect.top; row < rect.bottom; row += 1)
@@ -901,9 +1384,71 @@ namespace Simd
                 Image(hid.sum.width - 1, hid.sum.height - 1, dstStride, Image::Gray8, dst).Ref());
         }
 
+        template<class Hid> SIMD_INLINE int PassedStages(const Hid & hid, int result)
+        {
+            return result > 0 ? (int)hid.stages.size() : -result;
+        }
+
+        static int PassedStages(const HidBase & base, ptrdiff_t row, ptrdiff_t col)
+        {
+            if (base.featureType == SimdDetectionInfoFeatureHaar)
+            {
+                const HidHaarCascade & hid = (const HidHaarCascade &)base;
+                size_t offset = base.isThroughColumn ? row * hid.isum.stride / sizeof(uint32_t) + col / 2 : row * hid.sum.stride / sizeof(uint32_t) + col;
+                float norm = Norm32f(hid, row * hid.sqsum.stride / sizeof(uint32_t) + col);
+                return PassedStages(hid, Detect32f(hid, offset, 0, norm));
+            }
+            else if (base.isInt16)
+            {
+                const HidLbpCascade<int, short> & hid = (const HidLbpCascade<int, short> &)base;
+                size_t offset = row * hid.isum.stride / sizeof(short) + (base.isThroughColumn ? col / 2 : col);
+                return PassedStages(hid, Detect(hid, offset, 0));
+            }
+            else
+            {
+                const HidLbpCascade<float, int> & hid = (const HidLbpCascade<float, int> &)base;
+                size_t offset = base.isThroughColumn ? row * hid.isum.stride / sizeof(int) + col / 2 : row * hid.sum.stride / sizeof(int) + col;
+                return PassedStages(hid, Detect(hid, offset, 0));
+            }
+        }
+
+        size_t DetectionStageNumber(const void * _hid)
+        {
+            const HidBase & base = *(HidBase*)_hid;
+            if (base.featureType == SimdDetectionInfoFeatureHaar)
+                return ((const HidHaarCascade &)base).stages.size();
+            else if (base.isInt16)
+                return ((const HidLbpCascade<int, short> &)base).stages.size();
+            else
+                return ((const HidLbpCascade<float, int> &)base).stages.size();
+        }
+
+        void DetectionCountStages(const void * _hid, const uint8_t * mask, size_t maskStride,
+            ptrdiff_t left, ptrdiff_t top, ptrdiff_t right, ptrdiff_t bottom, size_t * counts)
+        {
+            const HidBase & hid = *(HidBase*)_hid;
+            ptrdiff_t step = hid.isThroughColumn ? 2 : 1;
+            for (ptrdiff_t row = top; row < bottom; row += step)
+            {
+                for (ptrdiff_t col = left; col < right; col += step)
+                {
+                    if (mask[row*maskStride + col] == 0)
+                        continue;
+                    for (int i = 0, n = PassedStages(hid, row, col); i <= n; ++i)
+                        counts[i]++;
+                }
+            }
+        }
+
         void DetectionFree(void * ptr)
         {
             delete (Deletable*)ptr;
         }
     }
+
+    Detection::Data::~Data()
+    {
+        if (mapped)
+            Base::UnmapFile(mapped, mappedSize);
+    }
 }
@@ -0,0 +1,91 @@
+/*
+* Simd Library (http://simd.sourceforge.net).
+*
+* Copyright (c) 2011-2017 Yermalayeu Ihar.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy 
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell 
+* copies of the Software, and to permit persons to whom the Software is 
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in 
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE 
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+#include "Simd/SimdBase.h"
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace Simd
+{
+    namespace Base
+    {
+        void * MapFile(const char * path, size_t * size)
+        {
+            void * data = NULL;
+            if (path == NULL || size == NULL)
+                return NULL;
+#ifdef _WIN32
+            HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+            if (file == INVALID_HANDLE_VALUE)
+                return NULL;
+            LARGE_INTEGER fileSize;
+            if (GetFileSizeEx(file, &fileSize) && fileSize.QuadPart > 0)
+            {
+                HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+                if (mapping)
+                {
+                    data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+                    *size = (size_t)fileSize.QuadPart;
+                    CloseHandle(mapping);
+                }
+            }
+            CloseHandle(file);
+#else
+            int file = open(path, O_RDONLY);
+            if (file < 0)
+                return NULL;
+            struct stat info;
+            if (fstat(file, &info) == 0 && info.st_size > 0)
+            {
+                data = mmap(NULL, (size_t)info.st_size, PROT_READ, MAP_SHARED, file, 0);
+                if (data == MAP_FAILED)
+                    data = NULL;
+                *size = (size_t)info.st_size;
+            }
+            close(file);
+#endif
+            return data;
+        }
+
+        void UnmapFile(void * data, size_t size)
+        {
+            if (data == NULL)
+                return;
+#ifdef _WIN32
+            UnmapViewOfFile(data);
+#else
+            munmap(data, size);
+#endif
+        }
+    }
+}
@@ -0,0 +1,268 @@
+/*
+* Simd Library (http://simd.sourceforge.net).
+*
+* Copyright (c) 2011-2017 Yermalayeu Ihar.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy 
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell 
+* copies of the Software, and to permit persons to whom the Software is 
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in 
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE 
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+#include "Simd/SimdFilter2D.h"
+
+namespace Simd
+{
+    namespace Base
+    {
+        SIMD_INLINE int Filter2DShift(float max, float sum, float range)
+        {
+            int shift = 0;
+            while (shift < 24 && max*float(2 << shift) <= 32767.0f && sum*range*float(2 << shift) <= float(1 << 30))
+                shift++;
+            return shift;
+        }
+
+        SIMD_INLINE void Filter2DQuantize(const float * src, size_t size, int shift, int16_t * dst)
+        {
+            for (size_t i = 0; i < size; ++i)
+                dst[i] = (int16_t)RestrictRange(Round(src[i] * float(1 << shift)), -32768, 32767);
+        }
+
+        SIMD_INLINE int Filter2DPower2(const int16_t * weights, size_t size)
+        {
+            int power = 0;
+            for (bool divisible = true; divisible && power < 15; power += divisible ? 1 : 0)
+            {
+                for (size_t i = 0; i < size && divisible; ++i)
+                    divisible = weights[i] % (2 << power) == 0;
+            }
+            return power;
+        }
+
+        SIMD_INLINE int Filter2DAbsSum(const int16_t * weights, size_t size)
+        {
+            int sum = 0;
+            for (size_t i = 0; i < size; ++i)
+                sum += Simd::Abs(weights[i]);
+            return sum;
+        }
+
+        Filter2DKernel::Filter2DKernel(const float * kernel, size_t size_)
+            : size(size_)
+            , half(size_ / 2)
+            , pairs(AlignHi(size_, 2))
+            , separable(false)
+            , small(false)
+            , shift(0)
+            , shiftH(0)
+        {
+            assert(size % 2 == 1);
+
+            _p = Allocate((size*size + 2 * size)*sizeof(float) + (size + 2)*pairs*sizeof(int16_t));
+            full = (float*)_p;
+            row = full + size*size;
+            col = row + size;
+            full16 = (int16_t*)(col + size);
+            row16 = full16 + size*pairs;
+            col16 = row16 + pairs;
+            memset(full16, 0, (size + 2)*pairs*sizeof(int16_t));
+
+            float max = 0, sum = 0;
+            size_t pivot = 0;
+            for (size_t i = 0; i < size*size; ++i)
+            {
+                full[i] = kernel[i];
+                sum += Simd::Abs(kernel[i]);
+                if (Simd::Abs(kernel[i]) > max)
+                {
+                    max = Simd::Abs(kernel[i]);
+                    pivot = i;
+                }
+            }
+
+            if (size > 1 && max > 0)
+            {
+                size_t py = pivot / size, px = pivot%size;
+                for (size_t i = 0; i < size; ++i)
+                {
+                    col[i] = kernel[i*size + px];
+                    row[i] = kernel[py*size + i] / kernel[pivot];
+                }
+                separable = true;
+                for (size_t i = 0; i < size*size && separable; ++i)
+                    separable = Simd::Abs(kernel[i] - col[i / size] * row[i%size]) <= max*0.00001f;
+            }
+
+            if (separable)
+            {
+                float maxRow = 0, sumRow = 0, maxCol = 0, sumCol = 0;
+                for (size_t i = 0; i < size; ++i)
+                {
+                    maxRow = Simd::Max(maxRow, Simd::Abs(row[i]));
+                    sumRow += Simd::Abs(row[i]);
+                    maxCol = Simd::Max(maxCol, Simd::Abs(col[i]));
+                    sumCol += Simd::Abs(col[i]);
+                }
+                int shiftRow = Filter2DShift(maxRow, sumRow, 255.0f);
+                while ((255.0f*sumRow*float(1 << shiftRow)) / float(1 << shiftH) > 32767.0f)
+                    shiftH++;
+                shift = shiftRow - shiftH + Filter2DShift(maxCol, sumCol, 32767.0f);
+                if (shift >= 0)
+                {
+                    Filter2DQuantize(row, size, shiftRow, row16);
+                    Filter2DQuantize(col, size, shift + shiftH - shiftRow, col16);
+                }
+                else
+                    separable = false, shiftH = 0;
+            }
+
+            if (separable)
+            {
+                // row16 = row*2^powerRow and col16 = col*2^powerCol, so the vertical pass gives Descale(sum(col*sum(row*src)), shift + shiftH - powerRow - powerCol).
+                int powerRow = Filter2DPower2(row16, size), powerCol = Filter2DPower2(col16, size), shiftSmall = shift + shiftH - powerRow - powerCol;
+                if (powerRow >= shiftH && shiftSmall >= 0)
+                {
+                    int sumRow = Filter2DAbsSum(row16, size) >> powerRow, sumCol = Filter2DAbsSum(col16, size) >> powerCol, maxRow = 0;
+                    for (size_t i = 0; i < size; ++i)
+                        maxRow = Simd::Max(maxRow, Simd::Abs(row16[i] >> powerRow));
+                    if (maxRow <= 127 && 255 * sumRow * sumCol + (shiftSmall ? 1 << (shiftSmall - 1) : 0) <= 32767)
+                    {
+                        for (size_t i = 0; i < size; ++i)
+                        {
+                            row16[i] >>= powerRow;
+                            col16[i] >>= powerCol;
+                        }
+                        small = true, shift = shiftSmall, shiftH = 0;
+                    }
+                }
+            }
+
+            if (!separable)
+            {
+                shift = Filter2DShift(max, sum, 255.0f);
+                for (size_t i = 0; i < size; ++i)
+                    Filter2DQuantize(full + i*size, size, shift, full16 + i*pairs);
+            }
+        }
+
+        SIMD_INLINE int Filter2DDescale(int sum, int shift)
+        {
+            return (sum + (shift ? 1 << (shift - 1) : 0)) >> shift;
+        }
+
+        struct Filter2DRows
+        {
+            static void Direct8u(const uint8_t * const * rows, const int16_t * weights, size_t size, size_t width, int shift, uint8_t * dst)
+            {
+                size_t pairs = AlignHi(size, 2);
+                for (size_t x = 0; x < width; ++x)
+                {
+                    int sum = 0;
+                    for (size_t ky = 0; ky < size; ++ky)
+                    {
+                        const uint8_t * r = rows[ky] + x;
+                        const int16_t * w = weights + ky*pairs;
+                        for (size_t kx = 0; kx < size; ++kx)
+                            sum += r[kx] * w[kx];
+                    }
+                    dst[x] = RestrictRange(Filter2DDescale(sum, shift));
+                }
+            }
+
+            static void Hor8u(const uint8_t * src, const int16_t * weights, size_t size, size_t width, int shift, int16_t * dst)
+            {
+                for (size_t x = 0; x < width; ++x)
+                {
+                    int sum = 0;
+                    for (size_t kx = 0; kx < size; ++kx)
+                        sum += src[x + kx] * weights[kx];
+                    dst[x] = RestrictRange(Filter2DDescale(sum, shift), SHRT_MIN, SHRT_MAX);
+                }
+            }
+
+            static void Ver8u(const int16_t * const * rows, const int16_t * weights, size_t size, size_t width, int shift, uint8_t * dst)
+            {
+                for (size_t x = 0; x < width; ++x)
+                {
+                    int sum = 0;
+                    for (size_t ky = 0; ky < size; ++ky)
+                        sum += rows[ky][x] * weights[ky];
+                    dst[x] = RestrictRange(Filter2DDescale(sum, shift));
+                }
+            }
+
+            static void Hor8uSmall(const uint8_t * src, const int16_t * weights, size_t size, size_t width, int16_t * dst)
+            {
+                Hor8u(src, weights, size, width, 0, dst);
+            }
+
+            static void Ver8uSmall(const int16_t * const * rows, const int16_t * weights, size_t size, size_t width, int shift, uint8_t * dst)
+            {
+                Ver8u(rows, weights, size, width, shift, dst);
+            }
+
+            static void Direct32f(const float * const * rows, const float * weights, size_t size, size_t width, float * dst)
+            {
+                for (size_t x = 0; x < width; ++x)
+                {
+                    float sum = 0;
+                    for (size_t ky = 0; ky < size; ++ky)
+                    {
+                        const float * r = rows[ky] + x;
+                        const float * w = weights + ky*size;
+                        for (size_t kx = 0; kx < size; ++kx)
+                            sum += r[kx] * w[kx];
+                    }
+                    dst[x] = sum;
+                }
+            }
+
+            static void Hor32f(const float * src, const float * weights, size_t size, size_t width, float * dst)
+            {
+                for (size_t x = 0; x < width; ++x)
+                {
+                    float sum = 0;
+                    for (size_t kx = 0; kx < size; ++kx)
+                        sum += src[x + kx] * weights[kx];
+                    dst[x] = sum;
+                }
+            }
+
+            static void Ver32f(const float * const * rows, const float * weights, size_t size, size_t width, float * dst)
+            {
+                for (size_t x = 0; x < width; ++x)
+                {
+                    float sum = 0;
+                    for (size_t ky = 0; ky < size; ++ky)
+                        sum += rows[ky][x] * weights[ky];
+                    dst[x] = sum;
+                }
+            }
+
+            static void Convert32fTo16i(const float * src, size_t width, int16_t * dst)
+            {
+                for (size_t x = 0; x < width; ++x)
+                    dst[x] = (int16_t)Round(Simd::RestrictRange(src[x], -32768.0f, 32767.0f));
+            }
+        };
+
+        void Filter2D(const uint8_t * src, size_t srcStride, size_t width, size_t height, SimdPixelFormatType format,
+            const float * kernel, size_t size, SimdBorderType border, uint8_t * dst, size_t dstStride)
+        {
+            Filter2DRun<Filter2DRows>(src, srcStride, width, height, format, kernel, size, border, dst, dstStride);
+        }
+    }
+}
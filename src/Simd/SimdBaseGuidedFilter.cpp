@@ -0,0 +1,114 @@
+/*
+* Simd Library (http://simd.sourceforge.net).
+*
+* Copyright (c) 2011-2017 Yermalayeu Ihar.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy 
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell 
+* copies of the Software, and to permit persons to whom the Software is 
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in 
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE 
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+#include "Simd/SimdIntegral.h"
+#include "Simd/SimdBase.h"
+
+#include <vector>
+
+namespace Simd
+{
+    namespace Base
+    {
+        /*
+        * Bounds of the window (2*radius + 1) clipped by the image border for every position along the row (or column).
+        * Mean value in the window is a difference of integral image values multiplied by inverted area of the window.
+        */
+        struct GuidedFilterBounds
+        {
+            std::vector<size_t> lo, hi;
+            std::vector<double> norm;
+
+            GuidedFilterBounds(size_t size, size_t radius, size_t step)
+                : lo(size), hi(size), norm(size)
+            {
+                for (size_t i = 0; i < size; ++i)
+                {
+                    size_t l = i > radius ? i - radius : 0, h = Simd::Min(i + radius + 1, size);
+                    lo[i] = l*step, hi[i] = h*step, norm[i] = 1.0 / double(h - l);
+                }
+            }
+        };
+
+        template <class T> SIMD_INLINE void GuidedFilterMean(const T * top, const T * bottom, const GuidedFilterBounds & cols, double norm, size_t width, float * dst)
+        {
+            for (size_t x = 0; x < width; ++x)
+            {
+                size_t l = cols.lo[x], h = cols.hi[x];
+                dst[x] = float(double(bottom[h] - bottom[l] - top[h] + top[l])*(norm*cols.norm[x]));
+            }
+        }
+
+        /*
+        * Mean values in the windows are taken from integral images: Base::Integral gives sums of src and src^2,
+        * Base::IntegralSum gives sums of coefficients a and b.
+        */
+        void GuidedFilter(const uint8_t * src, size_t srcStride, size_t width, size_t height, size_t channelCount,
+            size_t radius, float eps, uint8_t * dst, size_t dstStride)
+        {
+            size_t stride = width + 1;
+            GuidedFilterBounds cols(width, radius, 1), rows(height, radius, stride);
+            std::vector<uint8_t> plane(channelCount > 1 ? width*height : 0);
+            std::vector<uint32_t> sum(stride*(height + 1));
+            std::vector<double> square(stride*(height + 1)), sumA(stride*(height + 1)), sumB(stride*(height + 1));
+            std::vector<float> a(width*height), b(width*height), mean(width), meanSquare(width);
+            for (size_t c = 0; c < channelCount; ++c)
+            {
+                const uint8_t * s = src;
+                size_t sStride = srcStride;
+                if (channelCount > 1)
+                {
+                    for (size_t y = 0; y < height; ++y)
+                        for (size_t x = 0; x < width; ++x)
+                            plane[y*width + x] = src[y*srcStride + x*channelCount + c];
+                    s = plane.data(), sStride = width;
+                }
+                Integral(s, sStride, width, height, (uint8_t*)sum.data(), stride*sizeof(uint32_t), (uint8_t*)square.data(), stride*sizeof(double),
+                    NULL, 0, SimdPixelFormatInt32, SimdPixelFormatDouble);
+                for (size_t y = 0; y < height; ++y)
+                {
+                    GuidedFilterMean(sum.data() + rows.lo[y], sum.data() + rows.hi[y], cols, rows.norm[y], width, mean.data());
+                    GuidedFilterMean(square.data() + rows.lo[y], square.data() + rows.hi[y], cols, rows.norm[y], width, meanSquare.data());
+                    float * pa = a.data() + y*width, * pb = b.data() + y*width;
+                    for (size_t x = 0; x < width; ++x)
+                    {
+                        float variance = Simd::Max(meanSquare[x] - mean[x] * mean[x], 0.0f);
+                        pa[x] = variance / (variance + eps);
+                        pb[x] = mean[x] * (1.0f - pa[x]);
+                    }
+                }
+                IntegralSum(a.data(), width, width, height, sumA.data(), stride);
+                IntegralSum(b.data(), width, width, height, sumB.data(), stride);
+                for (size_t y = 0; y < height; ++y)
+                {
+                    GuidedFilterMean(sumA.data() + rows.lo[y], sumA.data() + rows.hi[y], cols, rows.norm[y], width, mean.data());
+                    GuidedFilterMean(sumB.data() + rows.lo[y], sumB.data() + rows.hi[y], cols, rows.norm[y], width, meanSquare.data());
+                    const uint8_t * ps = s + y*sStride;
+                    uint8_t * pd = dst + y*dstStride + c;
+                    for (size_t x = 0; x < width; ++x)
+                        pd[x*channelCount] = RestrictRange(Round(mean[x] * ps[x] + meanSquare[x]));
+                }
+            }
+        }
+    }
+}
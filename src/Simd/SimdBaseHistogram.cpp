@@ -23,6 +23,7 @@
 */
 #include "Simd/SimdMemory.h"
 #include "Simd/SimdCompare.h"
+#include "Simd/SimdClahe.h"
 
 namespace Simd
 {
@@ -198,5 +199,102 @@ namespace Simd
                 dst += dstStride;
             }
         }
+
+        ClaheAxis::ClaheAxis(size_t size, size_t tiles)
+            : lo(size)
+            , hi(size)
+            , weight(size)
+        {
+            std::vector<ptrdiff_t> centers(tiles);
+            for (size_t i = 0; i < tiles; ++i)
+                centers[i] = ClaheTileBorder(i, size, tiles) + ClaheTileBorder(i + 1, size, tiles);
+            for (size_t i = 0, tile = 0; i < size; ++i)
+            {
+                ptrdiff_t center = 2 * i + 1;
+                while (tile + 1 < tiles && centers[tile + 1] <= center)
+                    tile++;
+                if (center < centers[tile] || tile + 1 == tiles)
+                {
+                    lo[i] = hi[i] = (int)tile;
+                    weight[i] = 0;
+                }
+                else
+                {
+                    ptrdiff_t range = centers[tile + 1] - centers[tile];
+                    lo[i] = (int)tile;
+                    hi[i] = (int)tile + 1;
+                    weight[i] = int(((center - centers[tile]) * 256 + range / 2) / range);
+                }
+            }
+        }
+
+        void ClaheLuts(const uint8_t * src, size_t srcStride, size_t width, size_t height, size_t tilesX, size_t tilesY, 
+            float clipLimit, size_t tileRowBegin, size_t tileRowEnd, uint8_t * luts)
+        {
+            assert(tilesX > 0 && tilesY > 0 && width >= tilesX && height >= tilesY && tileRowEnd <= tilesY);
+
+            uint32_t histogram[HISTOGRAM_SIZE];
+            for (size_t ty = tileRowBegin; ty < tileRowEnd; ++ty)
+            {
+                size_t top = ClaheTileBorder(ty, height, tilesY), bottom = ClaheTileBorder(ty + 1, height, tilesY);
+                for (size_t tx = 0; tx < tilesX; ++tx)
+                {
+                    size_t left = ClaheTileBorder(tx, width, tilesX), right = ClaheTileBorder(tx + 1, width, tilesX);
+                    size_t area = (right - left)*(bottom - top);
+                    Histogram(src + top*srcStride + left, right - left, bottom - top, srcStride, histogram);
+
+                    if (clipLimit > 0)
+                    {
+                        uint32_t clip = Simd::Max<uint32_t>(uint32_t(clipLimit*area / HISTOGRAM_SIZE), 1), excess = 0;
+                        for (size_t i = 0; i < HISTOGRAM_SIZE; ++i)
+                        {
+                            if (histogram[i] > clip)
+                            {
+                                excess += histogram[i] - clip;
+                                histogram[i] = clip;
+                            }
+                        }
+                        uint32_t add = excess / HISTOGRAM_SIZE, rest = excess % HISTOGRAM_SIZE;
+                        for (size_t i = 0; i < HISTOGRAM_SIZE; ++i)
+                            histogram[i] += add;
+                        if (rest)
+                        {
+                            size_t step = Simd::Max<size_t>(HISTOGRAM_SIZE / rest, 1);
+                            for (size_t i = 0; i < HISTOGRAM_SIZE && rest > 0; i += step, rest--)
+                                histogram[i]++;
+                        }
+                    }
+
+                    uint8_t * lut = luts + (ty*tilesX + tx)*HISTOGRAM_SIZE;
+                    uint64_t sum = 0;
+                    for (size_t i = 0; i < HISTOGRAM_SIZE; ++i)
+                    {
+                        sum += histogram[i];
+                        lut[i] = (uint8_t)((sum * 255 + area / 2) / area);
+                    }
+                }
+            }
+        }
+
+        void ClaheApply(const uint8_t * src, size_t srcStride, size_t width, size_t height, size_t tilesX, size_t tilesY, 
+            const uint8_t * luts, size_t rowBegin, size_t rowEnd, uint8_t * dst, size_t dstStride)
+        {
+            assert(tilesX > 0 && tilesY > 0 && width >= tilesX && height >= tilesY && rowEnd <= height);
+
+            ClaheAxis axisX(width, tilesX), axisY(height, tilesY);
+            for (size_t row = rowBegin; row < rowEnd; ++row)
+            {
+                const uint8_t * top = luts + axisY.lo[row] * tilesX*HISTOGRAM_SIZE;
+                const uint8_t * bottom = luts + axisY.hi[row] * tilesX*HISTOGRAM_SIZE;
+                const uint8_t * s = src + row*srcStride;
+                uint8_t * d = dst + row*dstStride;
+                int wy = axisY.weight[row];
+                for (size_t col = 0; col < width; ++col)
+                {
+                    size_t lo = axisX.lo[col] * HISTOGRAM_SIZE + s[col], hi = axisX.hi[col] * HISTOGRAM_SIZE + s[col];
+                    d[col] = (uint8_t)ClaheInterpolate(top[lo], top[hi], bottom[lo], bottom[hi], axisX.weight[col], wy);
+                }
+            }
+        }
 	}
 }
@@ -21,31 +21,14 @@
 * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 * SOFTWARE.
 */
-#include "Simd/SimdMemory.h"
+#include "Simd/SimdIntegral.h"
+
+#include <vector>
 
 namespace Simd
 {
 	namespace Base
 	{
-        template <class TSum> void IntegralSum(const uint8_t * src, size_t srcStride, size_t width, size_t height, TSum * sum, size_t sumStride)
-        {
-            memset(sum, 0, (width + 1)*sizeof(TSum));
-            sum += sumStride + 1;
-
-            for(size_t row = 0; row < height; row++)
-            {
-                TSum rowSum = 0;
-                sum[-1] = 0;
-                for(size_t col = 0; col < width; col++)
-                {
-                    rowSum += src[col];
-                    sum[col] = rowSum + sum[col - sumStride];
-                }
-                src += srcStride;
-                sum += sumStride;
-            }
-        }
-
         template <class TSum, class TSqsum> void IntegralSumSqsum(const uint8_t * src, size_t srcStride, size_t width, size_t height,  
             TSum * sum, size_t sumStride, TSqsum * sqsum, size_t sqsumStride)
         {
@@ -305,5 +288,107 @@ namespace Simd
                 }
             }
         }
+
+        /*
+        * Changed pixel (x, y) affects sum[Y][X] and sqsum[Y][X] for X > x and Y > y, and tilted[Y][X] for Y > y and |X - 1 - x| < Y - y.
+        * Tilted integral is updated with recurrence: tilted[Y][X] = tilted[Y - 1][X - 1] + tilted[Y - 1][X + 1] - tilted[Y - 2][X] + src[Y - 1][X - 1] + src[Y - 2][X - 1].
+        */
+        template <class TSum, class TSqsum> void IntegralUpdate(const uint8_t * src, ptrdiff_t srcStride, size_t width, size_t height, const ptrdiff_t * rects, size_t rectNumber,
+            TSum * sum, ptrdiff_t sumStride, TSqsum * sqsum, ptrdiff_t sqsumStride, TSum * tilted, ptrdiff_t tiltedStride)
+        {
+            std::vector<ptrdiff_t> clipped;
+            ptrdiff_t top = height;
+            for (size_t i = 0; i < rectNumber; ++i, rects += 4)
+            {
+                ptrdiff_t l = std::max<ptrdiff_t>(rects[0], 0), t = std::max<ptrdiff_t>(rects[1], 0);
+                ptrdiff_t r = std::min<ptrdiff_t>(rects[2], width), b = std::min<ptrdiff_t>(rects[3], height);
+                if (l >= r || t >= b)
+                    continue;
+                clipped.push_back(l);
+                clipped.push_back(t);
+                clipped.push_back(r);
+                top = std::min(top, t);
+            }
+
+            for (ptrdiff_t row = top + 1; row <= (ptrdiff_t)height; ++row)
+            {
+                ptrdiff_t sumBegin = width + 1, tiltedBegin = width + 1, tiltedEnd = -1;
+                for (size_t i = 0; i < clipped.size(); i += 3)
+                {
+                    ptrdiff_t distance = row - 1 - clipped[i + 1];
+                    if (distance < 0)
+                        continue;
+                    sumBegin = std::min(sumBegin, clipped[i + 0] + 1);
+                    tiltedBegin = std::min(tiltedBegin, std::max<ptrdiff_t>(clipped[i + 0] + 1 - distance, 0));
+                    tiltedEnd = std::max(tiltedEnd, std::min<ptrdiff_t>(clipped[i + 2] + distance, width));
+                }
+
+                const uint8_t * s0 = src + (row - 1)*srcStride;
+                TSum * sum0 = sum + row*sumStride, * sum1 = sum0 - sumStride;
+                TSum rowSum = sum0[sumBegin - 1] - sum1[sumBegin - 1];
+                if (sqsum)
+                {
+                    TSqsum * sqsum0 = sqsum + row*sqsumStride, * sqsum1 = sqsum0 - sqsumStride;
+                    TSqsum rowSqsum = sqsum0[sumBegin - 1] - sqsum1[sumBegin - 1];
+                    for (ptrdiff_t col = sumBegin; col <= (ptrdiff_t)width; ++col)
+                    {
+                        TSum value = s0[col - 1];
+                        rowSum += value;
+                        rowSqsum += value*value;
+                        sum0[col] = sum1[col] + rowSum;
+                        sqsum0[col] = sqsum1[col] + rowSqsum;
+                    }
+                }
+                else
+                {
+                    for (ptrdiff_t col = sumBegin; col <= (ptrdiff_t)width; ++col)
+                    {
+                        rowSum += s0[col - 1];
+                        sum0[col] = sum1[col] + rowSum;
+                    }
+                }
+
+                if (tilted)
+                {
+                    TSum * tilted0 = tilted + row*tiltedStride, * tilted1 = tilted0 - tiltedStride;
+                    if (row == 1)
+                    {
+                        for (ptrdiff_t col = tiltedBegin; col <= tiltedEnd; ++col)
+                            tilted0[col] = col ? s0[col - 1] : 0;
+                        continue;
+                    }
+                    const uint8_t * s1 = s0 - srcStride;
+                    TSum * tilted2 = tilted1 - tiltedStride;
+                    ptrdiff_t col = tiltedBegin;
+                    if (col == 0)
+                        tilted0[col++] = tilted1[1];
+                    for (; col <= tiltedEnd && col < (ptrdiff_t)width; ++col)
+                        tilted0[col] = tilted1[col - 1] + tilted1[col + 1] - tilted2[col] + s0[col - 1] + s1[col - 1];
+                    if (col == (ptrdiff_t)width && col <= tiltedEnd)
+                        tilted0[col] = tilted1[col - 1] + s0[col - 1] + s1[col - 1];
+                }
+            }
+        }
+
+        void IntegralUpdate(const uint8_t * src, size_t srcStride, size_t width, size_t height, const ptrdiff_t * rects, size_t rectNumber,
+            uint8_t * sum, size_t sumStride, uint8_t * sqsum, size_t sqsumStride, uint8_t * tilted, size_t tiltedStride,
+            SimdPixelFormatType sumFormat, SimdPixelFormatType sqsumFormat)
+        {
+            assert(sumFormat == SimdPixelFormatInt32 && sumStride%sizeof(uint32_t) == 0);
+            if (tilted)
+                assert(tiltedStride%sizeof(uint32_t) == 0);
+
+            if (sqsum && sqsumFormat == SimdPixelFormatDouble)
+            {
+                IntegralUpdate<uint32_t, double>(src, srcStride, width, height, rects, rectNumber, (uint32_t*)sum, sumStride / sizeof(uint32_t),
+                    (double*)sqsum, sqsumStride / sizeof(double), (uint32_t*)tilted, tiltedStride / sizeof(uint32_t));
+            }
+            else
+            {
+                assert(sqsum == NULL || sqsumFormat == SimdPixelFormatInt32);
+                IntegralUpdate<uint32_t, uint32_t>(src, srcStride, width, height, rects, rectNumber, (uint32_t*)sum, sumStride / sizeof(uint32_t),
+                    (uint32_t*)sqsum, sqsumStride / sizeof(uint32_t), (uint32_t*)tilted, tiltedStride / sizeof(uint32_t));
+            }
+        }
 	}
 }
@@ -23,6 +23,8 @@
 */
 #include "Simd/SimdMath.h"
 #include "Simd/SimdMemory.h"
+#include "Simd/SimdNeural.h"
+#include "Simd/SimdBase.h"
 
 namespace Simd
 {
@@ -192,6 +194,23 @@ namespace Simd
                 AdaptiveGradientUpdate(delta, i, norm, _alpha, _epsilon, gradient, weight);
         }
 
+        void NeuralAdamUpdate(const float * delta, size_t size, size_t batch, const float * alpha, const float * beta1, const float * beta2, 
+            const float * epsilon, const float * decay, float * moment1, float * moment2, float * weight)
+        {
+            float norm = (float)(1.0 / batch), _alpha = alpha[0], _beta1 = beta1[0], _beta2 = beta2[0], _epsilon = epsilon[0], _decay = decay[0];
+            size_t alignedSize = Simd::AlignLo(size, 4);
+            size_t i = 0;
+            for (; i < alignedSize; i += 4)
+            {
+                AdamUpdate(delta, i + 0, norm, _alpha, _beta1, _beta2, _epsilon, _decay, moment1, moment2, weight);
+                AdamUpdate(delta, i + 1, norm, _alpha, _beta1, _beta2, _epsilon, _decay, moment1, moment2, weight);
+                AdamUpdate(delta, i + 2, norm, _alpha, _beta1, _beta2, _epsilon, _decay, moment1, moment2, weight);
+                AdamUpdate(delta, i + 3, norm, _alpha, _beta1, _beta2, _epsilon, _decay, moment1, moment2, weight);
+            }
+            for (; i < size; ++i)
+                AdamUpdate(delta, i, norm, _alpha, _beta1, _beta2, _epsilon, _decay, moment1, moment2, weight);
+        }
+
         SIMD_INLINE float Convolution3(const float * src, const float * weights)
         {
             return src[0] * weights[0] + src[1] * weights[1] + src[2] * weights[2];
@@ -334,5 +353,91 @@ namespace Simd
                 dst += dstStride;
             }
         }
+
+        void NeuralConvolutionForward(const float * src, size_t srcWidth, size_t srcHeight, size_t srcDepth, const float * weight,
+            size_t kernelX, size_t kernelY, size_t padX, size_t padY, size_t strideX, size_t strideY, size_t dilationX, size_t dilationY,
+            void * buffer, size_t * size, float * dst, size_t dstWidth, size_t dstHeight, size_t dstDepth, int add)
+        {
+            NeuralConvolutionShape shape(srcWidth, srcHeight, srcDepth, kernelX, kernelY, padX, padY, strideX, strideY, dilationX, dilationY, dstWidth, dstHeight, dstDepth);
+            NeuralConvolutionForwardRun<Gemm32fNN>(shape, src, weight, buffer, size, dst, add);
+        }
+
+        void NeuralConvolutionBackward(const float * src, size_t srcWidth, size_t srcHeight, size_t srcDepth, const float * weight,
+            size_t kernelX, size_t kernelY, size_t padX, size_t padY, size_t strideX, size_t strideY, size_t dilationX, size_t dilationY,
+            void * buffer, size_t * size, float * dst, size_t dstWidth, size_t dstHeight, size_t dstDepth, int add)
+        {
+            NeuralConvolutionShape shape(dstWidth, dstHeight, dstDepth, kernelX, kernelY, padX, padY, strideX, strideY, dilationX, dilationY, srcWidth, srcHeight, srcDepth);
+            NeuralConvolutionBackwardRun<Gemm32fNN>(shape, src, weight, buffer, size, dst, add);
+        }
+
+        void NeuralConvolutionSum(const float * src, size_t srcWidth, size_t srcHeight, size_t srcDepth, const float * dst, size_t dstWidth, size_t dstHeight, size_t dstDepth,
+            size_t kernelX, size_t kernelY, size_t padX, size_t padY, size_t strideX, size_t strideY, size_t dilationX, size_t dilationY,
+            void * buffer, size_t * size, float * sums)
+        {
+            NeuralConvolutionShape shape(srcWidth, srcHeight, srcDepth, kernelX, kernelY, padX, padY, strideX, strideY, dilationX, dilationY, dstWidth, dstHeight, dstDepth);
+            NeuralConvolutionSumRun<Gemm32fNN>(shape, src, dst, buffer, size, sums);
+        }
+
+        void NeuralWinograd2x2p3x3SetFilter(const float * src, size_t size, float * dst)
+        {
+            for (size_t i = 0; i < size; ++i)
+                NeuralWinograd2x2p3x3SetFilter1(src + i * 9, dst + i, size);
+        }
+
+        void NeuralWinograd2x2p3x3SetInput(const float * src, size_t srcWidth, size_t srcHeight, size_t srcDepth, float * dst)
+        {
+            assert(srcWidth > 2 && srcHeight > 2);
+            size_t tileH = (srcHeight - 1) / 2, tileW = (srcWidth - 1) / 2, dstStride = srcDepth*tileH*tileW;
+            for (size_t c = 0; c < srcDepth; ++c)
+            {
+                for (size_t row = 0; row < tileH; ++row)
+                {
+                    size_t rows = Simd::Min<size_t>(4, srcHeight - row * 2);
+                    const float * s = src + row * 2 * srcWidth;
+                    for (size_t col = 0; col < tileW; ++col)
+                    {
+                        size_t cols = Simd::Min<size_t>(4, srcWidth - col * 2);
+                        if (rows == 4 && cols == 4)
+                            NeuralWinograd2x2p3x3SetInput1(s + col * 2, srcWidth, dst++, dstStride);
+                        else
+                            NeuralWinograd2x2p3x3SetInput1(s + col * 2, srcWidth, rows, cols, dst++, dstStride);
+                    }
+                }
+                src += srcWidth*srcHeight;
+            }
+        }
+
+        void NeuralWinograd2x2p3x3SetOutput(const float * src, float * dst, size_t dstWidth, size_t dstHeight, size_t dstDepth)
+        {
+            size_t tileH = (dstHeight + 1) / 2, tileW = (dstWidth + 1) / 2, srcStride = dstDepth*tileH*tileW;
+            for (size_t c = 0; c < dstDepth; ++c)
+            {
+                for (size_t row = 0; row < tileH; ++row)
+                {
+                    size_t rows = Simd::Min<size_t>(2, dstHeight - row * 2);
+                    float * d = dst + row * 2 * dstWidth;
+                    for (size_t col = 0; col < tileW; ++col)
+                        NeuralWinograd2x2p3x3SetOutput1(src++, srcStride, d + col * 2, dstWidth, rows, Simd::Min<size_t>(2, dstWidth - col * 2));
+                }
+                dst += dstWidth*dstHeight;
+            }
+        }
+
+        void NeuralQuantize8u(const float * src, size_t size, const float * scale, const float * shift, uint8_t * dst)
+        {
+            for (size_t i = 0; i < size; ++i)
+                dst[i] = (uint8_t)RestrictRange(Round(src[i] * scale[0] + shift[0]), 0, 255);
+        }
+
+        void NeuralProductSum8u8i(const uint8_t * src, const int8_t * weight, size_t size, size_t count, int32_t * sums)
+        {
+            for (size_t i = 0; i < count; ++i, weight += size)
+            {
+                int32_t sum = 0;
+                for (size_t k = 0; k < size; ++k)
+                    sum += src[k] * weight[k];
+                sums[i] = sum;
+            }
+        }
     }
 }
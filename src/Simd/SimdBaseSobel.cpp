@@ -201,6 +201,153 @@ namespace Simd
             }
         }
 
+        void SobelDirectionTable(size_t quantization, int16_t * table)
+        {
+            assert(quantization%2 == 0 && quantization >= 2 && quantization <= 256);
+
+            size_t size = quantization/2;
+            for (size_t i = 0; i < size; ++i)
+            {
+                table[2*i + 0] = (int16_t)Round(::cos(i*M_PI/size)*SOBEL_DIRECTION_SCALE);
+                table[2*i + 1] = (int16_t)Round(::sin(i*M_PI/size)*SOBEL_DIRECTION_SCALE);
+            }
+        }
+
+        SIMD_INLINE int SobelDirection(int dx, int dy, const int16_t * table, int size)
+        {
+            int best = 0, index = 0;
+            for (int direction = 0; direction < size; ++direction)
+            {
+                int dot = table[2*direction + 0]*dx + table[2*direction + 1]*dy;
+                if (dot > best)
+                {
+                    best = dot;
+                    index = direction;
+                }
+                else if (-dot > best)
+                {
+                    best = -dot;
+                    index = direction + size;
+                }
+            }
+            return index;
+        }
+
+        SIMD_INLINE void SobelGradient(const uint8_t *s0, const uint8_t *s1, const uint8_t *s2, size_t x0, size_t x1, size_t x2, size_t col,
+            int16_t * dx, int16_t * dy, uint16_t * magnitude, const int16_t * table, int size, uint8_t * direction)
+        {
+            int _dx = SobelDx<false>(s0, s1, s2, x0, x2);
+            int _dy = SobelDy<false>(s0, s2, x0, x1, x2);
+            if (dx)
+                dx[col] = (int16_t)_dx;
+            if (dy)
+                dy[col] = (int16_t)_dy;
+            if (magnitude)
+                magnitude[col] = (uint16_t)(Simd::Abs(_dx) + Simd::Abs(_dy));
+            if (direction)
+                direction[col] = (uint8_t)SobelDirection(_dx, _dy, table, size);
+        }
+
+        void SobelGradient(const uint8_t * src, size_t srcStride, size_t width, size_t height, int16_t * dx, size_t dxStride, 
+            int16_t * dy, size_t dyStride, uint16_t * magnitude, size_t magnitudeStride, size_t quantization, uint8_t * direction, size_t directionStride)
+        {
+            assert(width > 1);
+
+            int16_t table[SOBEL_DIRECTION_TABLE_SIZE];
+            int size = (int)quantization/2;
+            if (direction)
+                SobelDirectionTable(quantization, table);
+
+            const uint8_t *src0, *src1, *src2;
+
+            for (size_t row = 0; row < height; ++row)
+            {
+                src0 = src + srcStride*(row - 1);
+                src1 = src0 + srcStride;
+                src2 = src1 + srcStride;
+                if (row == 0)
+                    src0 = src1;
+                if (row == height - 1)
+                    src2 = src1;
+
+                SobelGradient(src0, src1, src2, 0, 0, 1, 0, dx, dy, magnitude, table, size, direction);
+
+                for (size_t col = 1; col < width - 1; ++col)
+                    SobelGradient(src0, src1, src2, col - 1, col, col + 1, col, dx, dy, magnitude, table, size, direction);
+
+                SobelGradient(src0, src1, src2, width - 2, width - 1, width - 1, width - 1, dx, dy, magnitude, table, size, direction);
+
+                if (dx)
+                    dx += dxStride;
+                if (dy)
+                    dy += dyStride;
+                if (magnitude)
+                    magnitude += magnitudeStride;
+                if (direction)
+                    direction += directionStride;
+            }
+        }
+
+        void SobelGradient(const uint8_t * src, size_t srcStride, size_t width, size_t height, uint8_t * dx, size_t dxStride, 
+            uint8_t * dy, size_t dyStride, uint8_t * magnitude, size_t magnitudeStride, size_t quantization, uint8_t * direction, size_t directionStride)
+        {
+            assert(dxStride%sizeof(int16_t) == 0 && dyStride%sizeof(int16_t) == 0 && magnitudeStride%sizeof(uint16_t) == 0);
+
+            SobelGradient(src, srcStride, width, height, (int16_t*)dx, dxStride/sizeof(int16_t), (int16_t*)dy, dyStride/sizeof(int16_t), 
+                (uint16_t*)magnitude, magnitudeStride/sizeof(uint16_t), quantization, direction, directionStride);
+        }
+
+        SIMD_INLINE void SobelGradient32f(const uint8_t *s0, const uint8_t *s1, const uint8_t *s2, size_t x0, size_t x1, size_t x2, size_t col,
+            float * magnitude, float * direction)
+        {
+            float dx = (float)SobelDx<false>(s0, s1, s2, x0, x2);
+            float dy = (float)SobelDy<false>(s0, s2, x0, x1, x2);
+            if (magnitude)
+                magnitude[col] = ::sqrt(dx*dx + dy*dy);
+            if (direction)
+                direction[col] = Atan2(dy, dx);
+        }
+
+        void SobelGradient32f(const uint8_t * src, size_t srcStride, size_t width, size_t height, 
+            float * magnitude, size_t magnitudeStride, float * direction, size_t directionStride)
+        {
+            assert(width > 1);
+
+            const uint8_t *src0, *src1, *src2;
+
+            for (size_t row = 0; row < height; ++row)
+            {
+                src0 = src + srcStride*(row - 1);
+                src1 = src0 + srcStride;
+                src2 = src1 + srcStride;
+                if (row == 0)
+                    src0 = src1;
+                if (row == height - 1)
+                    src2 = src1;
+
+                SobelGradient32f(src0, src1, src2, 0, 0, 1, 0, magnitude, direction);
+
+                for (size_t col = 1; col < width - 1; ++col)
+                    SobelGradient32f(src0, src1, src2, col - 1, col, col + 1, col, magnitude, direction);
+
+                SobelGradient32f(src0, src1, src2, width - 2, width - 1, width - 1, width - 1, magnitude, direction);
+
+                if (magnitude)
+                    magnitude += magnitudeStride;
+                if (direction)
+                    direction += directionStride;
+            }
+        }
+
+        void SobelGradient32f(const uint8_t * src, size_t srcStride, size_t width, size_t height, 
+            uint8_t * magnitude, size_t magnitudeStride, uint8_t * direction, size_t directionStride)
+        {
+            assert(magnitudeStride%sizeof(float) == 0 && directionStride%sizeof(float) == 0);
+
+            SobelGradient32f(src, srcStride, width, height, (float*)magnitude, magnitudeStride/sizeof(float), 
+                (float*)direction, directionStride/sizeof(float));
+        }
+
         SIMD_INLINE int ContourMetrics(const uint8_t *s0, const uint8_t *s1, const uint8_t *s2, size_t x0, size_t x1, size_t x2)
         {
             int dx = SobelDx<true>(s0, s1, s2, x0, x2);
@@ -22,6 +22,7 @@
 * SOFTWARE.
 */
 #include "Simd/SimdMath.h"
+#include "Simd/SimdStatistic.h"
 
 namespace Simd
 {
@@ -236,5 +237,84 @@ namespace Simd
                 b += bStride;
             }
         }
+
+        SIMD_INLINE int LaplaceAbs3x3(const uint8_t * s0, const uint8_t * s1, const uint8_t * s2, size_t x0, size_t x1, size_t x2)
+        {
+            return Simd::Abs(8 * s1[x1] - (s0[x0] + s0[x1] + s0[x2] + s1[x0] + s1[x2] + s2[x0] + s2[x1] + s2[x2]));
+        }
+
+        void GetImageStatistics(const uint8_t * src, size_t srcStride, size_t width, size_t height, const uint8_t * mask, size_t maskStride, 
+            uint8_t index, uint32_t flags, size_t rowBegin, size_t rowEnd, SimdImageStatistics * statistics)
+        {
+            assert(width < 0x10000 && rowEnd <= height && (!(flags & SimdImageStatisticsLaplaceAbsSum) || width > 1));
+
+            SimdImageStatistics & s = *statistics;
+            memset(&s, 0, sizeof(s));
+            int min = UCHAR_MAX, max = 0;
+            ImageStatisticsHistograms histograms;
+            if (flags & SimdImageStatisticsHistogram)
+                memset(histograms, 0, sizeof(histograms));
+            for (size_t row = rowBegin; row < rowEnd; ++row)
+            {
+                const uint8_t * s1 = src + row*srcStride, * m = mask ? mask + row*maskStride : NULL;
+                uint64_t count = 0, x = 0, xx = 0;
+                if (m)
+                {
+                    for (size_t col = 0; col < width; ++col)
+                    {
+                        if (m[col] == index)
+                        {
+                            count++;
+                            x += col;
+                            xx += col*col;
+                        }
+                    }
+                }
+                else
+                {
+                    count = width;
+                    x = uint64_t(width)*(width - 1) / 2;
+                    xx = uint64_t(width)*(width - 1)*(2 * width - 1) / 6;
+                }
+                s.count += count;
+                if (flags & SimdImageStatisticsMoments)
+                    ImageStatisticsMoments(row, count, x, xx, s);
+
+                if (flags & (SimdImageStatisticsMinMax | SimdImageStatisticsSums))
+                {
+                    uint32_t sum = 0, squareSum = 0;
+                    for (size_t col = 0; col < width; ++col)
+                    {
+                        if (m && m[col] != index)
+                            continue;
+                        int value = s1[col];
+                        min = MinU8(value, min);
+                        max = MaxU8(value, max);
+                        sum += value;
+                        squareSum += Square(value);
+                    }
+                    s.sum += sum;
+                    s.squareSum += squareSum;
+                }
+
+                if (flags & SimdImageStatisticsHistogram)
+                    ImageStatisticsHistogram(s1, m, index, width, histograms);
+
+                if (flags & SimdImageStatisticsLaplaceAbsSum)
+                {
+                    const uint8_t * s0 = row ? s1 - srcStride : s1, * s2 = row < height - 1 ? s1 + srcStride : s1;
+                    uint64_t sum = 0;
+                    for (size_t col = 0; col < width; ++col)
+                    {
+                        if (m && m[col] != index)
+                            continue;
+                        sum += LaplaceAbs3x3(s0, s1, s2, col ? col - 1 : 0, col, col < width - 1 ? col + 1 : col);
+                    }
+                    s.laplaceAbsSum += sum;
+                }
+            }
+
+            ImageStatisticsFinalize(flags, min, max, histograms, s);
+        }
     }
 }
\ No newline at end of file
@@ -0,0 +1,73 @@
+/*
+* Simd Library (http://simd.sourceforge.net).
+*
+* Copyright (c) 2011-2017 Yermalayeu Ihar.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy 
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell 
+* copies of the Software, and to permit persons to whom the Software is 
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in 
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE 
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+#ifndef __SimdBilateralFilter_h__
+#define __SimdBilateralFilter_h__
+
+#include "Simd/SimdMemory.h"
+
+#include <vector>
+
+namespace Simd
+{
+    namespace Base
+    {
+        /*
+        * Prepared data of BilateralFilter: a copy of the source image with replicated border of width radius,
+        * offsets (in bytes) of the neighbors inside of the circle of given radius, their spatial weights
+        * and a table of range weights (it is indexed by sum of absolute channel differences).
+        */
+        struct BilateralFilterParam
+        {
+            size_t channelCount, radius, stride;
+            std::vector<int> offsets;
+            std::vector<float> space, range;
+
+            BilateralFilterParam(const uint8_t * src, size_t srcStride, size_t width, size_t height,
+                size_t channelCount, size_t radius, float sigmaSpace, float sigmaRange);
+
+            ~BilateralFilterParam()
+            {
+                Free(_padded);
+            }
+
+            SIMD_INLINE const uint8_t * Row(size_t row) const
+            {
+                return _padded + (row + radius)*stride + radius*channelCount;
+            }
+
+        private:
+            uint8_t * _padded;
+        };
+
+        /*
+        * All implementations round filtered (non-negative) values half up with the same float arithmetic, so their results are bit-exact.
+        */
+        SIMD_INLINE uint8_t BilateralFilterRound(float value)
+        {
+            return (uint8_t)int(value + 0.5f);
+        }
+    }
+}
+
+#endif//__SimdBilateralFilter_h__
@@ -0,0 +1,61 @@
+/*
+* Simd Library (http://simd.sourceforge.net).
+*
+* Copyright (c) 2011-2017 Yermalayeu Ihar.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy 
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell 
+* copies of the Software, and to permit persons to whom the Software is 
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in 
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE 
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+#ifndef __SimdClahe_h__
+#define __SimdClahe_h__
+
+#include "Simd/SimdConst.h"
+
+#include <vector>
+
+namespace Simd
+{
+    namespace Base
+    {
+        SIMD_INLINE size_t ClaheTileBorder(size_t index, size_t size, size_t tiles)
+        {
+            return index*size / tiles;
+        }
+
+        /*
+        * Bilinear interpolation grid along one axis of CLAHE: for every pixel it contains indexes of two nearest tiles
+        * (lo and hi, their centers surround the pixel center) and 8-bit fixed point weight of the hi tile.
+        * Pixels before the first tile center and after the last one use only the nearest tile.
+        */
+        struct ClaheAxis
+        {
+            std::vector<int> lo, hi, weight;
+
+            ClaheAxis(size_t size, size_t tiles);
+        };
+
+        SIMD_INLINE int ClaheInterpolate(int lut00, int lut01, int lut10, int lut11, int wx, int wy)
+        {
+            int top = lut00*(256 - wx) + lut01*wx;
+            int bottom = lut10*(256 - wx) + lut11*wx;
+            return (top*(256 - wy) + bottom*wy + 0x8000) >> 16;
+        }
+    }
+}
+
+#endif//__SimdClahe_h__
@@ -74,6 +74,9 @@ namespace Simd
 
 		const int DIVISION_BY_9_SHIFT = 16;
 		const int DIVISION_BY_9_FACTOR = (1 << DIVISION_BY_9_SHIFT) / 9;
+
+        const int SOBEL_DIRECTION_SCALE = 1 << 14;
+        const size_t SOBEL_DIRECTION_TABLE_SIZE = 256;
     }
 
 #ifdef SIMD_SSE_ENABLE    
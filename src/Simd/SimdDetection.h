@@ -45,6 +45,32 @@ namespace Simd
             virtual ~Deletable() {}
         };
 
+        /*
+        * Read only array of cascade data. It either owns its elements (cascade is loaded from XML file)
+        * or refers to memory of mapped binary cascade file.
+        */
+        template <class T> class Array
+        {
+        public:
+            Array() : _data(NULL), _size(0) {}
+
+            void reserve(size_t size) { _vector.reserve(size); _data = _vector.data(); }
+            void push_back(const T & value) { _vector.push_back(value); _data = _vector.data(); _size = _vector.size(); }
+            void Refer(const T * data, size_t size) { _vector.clear(); _data = data; _size = size; }
+
+            size_t size() const { return _size; }
+            const T * data() const { return _data; }
+            const T & operator[](size_t i) const { assert(i < _size); return _data[i]; }
+
+        private:
+            std::vector<T> _vector;
+            const T * _data;
+            size_t _size;
+
+            Array(const Array &);
+            Array & operator = (const Array &);
+        };
+
         struct Data : public Deletable
         {
             struct DTreeNode
@@ -101,16 +127,20 @@ namespace Simd
             int ncategories;
             Size origWinSize;
 
-            std::vector<Stage> stages;
-            std::vector<DTree> classifiers;
-            std::vector<DTreeNode> nodes;
-            std::vector<float> leaves;
-            std::vector<int> subsets;
+            Array<Stage> stages;
+            Array<DTree> classifiers;
+            Array<DTreeNode> nodes;
+            Array<float> leaves;
+            Array<int> subsets;
+
+            Array<HaarFeature> haarFeatures;
+            Array<LbpFeature> lbpFeatures;
 
-            std::vector<HaarFeature> haarFeatures;
-            std::vector<LbpFeature> lbpFeatures;
+            void * mapped; // a memory mapped binary cascade file (if the cascade was loaded from it).
+            size_t mappedSize;
 
-            virtual ~Data() {}
+            Data() : mapped(NULL), mappedSize(0) {}
+            virtual ~Data();
         };
 
         struct HidBase : public Deletable
@@ -137,11 +167,23 @@ namespace Simd
             WeightedRect rect[Data::HaarFeature::RECT_NUM];
         };
 
+        struct WeightedRect16
+        {
+            uint16_t *p0, *p1, *p2, *p3;
+            int16_t weight;
+        };
+
+        struct HidHaarFeature16
+        {
+            WeightedRect16 rect[Data::HaarFeature::RECT_NUM];
+        };
+
         struct HidHaarStage
         {
             int first;
             int ntrees;
             float threshold;
+            int16_t threshold16;
             bool hasThree;
             bool canSkip;
         };
@@ -152,8 +194,17 @@ namespace Simd
             int left;
             int right;
             float threshold;
+            int16_t threshold16;
         };
 
+        /*
+        * 16-bit integer evaluation of HAAR cascade (isInt16 is set):
+        *   every feature is evaluated on 16-bit integral images isum16[s] (itilted16[s]) which contain 32-bit integrals shifted right by s
+        *   (the shift is chosen for every feature to fit its weighted sum in 16-bit integer, features16 refer to these images);
+        *   the normalization factor is rounded to 16-bit integer norm16 = norm*normScale, node thresholds are scaled by 2^16/normScale/2^s,
+        *   so the condition sum >= threshold*norm turns to sum16 > (threshold16*norm16) >> 16;
+        *   leaves16 and stage threshold16 are scaled to fit stage sum in 16-bit integer (as in HidLbpCascade<int, short>).
+        */
         struct HidHaarCascade : public HidBase
         {
             typedef HidHaarNode Node;
@@ -177,12 +228,24 @@ namespace Simd
             typedef int ILeave;
             typedef std::vector<ILeave> ILeaves;
 
+            typedef HidHaarFeature16 Feature16;
+            typedef std::vector<Feature16> Features16;
+
+            typedef int16_t Leave16;
+            typedef std::vector<Leave16> Leaves16;
+
+            enum { INT16_SHIFT_MAX = 3 };
+
             Nodes nodes;
             Trees trees;
             Stages stages;
             Leaves leaves;
             Features features;
 
+            Leaves16 leaves16;
+            Features16 features16;
+            float normScale;
+
             float windowArea;
             float invWinArea;
             uint32_t *pq[4];
@@ -190,6 +253,7 @@ namespace Simd
 
             Image sum, sqsum, tilted;
             Image isum, itilted;
+            Image isum16[INT16_SHIFT_MAX + 1], itilted16[INT16_SHIFT_MAX + 1];
 
             virtual ~HidHaarCascade() 
             {
@@ -289,7 +353,7 @@ namespace Simd
 
         SIMD_INLINE int Norm16i(const HidHaarCascade & hid, size_t offset)
         {
-            return Simd::Round(Norm32f(hid, offset)*hid.invWinArea);
+            return int(Norm32f(hid, offset)*hid.normScale + 0.5f);
         }
 
         SIMD_INLINE float WeightedSum32f(const WeightedRect & rect, size_t offset)
@@ -300,6 +364,13 @@ namespace Simd
 
         int Detect32f(const struct HidHaarCascade & hid, size_t offset, int startStage, float norm);
 
+        SIMD_INLINE int WeightedSum16i(const WeightedRect16 & rect, size_t offset)
+        {
+            return rect.weight*(rect.p0[offset] - rect.p1[offset] - rect.p2[offset] + rect.p3[offset]);
+        }
+
+        int Detect16i(const struct HidHaarCascade & hid, size_t offset, int startStage, int norm);
+
         template< class T> SIMD_INLINE T IntegralSum(const T * p0, const T * p1, const T * p2, const T * p3, ptrdiff_t offset)
         {
             return p0[offset] - p1[offset] - p2[offset] + p3[offset];
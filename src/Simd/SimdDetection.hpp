@@ -30,6 +30,13 @@
 #include <vector>
 #include <map>
 #include <memory>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <algorithm>
+#include <cmath>
+#include <cfloat>
+#include <chrono>
 
 namespace Simd
 {
@@ -121,10 +128,82 @@ namespace Simd
         };
         typedef std::vector<Object> Objects; /*!< A vector of objects type defenition. */
 
+        /*!
+            \enum TrackMode
+            Describes how an image was processed by Simd::Detection::Track.
+        */
+        enum TrackMode
+        {
+            /*! The whole image was scanned (key frame). */
+            TrackFull,
+            /*! Only regions around objects detected at previous frame and motion regions were scanned. */
+            TrackRegions,
+        };
+
+        /*!
+            \short The Profile structure contains profiling information of Simd::Detection (see Simd::Detection::SetProfiling).
+        */
+        struct Profile
+        {
+            /*!
+                \short Profiling information of one cascade at one scaled image.
+            */
+            struct Cascade
+            {
+                Tag tag; /*!< \brief A tag of the cascade. */
+                Size window; /*!< \brief A size of detection window in coordinates of original image (zero if the cascade is not used at this scaled image). */
+                std::vector<size_t> windows; /*!< \brief windows[0] is a number of tested windows, windows[i + 1] is a number of windows which passed stage i.
+                                                  Windows are always counted with 32-bit float evaluation, so for 16-bit integer evaluation they are approximate. */
+                double evaluation; /*!< \brief A time (in seconds) spent in evaluation of the cascade. */
+                bool int16; /*!< \brief The cascade was evaluated with 16-bit integer numbers (see Simd::Detection::SetHaarInt16) at least once. */
+
+                /*!
+                    Creates a new empty Cascade structure.
+                */
+                Cascade() : tag(UNDEFINED_OBJECT_TAG), evaluation(0), int16(false) {}
+            };
+
+            /*!
+                \short Profiling information of one scaled image (level of image pyramid).
+            */
+            struct Level
+            {
+                double scale; /*!< \brief A scale of the image. */
+                double resize; /*!< \brief A time (in seconds) spent in resizing (and histogram normalization) of the image. */
+                double integral; /*!< \brief A time (in seconds) spent in estimation of integral images. */
+                std::vector<Cascade> cascades; /*!< \brief Profiling information for every loaded cascade (in order of loading). */
+
+                /*!
+                    Creates a new empty Level structure.
+                */
+                Level() : scale(0), resize(0), integral(0) {}
+            };
+
+            size_t frames; /*!< \brief A number of processed images. */
+            std::vector<Level> levels; /*!< \brief Profiling information of every scaled image (sorted by scale). Images of different sizes
+                                            (see Simd::Detection::DetectBatch) are accumulated together at levels with the same scale. */
+
+            /*!
+                Creates a new empty Profile structure.
+            */
+            Profile() : frames(0) {}
+        };
+
         /*!
             Creates a new empty Detection structure.
         */
         Detection() 
+            : _overlapMax(0)
+            , _trackPeriod(10)
+            , _trackCount(0)
+            , _trackExpansion(0.5)
+            , _trackSizeRange(1.5)
+            , _profiling(false)
+            , _haarInt16LossMax(0.05)
+            , _haarInt16DetectionsMin(100)
+            , _haarInt16FramesMax(100)
+            , _incrementalPeriod(0)
+            , _incrementalCount(0)
         {
         }
 
@@ -149,16 +228,20 @@ namespace Simd
         */
         bool Load(const std::string & path, Tag tag = UNDEFINED_OBJECT_TAG)
         {
-            Handle handle = ::SimdDetectionLoadA(path.c_str());
-            if (handle)
-            {
-                Data data;
-                data.handle = handle;
-                data.tag = tag;
-                ::SimdDetectionInfo(handle, (size_t*)&data.size.x, (size_t*)&data.size.y, &data.flags);
-                _data.push_back(data);
-            }
-            return handle != NULL;
+            return AddData(::SimdDetectionLoadA(path.c_str()), tag);
+        }
+
+        /*!
+            Loads classifier cascade from binary file (it can be created with using of function ::SimdDetectionSaveBinary). 
+            The file is memory mapped and is not parsed, so this method is much faster than Simd::Detection::Load.
+
+            \param [in] path - a path to binary cascade.
+            \param [in] tag - an user defined tag. This tag will be inserted in output Object structure.
+            \return a result of this operation.
+        */
+        bool LoadBinary(const std::string & path, Tag tag = UNDEFINED_OBJECT_TAG)
+        {
+            return AddData(::SimdDetectionLoadBinary(path.c_str()), tag);
         }
 
         /*!
@@ -172,17 +255,31 @@ namespace Simd
             \param [in] roi - a 8-bit image mask which defines Region Of Interest. User can restricts detection region with using this mask.
                               The mask affects to the center of detected object.
             \param [in] threadNumber - a number of work threads. It useful for multi core CPU. Use value -1 to auto choose of thread number. 
+            \param [in] resizeFromPrevious - if true then every scaled image is resized from the nearest larger scaled image instead of 
+                                             the original image. It reduces memory traffic (small scale factors) but slightly blurs small scaled images.
             \return a result of this operation.
         */
         bool Init(const Size & imageSize, double scaleFactor = 1.1, const Size & sizeMin = Size(0, 0),
-            const Size & sizeMax = Size(INT_MAX, INT_MAX), const View & roi = View(), ptrdiff_t threadNumber = -1)
+            const Size & sizeMax = Size(INT_MAX, INT_MAX), const View & roi = View(), ptrdiff_t threadNumber = -1, bool resizeFromPrevious = false)
         {
             if (_data.empty())
                 return false;
-            _imageSize = imageSize;
+            _scaleFactor = scaleFactor;
+            _sizeMin = sizeMin;
+            _sizeMax = sizeMax;
+            _roi.Recreate(roi.Size(), roi.format);
+            if (roi.format != View::None)
+                Simd::Copy(roi, _roi);
+            _resizeFromPrevious = resizeFromPrevious;
             ptrdiff_t threadNumberMax = std::thread::hardware_concurrency();
             _threadNumber = (threadNumber <= 0 || threadNumber > threadNumberMax) ? threadNumberMax : threadNumber;
-            return InitLevels(scaleFactor, sizeMin, sizeMax, roi);
+            _batch.clear();
+            _tracked.clear();
+            _trackCount = 0;
+            _incrementalCount = 0;
+            for (size_t i = 0; i < _data.size(); ++i)
+                InitInt16(_data[i]);
+            return InitLevels(_frame, imageSize);
         }
 
         /*!
@@ -200,42 +297,231 @@ namespace Simd
         bool Detect(const View & src, Objects & objects, int groupSizeMin = 3, double sizeDifferenceMax = 0.2,
             bool motionMask = false, const Rects & motionRegions = Rects())
         {
-            if (_levels.empty() || src.Size() != _imageSize)
+            if (_frame.levels.empty() || src.Size() != _frame.size)
                 return false;
 
-            FillLevels(src);
+            if (motionMask)
+            {
+                for (size_t i = 0; i < _frame.levels.size(); ++i)
+                    _frame.levels[i].regions = motionRegions;
+            }
 
-            typedef std::map<Tag, Objects> Candidates;
-            Candidates candidates;
+            SetChangedRegions(_frame, motionMask, motionRegions);
+            Frame * frame = &_frame;
+            View gray = Gray(_frame, src);
+            if (!RunTasks(&frame, &gray, 1, motionMask))
+                return false;
+
+            AddObjects(_frame);
+            Group(_frame.candidates, objects, groupSizeMin, sizeDifferenceMax);
+
+            return true;
+        }
+
+        /*!
+            Detects objects at given frame of video stream. The whole frame is scanned only at key frames (every keyFramePeriod frame, 
+            see Simd::Detection::SetTracking). At other frames only expanded regions around objects detected at previous frame 
+            (at scaled images with nearby scales) and motion regions are scanned.
+
+            \param [in] src - a input image (next frame of video stream).
+            \param [out] objects - detected objects.
+            \param [out] mode - a way of processing of the frame (full scan or scan of tracked regions).
+            \param [in] groupSizeMin - a minimal weight (number of elementary detections) of detected image.
+            \param [in] sizeDifferenceMax - a parameter to group elementary detections.
+            \param [in] motionRegions - a set of rectangles (motion regions) where new objects can appear. They are scanned in addition to
+                                        regions of tracked objects. The regions affect to the center of detected object.
+            \return a result of this operation.
+        */
+        bool Track(const View & src, Objects & objects, TrackMode & mode, int groupSizeMin = 3, double sizeDifferenceMax = 0.2,
+            const Rects & motionRegions = Rects())
+        {
+            if (_frame.levels.empty() || src.Size() != _frame.size)
+                return false;
+
+            mode = _trackCount ? TrackRegions : TrackFull;
+            if (mode == TrackRegions)
+                SetTrackedRegions(_frame, motionRegions);
+
+            SetChangedRegions(_frame, true, motionRegions);
+            Frame * frame = &_frame;
+            View gray = Gray(_frame, src);
+            if (!RunTasks(&frame, &gray, 1, mode == TrackRegions))
+                return false;
+
+            AddObjects(_frame);
+            Group(_frame.candidates, objects, groupSizeMin, sizeDifferenceMax);
+
+            _tracked = objects;
+            _trackCount = (_trackCount + 1) % _trackPeriod;
+
+            return true;
+        }
+
+        /*!
+            Sets parameters of tracking mode of detection (see Simd::Detection::Track). The next frame will be a key frame.
+
+            \param [in] keyFramePeriod - a period of key frames (full scans of frame). By default it is equal to 10.
+            \param [in] expansion - an expansion of regions around tracked objects (relative to object size). By default it is equal to 0.5.
+            \param [in] sizeRange - a maximal ratio between sizes of tracked object and detection window for scaled images which are scanned 
+                                    around the object. By default it is equal to 1.5.
+        */
+        void SetTracking(size_t keyFramePeriod, double expansion = 0.5, double sizeRange = 1.5)
+        {
+            _trackPeriod = std::max<size_t>(keyFramePeriod, 1);
+            _trackExpansion = expansion;
+            _trackSizeRange = sizeRange;
+            _trackCount = 0;
+        }
+
+        /*!
+            Enables incremental estimation of integral images for static cameras. In this mode Simd::Detection::Detect (with motionMask = true) 
+            and Simd::Detection::Track use motion regions (for example rectangles of objects found by Simd::Motion::Detector) as regions 
+            changed since previous frame: integral images of scaled images are recomputed only below and to the right of these regions 
+            (see ::SimdIntegralUpdate), other pixels are assumed to be unchanged. 
+            Histogram normalization used for HAAR cascades depends on the whole image (any local change alters all pixels), 
+            so integral images are always fully recomputed for images with HAAR cascades. Empty motion regions mean an unchanged frame. 
+            Integral images are fully recomputed at every refreshPeriod frame, 
+            after Simd::Detection::Init and if Simd::Detection::Detect is called without motion mask.
+
+            \param [in] refreshPeriod - a period of full recomputation of integral images. Value 0 disables incremental mode (by default).
+        */
+        void SetIncrementalIntegral(size_t refreshPeriod)
+        {
+            _incrementalPeriod = refreshPeriod;
+            _incrementalCount = 0;
+        }
+
+        /*!
+            Enables or disables profiling mode of detection. In this mode Simd::Detection::Detect, Simd::Detection::Track 
+            and Simd::Detection::DetectBatch measure time of resizing, estimation of integral images and cascade evaluation 
+            at every scaled image and count windows which pass every stage of cascades. 
+            The counting is performed by scalar code after detection (it doesn't affect to measured time), so profiling mode is much slower. 
+            Collected information is accumulated until next call of this method.
+
+            \param [in] enable - a flag to enable profiling mode.
+        */
+        void SetProfiling(bool enable)
+        {
+            _profiling = enable;
+            _profile = Profile();
+        }
+
+        /*!
+            Gets profiling information which was collected in profiling mode (see Simd::Detection::SetProfiling).
+
+            \return a reference to profiling information.
+        */
+        const Profile & GetProfile() const
+        {
+            return _profile;
+        }
 
-            for (size_t i = 0; i < _levels.size(); ++i)
+        /*!
+            Detects objects at several images at once (for example at frames of many video streams). 
+            All images are processed by common pool of work threads with using of common task queue, 
+            so small images don't leave threads idle. Cascades are shared, buffers of scaled images are created for every image of the batch 
+            (they are reused in next calls if image sizes are not changed). 
+            The images are processed with parameters passed to Simd::Detection::Init (except image size): 
+            the ROI is scaled to the size of every image, motion masks and motion regions are not used, 
+            so every image is scanned within the ROI only. An image smaller than windows of all cascades gives no objects.
+
+            \param [in] srcs - input images. They can have different sizes.
+            \param [out] objects - detected objects for every input image.
+            \param [in] groupSizeMin - a minimal weight (number of elementary detections) of detected image.
+            \param [in] sizeDifferenceMax - a parameter to group elementary detections.
+            \return a result of this operation.
+        */
+        bool DetectBatch(const std::vector<View> & srcs, std::vector<Objects> & objects, int groupSizeMin = 3, double sizeDifferenceMax = 0.2)
+        {
+            if (_frame.levels.empty())
+                return false;
+
+            while (_batch.size() < srcs.size())
+                _batch.push_back(FramePtr(new Frame()));
+            std::vector<Frame*> frames(srcs.size());
+            std::vector<View> grays(srcs.size());
+            for (size_t i = 0; i < srcs.size(); ++i)
             {
-                Level & level = _levels[i];
-                View mask = level.roi;
-                Rect rect = level.rect;
-                if (motionMask)
+                frames[i] = _batch[i].get();
+                if (frames[i]->size != srcs[i].Size() && !InitLevels(*frames[i], srcs[i].Size()))
                 {
-                    FillMotionMask(motionRegions, level, rect);
-                    mask = level.mask;
+                    // An image smaller than windows of all cascades has no levels and gives no objects; other failures are errors.
+                    if (!frames[i]->levels.empty())
+                    {
+                        frames[i]->size = Size();
+                        return false;
+                    }
                 }
-                if (rect.Empty())
-                    continue;
-                for (size_t j = 0; j < level.hids.size(); ++j)
-                {
-                    Hid & hid = level.hids[j];
+                grays[i] = Gray(*frames[i], srcs[i]);
+            }
 
-                    hid.Detect(mask, rect, level.dst, _threadNumber, level.throughColumn);
+            if (!RunTasks(frames.data(), grays.data(), frames.size(), false))
+                return false;
 
-                    AddObjects(candidates[hid.data->tag], level.dst, rect, hid.data->size, level.scale,
-                        level.throughColumn ? 2 : 1, hid.data->tag);
-                }
+            objects.resize(srcs.size());
+            for (size_t i = 0; i < frames.size(); ++i)
+            {
+                AddObjects(*frames[i]);
+                Group(frames[i]->candidates, objects[i], groupSizeMin, sizeDifferenceMax);
             }
 
+            return true;
+        }
+
+        /*!
+            Groups elementary detections (candidates) into objects. It is used by Simd::Detection::Detect.
+            Candidates with different tags are grouped separately. 
+
+            \param [in] candidates - elementary detections.
+            \param [out] objects - grouped objects.
+            \param [in] groupSizeMin - a minimal weight (number of elementary detections) of detected image.
+            \param [in] sizeDifferenceMax - a parameter to group elementary detections.
+        */
+        void Group(const Objects & candidates, Objects & objects, int groupSizeMin = 3, double sizeDifferenceMax = 0.2)
+        {
+            typedef std::map<Tag, Objects> Candidates;
+            Candidates tagged;
+            for (size_t i = 0; i < candidates.size(); ++i)
+                tagged[candidates[i].tag].push_back(candidates[i]);
+
             objects.clear();
-            for (typename Candidates::iterator it = candidates.begin(); it != candidates.end(); ++it)
+            for (typename Candidates::iterator it = tagged.begin(); it != tagged.end(); ++it)
                 GroupObjects(objects, it->second, groupSizeMin, sizeDifferenceMax);
+        }
 
-            return true;
+        /*!
+            Sets a bound of accuracy loss of 16-bit integer evaluation of HAAR cascades. 
+            HAAR cascades which support it (see ::SimdDetectionInfoCanInt16) are evaluated both with 32-bit float and 16-bit integer numbers 
+            at first processed images (calibration, results of 32-bit float evaluation are used, so it is slower than usual detection). 
+            Calibration lasts until at least detectionsMin windows are detected with 32-bit float evaluation (or framesMax images are processed). 
+            Then faster 16-bit integer evaluation is used if the number of windows with different results doesn't exceed lossMax multiplied 
+            by the number of windows detected with 32-bit float evaluation. Else 32-bit float evaluation is used. 
+            This method and method Init restart calibration.
+
+            \param [in] lossMax - a maximal relative accuracy loss. A negative value disables 16-bit integer evaluation of HAAR cascades. 
+                                  By default it is equal to 0.05.
+            \param [in] detectionsMin - a minimal number of windows detected during calibration. By default it is equal to 100.
+            \param [in] framesMax - a maximal number of images processed during calibration. By default it is equal to 100.
+        */
+        void SetHaarInt16(double lossMax, size_t detectionsMin = 100, size_t framesMax = 100)
+        {
+            _haarInt16LossMax = lossMax;
+            _haarInt16DetectionsMin = detectionsMin;
+            _haarInt16FramesMax = std::max<size_t>(framesMax, 1);
+            for (size_t i = 0; i < _data.size(); ++i)
+                InitInt16(_data[i]);
+        }
+
+        /*!
+            Sets non-maximum suppression mode of grouping. In this mode groups of elementary detections are sorted by their weight (score),
+            and a group is rejected if its overlap (intersection over union) with a heavier accepted group exceeds given threshold.
+            By default (overlapMax = 0) a group is rejected only if it is nested in a heavier group.
+
+            \param [in] overlapMax - a maximal overlap (intersection over union) of output objects. Zero value disables this mode.
+        */
+        void SetNonMaximumSuppression(double overlapMax)
+        {
+            _overlapMax = overlapMax;
         }
 
     private:
@@ -252,6 +538,9 @@ namespace Simd
             bool Haar() const { return (flags&::SimdDetectionInfoFeatureMask) == ::SimdDetectionInfoFeatureHaar; }
             bool Tilted() const { return (flags&::SimdDetectionInfoHasTilted) != 0; }
             bool Int16() const {return (flags&::SimdDetectionInfoCanInt16) != 0; }
+
+            int int16; // 16-bit integer evaluation of HAAR cascade: -1 - calibration, 0 - disabled, 1 - enabled.
+            size_t differences, detections, frames; // statistics of calibration.
         };
 
         typedef void(*DetectPtr)(const void * hid, const uint8_t * mask, size_t maskStride,
@@ -265,20 +554,41 @@ namespace Simd
         {
             Handle handle;
             Data * data;
-            DetectPtr detect;
+            DetectPtr detect, detect16;
+
+            View dst;
 
-            void Detect(const View & mask, const Rect & rect, View & dst, size_t threadNumber, bool throughColumn)
+            Rect Area(const Rect & rect) const
             {
-                Size s = dst.Size() - data->size;
-                View m = mask.Region(s, View::MiddleCenter);
-                Rect r = rect.Shifted(-data->size / 2).Intersection(Rect(s));
-                Simd::Fill(dst, 0);
-                ::SimdDetectionPrepare(handle);
+                return rect.Shifted(-data->size / 2).Intersection(Rect(dst.Size() - data->size));
+            }
 
-                Parallel(r.top, r.bottom, [&](size_t thread, size_t begin, size_t end)
-                {
-                    detect(handle, m.data, m.stride, r.left, begin, r.right, end, dst.data, dst.stride);
-                }, threadNumber, throughColumn ? 2 : 1);
+            bool Bounds(const View & mask, const Rect & rect, ptrdiff_t begin, ptrdiff_t end, bool throughColumn, View & m, Rect & r) const
+            {
+                m = mask.Region(dst.Size() - data->size, View::MiddleCenter);
+                r = Area(rect);
+                ptrdiff_t top = std::max(begin, r.top);
+                if (throughColumn && (top - r.top) % 2)
+                    top++;
+                r.top = top;
+                r.bottom = std::min(end, r.bottom);
+                return r.top < r.bottom && r.left < r.right;
+            }
+
+            void Detect(const View & mask, const Rect & rect, ptrdiff_t begin, ptrdiff_t end, bool throughColumn)
+            {
+                View m;
+                Rect r;
+                if (Bounds(mask, rect, begin, end, throughColumn, m, r))
+                    (data->int16 > 0 ? detect16 : detect)(handle, m.data, m.stride, r.left, r.top, r.right, r.bottom, dst.data, dst.stride);
+            }
+
+            void Count(const View & mask, const Rect & rect, ptrdiff_t begin, ptrdiff_t end, bool throughColumn, size_t * counts) const
+            {
+                View m;
+                Rect r;
+                if (Bounds(mask, rect, begin, end, throughColumn, m, r))
+                    ::SimdDetectionCountStages(handle, m.data, m.stride, r.left, r.top, r.right, r.bottom, counts);
             }
         };
         typedef std::vector<Hid> Hids;
@@ -298,11 +608,15 @@ namespace Simd
             View sqsum;
             View tilted;
 
-            View dst;
+            Rects regions;
+            Rect area;
+            bool resized;
+            bool ready;
 
             bool throughColumn;
             bool needSqsum;
             bool needTilted;
+            bool integral;
 
             ~Level()
             {
@@ -312,17 +626,80 @@ namespace Simd
         };
         typedef std::vector<Level> Levels;
 
+        struct Task
+        {
+            size_t level, hid;
+            ptrdiff_t begin, end;
+            bool prepare;
+        };
+        typedef std::vector<Task> Tasks;
+
+        struct Frame
+        {
+            Size size;
+            Levels levels;
+            Tasks tasks;
+            View gray;
+            Objects candidates;
+            Rects changed;
+            bool incremental;
+            bool needNormalization;
+        };
+        typedef std::shared_ptr<Frame> FramePtr;
+        typedef std::vector<FramePtr> FramePtrs;
+
         std::vector<Data> _data;
-        Size _imageSize;
-        bool _needNormalization;
+        double _scaleFactor;
+        Size _sizeMin, _sizeMax;
+        View _roi;
+        bool _resizeFromPrevious;
         ptrdiff_t _threadNumber;
-        Levels _levels;
+        Frame _frame;
+        FramePtrs _batch;
+        double _overlapMax;
+        size_t _trackPeriod, _trackCount;
+        double _trackExpansion, _trackSizeRange;
+        Objects _tracked;
+        bool _profiling;
+        Profile _profile;
+        double _haarInt16LossMax;
+        size_t _haarInt16DetectionsMin, _haarInt16FramesMax;
+        size_t _incrementalPeriod, _incrementalCount;
+        std::mutex _mutex;
+        std::condition_variable _condition;
+
+        bool AddData(Handle handle, Tag tag)
+        {
+            if (handle)
+            {
+                Data data;
+                data.handle = handle;
+                data.tag = tag;
+                ::SimdDetectionInfo(handle, (size_t*)&data.size.x, (size_t*)&data.size.y, &data.flags);
+                InitInt16(data);
+                _data.push_back(data);
+            }
+            return handle != NULL;
+        }
+
+        void InitInt16(Data & data)
+        {
+            data.int16 = data.Haar() && data.Int16() && _haarInt16LossMax >= 0 ? -1 : 0;
+            data.differences = 0;
+            data.detections = 0;
+            data.frames = 0;
+        }
 
-        bool InitLevels(double scaleFactor, const Size & sizeMin, const Size & sizeMax, const View & roi)
+        bool InitLevels(Frame & frame, const Size & imageSize)
         {
-            _needNormalization = false;
-            _levels.clear();
-            _levels.reserve(100);
+            Levels & levels = frame.levels;
+            const Size & sizeMin = _sizeMin, & sizeMax = _sizeMax;
+            const View & roi = _roi;
+            frame.size = imageSize;
+            frame.incremental = false;
+            frame.needNormalization = false;
+            levels.clear();
+            levels.reserve(100);
             double scale = 1.0;
             do
             {
@@ -332,7 +709,7 @@ namespace Simd
                 {
                     Size windowSize = _data[i].size * scale;
                     if (windowSize.x <= sizeMax.x && windowSize.y <= sizeMax.y &&
-                        windowSize.x <= _imageSize.x && windowSize.y <= _imageSize.y)
+                        windowSize.x <= imageSize.x && windowSize.y <= imageSize.y)
                     {
                         if (windowSize.x >= sizeMin.x && windowSize.y >= sizeMin.y)
                             insert = inserts[i] = true;
@@ -344,12 +721,12 @@ namespace Simd
 
                 if (insert)
                 {
-                    _levels.push_back(Level());
-                    Level & level = _levels.back();
+                    levels.push_back(Level());
+                    Level & level = levels.back();
 
                     level.scale = scale;
                     level.throughColumn = scale <= 2.0;
-                    Size scaledSize(_imageSize / scale);
+                    Size scaledSize(imageSize / scale);
 
                     level.src.Recreate(scaledSize, View::Gray8);
                     level.roi.Recreate(scaledSize, View::Gray8);
@@ -359,38 +736,24 @@ namespace Simd
                     level.sqsum.Recreate(scaledSize + Size(1, 1), View::Int32);
                     level.tilted.Recreate(scaledSize + Size(1, 1), View::Int32);
 
-                    level.dst.Recreate(scaledSize, View::Gray8);
-
                     level.needSqsum = false, level.needTilted = false;
+                    level.integral = false;
                     for (size_t i = 0; i < _data.size(); ++i)
                     {
                         if (!inserts[i])
                             continue;
-                        Handle handle = ::SimdDetectionInit(_data[i].handle, level.sum.data, level.sum.stride, level.sum.width, level.sum.height,
-                            level.sqsum.data, level.sqsum.stride, level.tilted.data, level.tilted.stride, level.throughColumn, _data[i].Int16());
-                        if (handle)
-                        {
-                            Hid hid;
-                            hid.handle = handle;
-                            hid.data = &_data[i];
-                            if (_data[i].Haar())
-                                hid.detect = level.throughColumn ? ::SimdDetectionHaarDetect32fi : ::SimdDetectionHaarDetect32fp;
-                            else
-                            {
-                                if(_data[i].Int16())
-                                    hid.detect = level.throughColumn ? ::SimdDetectionLbpDetect16ii : ::SimdDetectionLbpDetect16ip;
-                                else
-                                    hid.detect = level.throughColumn ? ::SimdDetectionLbpDetect32fi : ::SimdDetectionLbpDetect32fp;
-                            }
-                            level.hids.push_back(hid);
-                        }
-                        else
+                        Hid hid;
+                        if (!InitHid(level, _data[i], hid))
                             return false;
+                        level.hids.push_back(hid);
                         level.needSqsum = level.needSqsum | _data[i].Haar();
                         level.needTilted = level.needTilted | _data[i].Tilted();
-                        _needNormalization = _needNormalization | _data[i].Haar();
+                        frame.needNormalization = frame.needNormalization | _data[i].Haar();
                     }
 
+                    for (size_t i = 0; i < level.hids.size(); ++i)
+                        level.hids[i].dst.Recreate(scaledSize, View::Gray8);
+
                     level.rect = Rect(level.roi.Size());
                     if (roi.format == View::None)
                         Simd::Fill(level.roi, 255);
@@ -401,30 +764,360 @@ namespace Simd
                         Simd::SegmentationShrinkRegion(level.roi, 255, level.rect);
                     }
                 }
-                scale *= scaleFactor;
+                scale *= _scaleFactor;
             } while (true);
-            return !_levels.empty();
+            InitTasks(frame);
+            return !levels.empty();
         }
 
-        void FillLevels(View src)
+        // 16-bit integer structures of HAAR cascade are created only during calibration or if 16-bit evaluation is enabled:
+        // otherwise DetectionPrepare would rebuild unused 16-bit integral images at every level of every frame.
+        bool InitHid(const Level & level, Data & data, Hid & hid)
         {
-            View gray;
-            if (src.format != View::Gray8)
+            bool int16 = data.Haar() ? data.int16 != 0 : data.Int16();
+            hid.handle = ::SimdDetectionInit(data.handle, level.sum.data, level.sum.stride, level.sum.width, level.sum.height,
+                level.sqsum.data, level.sqsum.stride, level.tilted.data, level.tilted.stride, level.throughColumn, int16);
+            if (hid.handle == NULL)
+                return false;
+            hid.data = &data;
+            hid.detect16 = NULL;
+            if (data.Haar())
             {
-                gray.Recreate(src.Size(), View::Gray8);
-                Convert(src, gray);
-                src = gray;
+                hid.detect = level.throughColumn ? ::SimdDetectionHaarDetect32fi : ::SimdDetectionHaarDetect32fp;
+                if (int16)
+                    hid.detect16 = level.throughColumn ? ::SimdDetectionHaarDetect16ii : ::SimdDetectionHaarDetect16ip;
             }
+            else
+            {
+                if (int16)
+                    hid.detect = level.throughColumn ? ::SimdDetectionLbpDetect16ii : ::SimdDetectionLbpDetect16ip;
+                else
+                    hid.detect = level.throughColumn ? ::SimdDetectionLbpDetect32fi : ::SimdDetectionLbpDetect32fp;
+            }
+            return true;
+        }
 
-            Simd::ResizeBilinear(src, _levels[0].src);
-            if (_needNormalization)
-                Simd::NormalizeHistogram(_levels[0].src, _levels[0].src);
-            EstimateIntegral(_levels[0]);
-            for (size_t i = 1; i < _levels.size(); ++i)
+        // Recreates HAAR hids whose 16-bit structures don't match current state (calibration result or Simd::Detection::SetHaarInt16).
+        bool UpdateInt16(Frame & frame)
+        {
+            for (size_t l = 0; l < frame.levels.size(); ++l)
             {
-                Simd::ResizeBilinear(_levels[0].src, _levels[i].src);
-                EstimateIntegral(_levels[i]);
+                Level & level = frame.levels[l];
+                for (size_t i = 0; i < level.hids.size(); ++i)
+                {
+                    Hid & hid = level.hids[i];
+                    if (!hid.data->Haar() || (hid.data->int16 != 0) == (hid.detect16 != NULL))
+                        continue;
+                    Hid updated;
+                    if (!InitHid(level, *hid.data, updated))
+                        return false;
+                    ::SimdDetectionFree(hid.handle);
+                    hid.handle = updated.handle;
+                    hid.detect = updated.detect;
+                    hid.detect16 = updated.detect16;
+                }
+            }
+            return true;
+        }
+
+        // Tasks are ordered as: prepare level 0, prepare level 1, bands of level 0, prepare level 2, bands of level 1, ...
+        // so preparation of the next level overlaps with detection at the current one.
+        void InitTasks(Frame & frame)
+        {
+            Tasks bands;
+            Tasks & tasks = frame.tasks;
+            tasks.clear();
+            for (size_t i = 0; i < frame.levels.size(); ++i)
+            {
+                Level & level = frame.levels[i];
+                Task task;
+                task.level = i;
+                task.prepare = true;
+                tasks.push_back(task);
+                if (i)
+                    tasks.insert(tasks.end(), bands.begin(), bands.end());
+                bands.clear();
+                task.prepare = false;
+                for (size_t j = 0; j < level.hids.size(); ++j)
+                {
+                    Rect r = level.hids[j].Area(level.rect);
+                    ptrdiff_t band = std::max<ptrdiff_t>(r.Height() / (_threadNumber * 4), 1);
+                    if (_threadNumber == 1)
+                        band = r.Height();
+                    if (level.throughColumn)
+                        band += band & 1;
+                    task.hid = j;
+                    for (task.begin = r.top; task.begin < r.bottom; task.begin += band)
+                    {
+                        task.end = std::min(task.begin + band, r.bottom);
+                        bands.push_back(task);
+                    }
+                }
             }
+            tasks.insert(tasks.end(), bands.begin(), bands.end());
+        }
+
+        // Task queues of all frames are concatenated and are processed by common pool of threads.
+        bool RunTasks(Frame * const * frames, const View * srcs, size_t count, bool motionMask)
+        {
+            for (size_t f = 0; f < count; ++f)
+                if (!UpdateInt16(*frames[f]))
+                    return false;
+            if (_profiling)
+                _profile.frames += count;
+            std::vector<size_t> ends(count);
+            for (size_t f = 0, total = 0; f < count; ++f)
+            {
+                Levels & levels = frames[f]->levels;
+                for (size_t i = 0; i < levels.size(); ++i)
+                    levels[i].resized = false, levels[i].ready = false;
+                ends[f] = total += frames[f]->tasks.size();
+            }
+            size_t total = count ? ends[count - 1] : 0;
+            std::atomic<size_t> next(0);
+            auto Run = [&]()
+            {
+                size_t f = 0;
+                for (size_t t = next++; t < total; t = next++)
+                {
+                    while (t >= ends[f])
+                        f++;
+                    Frame & frame = *frames[f];
+                    const Task & task = frame.tasks[t - (f ? ends[f - 1] : 0)];
+                    Level & level = frame.levels[task.level];
+                    if (task.prepare)
+                    {
+                        PrepareLevel(frame, srcs[f], task.level, motionMask);
+                        Notify(level.ready);
+                    }
+                    else
+                    {
+                        Wait(level.ready);
+                        if (level.area.Empty())
+                            continue;
+                        const View & mask = motionMask ? level.mask : level.roi;
+                        if (_profiling)
+                            ProfileDetect(level, task, mask);
+                        else
+                            DetectTask(level, task, mask);
+                    }
+                }
+            };
+            std::vector<std::future<void>> futures;
+            for (size_t i = 1, n = std::min<size_t>(_threadNumber, total); i < n; ++i)
+                futures.push_back(std::async(std::launch::async, Run));
+            Run();
+            for (size_t i = 0; i < futures.size(); ++i)
+                futures[i].wait();
+            for (size_t i = 0; i < _data.size(); ++i)
+            {
+                Data & data = _data[i];
+                if (data.int16 >= 0)
+                    continue;
+                data.frames += count;
+                if (data.detections >= _haarInt16DetectionsMin || data.frames >= _haarInt16FramesMax)
+                    data.int16 = data.differences <= _haarInt16LossMax * data.detections ? 1 : 0;
+            }
+            return true;
+        }
+
+        void DetectTask(Level & level, const Task & task, const View & mask)
+        {
+            Hid & hid = level.hids[task.hid];
+            if (hid.data->int16 < 0)
+                Calibrate(level, task, mask);
+            else
+                hid.Detect(mask, level.area, task.begin, task.end, level.throughColumn);
+        }
+
+        // The result of 32-bit float evaluation is used, 16-bit integer evaluation is performed to count different windows.
+        void Calibrate(Level & level, const Task & task, const View & mask)
+        {
+            Hid & hid = level.hids[task.hid];
+            View m;
+            Rect r;
+            if (!hid.Bounds(mask, level.area, task.begin, task.end, level.throughColumn, m, r))
+                return;
+            View dst(hid.dst.Size(), View::Gray8);
+            Simd::Fill(dst, 0);
+            hid.detect(hid.handle, m.data, m.stride, r.left, r.top, r.right, r.bottom, hid.dst.data, hid.dst.stride);
+            hid.detect16(hid.handle, m.data, m.stride, r.left, r.top, r.right, r.bottom, dst.data, dst.stride);
+            size_t differences = 0, detections = 0;
+            for (ptrdiff_t row = r.top; row < r.bottom; ++row)
+            {
+                const uint8_t * d32 = hid.dst.data + row * hid.dst.stride, * d16 = dst.data + row * dst.stride;
+                for (ptrdiff_t col = r.left; col < r.right; ++col)
+                {
+                    detections += d32[col] ? 1 : 0;
+                    differences += (d32[col] != 0) != (d16[col] != 0) ? 1 : 0;
+                }
+            }
+            std::lock_guard<std::mutex> lock(_mutex);
+            hid.data->differences += differences;
+            hid.data->detections += detections;
+        }
+
+        void Wait(const bool & flag)
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _condition.wait(lock, [&flag] { return flag; });
+        }
+
+        void Notify(bool & flag)
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            flag = true;
+            _condition.notify_all();
+        }
+
+        void PrepareLevel(Frame & frame, const View & src, size_t index, bool motionMask)
+        {
+            Level & level = frame.levels[index];
+            double start = _profiling ? Time() : 0;
+            if (index)
+            {
+                const Level & larger = frame.levels[_resizeFromPrevious ? index - 1 : 0];
+                Wait(larger.resized);
+                Simd::ResizeBilinear(larger.src, level.src);
+            }
+            else
+            {
+                Simd::ResizeBilinear(src, level.src);
+                if (frame.needNormalization)
+                    Simd::NormalizeHistogram(level.src, level.src);
+            }
+            Notify(level.resized);
+            double resized = _profiling ? Time() : 0;
+            level.area = level.rect;
+            if (motionMask)
+                FillMotionMask(level.regions, level, level.area);
+            if (level.area.Empty() && !frame.incremental)
+            {
+                level.integral = false;
+                return;
+            }
+            EstimateIntegral(frame, level, index);
+            if (_profiling)
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                typename Profile::Level & profile = ProfileLevel(level);
+                profile.resize += resized - start;
+                profile.integral += Time() - resized;
+            }
+            if (level.area.Empty())
+                return;
+            for (size_t i = 0; i < level.hids.size(); ++i)
+            {
+                Simd::Fill(level.hids[i].dst, 0);
+                ::SimdDetectionPrepare(level.hids[i].handle);
+            }
+        }
+
+        // Every level gets motion regions and expanded regions of tracked objects which size is close to size of its detection windows.
+        void SetTrackedRegions(Frame & frame, const Rects & motionRegions)
+        {
+            for (size_t i = 0; i < frame.levels.size(); ++i)
+            {
+                Level & level = frame.levels[i];
+                level.regions = motionRegions;
+                double sizeMin = DBL_MAX, sizeMax = 0;
+                for (size_t j = 0; j < level.hids.size(); ++j)
+                {
+                    double size = level.hids[j].data->size.x * level.scale;
+                    sizeMin = std::min(sizeMin, size);
+                    sizeMax = std::max(sizeMax, size);
+                }
+                for (size_t j = 0; j < _tracked.size(); ++j)
+                {
+                    Rect rect = _tracked[j].rect;
+                    double size = (double)rect.Width();
+                    if (size * _trackSizeRange < sizeMin || size > sizeMax * _trackSizeRange)
+                        continue;
+                    rect.AddBorder(ptrdiff_t(std::max(rect.Width(), rect.Height()) * _trackExpansion));
+                    level.regions.push_back(rect);
+                }
+            }
+        }
+
+        static double Time()
+        {
+            return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+        }
+
+        // Levels are keyed by scale (not by index): levels of images with different sizes can have different scales at the same index.
+        typename Profile::Level & ProfileLevel(const Level & level)
+        {
+            std::vector<typename Profile::Level> & levels = _profile.levels;
+            size_t index = 0;
+            while (index < levels.size() && levels[index].scale < level.scale * (1.0 - 1e-6))
+                index++;
+            if (index == levels.size() || levels[index].scale > level.scale * (1.0 + 1e-6))
+            {
+                levels.insert(levels.begin() + index, typename Profile::Level());
+                levels[index].scale = level.scale;
+            }
+            typename Profile::Level & profile = levels[index];
+            if (profile.cascades.size() != _data.size())
+            {
+                profile.cascades.resize(_data.size());
+                for (size_t i = 0; i < _data.size(); ++i)
+                    profile.cascades[i].tag = _data[i].tag;
+            }
+            return profile;
+        }
+
+        // Detection time is measured at first, then windows are counted by scalar code.
+        void ProfileDetect(Level & level, const Task & task, const View & mask)
+        {
+            Hid & hid = level.hids[task.hid];
+            double start = Time();
+            DetectTask(level, task, mask);
+            double time = Time() - start;
+            std::vector<size_t> counts(::SimdDetectionStageNumber(hid.handle) + 1, 0);
+            hid.Count(mask, level.area, task.begin, task.end, level.throughColumn, counts.data());
+
+            std::lock_guard<std::mutex> lock(_mutex);
+            typename Profile::Cascade & profile = ProfileLevel(level).cascades[hid.data - _data.data()];
+            profile.window = hid.data->size * level.scale;
+            profile.int16 = profile.int16 || hid.data->int16 > 0;
+            profile.evaluation += time;
+            profile.windows.resize(counts.size(), 0);
+            for (size_t i = 0; i < counts.size(); ++i)
+                profile.windows[i] += counts[i];
+        }
+
+        const View & Gray(Frame & frame, const View & src)
+        {
+            if (src.format == View::Gray8)
+                return src;
+            if (frame.gray.Size() != src.Size())
+                frame.gray.Recreate(src.Size(), View::Gray8);
+            Convert(src, frame.gray);
+            return frame.gray;
+        }
+
+        void SetChangedRegions(Frame & frame, bool motionMask, const Rects & motionRegions)
+        {
+            frame.incremental = motionMask && _incrementalCount > 0 && !frame.needNormalization;
+            frame.changed = motionRegions;
+            _incrementalCount = _incrementalPeriod ? (frame.incremental ? _incrementalCount + 1 : 1) % _incrementalPeriod : 0;
+        }
+
+        // Bilinear resizing spreads changes to neighboring pixels (and accumulates spreading when levels are resized from previous ones).
+        void EstimateIntegral(const Frame & frame, Level & level, size_t index)
+        {
+            if (frame.incremental && level.integral)
+            {
+                ptrdiff_t border = 2 + (_resizeFromPrevious ? 2 * index : 0);
+                Rects changed(frame.changed.size());
+                for (size_t i = 0; i < changed.size(); ++i)
+                    changed[i] = (frame.changed[i] / level.scale).AddBorder(border);
+                View empty;
+                Simd::IntegralUpdate(level.src, changed, level.sum, level.needSqsum ? level.sqsum : empty, level.needTilted ? level.tilted : empty);
+            }
+            else
+                EstimateIntegral(level);
+            level.integral = true;
         }
 
         void EstimateIntegral(Level & level)        
@@ -454,6 +1147,23 @@ namespace Simd
             Simd::OperationBinary8u(level.mask, level.roi, level.mask, SimdOperationBinary8uAnd);
         }
 
+        void AddObjects(Frame & frame)
+        {
+            frame.candidates.clear();
+            for (size_t i = 0; i < frame.levels.size(); ++i)
+            {
+                Level & level = frame.levels[i];
+                if (level.area.Empty())
+                    continue;
+                for (size_t j = 0; j < level.hids.size(); ++j)
+                {
+                    Hid & hid = level.hids[j];
+                    AddObjects(frame.candidates, hid.dst, level.area, hid.data->size, level.scale,
+                        level.throughColumn ? 2 : 1, hid.data->tag);
+                }
+            }
+        }
+
         void AddObjects(Objects & objects, const View & dst, const Rect & rect, const Size & size, double scale, size_t step, Tag tag)
         {
             Size s = dst.Size() - size;
@@ -489,78 +1199,88 @@ namespace Simd
             double _sizeDifferenceMax;
         };
 
-        template<typename T> int Partition(const std::vector<T> & vec, std::vector<int> & labels, double sizeDifferenceMax)
+        static int Root(std::vector<int> & parents, int i)
         {
-            Similar similar(sizeDifferenceMax);
-            int i, j, N = (int)vec.size();
-            const int PARENT = 0;
-            const int RANK = 1;
-
-            std::vector<int> _nodes(N * 2);
-            int(*nodes)[2] = (int(*)[2])&_nodes[0];
+            while (parents[i] != i)
+                i = parents[i] = parents[parents[i]];
+            return i;
+        }
 
-            for (i = 0; i < N; i++)
+        // Candidates are bucketed in a grid by their top-left corners, so only candidates from neighboring cells are compared.
+        int Partition(const Objects & objects, std::vector<int> & labels, double sizeDifferenceMax)
+        {
+            Similar similar(sizeDifferenceMax);
+            int N = (int)objects.size();
+            if (N == 0)
             {
-                nodes[i][PARENT] = -1;
-                nodes[i][RANK] = 0;
+                labels.clear();
+                return 0;
             }
 
-            for (i = 0; i < N; i++)
+            std::vector<double> reaches(N);
+            Rect bound;
+            double cell = 0;
+            for (int i = 0; i < N; ++i)
             {
-                int root = i;
-                while (nodes[root][PARENT] >= 0)
-                    root = nodes[root][PARENT];
+                const Rect & r = objects[i].rect;
+                reaches[i] = sizeDifferenceMax*(r.Width() + r.Height())*0.5;
+                cell += reaches[i];
+                bound |= r.TopLeft();
+            }
+            cell = std::max(cell / N, std::sqrt(double(bound.Area()) / (4.0 * N)));
+            cell = std::max(cell, 1.0);
+            ptrdiff_t cols = ptrdiff_t(bound.Width() / cell) + 1, rows = ptrdiff_t(bound.Height() / cell) + 1;
 
-                for (j = 0; j < N; j++)
-                {
-                    if (i == j || !similar(vec[i], vec[j]))
-                        continue;
-                    int root2 = j;
+            std::vector<int> offsets(cols*rows + 1, 0), indexes(N), cells(N);
+            for (int i = 0; i < N; ++i)
+            {
+                const Rect & r = objects[i].rect;
+                cells[i] = int(ptrdiff_t((r.top - bound.top) / cell)*cols + ptrdiff_t((r.left - bound.left) / cell));
+                offsets[cells[i] + 1]++;
+            }
+            for (size_t c = 1; c < offsets.size(); ++c)
+                offsets[c] += offsets[c - 1];
+            std::vector<int> fill(offsets.begin(), offsets.end() - 1);
+            for (int i = 0; i < N; ++i)
+                indexes[fill[cells[i]]++] = i;
 
-                    while (nodes[root2][PARENT] >= 0)
-                        root2 = nodes[root2][PARENT];
+            std::vector<int> parents(N);
+            for (int i = 0; i < N; ++i)
+                parents[i] = i;
 
-                    if (root2 != root)
+            for (int i = 0; i < N; ++i)
+            {
+                const Rect & r = objects[i].rect;
+                ptrdiff_t x0 = std::max<ptrdiff_t>(ptrdiff_t(std::floor((r.left - bound.left - reaches[i]) / cell)), 0);
+                ptrdiff_t x1 = std::min<ptrdiff_t>(ptrdiff_t(std::floor((r.left - bound.left + reaches[i]) / cell)), cols - 1);
+                ptrdiff_t y0 = std::max<ptrdiff_t>(ptrdiff_t(std::floor((r.top - bound.top - reaches[i]) / cell)), 0);
+                ptrdiff_t y1 = std::min<ptrdiff_t>(ptrdiff_t(std::floor((r.top - bound.top + reaches[i]) / cell)), rows - 1);
+                for (ptrdiff_t y = y0; y <= y1; ++y)
+                {
+                    for (ptrdiff_t x = x0; x <= x1; ++x)
                     {
-                        int rank = nodes[root][RANK], rank2 = nodes[root2][RANK];
-                        if (rank > rank2)
-                            nodes[root2][PARENT] = root;
-                        else
+                        for (int c = offsets[y*cols + x], end = offsets[y*cols + x + 1]; c < end; ++c)
                         {
-                            nodes[root][PARENT] = root2;
-                            nodes[root2][RANK] += rank == rank2;
-                            root = root2;
-                        }
-                        assert(nodes[root][PARENT] < 0);
-
-                        int k = j, parent;
-                        while ((parent = nodes[k][PARENT]) >= 0)
-                        {
-                            nodes[k][PARENT] = root;
-                            k = parent;
-                        }
-
-                        k = i;
-                        while ((parent = nodes[k][PARENT]) >= 0)
-                        {
-                            nodes[k][PARENT] = root;
-                            k = parent;
+                            int j = indexes[c];
+                            if (j <= i || !similar(objects[i], objects[j]))
+                                continue;
+                            int root = Root(parents, i), root2 = Root(parents, j);
+                            if (root != root2)
+                                parents[std::max(root, root2)] = std::min(root, root2);
                         }
                     }
                 }
             }
 
             labels.resize(N);
+            std::vector<int> classes(N, -1);
             int nclasses = 0;
-
-            for (i = 0; i < N; i++)
+            for (int i = 0; i < N; ++i)
             {
-                int root = i;
-                while (nodes[root][PARENT] >= 0)
-                    root = nodes[root][PARENT];
-                if (nodes[root][RANK] >= 0)
-                    nodes[root][RANK] = ~nclasses++;
-                labels[i] = ~nodes[root][RANK];
+                int root = Root(parents, i);
+                if (classes[root] < 0)
+                    classes[root] = nclasses++;
+                labels[i] = classes[root];
             }
 
             return nclasses;
@@ -587,6 +1307,12 @@ namespace Simd
             for (size_t i = 0; i < buffer.size(); i++)
                 buffer[i].rect = buffer[i].rect / double(buffer[i].weight);
 
+            if (_overlapMax > 0)
+            {
+                SuppressObjects(dst, buffer, groupSizeMin);
+                return;
+            }
+
             for (size_t i = 0; i < buffer.size(); i++)
             {
                 Rect r1 = buffer[i].rect;
@@ -617,6 +1343,35 @@ namespace Simd
                     dst.push_back(buffer[i]);
             }
         }
+
+        static bool Heavier(const Object & o1, const Object & o2)
+        {
+            return o1.weight > o2.weight;
+        }
+
+        static double Overlap(const Rect & r1, const Rect & r2)
+        {
+            double intersection = double(r1.Intersection(r2).Area());
+            double area = double(r1.Area()) + double(r2.Area()) - intersection;
+            return area > 0 ? intersection / area : 0;
+        }
+
+        void SuppressObjects(Objects & dst, Objects & groups, size_t groupSizeMin)
+        {
+            std::stable_sort(groups.begin(), groups.end(), Heavier);
+            size_t begin = dst.size();
+            for (size_t i = 0; i < groups.size() && groups[i].weight >= (int)groupSizeMin; ++i)
+            {
+                size_t j = begin;
+                for (; j < dst.size(); ++j)
+                {
+                    if (Overlap(groups[i].rect, dst[j].rect) > _overlapMax)
+                        break;
+                }
+                if (j == dst.size())
+                    dst.push_back(groups[i]);
+            }
+        }
 	};
 }
 
@@ -0,0 +1,242 @@
+/*
+* Simd Library (http://simd.sourceforge.net).
+*
+* Copyright (c) 2011-2017 Yermalayeu Ihar.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+#ifndef __SimdFilter2D_h__
+#define __SimdFilter2D_h__
+
+#include "Simd/SimdMemory.h"
+
+#include <vector>
+
+namespace Simd
+{
+    namespace Base
+    {
+        /*
+        * Prepared weights of Filter2D kernel.
+        * If the kernel is separable (it is equal to outer product col*row) then row and col are used, else full.
+        * 16-bit weights are used for 8-bit images (fixed point arithmetic). They are padded to even count in every row
+        * (pairs of weights for _mm_madd_epi16). 8-bit separable filter: the horizontal pass shifts its sums by shiftH
+        * (to fit 16-bit integer), the vertical pass shifts by shift.
+        * If separable weights are small integers multiplied by powers of 2 (binomial kernels for example), these powers are
+        * reduced (that gives exactly the same result) and small is set: row16 fit 8-bit integer, shiftH is 0 and
+        * all sums of both passes fit 16-bit integer.
+        */
+        struct Filter2DKernel
+        {
+            size_t size, half, pairs;
+            bool separable, small;
+            int shift, shiftH;
+            float * full, * row, * col;
+            int16_t * full16, * row16, * col16;
+
+            Filter2DKernel(const float * kernel, size_t size);
+
+            ~Filter2DKernel()
+            {
+                Free(_p);
+            }
+
+        private:
+            void * _p;
+        };
+
+        SIMD_INLINE ptrdiff_t Filter2DIndex(ptrdiff_t index, ptrdiff_t size, SimdBorderType border)
+        {
+            if (index >= 0 && index < size)
+                return index;
+            switch (border)
+            {
+            case SimdBorderReplicate:
+                return index < 0 ? 0 : size - 1;
+            case SimdBorderMirror:
+                return Simd::RestrictRange<ptrdiff_t>(index < 0 ? -index : 2 * size - 2 - index, 0, size - 1);
+            default:
+                return -1;
+            }
+        }
+
+        template <class S, class D> SIMD_INLINE void Filter2DPadRow(const S * src, size_t width, size_t half, SimdBorderType border, D * dst)
+        {
+            for (size_t i = 0; i < half; ++i)
+            {
+                ptrdiff_t left = Filter2DIndex(ptrdiff_t(i) - ptrdiff_t(half), width, border);
+                ptrdiff_t right = Filter2DIndex(width + i, width, border);
+                dst[i] = left < 0 ? D(0) : D(src[left]);
+                dst[half + width + i] = right < 0 ? D(0) : D(src[right]);
+            }
+            for (size_t x = 0; x < width; ++x)
+                dst[half + x] = D(src[x]);
+        }
+
+        template <class T> SIMD_INLINE void Filter2DPadRow(const T * src, size_t width, size_t half, SimdBorderType border, T * dst)
+        {
+            for (size_t i = 0; i < half; ++i)
+            {
+                ptrdiff_t left = Filter2DIndex(ptrdiff_t(i) - ptrdiff_t(half), width, border);
+                ptrdiff_t right = Filter2DIndex(width + i, width, border);
+                dst[i] = left < 0 ? T(0) : src[left];
+                dst[half + width + i] = right < 0 ? T(0) : src[right];
+            }
+            memcpy(dst + half, src, width*sizeof(T));
+        }
+
+        template <class T> class Filter2DRing
+        {
+        public:
+            SIMD_INLINE Filter2DRing(size_t count, size_t width)
+                : _count(count)
+                , _stride(AlignHi(width + SIMD_ALIGN, SIMD_ALIGN))
+                , _index(count, -1)
+            {
+                _rows = (T*)Allocate((count + 1)*_stride*sizeof(T));
+                _zero = _rows + count*_stride;
+                memset(_zero, 0, _stride*sizeof(T));
+            }
+
+            SIMD_INLINE ~Filter2DRing()
+            {
+                Free(_rows);
+            }
+
+            // Returns a buffer for row with given index (zero row for negative index). Sets fresh if the buffer has to be filled.
+            SIMD_INLINE T * Get(ptrdiff_t index, bool & fresh)
+            {
+                fresh = false;
+                if (index < 0)
+                    return _zero;
+                size_t slot = index%_count;
+                if (_index[slot] != index)
+                {
+                    _index[slot] = index;
+                    fresh = true;
+                }
+                return _rows + slot*_stride;
+            }
+
+        private:
+            size_t _count, _stride;
+            std::vector<ptrdiff_t> _index;
+            T * _rows, * _zero;
+        };
+
+        /*
+        * Generic driver of Filter2D: it performs border extrapolation and caching of source rows and calls row filters of F:
+        *   F::Direct8u, F::Hor8u, F::Ver8u - for 8-bit gray images;
+        *   F::Hor8uSmall, F::Ver8uSmall - for 8-bit gray images and kernel with small weights (16-bit arithmetic is enough);
+        *   F::Direct32f, F::Hor32f, F::Ver32f, F::Convert32fTo16i - for 16-bit integer and 32-bit float images.
+        */
+        template <class F> void Filter2DRun(const uint8_t * src, size_t srcStride, size_t width, size_t height, SimdPixelFormatType format,
+            const float * weights, size_t size, SimdBorderType border, uint8_t * dst, size_t dstStride)
+        {
+            Filter2DKernel kernel(weights, size);
+            size_t half = kernel.half, padded = width + 2 * half;
+            bool fresh;
+            if (format == SimdPixelFormatGray8)
+            {
+                if (kernel.separable)
+                {
+                    Filter2DRing<int16_t> ring(size, width);
+                    Filter2DRing<uint8_t> buffer(1, padded);
+                    uint8_t * tmp = buffer.Get(0, fresh);
+                    std::vector<const int16_t*> rows(kernel.pairs);
+                    for (size_t y = 0; y < height; ++y)
+                    {
+                        for (size_t ky = 0; ky < size; ++ky)
+                        {
+                            ptrdiff_t sy = Filter2DIndex(ptrdiff_t(y + ky) - ptrdiff_t(half), height, border);
+                            int16_t * row = ring.Get(sy, fresh);
+                            if (fresh)
+                            {
+                                Filter2DPadRow(src + sy*srcStride, width, half, border, tmp);
+                                if (kernel.small)
+                                    F::Hor8uSmall(tmp, kernel.row16, size, width, row);
+                                else
+                                    F::Hor8u(tmp, kernel.row16, size, width, kernel.shiftH, row);
+                            }
+                            rows[ky] = row;
+                        }
+                        rows[kernel.pairs - 1] = rows[size - 1];
+                        if (kernel.small)
+                            F::Ver8uSmall(&rows[0], kernel.col16, size, width, kernel.shift, dst + y*dstStride);
+                        else
+                            F::Ver8u(&rows[0], kernel.col16, size, width, kernel.shift, dst + y*dstStride);
+                    }
+                }
+                else
+                {
+                    Filter2DRing<uint8_t> ring(size, padded);
+                    std::vector<const uint8_t*> rows(size);
+                    for (size_t y = 0; y < height; ++y)
+                    {
+                        for (size_t ky = 0; ky < size; ++ky)
+                        {
+                            ptrdiff_t sy = Filter2DIndex(ptrdiff_t(y + ky) - ptrdiff_t(half), height, border);
+                            uint8_t * row = ring.Get(sy, fresh);
+                            if (fresh)
+                                Filter2DPadRow(src + sy*srcStride, width, half, border, row);
+                            rows[ky] = row;
+                        }
+                        F::Direct8u(&rows[0], kernel.full16, size, width, kernel.shift, dst + y*dstStride);
+                    }
+                }
+            }
+            else
+            {
+                assert(format == SimdPixelFormatInt16 || format == SimdPixelFormatFloat);
+                Filter2DRing<float> ring(size, kernel.separable ? width : padded);
+                Filter2DRing<float> buffer(2, padded);
+                float * tmp = buffer.Get(0, fresh), * out = buffer.Get(1, fresh);
+                std::vector<const float*> rows(size);
+                for (size_t y = 0; y < height; ++y)
+                {
+                    for (size_t ky = 0; ky < size; ++ky)
+                    {
+                        ptrdiff_t sy = Filter2DIndex(ptrdiff_t(y + ky) - ptrdiff_t(half), height, border);
+                        float * row = ring.Get(sy, fresh);
+                        if (fresh)
+                        {
+                            float * pad = kernel.separable ? tmp : row;
+                            if (format == SimdPixelFormatInt16)
+                                Filter2DPadRow((const int16_t*)(src + sy*srcStride), width, half, border, pad);
+                            else
+                                Filter2DPadRow((const float*)(src + sy*srcStride), width, half, border, pad);
+                            if (kernel.separable)
+                                F::Hor32f(tmp, kernel.row, size, width, row);
+                        }
+                        rows[ky] = row;
+                    }
+                    float * dstRow = format == SimdPixelFormatFloat ? (float*)(dst + y*dstStride) : out;
+                    if (kernel.separable)
+                        F::Ver32f(&rows[0], kernel.col, size, width, dstRow);
+                    else
+                        F::Direct32f(&rows[0], kernel.full, size, width, dstRow);
+                    if (format == SimdPixelFormatInt16)
+                        F::Convert32fTo16i(out, width, (int16_t*)(dst + y*dstStride));
+                }
+            }
+        }
+    }
+}
+
+#endif//__SimdFilter2D_h__
@@ -0,0 +1,167 @@
+/*
+* Simd Library (http://simd.sourceforge.net).
+*
+* Copyright (c) 2011-2017 Yermalayeu Ihar.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+#ifndef __SimdGemm_h__
+#define __SimdGemm_h__
+
+#include "Simd/SimdMath.h"
+
+namespace Simd
+{
+    namespace Base
+    {
+        const size_t GEMM_M_BLOCK = 4;
+        const size_t GEMM_N_BLOCK = 128;
+        const size_t GEMM_K_BLOCK = 256;
+
+        /*
+        * Generic driver of Gemm32fNN: C = alpha*A*B + beta*C (all matrices are row-major).
+        * It scales C by beta and splits the product into blocks: a GEMM_K_BLOCK x GEMM_N_BLOCK panel of B stays in L2 cache
+        * while it is multiplied by all rows of A. F::Kernel accumulates alpha*A*B for block of (M <= GEMM_M_BLOCK) rows and N columns.
+        * A and B are not packed: kernels read them in place with use of their leading dimensions.
+        */
+        template <class F> void Gemm32fNNRun(size_t M, size_t N, size_t K, float alpha, const float * A, size_t lda,
+            const float * B, size_t ldb, float beta, float * C, size_t ldc)
+        {
+            if (beta != 1.0f)
+            {
+                for (size_t i = 0; i < M; ++i)
+                {
+                    float * c = C + i*ldc;
+                    if (beta == 0.0f)
+                        memset(c, 0, N * sizeof(float));
+                    else
+                        for (size_t j = 0; j < N; ++j)
+                            c[j] *= beta;
+                }
+            }
+            for (size_t k = 0; k < K; k += GEMM_K_BLOCK)
+            {
+                size_t kb = std::min(K - k, GEMM_K_BLOCK);
+                for (size_t j = 0; j < N; j += GEMM_N_BLOCK)
+                {
+                    size_t nb = std::min(N - j, GEMM_N_BLOCK);
+                    for (size_t i = 0; i < M; i += GEMM_M_BLOCK)
+                        F::Kernel(std::min(M - i, GEMM_M_BLOCK), nb, kb, alpha, A + i*lda + k, lda, B + k*ldb + j, ldb, C + i*ldc + j, ldc);
+                }
+            }
+        }
+    }
+
+#ifdef SIMD_AVX_ENABLE
+    namespace Avx
+    {
+        /*
+        * Micro-kernels of Gemm32fNN which are shared by AVX and AVX2 implementations. 
+        * MA::MulAdd(a, b, c) returns a*b + c (separate multiplication and addition for AVX, FMA for AVX2).
+        */
+        SIMD_INLINE __m256i GemmTailMask(size_t tail)
+        {
+            const int32_t mask[DF] = { -1, -1, -1, -1, -1, -1, -1, -1, 0, 0, 0, 0, 0, 0, 0, 0 };
+            return _mm256_loadu_si256((__m256i*)(mask + F - tail));
+        }
+
+        template <class MA, size_t M> SIMD_INLINE void GemmKernel2F(size_t K, const __m256 & alpha, const float * A, size_t lda, const float * B, size_t ldb, float * C, size_t ldc)
+        {
+            __m256 c[M][2];
+            for (size_t i = 0; i < M; ++i)
+                c[i][0] = _mm256_setzero_ps(), c[i][1] = _mm256_setzero_ps();
+            for (size_t k = 0; k < K; ++k)
+            {
+                __m256 b0 = _mm256_loadu_ps(B + k*ldb + 0);
+                __m256 b1 = _mm256_loadu_ps(B + k*ldb + F);
+                for (size_t i = 0; i < M; ++i)
+                {
+                    __m256 a = _mm256_set1_ps(A[i*lda + k]);
+                    c[i][0] = MA::MulAdd(a, b0, c[i][0]);
+                    c[i][1] = MA::MulAdd(a, b1, c[i][1]);
+                }
+            }
+            for (size_t i = 0; i < M; ++i)
+            {
+                _mm256_storeu_ps(C + i*ldc + 0, MA::MulAdd(alpha, c[i][0], _mm256_loadu_ps(C + i*ldc + 0)));
+                _mm256_storeu_ps(C + i*ldc + F, MA::MulAdd(alpha, c[i][1], _mm256_loadu_ps(C + i*ldc + F)));
+            }
+        }
+
+        template <class MA, size_t M> SIMD_INLINE void GemmKernel1F(size_t K, const __m256 & alpha, const float * A, size_t lda, const float * B, size_t ldb, float * C, size_t ldc)
+        {
+            __m256 c[M];
+            for (size_t i = 0; i < M; ++i)
+                c[i] = _mm256_setzero_ps();
+            for (size_t k = 0; k < K; ++k)
+            {
+                __m256 b0 = _mm256_loadu_ps(B + k*ldb);
+                for (size_t i = 0; i < M; ++i)
+                    c[i] = MA::MulAdd(_mm256_set1_ps(A[i*lda + k]), b0, c[i]);
+            }
+            for (size_t i = 0; i < M; ++i)
+                _mm256_storeu_ps(C + i*ldc, MA::MulAdd(alpha, c[i], _mm256_loadu_ps(C + i*ldc)));
+        }
+
+        template <class MA, size_t M> SIMD_INLINE void GemmKernelTail(size_t K, const __m256 & alpha, const float * A, size_t lda, const float * B, size_t ldb, float * C, size_t ldc, __m256i tail)
+        {
+            __m256 c[M];
+            for (size_t i = 0; i < M; ++i)
+                c[i] = _mm256_setzero_ps();
+            for (size_t k = 0; k < K; ++k)
+            {
+                __m256 b0 = _mm256_maskload_ps(B + k*ldb, tail);
+                for (size_t i = 0; i < M; ++i)
+                    c[i] = MA::MulAdd(_mm256_set1_ps(A[i*lda + k]), b0, c[i]);
+            }
+            for (size_t i = 0; i < M; ++i)
+                _mm256_maskstore_ps(C + i*ldc, tail, MA::MulAdd(alpha, c[i], _mm256_maskload_ps(C + i*ldc, tail)));
+        }
+
+        template <class MA, size_t M> void GemmKernel(size_t N, size_t K, float alpha, const float * A, size_t lda, const float * B, size_t ldb, float * C, size_t ldc)
+        {
+            __m256 _alpha = _mm256_set1_ps(alpha);
+            size_t j = 0;
+            for (; j + DF <= N; j += DF)
+                GemmKernel2F<MA, M>(K, _alpha, A, lda, B + j, ldb, C + j, ldc);
+            for (; j + F <= N; j += F)
+                GemmKernel1F<MA, M>(K, _alpha, A, lda, B + j, ldb, C + j, ldc);
+            if (j < N)
+                GemmKernelTail<MA, M>(K, _alpha, A, lda, B + j, ldb, C + j, ldc, GemmTailMask(N - j));
+        }
+
+        template <class MA> struct Gemm32fNNKernels
+        {
+            static void Kernel(size_t M, size_t N, size_t K, float alpha, const float * A, size_t lda, const float * B, size_t ldb, float * C, size_t ldc)
+            {
+                switch (M)
+                {
+                case 1: GemmKernel<MA, 1>(N, K, alpha, A, lda, B, ldb, C, ldc); break;
+                case 2: GemmKernel<MA, 2>(N, K, alpha, A, lda, B, ldb, C, ldc); break;
+                case 3: GemmKernel<MA, 3>(N, K, alpha, A, lda, B, ldb, C, ldc); break;
+                case 4: GemmKernel<MA, 4>(N, K, alpha, A, lda, B, ldb, C, ldc); break;
+                default: assert(0);
+                }
+            }
+        };
+    }
+#endif// SIMD_AVX_ENABLE
+}
+
+#endif//__SimdGemm_h__
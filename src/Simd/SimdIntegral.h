@@ -0,0 +1,58 @@
+/*
+* Simd Library (http://simd.sourceforge.net).
+*
+* Copyright (c) 2011-2017 Yermalayeu Ihar.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+#ifndef __SimdIntegral_h__
+#define __SimdIntegral_h__
+
+#include "Simd/SimdMemory.h"
+
+namespace Simd
+{
+    namespace Base
+    {
+        /*
+        * Integral image of (width + 1)x(height + 1) size: sum[y][x] is equal to sum of src[j][i] for i < x and j < y.
+        * Strides are given in elements.
+        */
+        template <class TSum, class TSrc> void IntegralSum(const TSrc * src, size_t srcStride, size_t width, size_t height, TSum * sum, size_t sumStride)
+        {
+            memset(sum, 0, (width + 1)*sizeof(TSum));
+            sum += sumStride + 1;
+
+            for(size_t row = 0; row < height; row++)
+            {
+                TSum rowSum = 0;
+                sum[-1] = 0;
+                for(size_t col = 0; col < width; col++)
+                {
+                    rowSum += src[col];
+                    sum[col] = rowSum + sum[col - sumStride];
+                }
+                src += srcStride;
+                sum += sumStride;
+            }
+        }
+    }
+}
+
+#endif//__SimdIntegral_h__
@@ -91,6 +91,16 @@ SIMD_API size_t SimdAlignment()
     return Simd::ALIGNMENT;
 }
 
+SIMD_API void * SimdMapFile(const char * path, size_t * size)
+{
+    return Base::MapFile(path, size);
+}
+
+SIMD_API void SimdUnmapFile(void * data, size_t size)
+{
+    Base::UnmapFile(data, size);
+}
+
 SIMD_API uint32_t SimdCrc32c(const void * src, size_t size)
 {
 #ifdef SIMD_SSE42_ENABLE
@@ -856,6 +866,17 @@ SIMD_API void SimdBgrToYuv444p(const uint8_t * bgr, size_t width, size_t height,
         Base::BgrToYuv444p(bgr, width, height, bgrStride, y, yStride, u, uStride, v, vStride);
 }
 
+SIMD_API void SimdBilateralFilter(const uint8_t * src, size_t srcStride, size_t width, size_t height, size_t channelCount,
+    size_t radius, float sigmaSpace, float sigmaRange, uint8_t * dst, size_t dstStride)
+{
+#ifdef SIMD_AVX2_ENABLE
+    if(Avx2::Enable && width >= Avx2::F)
+        Avx2::BilateralFilter(src, srcStride, width, height, channelCount, radius, sigmaSpace, sigmaRange, dst, dstStride);
+    else
+#endif
+        Base::BilateralFilter(src, srcStride, width, height, channelCount, radius, sigmaSpace, sigmaRange, dst, dstStride);
+}
+
 SIMD_API void SimdBinarization(const uint8_t * src, size_t srcStride, size_t width, size_t height,
                   uint8_t value, uint8_t positive, uint8_t negative, uint8_t * dst, size_t dstStride, SimdCompareType compareType)
 {
@@ -1148,6 +1169,16 @@ SIMD_API void * SimdDetectionLoadA(const char * path)
     return Base::DetectionLoadA(path);
 }
 
+SIMD_API int SimdDetectionSaveBinary(const void * data, const char * path)
+{
+    return Base::DetectionSaveBinary(data, path);
+}
+
+SIMD_API void * SimdDetectionLoadBinary(const char * path)
+{
+    return Base::DetectionLoadBinary(path);
+}
+
 SIMD_API void SimdDetectionInfo(const void * data, size_t * width, size_t * height, SimdDetectionInfoFlags * flags)
 {
     Base::DetectionInfo(data, width, height, flags);
@@ -1208,6 +1239,40 @@ SIMD_API void SimdDetectionHaarDetect32fi(const void * hid, const uint8_t * mask
         Base::DetectionHaarDetect32fi(hid, mask, maskStride, left, top, right, bottom, dst, dstStride);
 }
 
+SIMD_API void SimdDetectionHaarDetect16ip(const void * hid, const uint8_t * mask, size_t maskStride,
+    ptrdiff_t left, ptrdiff_t top, ptrdiff_t right, ptrdiff_t bottom, uint8_t * dst, size_t dstStride)
+{
+    size_t width = right - left;
+#ifdef SIMD_AVX2_ENABLE
+    if (Avx2::Enable && width >= Avx2::A)
+        Avx2::DetectionHaarDetect16ip(hid, mask, maskStride, left, top, right, bottom, dst, dstStride);
+    else
+#endif
+#ifdef SIMD_SSE41_ENABLE
+    if (Sse41::Enable && width >= Sse41::A)
+        Sse41::DetectionHaarDetect16ip(hid, mask, maskStride, left, top, right, bottom, dst, dstStride);
+    else
+#endif
+        Base::DetectionHaarDetect16ip(hid, mask, maskStride, left, top, right, bottom, dst, dstStride);
+}
+
+SIMD_API void SimdDetectionHaarDetect16ii(const void * hid, const uint8_t * mask, size_t maskStride,
+    ptrdiff_t left, ptrdiff_t top, ptrdiff_t right, ptrdiff_t bottom, uint8_t * dst, size_t dstStride)
+{
+    size_t width = right - left;
+#ifdef SIMD_AVX2_ENABLE
+    if (Avx2::Enable && width >= Avx2::A)
+        Avx2::DetectionHaarDetect16ii(hid, mask, maskStride, left, top, right, bottom, dst, dstStride);
+    else
+#endif
+#ifdef SIMD_SSE41_ENABLE
+    if (Sse41::Enable && width >= Sse41::A)
+        Sse41::DetectionHaarDetect16ii(hid, mask, maskStride, left, top, right, bottom, dst, dstStride);
+    else
+#endif
+        Base::DetectionHaarDetect16ii(hid, mask, maskStride, left, top, right, bottom, dst, dstStride);
+}
+
 SIMD_API void SimdDetectionLbpDetect32fp(const void * hid, const uint8_t * mask, size_t maskStride,
     ptrdiff_t left, ptrdiff_t top, ptrdiff_t right, ptrdiff_t bottom, uint8_t * dst, size_t dstStride)
 {
@@ -1296,6 +1361,17 @@ SIMD_API void SimdDetectionLbpDetect16ii(const void * hid, const uint8_t * mask,
         Base::DetectionLbpDetect16ii(hid, mask, maskStride, left, top, right, bottom, dst, dstStride);
 }
 
+SIMD_API size_t SimdDetectionStageNumber(const void * hid)
+{
+    return Base::DetectionStageNumber(hid);
+}
+
+SIMD_API void SimdDetectionCountStages(const void * hid, const uint8_t * mask, size_t maskStride,
+    ptrdiff_t left, ptrdiff_t top, ptrdiff_t right, ptrdiff_t bottom, size_t * counts)
+{
+    Base::DetectionCountStages(hid, mask, maskStride, left, top, right, bottom, counts);
+}
+
 SIMD_API void SimdDetectionFree(void * ptr)
 {
     Base::DetectionFree(ptr);
@@ -1544,6 +1620,22 @@ SIMD_API void SimdFillBgra(uint8_t * dst, size_t stride, size_t width, size_t he
         Base::FillBgra(dst, stride, width, height, blue, green, red, alpha);
 }
 
+SIMD_API void SimdFilter2D(const uint8_t * src, size_t srcStride, size_t width, size_t height, SimdPixelFormatType format,
+    const float * kernel, size_t size, SimdBorderType border, uint8_t * dst, size_t dstStride)
+{
+#ifdef SIMD_AVX2_ENABLE
+    if(Avx2::Enable && width >= Avx2::A)
+        Avx2::Filter2D(src, srcStride, width, height, format, kernel, size, border, dst, dstStride);
+    else
+#endif
+#ifdef SIMD_SSE2_ENABLE
+    if(Sse2::Enable && width >= Sse2::A)
+        Sse2::Filter2D(src, srcStride, width, height, format, kernel, size, border, dst, dstStride);
+    else
+#endif
+        Base::Filter2D(src, srcStride, width, height, format, kernel, size, border, dst, dstStride);
+}
+
 SIMD_API void SimdGaussianBlur3x3(const uint8_t * src, size_t srcStride, size_t width, size_t height,
                      size_t channelCount, uint8_t * dst, size_t dstStride)
 {
@@ -1575,6 +1667,16 @@ SIMD_API void SimdGaussianBlur3x3(const uint8_t * src, size_t srcStride, size_t
 		Base::GaussianBlur3x3(src, srcStride, width, height, channelCount, dst, dstStride);
 }
 
+typedef void(*SimdGemm32fNNPtr) (size_t M, size_t N, size_t K, const float * alpha, const float * A, size_t lda, 
+    const float * B, size_t ldb, const float * beta, float * C, size_t ldc);
+SimdGemm32fNNPtr simdGemm32fNN = SIMD_FUNC3(Gemm32fNN, SIMD_AVX2_FUNC, SIMD_AVX_FUNC, SIMD_SSE_FUNC);
+
+SIMD_API void SimdGemm32fNN(size_t M, size_t N, size_t K, const float * alpha, const float * A, size_t lda,
+    const float * B, size_t ldb, const float * beta, float * C, size_t ldc)
+{
+    simdGemm32fNN(M, N, K, alpha, A, lda, B, ldb, beta, C, ldc);
+}
+
 SIMD_API void SimdGrayToBgr(const uint8_t * gray, size_t width, size_t height, size_t grayStride, uint8_t * bgr, size_t bgrStride)
 {
 #ifdef SIMD_AVX2_ENABLE
@@ -1650,6 +1752,12 @@ SIMD_API void SimdAbsSecondDerivativeHistogram(const uint8_t *src, size_t width,
         Base::AbsSecondDerivativeHistogram(src, width, height, stride, step, indent, histogram);
 }
 
+SIMD_API void SimdGuidedFilter(const uint8_t * src, size_t srcStride, size_t width, size_t height, size_t channelCount,
+    size_t radius, float eps, uint8_t * dst, size_t dstStride)
+{
+    Base::GuidedFilter(src, srcStride, width, height, channelCount, radius, eps, dst, dstStride);
+}
+
 SIMD_API void SimdHistogram(const uint8_t *src, size_t width, size_t height, size_t stride, uint32_t * histogram)
 {
     Base::Histogram(src, width, height, stride, histogram);
@@ -1707,6 +1815,23 @@ SIMD_API void SimdNormalizeHistogram(const uint8_t * src, size_t srcStride, size
     Base::NormalizeHistogram(src, srcStride, width, height, dst, dstStride);
 }
 
+SIMD_API void SimdClaheLuts(const uint8_t * src, size_t srcStride, size_t width, size_t height, size_t tilesX, size_t tilesY,
+    float clipLimit, size_t tileRowBegin, size_t tileRowEnd, uint8_t * luts)
+{
+    Base::ClaheLuts(src, srcStride, width, height, tilesX, tilesY, clipLimit, tileRowBegin, tileRowEnd, luts);
+}
+
+SIMD_API void SimdClaheApply(const uint8_t * src, size_t srcStride, size_t width, size_t height, size_t tilesX, size_t tilesY,
+    const uint8_t * luts, size_t rowBegin, size_t rowEnd, uint8_t * dst, size_t dstStride)
+{
+#ifdef SIMD_AVX2_ENABLE
+    if(Avx2::Enable && width >= Avx2::F)
+        Avx2::ClaheApply(src, srcStride, width, height, tilesX, tilesY, luts, rowBegin, rowEnd, dst, dstStride);
+    else
+#endif//SIMD_AVX2_ENABLE
+        Base::ClaheApply(src, srcStride, width, height, tilesX, tilesY, luts, rowBegin, rowEnd, dst, dstStride);
+}
+
 SIMD_API void SimdHogDirectionHistograms(const uint8_t * src, size_t stride, size_t width, size_t height, 
                                          size_t cellX, size_t cellY, size_t quantization, float * histograms)
 {
@@ -1760,6 +1885,13 @@ SIMD_API void SimdIntegral(const uint8_t * src, size_t srcStride, size_t width,
     Base::Integral(src, srcStride, width, height, sum, sumStride, sqsum, sqsumStride, tilted, tiltedStride, sumFormat, sqsumFormat);
 }
 
+SIMD_API void SimdIntegralUpdate(const uint8_t * src, size_t srcStride, size_t width, size_t height, const ptrdiff_t * rects, size_t rectNumber,
+                      uint8_t * sum, size_t sumStride, uint8_t * sqsum, size_t sqsumStride, uint8_t * tilted, size_t tiltedStride,
+                      SimdPixelFormatType sumFormat, SimdPixelFormatType sqsumFormat)
+{
+    Base::IntegralUpdate(src, srcStride, width, height, rects, rectNumber, sum, sumStride, sqsum, sqsumStride, tilted, tiltedStride, sumFormat, sqsumFormat);
+}
+
 SIMD_API void SimdInterferenceIncrement(uint8_t * statistic, size_t stride, size_t width, size_t height, uint8_t increment, int16_t saturation)
 {
 #ifdef SIMD_AVX2_ENABLE
@@ -2293,6 +2425,16 @@ SIMD_API void SimdNeuralAdaptiveGradientUpdate(const float * delta, size_t size,
     simdNeuralAdaptiveGradientUpdate(delta, size, batch, alpha, epsilon, gradient, weight);
 }
 
+typedef void(*SimdNeuralAdamUpdatePtr) (const float * delta, size_t size, size_t batch, const float * alpha, const float * beta1, const float * beta2, 
+    const float * epsilon, const float * decay, float * moment1, float * moment2, float * weight);
+SimdNeuralAdamUpdatePtr simdNeuralAdamUpdate = SIMD_FUNC2(NeuralAdamUpdate, SIMD_AVX_FUNC, SIMD_SSE_FUNC);
+
+SIMD_API void SimdNeuralAdamUpdate(const float * delta, size_t size, size_t batch, const float * alpha, const float * beta1, const float * beta2,
+    const float * epsilon, const float * decay, float * moment1, float * moment2, float * weight)
+{
+    simdNeuralAdamUpdate(delta, size, batch, alpha, beta1, beta2, epsilon, decay, moment1, moment2, weight);
+}
+
 SIMD_API void SimdNeuralAddConvolution3x3(const float * src, size_t srcStride, size_t width, size_t height, const float * weights, float * dst, size_t dstStride)
 {
 #ifdef SIMD_AVX_ENABLE
@@ -2414,6 +2556,79 @@ SIMD_API void SimdNeuralAddConvolution5x5Sum(const float * src, size_t srcStride
         Base::NeuralAddConvolution5x5Sum(src, srcStride, dst, dstStride, width, height, sums);
 }
 
+typedef void(*SimdNeuralConvolutionForwardPtr) (const float * src, size_t srcWidth, size_t srcHeight, size_t srcDepth, const float * weight,
+    size_t kernelX, size_t kernelY, size_t padX, size_t padY, size_t strideX, size_t strideY, size_t dilationX, size_t dilationY,
+    void * buffer, size_t * size, float * dst, size_t dstWidth, size_t dstHeight, size_t dstDepth, int add);
+SimdNeuralConvolutionForwardPtr simdNeuralConvolutionForward = SIMD_FUNC3(NeuralConvolutionForward, SIMD_AVX2_FUNC, SIMD_AVX_FUNC, SIMD_SSE_FUNC);
+
+SIMD_API void SimdNeuralConvolutionForward(const float * src, size_t srcWidth, size_t srcHeight, size_t srcDepth, const float * weight,
+    size_t kernelX, size_t kernelY, size_t padX, size_t padY, size_t strideX, size_t strideY, size_t dilationX, size_t dilationY,
+    void * buffer, size_t * size, float * dst, size_t dstWidth, size_t dstHeight, size_t dstDepth, int add)
+{
+    simdNeuralConvolutionForward(src, srcWidth, srcHeight, srcDepth, weight, kernelX, kernelY, padX, padY, strideX, strideY, dilationX, dilationY, buffer, size, dst, dstWidth, dstHeight, dstDepth, add);
+}
+
+typedef void(*SimdNeuralConvolutionBackwardPtr) (const float * src, size_t srcWidth, size_t srcHeight, size_t srcDepth, const float * weight,
+    size_t kernelX, size_t kernelY, size_t padX, size_t padY, size_t strideX, size_t strideY, size_t dilationX, size_t dilationY,
+    void * buffer, size_t * size, float * dst, size_t dstWidth, size_t dstHeight, size_t dstDepth, int add);
+SimdNeuralConvolutionBackwardPtr simdNeuralConvolutionBackward = SIMD_FUNC3(NeuralConvolutionBackward, SIMD_AVX2_FUNC, SIMD_AVX_FUNC, SIMD_SSE_FUNC);
+
+SIMD_API void SimdNeuralConvolutionBackward(const float * src, size_t srcWidth, size_t srcHeight, size_t srcDepth, const float * weight,
+    size_t kernelX, size_t kernelY, size_t padX, size_t padY, size_t strideX, size_t strideY, size_t dilationX, size_t dilationY,
+    void * buffer, size_t * size, float * dst, size_t dstWidth, size_t dstHeight, size_t dstDepth, int add)
+{
+    simdNeuralConvolutionBackward(src, srcWidth, srcHeight, srcDepth, weight, kernelX, kernelY, padX, padY, strideX, strideY, dilationX, dilationY, buffer, size, dst, dstWidth, dstHeight, dstDepth, add);
+}
+
+typedef void(*SimdNeuralConvolutionSumPtr) (const float * src, size_t srcWidth, size_t srcHeight, size_t srcDepth, const float * dst, size_t dstWidth, size_t dstHeight, size_t dstDepth,
+    size_t kernelX, size_t kernelY, size_t padX, size_t padY, size_t strideX, size_t strideY, size_t dilationX, size_t dilationY,
+    void * buffer, size_t * size, float * sums);
+SimdNeuralConvolutionSumPtr simdNeuralConvolutionSum = SIMD_FUNC3(NeuralConvolutionSum, SIMD_AVX2_FUNC, SIMD_AVX_FUNC, SIMD_SSE_FUNC);
+
+SIMD_API void SimdNeuralConvolutionSum(const float * src, size_t srcWidth, size_t srcHeight, size_t srcDepth, const float * dst, size_t dstWidth, size_t dstHeight, size_t dstDepth,
+    size_t kernelX, size_t kernelY, size_t padX, size_t padY, size_t strideX, size_t strideY, size_t dilationX, size_t dilationY,
+    void * buffer, size_t * size, float * sums)
+{
+    simdNeuralConvolutionSum(src, srcWidth, srcHeight, srcDepth, dst, dstWidth, dstHeight, dstDepth, kernelX, kernelY, padX, padY, strideX, strideY, dilationX, dilationY, buffer, size, sums);
+}
+
+SIMD_API void SimdNeuralWinograd2x2p3x3SetFilter(const float * src, size_t size, float * dst)
+{
+    Base::NeuralWinograd2x2p3x3SetFilter(src, size, dst);
+}
+
+typedef void(*SimdNeuralWinograd2x2p3x3SetInputPtr) (const float * src, size_t srcWidth, size_t srcHeight, size_t srcDepth, float * dst);
+SimdNeuralWinograd2x2p3x3SetInputPtr simdNeuralWinograd2x2p3x3SetInput = SIMD_FUNC2(NeuralWinograd2x2p3x3SetInput, SIMD_AVX_FUNC, SIMD_SSE_FUNC);
+
+SIMD_API void SimdNeuralWinograd2x2p3x3SetInput(const float * src, size_t srcWidth, size_t srcHeight, size_t srcDepth, float * dst)
+{
+    simdNeuralWinograd2x2p3x3SetInput(src, srcWidth, srcHeight, srcDepth, dst);
+}
+
+typedef void(*SimdNeuralWinograd2x2p3x3SetOutputPtr) (const float * src, float * dst, size_t dstWidth, size_t dstHeight, size_t dstDepth);
+SimdNeuralWinograd2x2p3x3SetOutputPtr simdNeuralWinograd2x2p3x3SetOutput = SIMD_FUNC2(NeuralWinograd2x2p3x3SetOutput, SIMD_AVX_FUNC, SIMD_SSE_FUNC);
+
+SIMD_API void SimdNeuralWinograd2x2p3x3SetOutput(const float * src, float * dst, size_t dstWidth, size_t dstHeight, size_t dstDepth)
+{
+    simdNeuralWinograd2x2p3x3SetOutput(src, dst, dstWidth, dstHeight, dstDepth);
+}
+
+typedef void(*SimdNeuralQuantize8uPtr) (const float * src, size_t size, const float * scale, const float * shift, uint8_t * dst);
+SimdNeuralQuantize8uPtr simdNeuralQuantize8u = SIMD_FUNC2(NeuralQuantize8u, SIMD_AVX2_FUNC, SIMD_SSE2_FUNC);
+
+SIMD_API void SimdNeuralQuantize8u(const float * src, size_t size, const float * scale, const float * shift, uint8_t * dst)
+{
+    simdNeuralQuantize8u(src, size, scale, shift, dst);
+}
+
+typedef void(*SimdNeuralProductSum8u8iPtr) (const uint8_t * src, const int8_t * weight, size_t size, size_t count, int32_t * sums);
+SimdNeuralProductSum8u8iPtr simdNeuralProductSum8u8i = SIMD_FUNC2(NeuralProductSum8u8i, SIMD_AVX2_FUNC, SIMD_SSSE3_FUNC);
+
+SIMD_API void SimdNeuralProductSum8u8i(const uint8_t * src, const int8_t * weight, size_t size, size_t count, int32_t * sums)
+{
+    simdNeuralProductSum8u8i(src, weight, size, count, sums);
+}
+
 SIMD_API void SimdNeuralMax2x2(const float * src, size_t srcStride, size_t width, size_t height, float * dst, size_t dstStride)
 {
 #ifdef SIMD_AVX_ENABLE
@@ -3046,6 +3261,38 @@ SIMD_API void SimdSobelDyAbsSum(const uint8_t * src, size_t stride, size_t width
 		Base::SobelDyAbsSum(src, stride, width, height, sum);
 }
 
+SIMD_API void SimdSobelGradient(const uint8_t * src, size_t srcStride, size_t width, size_t height, uint8_t * dx, size_t dxStride,
+    uint8_t * dy, size_t dyStride, uint8_t * magnitude, size_t magnitudeStride, size_t quantization, uint8_t * direction, size_t directionStride)
+{
+#ifdef SIMD_AVX2_ENABLE
+    if(Avx2::Enable && width > Avx2::A)
+        Avx2::SobelGradient(src, srcStride, width, height, dx, dxStride, dy, dyStride, magnitude, magnitudeStride, quantization, direction, directionStride);
+    else
+#endif
+#ifdef SIMD_SSE2_ENABLE
+    if(Sse2::Enable && width > Sse2::A)
+        Sse2::SobelGradient(src, srcStride, width, height, dx, dxStride, dy, dyStride, magnitude, magnitudeStride, quantization, direction, directionStride);
+    else
+#endif
+        Base::SobelGradient(src, srcStride, width, height, dx, dxStride, dy, dyStride, magnitude, magnitudeStride, quantization, direction, directionStride);
+}
+
+SIMD_API void SimdSobelGradient32f(const uint8_t * src, size_t srcStride, size_t width, size_t height,
+    uint8_t * magnitude, size_t magnitudeStride, uint8_t * direction, size_t directionStride)
+{
+#ifdef SIMD_AVX2_ENABLE
+    if(Avx2::Enable && width > Avx2::A)
+        Avx2::SobelGradient32f(src, srcStride, width, height, magnitude, magnitudeStride, direction, directionStride);
+    else
+#endif
+#ifdef SIMD_SSE2_ENABLE
+    if(Sse2::Enable && width > Sse2::A)
+        Sse2::SobelGradient32f(src, srcStride, width, height, magnitude, magnitudeStride, direction, directionStride);
+    else
+#endif
+        Base::SobelGradient32f(src, srcStride, width, height, magnitude, magnitudeStride, direction, directionStride);
+}
+
 SIMD_API void SimdContourMetrics(const uint8_t * src, size_t srcStride, size_t width, size_t height, uint8_t * dst, size_t dstStride)
 {
 #ifdef SIMD_AVX2_ENABLE
@@ -3252,6 +3499,17 @@ SIMD_API void SimdGetMoments(const uint8_t * mask, size_t stride, size_t width,
 		Base::GetMoments(mask, stride, width, height, index, area, x, y, xx, xy, yy);
 }
 
+SIMD_API void SimdGetImageStatistics(const uint8_t * src, size_t srcStride, size_t width, size_t height, const uint8_t * mask, size_t maskStride,
+    uint8_t index, uint32_t flags, size_t rowBegin, size_t rowEnd, SimdImageStatistics * statistics)
+{
+#ifdef SIMD_AVX2_ENABLE
+    if(Avx2::Enable && width > Avx2::A && width < SHRT_MAX)
+        Avx2::GetImageStatistics(src, srcStride, width, height, mask, maskStride, index, flags, rowBegin, rowEnd, statistics);
+    else
+#endif
+        Base::GetImageStatistics(src, srcStride, width, height, mask, maskStride, index, flags, rowBegin, rowEnd, statistics);
+}
+
 SIMD_API void SimdGetRowSums(const uint8_t * src, size_t stride, size_t width, size_t height, uint32_t * sums)
 {
 #ifdef SIMD_AVX2_ENABLE
@@ -179,6 +179,59 @@ typedef enum
     SimdDetectionInfoCanInt16 = 8,
 } SimdDetectionInfoFlags;
 
+/*! @ingroup c_types
+    Describes the way to extrapolate pixels outside of an image (see function ::SimdFilter2D).
+*/
+typedef enum
+{
+    /*! Border pixels are replicated: aaa|abcdefgh|hhh. */
+    SimdBorderReplicate,
+    /*! Border pixels are mirrored without repetition of the edge pixel: dcb|abcdefgh|gfe. */
+    SimdBorderMirror,
+    /*! Pixels outside of the image are equal to zero: 000|abcdefgh|000. */
+    SimdBorderZero,
+} SimdBorderType;
+
+/*! @ingroup c_types
+    Describes statistics calculated by function ::SimdGetImageStatistics. The flags can be combined.
+*/
+typedef enum
+{
+    /*! Minimal, maximal and average pixel values (fields min, max and average). Fields sum and squareSum are also filled. */
+    SimdImageStatisticsMinMax = 1,
+    /*! A sum and a sum of squares of pixel values (fields sum and squareSum). */
+    SimdImageStatisticsSums = 2,
+    /*! Moments of pixel positions (fields x, y, xx, xy and yy, see function ::SimdGetMoments). */
+    SimdImageStatisticsMoments = 4,
+    /*! A 256-bin histogram of pixel values (field histogram). */
+    SimdImageStatisticsHistogram = 8,
+    /*! A sum of absolute values of Laplace's filter (field laplaceAbsSum, see function ::SimdLaplaceAbsSum). It is a sharpness measure. */
+    SimdImageStatisticsLaplaceAbsSum = 16,
+    /*! All statistics. */
+    SimdImageStatisticsAll = 31,
+} SimdImageStatisticsFlags;
+
+/*! @ingroup c_types
+    Contains statistics of 8-bit gray image calculated by function ::SimdGetImageStatistics. 
+    Fields of statistics which were not requested are equal to zero. 
+*/
+typedef struct
+{
+    uint64_t count; /*!< A number of processed pixels (it is always calculated). */
+    uint8_t min; /*!< A minimal pixel value. */
+    uint8_t max; /*!< A maximal pixel value. */
+    uint8_t average; /*!< An average pixel value. */
+    uint64_t sum; /*!< A sum of pixel values. */
+    uint64_t squareSum; /*!< A sum of squared pixel values. */
+    uint64_t x; /*!< A first-order moment x (a sum of X coordinates of processed pixels). */
+    uint64_t y; /*!< A first-order moment y. */
+    uint64_t xx; /*!< A second-order moment xx. */
+    uint64_t xy; /*!< A second-order moment xy. */
+    uint64_t yy; /*!< A second-order moment yy. */
+    uint64_t laplaceAbsSum; /*!< A sum of absolute values of Laplace's filter. */
+    uint32_t histogram[256]; /*!< A histogram of pixel values. */
+} SimdImageStatistics;
+
 /*! @ingroup c_types
     Describes type of algorithm used for image reducing (downscale in 2 times) (see function Simd::ReduceGray).
 */
@@ -265,6 +318,37 @@ extern "C"
     */
     SIMD_API size_t SimdAlignment();
 
+    /*! @ingroup memory
+
+        \fn void * SimdMapFile(const char * path, size_t * size);
+
+        \short Maps file to memory for reading.
+
+        The file is mapped in read only shared mode: its pages are loaded on demand and are shared between all processes 
+        which map the same file. So data structures which are stored in the file in ready to use form can be used directly 
+        from the mapped memory without copying (see ::SimdDetectionLoadBinary and Simd::Neural::Network::LoadBinary).
+
+        \note The memory mapped by this function is must be released by function ::SimdUnmapFile.
+
+        \param [in] path - a path to the file.
+        \param [out] size - a pointer to the size of mapped memory (it is equal to size of the file).
+        \return a pointer to mapped memory. It is NULL if the file can't be opened or is empty.
+    */
+    SIMD_API void * SimdMapFile(const char * path, size_t * size);
+
+    /*! @ingroup memory
+
+        \fn void SimdUnmapFile(void * data, size_t size);
+
+        \short Releases memory mapped file.
+
+        \note This function releases a memory mapped by function ::SimdMapFile.
+
+        \param [in] data - a pointer to mapped memory.
+        \param [in] size - a size of mapped memory.
+    */
+    SIMD_API void SimdUnmapFile(void * data, size_t size);
+
     /*! @ingroup hash
 
         \fn uint32_t SimdCrc32c(const void * src, size_t size);
@@ -1121,6 +1205,39 @@ extern "C"
 	*/
     SIMD_API void SimdBgrToYuv444p(const uint8_t * bgr, size_t width, size_t height, size_t bgrStride, uint8_t * y, size_t yStride, uint8_t * u, size_t uStride, uint8_t * v, size_t vStride);
 
+    /*! @ingroup other_filter
+
+        \fn void SimdBilateralFilter(const uint8_t * src, size_t srcStride, size_t width, size_t height, size_t channelCount, size_t radius, float sigmaSpace, float sigmaRange, uint8_t * dst, size_t dstStride);
+
+        \short Performs bilateral (edge-preserving) filtration of the image.
+
+        For every point:
+        \verbatim
+        w[dx, dy] = exp(-(dx*dx + dy*dy)/(2*sigmaSpace*sigmaSpace))*exp(-d*d/(2*sigmaRange*sigmaRange));
+        dst[x, y] = sum(w[dx, dy]*src[x + dx, y + dy])/sum(w[dx, dy]), dx*dx + dy*dy <= radius*radius;
+        \endverbatim
+        where d is an absolute difference between src[x + dx, y + dy] and src[x, y] (for BGR image it is a mean of absolute differences of channels).
+        Border pixels of the image are replicated. The range weights are taken from precomputed table.
+        Sigmas which are not positive are clamped by minimal positive value (so zero sigmaRange means averaging of pixels equal to central one).
+
+        All images must have the same width, height and format (8-bit gray or 24-bit BGR).
+
+        \note This function has a C++ wrapper Simd::BilateralFilter(const View<A>& src, size_t radius, float sigmaSpace, float sigmaRange, View<A>& dst).
+
+        \param [in] src - a pointer to pixels data of source image.
+        \param [in] srcStride - a row size of the src image.
+        \param [in] width - an image width.
+        \param [in] height - an image height.
+        \param [in] channelCount - a channel count (1 or 3).
+        \param [in] radius - a radius of the filter window.
+        \param [in] sigmaSpace - a sigma of the spatial Gaussian. It must be positive.
+        \param [in] sigmaRange - a sigma of the range (intensity difference) Gaussian. It must be positive.
+        \param [out] dst - a pointer to pixels data of destination image.
+        \param [in] dstStride - a row size of the dst image.
+    */
+    SIMD_API void SimdBilateralFilter(const uint8_t * src, size_t srcStride, size_t width, size_t height, size_t channelCount,
+        size_t radius, float sigmaSpace, float sigmaRange, uint8_t * dst, size_t dstStride);
+
     /*! @ingroup binarization
 
         \fn void SimdBinarization(const uint8_t * src, size_t srcStride, size_t width, size_t height, uint8_t value, uint8_t positive, uint8_t negative, uint8_t * dst, size_t dstStride, SimdCompareType compareType);
@@ -1508,6 +1625,39 @@ extern "C"
     */
     SIMD_API void * SimdDetectionLoadA(const char * path);
 
+    /*! @ingroup object_detection
+
+        \fn int SimdDetectionSaveBinary(const void * data, const char * path);
+
+        \short Saves a classifier cascade to file in binary format.
+
+        The binary format is versioned and relocatable: it consists of a header and arrays of cascade data which are stored 
+        by offsets and aligned by 64 bytes. Such a file can be loaded by function ::SimdDetectionLoadBinary without parsing.
+
+        \param [in] data - a pointer to cascade which was received with using of function ::SimdDetectionLoadA or ::SimdDetectionLoadBinary.
+        \param [in] path - a path to output binary file.
+        \return 1 on success and 0 on error.
+    */
+    SIMD_API int SimdDetectionSaveBinary(const void * data, const char * path);
+
+    /*! @ingroup object_detection
+
+        \fn void * SimdDetectionLoadBinary(const char * path);
+
+        \short Loads a classifier cascade from binary file which was saved by function ::SimdDetectionSaveBinary.
+
+        The file is memory mapped in read only mode and the cascade refers to the mapped memory directly, 
+        so the file pages are shared between all processes which load the same file.
+        The file must not be modified until the cascade is released.
+
+        \note This function is used for implementation of Simd::Detection.
+
+        \param [in] path - a path to binary cascade.
+        \return a pointer to loaded cascade. On error it returns NULL. 
+                This pointer is used in functions ::SimdDetectionInfo and ::SimdDetectionInit, and must be released with using function ::SimdDetectionFree.
+    */
+    SIMD_API void * SimdDetectionLoadBinary(const char * path);
+
     /*! @ingroup object_detection
 
         \fn void SimdDetectionInfo(const void * data, size_t * width, size_t * height, SimdDetectionInfoFlags * flags);
@@ -1516,7 +1666,7 @@ extern "C"
 
         \note This function is used for implementation of Simd::Detection.
 
-        \param [in] data - a pointer to cascade which was received with using of function ::SimdDetectionLoadA. 
+        \param [in] data - a pointer to cascade which was received with using of function ::SimdDetectionLoadA or ::SimdDetectionLoadBinary. 
         \param [out] width - a pointer to returned width of cascade window.
         \param [out] height - a pointer to returned height of cascade window.
         \param [out] flags - a pointer to flags with other information (See ::SimdDetectionInfoFlags).
@@ -1531,7 +1681,7 @@ extern "C"
 
         \note This function is used for implementation of Simd::Detection.
 
-        \param [in] data - a pointer to cascade which was received with using of function ::SimdDetectionLoadA.
+        \param [in] data - a pointer to cascade which was received with using of function ::SimdDetectionLoadA or ::SimdDetectionLoadBinary.
         \param [in] sum - a pointer to pixels data of 32-bit integer image with integral sum of given input 8-bit gray image.
                           See function ::SimdIntegral in order to estimate this integral sum.
         \param [in] sumStride - a row size of the sum image.
@@ -1547,6 +1697,7 @@ extern "C"
         \param [in] int16 - a flag use for 16-bit integer version of detection algorithm. (See ::SimdDetectionInfo). 
         \return a pointer to hidden cascade. On error it returns NULL.
                 This pointer is used in functions ::SimdDetectionPrepare, ::SimdDetectionHaarDetect32fp, ::SimdDetectionHaarDetect32fi,
+                ::SimdDetectionHaarDetect16ip, ::SimdDetectionHaarDetect16ii,
                 ::SimdDetectionLbpDetect32fp, ::SimdDetectionLbpDetect32fi, ::SimdDetectionLbpDetect16ip and ::SimdDetectionLbpDetect16ii.
                 It must be released with using function ::SimdDetectionFree.
     */    
@@ -1560,6 +1711,7 @@ extern "C"
         \short Prepares hidden classifier cascade structure to work with given input 8-bit gray image. 
 
         You must call this function before calling of functions ::SimdDetectionHaarDetect32fp, ::SimdDetectionHaarDetect32fi,
+         ::SimdDetectionHaarDetect16ip, ::SimdDetectionHaarDetect16ii,
          ::SimdDetectionLbpDetect32fp, ::SimdDetectionLbpDetect32fi, ::SimdDetectionLbpDetect16ip and ::SimdDetectionLbpDetect16ii.
 
         \note This function is used for implementation of Simd::Detection.
@@ -1616,6 +1768,58 @@ extern "C"
     SIMD_API void SimdDetectionHaarDetect32fi(const void * hid, const uint8_t * mask, size_t maskStride,
         ptrdiff_t left, ptrdiff_t top, ptrdiff_t right, ptrdiff_t bottom, uint8_t * dst, size_t dstStride);
 
+    /*! @ingroup object_detection
+
+        \fn void SimdDetectionHaarDetect16ip(const void * hid, const uint8_t * mask, size_t maskStride, ptrdiff_t left, ptrdiff_t top, ptrdiff_t right, ptrdiff_t bottom, uint8_t * dst, size_t dstStride);
+
+        \short Performs object detection with using of HAAR cascade classifier (uses 16-bit integer numbers, processes all points).
+
+        Hidden cascade must be created with int16 flag (see ::SimdDetectionInit) for a cascade which supports it (see ::SimdDetectionInfo). 
+        Feature sums, thresholds and leaves are quantized, so the result can differ a little from result of function ::SimdDetectionHaarDetect32fp.
+        You must call function ::SimdDetectionPrepare before calling of this functions.
+        All restriction (input mask and bounding box) affects to left-top corner of scanning window.
+
+        \note This function is used for implementation of Simd::Detection.
+
+        \param [in] hid - a pointer to hidden cascade which was received with using of function ::SimdDetectionInit.
+        \param [in] mask - a pointer to pixels data of 8-bit image with mask. The mask restricts detection region.
+        \param [in] maskStride - a row size of the mask image.
+        \param [in] left - a left side of bounding box which restricts detection region.
+        \param [in] top - a top side of bounding box which restricts detection region.
+        \param [in] right - a right side of bounding box which restricts detection region.
+        \param [in] bottom - a bottom side of bounding box which restricts detection region.
+        \param [out] dst - a pointer to pixels data of 8-bit image with output result. None zero points refer to left-top corner of detected objects.
+        \param [in] dstStride - a row size of the dst image.
+    */
+    SIMD_API void SimdDetectionHaarDetect16ip(const void * hid, const uint8_t * mask, size_t maskStride,
+        ptrdiff_t left, ptrdiff_t top, ptrdiff_t right, ptrdiff_t bottom, uint8_t * dst, size_t dstStride);
+
+    /*! @ingroup object_detection
+
+        \fn void SimdDetectionHaarDetect16ii(const void * hid, const uint8_t * mask, size_t maskStride, ptrdiff_t left, ptrdiff_t top, ptrdiff_t right, ptrdiff_t bottom, uint8_t * dst, size_t dstStride);
+
+        \short Performs object detection with using of HAAR cascade classifier (uses 16-bit integer numbers, processes only even points).
+
+        Hidden cascade must be created with int16 flag (see ::SimdDetectionInit) for a cascade which supports it (see ::SimdDetectionInfo). 
+        Feature sums, thresholds and leaves are quantized, so the result can differ a little from result of function ::SimdDetectionHaarDetect32fi.
+        You must call function ::SimdDetectionPrepare before calling of this functions.
+        All restriction (input mask and bounding box) affects to left-top corner of scanning window.
+
+        \note This function is used for implementation of Simd::Detection.
+
+        \param [in] hid - a pointer to hidden cascade which was received with using of function ::SimdDetectionInit.
+        \param [in] mask - a pointer to pixels data of 8-bit image with mask. The mask restricts detection region.
+        \param [in] maskStride - a row size of the mask image.
+        \param [in] left - a left side of bounding box which restricts detection region.
+        \param [in] top - a top side of bounding box which restricts detection region.
+        \param [in] right - a right side of bounding box which restricts detection region.
+        \param [in] bottom - a bottom side of bounding box which restricts detection region.
+        \param [out] dst - a pointer to pixels data of 8-bit image with output result. None zero points refer to left-top corner of detected objects.
+        \param [in] dstStride - a row size of the dst image.
+    */
+    SIMD_API void SimdDetectionHaarDetect16ii(const void * hid, const uint8_t * mask, size_t maskStride,
+        ptrdiff_t left, ptrdiff_t top, ptrdiff_t right, ptrdiff_t bottom, uint8_t * dst, size_t dstStride);
+
     /*! @ingroup object_detection
 
         \fn void SimdDetectionLbpDetect32fp(const void * hid, const uint8_t * mask, size_t maskStride, ptrdiff_t left, ptrdiff_t top, ptrdiff_t right, ptrdiff_t bottom, uint8_t * dst, size_t dstStride);
@@ -1712,6 +1916,44 @@ extern "C"
     SIMD_API void SimdDetectionLbpDetect16ii(const void * hid, const uint8_t * mask, size_t maskStride,
         ptrdiff_t left, ptrdiff_t top, ptrdiff_t right, ptrdiff_t bottom, uint8_t * dst, size_t dstStride);
 
+    /*! @ingroup object_detection
+
+        \fn size_t SimdDetectionStageNumber(const void * hid);
+
+        \short Gets number of stages of hidden cascade classifier.
+
+        \note This function is used for implementation of Simd::Detection (profiling mode).
+
+        \param [in] hid - a pointer to hidden cascade which was received with using of function ::SimdDetectionInit.
+        \return number of stages of the cascade.
+    */
+    SIMD_API size_t SimdDetectionStageNumber(const void * hid);
+
+    /*! @ingroup object_detection
+
+        \fn void SimdDetectionCountStages(const void * hid, const uint8_t * mask, size_t maskStride, ptrdiff_t left, ptrdiff_t top, ptrdiff_t right, ptrdiff_t bottom, size_t * counts);
+
+        \short Counts scanning windows which pass every stage of cascade classifier (it is useful for profiling of detection).
+
+        It scans the same windows as corresponding detection function (::SimdDetectionHaarDetect32fp, ::SimdDetectionLbpDetect16ii and etc.) 
+        with the same arguments. You must call function ::SimdDetectionPrepare before calling of this functions. 
+        It has only scalar implementation, so it is much slower than detection functions.
+
+        \note This function is used for implementation of Simd::Detection (profiling mode).
+
+        \param [in] hid - a pointer to hidden cascade which was received with using of function ::SimdDetectionInit.
+        \param [in] mask - a pointer to pixels data of 8-bit image with mask. The mask restricts detection region.
+        \param [in] maskStride - a row size of the mask image.
+        \param [in] left - a left side of bounding box which restricts detection region.
+        \param [in] top - a top side of bounding box which restricts detection region.
+        \param [in] right - a right side of bounding box which restricts detection region.
+        \param [in] bottom - a bottom side of bounding box which restricts detection region.
+        \param [in, out] counts - a pointer to array of counters. Its size must be equal to (::SimdDetectionStageNumber + 1). 
+                                  The number of tested windows is added to counts[0], the number of windows which pass stage i is added to counts[i + 1].
+    */
+    SIMD_API void SimdDetectionCountStages(const void * hid, const uint8_t * mask, size_t maskStride,
+        ptrdiff_t left, ptrdiff_t top, ptrdiff_t right, ptrdiff_t bottom, size_t * counts);
+
     /*! @ingroup object_detection
 
         \fn void SimdDetectionFree(void * ptr);
@@ -2005,6 +2247,39 @@ extern "C"
     SIMD_API void SimdFillBgra(uint8_t * dst, size_t stride, size_t width, size_t height,
         uint8_t blue, uint8_t green, uint8_t red, uint8_t alpha);
 
+    /*! @ingroup other_filter
+
+        \fn void SimdFilter2D(const uint8_t * src, size_t srcStride, size_t width, size_t height, SimdPixelFormatType format, const float * kernel, size_t size, SimdBorderType border, uint8_t * dst, size_t dstStride);
+
+        \short Performs filtration of the image with arbitrary square kernel (2D correlation).
+
+        For every point:
+        \verbatim
+        dst[x, y] = sum(kernel[ky*size + kx]*src[x + kx - size/2, y + ky - size/2]), kx, ky = 0 .. size - 1;
+        \endverbatim
+        Points outside of the image are extrapolated according to border type.
+
+        All images must have the same width, height and format (8-bit gray, 16-bit signed integer or 32-bit float).
+        8-bit gray images are filtered with using of fixed point arithmetic, the result is rounded and saturated to range [0, 255].
+        Results for 16-bit integer images are rounded and saturated to range [-32768, 32767].
+        If the kernel is separable (it is an outer product of a column and a row) then faster two-pass algorithm is used.
+
+        \note This function has a C++ wrapper Simd::Filter2D(const View<A>& src, const float * kernel, size_t size, SimdBorderType border, View<A>& dst).
+
+        \param [in] src - a pointer to pixels data of source image.
+        \param [in] srcStride - a row size of the src image.
+        \param [in] width - an image width.
+        \param [in] height - an image height.
+        \param [in] format - a pixel format of the images (::SimdPixelFormatGray8, ::SimdPixelFormatInt16 or ::SimdPixelFormatFloat).
+        \param [in] kernel - a pointer to kernel weights (size*size values). Absolute values of the weights must be less than 32768.
+        \param [in] size - a kernel size. It must be odd.
+        \param [in] border - a type of border extrapolation.
+        \param [out] dst - a pointer to pixels data of destination image.
+        \param [in] dstStride - a row size of the dst image.
+    */
+    SIMD_API void SimdFilter2D(const uint8_t * src, size_t srcStride, size_t width, size_t height, SimdPixelFormatType format,
+        const float * kernel, size_t size, SimdBorderType border, uint8_t * dst, size_t dstStride);
+
     /*! @ingroup other_filter
 
         \fn void SimdGaussianBlur3x3(const uint8_t * src, size_t srcStride, size_t width, size_t height, size_t channelCount, uint8_t * dst, size_t dstStride);
@@ -2033,6 +2308,36 @@ extern "C"
     SIMD_API void SimdGaussianBlur3x3(const uint8_t * src, size_t srcStride, size_t width, size_t height,
         size_t channelCount, uint8_t * dst, size_t dstStride);
 
+    /*! @ingroup neural
+
+        \fn void SimdGemm32fNN(size_t M, size_t N, size_t K, const float * alpha, const float * A, size_t lda, const float * B, size_t ldb, const float * beta, float * C, size_t ldc);
+
+        \short Performs general matrix multiplication (for 32-bit float numbers).
+
+        All matrices are stored in row-major order and are not transposed:
+        \verbatim
+        C(M, N) = alpha*A(M, K)*B(K, N) + beta*C(M, N);
+        \endverbatim
+
+        The product is computed by blocks: a panel of B stays in cache while it is multiplied by all rows of A.
+
+        \note This function is used in Simd::Neural.
+
+        \param [in] M - a height of A and height of C matrices.
+        \param [in] N - a width of B and width of C matrices.
+        \param [in] K - a width of A and height of B matrices.
+        \param [in] alpha - a pointer to multiplier of the first term.
+        \param [in] A - a pointer to input A matrix.
+        \param [in] lda - a leading dimension of A matrix.
+        \param [in] B - a pointer to input B matrix.
+        \param [in] ldb - a leading dimension of B matrix.
+        \param [in] beta - a pointer to multiplier of the second term.
+        \param [out] C - a pointer to output C matrix.
+        \param [in] ldc - a leading dimension of C matrix.
+    */
+    SIMD_API void SimdGemm32fNN(size_t M, size_t N, size_t K, const float * alpha, const float * A, size_t lda,
+        const float * B, size_t ldb, const float * beta, float * C, size_t ldc);
+
     /*! @ingroup gray_conversion
 
         \fn void SimdGrayToBgr(const uint8_t * gray, size_t width, size_t height, size_t grayStride, uint8_t * bgr, size_t bgrStride);
@@ -2073,6 +2378,38 @@ extern "C"
     SIMD_API void SimdGrayToBgra(const uint8_t *gray, size_t width, size_t height, size_t grayStride,
         uint8_t *bgra, size_t bgraStride, uint8_t alpha);
 
+    /*! @ingroup other_filter
+
+        \fn void SimdGuidedFilter(const uint8_t * src, size_t srcStride, size_t width, size_t height, size_t channelCount, size_t radius, float eps, uint8_t * dst, size_t dstStride);
+
+        \short Performs edge-preserving smoothing of the image with using of guided filter (the image is its own guide).
+
+        It is a fast approximation of bilateral filter: its complexity does not depend on the radius.
+        For every channel:
+        \verbatim
+        a = var(src)/(var(src) + eps);
+        b = mean(src)*(1 - a);
+        dst = mean(a)*src + mean(b);
+        \endverbatim
+        where mean and var are a mean value and a variance in the window (2*radius + 1)x(2*radius + 1) clipped by the image border.
+
+        All images must have the same width, height and format (8-bit gray, 16-bit UV, 24-bit BGR or 32-bit BGRA).
+
+        \note This function has a C++ wrapper Simd::GuidedFilter(const View<A>& src, size_t radius, float eps, View<A>& dst).
+
+        \param [in] src - a pointer to pixels data of source image.
+        \param [in] srcStride - a row size of the src image.
+        \param [in] width - an image width.
+        \param [in] height - an image height.
+        \param [in] channelCount - a channel count.
+        \param [in] radius - a radius of the box window.
+        \param [in] eps - a regularization parameter (it is compared with variance of intensity, for example (0.1*255)^2).
+        \param [out] dst - a pointer to pixels data of destination image.
+        \param [in] dstStride - a row size of the dst image.
+    */
+    SIMD_API void SimdGuidedFilter(const uint8_t * src, size_t srcStride, size_t width, size_t height, size_t channelCount,
+        size_t radius, float eps, uint8_t * dst, size_t dstStride);
+
     /*! @ingroup histogram
 
         \fn void SimdAbsSecondDerivativeHistogram(const uint8_t * src, size_t width, size_t height, size_t stride, size_t step, size_t indent, uint32_t * histogram);
@@ -2192,6 +2529,60 @@ extern "C"
     */
     SIMD_API void SimdNormalizeHistogram(const uint8_t * src, size_t srcStride, size_t width, size_t height, uint8_t * dst, size_t dstStride);
 
+    /*! @ingroup histogram
+
+        \fn void SimdClaheLuts(const uint8_t * src, size_t srcStride, size_t width, size_t height, size_t tilesX, size_t tilesY, float clipLimit, size_t tileRowBegin, size_t tileRowEnd, uint8_t * luts);
+
+        \short Calculates lookup tables of contrast limited adaptive histogram equalization (CLAHE) for 8-bit gray image.
+
+        The image is divided into tilesX*tilesY tiles. For every tile its histogram is calculated and clipped by given limit 
+        (the clipped excess is uniformly redistributed over all bins), then its cumulative distribution is used as a lookup table.
+        The function processes only tile rows in range [tileRowBegin, tileRowEnd), so several ranges can be processed in parallel.
+        The lookup tables are used by function ::SimdClaheApply.
+
+        \note This function has a C++ wrapper Simd::Clahe(const View<A> & src, size_t tilesX, size_t tilesY, float clipLimit, View<A> & dst, size_t threadNumber).
+
+        \param [in] src - a pointer to pixels data of input 8-bit gray image.
+        \param [in] srcStride - a row size of the image.
+        \param [in] width - an image width. It must be greater or equal to tilesX.
+        \param [in] height - an image height. It must be greater or equal to tilesY.
+        \param [in] tilesX - a number of tiles in horizontal direction.
+        \param [in] tilesY - a number of tiles in vertical direction.
+        \param [in] clipLimit - a clip limit relative to height of uniform histogram (for example 2.0 or 4.0). Zero or negative value disables clipping.
+        \param [in] tileRowBegin - a first processed tile row.
+        \param [in] tileRowEnd - an end of processed tile rows. It must be less or equal to tilesY.
+        \param [out] luts - a pointer to buffer with lookup tables. Its size must be equal to tilesX*tilesY*256.
+    */
+    SIMD_API void SimdClaheLuts(const uint8_t * src, size_t srcStride, size_t width, size_t height, size_t tilesX, size_t tilesY,
+        float clipLimit, size_t tileRowBegin, size_t tileRowEnd, uint8_t * luts);
+
+    /*! @ingroup histogram
+
+        \fn void SimdClaheApply(const uint8_t * src, size_t srcStride, size_t width, size_t height, size_t tilesX, size_t tilesY, const uint8_t * luts, size_t rowBegin, size_t rowEnd, uint8_t * dst, size_t dstStride);
+
+        \short Applies lookup tables of contrast limited adaptive histogram equalization (CLAHE) to 8-bit gray image.
+
+        Every output pixel is a bilinear interpolation of values of lookup tables of four nearest tiles (their centers surround the pixel).
+        The function processes only image rows in range [rowBegin, rowEnd), so several ranges can be processed in parallel.
+        The input and output 8-bit gray images must have the same size.
+
+        \note This function has a C++ wrapper Simd::Clahe(const View<A> & src, size_t tilesX, size_t tilesY, float clipLimit, View<A> & dst, size_t threadNumber).
+
+        \param [in] src - a pointer to pixels data of input 8-bit gray image.
+        \param [in] srcStride - a row size of the image.
+        \param [in] width - an image width. It must be greater or equal to tilesX.
+        \param [in] height - an image height. It must be greater or equal to tilesY.
+        \param [in] tilesX - a number of tiles in horizontal direction.
+        \param [in] tilesY - a number of tiles in vertical direction.
+        \param [in] luts - a pointer to lookup tables calculated by function ::SimdClaheLuts.
+        \param [in] rowBegin - a first processed image row.
+        \param [in] rowEnd - an end of processed image rows. It must be less or equal to height.
+        \param [out] dst - a pointer to pixels data of output 8-bit gray image.
+        \param [in] dstStride - a row size of the output image.
+    */
+    SIMD_API void SimdClaheApply(const uint8_t * src, size_t srcStride, size_t width, size_t height, size_t tilesX, size_t tilesY,
+        const uint8_t * luts, size_t rowBegin, size_t rowEnd, uint8_t * dst, size_t dstStride);
+
     /*! @ingroup face_recognition
 
         \fn void SimdHogDirectionHistograms(const uint8_t * src, size_t stride, size_t width, size_t height, size_t cellX, size_t cellY, size_t quantization, float * histograms);
@@ -2269,6 +2660,38 @@ extern "C"
         uint8_t * sum, size_t sumStride, uint8_t * sqsum, size_t sqsumStride, uint8_t * tilted, size_t tiltedStride, 
         SimdPixelFormatType sumFormat, SimdPixelFormatType sqsumFormat);
 
+    /*! @ingroup integral
+
+        \fn void SimdIntegralUpdate(const uint8_t * src, size_t srcStride, size_t width, size_t height, const ptrdiff_t * rects, size_t rectNumber, uint8_t * sum, size_t sumStride, uint8_t * sqsum, size_t sqsumStride, uint8_t * tilted, size_t tiltedStride, SimdPixelFormatType sumFormat, SimdPixelFormatType sqsumFormat);
+
+        \short Updates integral images of partially changed 8-bit gray image. 
+
+        The integral images must be estimated earlier (see ::SimdIntegral) for previous image which differs from current image only inside given rectangles. 
+        The function recomputes sum and square sum integral images only below and to the right of top left corners of the rectangles 
+        and tilted sum integral image only in cones below the rectangles. Result is equal to ::SimdIntegral for current image.
+
+        \note This function has a C++ wrapper Simd::IntegralUpdate(const View<A>& src, const std::vector<Rectangle<ptrdiff_t>> & rects, View<A>& sum, View<A>& sqsum, View<A>& tilted).
+
+        \param [in] src - a pointer to pixels data of current 8-bit gray image.
+        \param [in] srcStride - a row size of src image.
+        \param [in] width - an image width.
+        \param [in] height - an image height.
+        \param [in] rects - an array of changed rectangles. Every rectangle is given by 4 numbers: left, top, right and bottom. 
+                            The rectangles are clipped by image boundaries.
+        \param [in] rectNumber - a number of changed rectangles.
+        \param [in, out] sum - a pointer to pixels data of 32-bit integer sum image. 
+        \param [in] sumStride - a row size of sum image (in bytes).
+        \param [in, out] sqsum - a pointer to pixels data of 32-bit integer or 64-bit float point square sum image. It can be NULL.
+        \param [in] sqsumStride - a row size of sqsum image (in bytes).
+        \param [in, out] tilted - a pointer to pixels data of 32-bit integer tilted sum image. It can be NULL.
+        \param [in] tiltedStride - a row size of tilted image (in bytes).
+        \param [in] sumFormat - a format of sum image and tilted image. It can be equal to ::SimdPixelFormatInt32.
+        \param [in] sqsumFormat - a format of sqsum image. It can be equal to ::SimdPixelFormatInt32 or ::SimdPixelFormatDouble.
+    */
+    SIMD_API void SimdIntegralUpdate(const uint8_t * src, size_t srcStride, size_t width, size_t height, const ptrdiff_t * rects, size_t rectNumber,
+        uint8_t * sum, size_t sumStride, uint8_t * sqsum, size_t sqsumStride, uint8_t * tilted, size_t tiltedStride, 
+        SimdPixelFormatType sumFormat, SimdPixelFormatType sqsumFormat);
+
     /*! @ingroup interference
 
         \fn void SimdInterferenceIncrement(uint8_t * statistic, size_t stride, size_t width, size_t height, uint8_t increment, int16_t saturation);
@@ -3001,6 +3424,46 @@ extern "C"
     */
     SIMD_API void SimdNeuralAdaptiveGradientUpdate(const float * delta, size_t size, size_t batch, const float * alpha, const float * epsilon, float * gradient, float * weight);
 
+    /*! @ingroup neural
+
+        \fn void SimdNeuralAdamUpdate(const float * delta, size_t size, size_t batch, const float * alpha, const float * beta1, const float * beta2, const float * epsilon, const float * decay, float * moment1, float * moment2, float * weight);
+
+        \short Updates neural network weights with using of Adam (AdamW) method.
+
+        Adam: a method for stochastic optimization.
+        D Kingma, J Ba, "Adam: A Method for Stochastic Optimization", ICLR 2015.
+        Decoupled weight decay (AdamW):
+        I Loshchilov, F Hutter, "Decoupled Weight Decay Regularization", ICLR 2019.
+
+        The algorithm performs:
+        \verbatim
+        for (i = 0; i < size; ++i)
+        {
+            d = delta[i]/batch;
+            moment1[i] = beta1*moment1[i] + (1 - beta1)*d;
+            moment2[i] = beta2*moment2[i] + (1 - beta2)*d*d;
+            weight[i] -= alpha*moment1[i]/(sqrt(moment2[i]) + epsilon) + decay*weight[i];
+        }
+        \endverbatim
+
+        \note All arrays must have the same size. This function is used in Simd::Neural. 
+            Bias correction of moments must be included into alpha: alpha = rate*sqrt(1 - beta2^t)/(1 - beta1^t), where t is the number of the step.
+
+        \param [in] delta - a pointer to the array with error (delta).
+        \param [in] size - a size of arrays.
+        \param [in] batch - a batch size.
+        \param [in] alpha - a pointer to alpha parameter (update speed).
+        \param [in] beta1 - a pointer to exponential decay rate of the first moment.
+        \param [in] beta2 - a pointer to exponential decay rate of the second moment.
+        \param [in] epsilon - a pointer to epsilon parameter (a small number used to avoid division by zero).
+        \param [in] decay - a pointer to decoupled weight decay parameter (0 for original Adam).
+        \param [in, out] moment1 - a pointer to the array with the first moment of gradients.
+        \param [in, out] moment2 - a pointer to the array with the second moment of gradients.
+        \param [in, out] weight - a pointer to the array with weights.
+    */
+    SIMD_API void SimdNeuralAdamUpdate(const float * delta, size_t size, size_t batch, const float * alpha, const float * beta1, const float * beta2, 
+        const float * epsilon, const float * decay, float * moment1, float * moment2, float * weight);
+
     /*! @ingroup neural
 
         \fn void SimdNeuralAddConvolution3x3(const float * src, size_t srcStride, size_t width, size_t height, const float * weights, float * dst, size_t dstStride);
@@ -3109,6 +3572,231 @@ extern "C"
     */
     SIMD_API void SimdNeuralAddConvolution5x5Sum(const float * src, size_t srcStride, const float * dst, size_t dstStride, size_t width, size_t height, float * sums);
 
+    /*! @ingroup neural
+
+        \fn void SimdNeuralConvolutionForward(const float * src, size_t srcWidth, size_t srcHeight, size_t srcDepth, const float * weight, size_t kernelX, size_t kernelY, size_t padX, size_t padY, size_t strideX, size_t strideY, size_t dilationX, size_t dilationY, void * buffer, size_t * size, float * dst, size_t dstWidth, size_t dstHeight, size_t dstDepth, int add);
+
+        \short Performs forward propagation of generic convolution of 32-bit float multichannel image.
+
+        The convolution supports any kernel size, padding, stride and dilation:
+        \verbatim
+        dstWidth = (srcWidth + 2*padX - (dilationX*(kernelX - 1) + 1))/strideX + 1;
+        dstHeight = (srcHeight + 2*padY - (dilationY*(kernelY - 1) + 1))/strideY + 1;
+
+        dst[dc, y, x] (+)= sum(weight[dc, sc, ky, kx]*src[sc, y*strideY + ky*dilationY - padY, x*strideX + kx*dilationX - padX]);
+        \endverbatim
+        The input image is transformed to matrix (im2col) and the convolution is performed as product of matrices (see ::SimdGemm32fNN).
+
+        \note This function is used in Simd::Neural.
+
+        \param [in] src - a pointer to the input 32-bit float image (its layout is [srcDepth][srcHeight][srcWidth]).
+        \param [in] srcWidth - a width of the input image.
+        \param [in] srcHeight - a height of the input image.
+        \param [in] srcDepth - a number of channels in the input image.
+        \param [in] weight - a pointer to the convolution weights (its layout is [dstDepth][srcDepth][kernelY][kernelX]).
+        \param [in] kernelX - a width of the convolution kernel.
+        \param [in] kernelY - a height of the convolution kernel.
+        \param [in] padX - a horizontal padding (zeros are added at the left and the right sides of the input image).
+        \param [in] padY - a vertical padding (zeros are added at the top and the bottom sides of the input image).
+        \param [in] strideX - a horizontal stride of the convolution.
+        \param [in] strideY - a vertical stride of the convolution.
+        \param [in] dilationX - a horizontal dilation of the convolution kernel.
+        \param [in] dilationY - a vertical dilation of the convolution kernel.
+        \param [in] buffer - a pointer to external temporary buffer. It can be NULL.
+        \param [in, out] size - a pointer to the size of external temporary buffer (in bytes). If the size is insufficient, the function allocates 
+                                temporary buffer itself and returns here required size of external buffer. It can be NULL.
+        \param [in, out] dst - a pointer to the output 32-bit float image (its layout is [dstDepth][dstHeight][dstWidth]).
+        \param [in] dstWidth - a width of the output image.
+        \param [in] dstHeight - a height of the output image.
+        \param [in] dstDepth - a number of channels in the output image.
+        \param [in] add - a flag of addition of the result to the output image (else the output image is overwritten).
+    */
+    SIMD_API void SimdNeuralConvolutionForward(const float * src, size_t srcWidth, size_t srcHeight, size_t srcDepth, const float * weight,
+        size_t kernelX, size_t kernelY, size_t padX, size_t padY, size_t strideX, size_t strideY, size_t dilationX, size_t dilationY,
+        void * buffer, size_t * size, float * dst, size_t dstWidth, size_t dstHeight, size_t dstDepth, int add);
+
+    /*! @ingroup neural
+
+        \fn void SimdNeuralConvolutionBackward(const float * src, size_t srcWidth, size_t srcHeight, size_t srcDepth, const float * weight, size_t kernelX, size_t kernelY, size_t padX, size_t padY, size_t strideX, size_t strideY, size_t dilationX, size_t dilationY, void * buffer, size_t * size, float * dst, size_t dstWidth, size_t dstHeight, size_t dstDepth, int add);
+
+        \short Performs backward propagation of generic convolution of 32-bit float multichannel image.
+
+        It propagates the output delta of the convolution (see ::SimdNeuralConvolutionForward) back to its input: 
+        \verbatim
+        dst[sc, y*strideY + ky*dilationY - padY, x*strideX + kx*dilationX - padX] (+)= sum(weight[dc, sc, ky, kx]*src[dc, y, x]);
+        \endverbatim
+
+        \note This function is used in Simd::Neural.
+
+        \param [in] src - a pointer to the delta of convolution output (its layout is [srcDepth][srcHeight][srcWidth]).
+        \param [in] srcWidth - a width of the convolution output.
+        \param [in] srcHeight - a height of the convolution output.
+        \param [in] srcDepth - a number of channels in the convolution output.
+        \param [in] weight - a pointer to the convolution weights (its layout is [srcDepth][dstDepth][kernelY][kernelX]).
+        \param [in] kernelX - a width of the convolution kernel.
+        \param [in] kernelY - a height of the convolution kernel.
+        \param [in] padX - a horizontal padding (zeros are added at the left and the right sides of the input image).
+        \param [in] padY - a vertical padding (zeros are added at the top and the bottom sides of the input image).
+        \param [in] strideX - a horizontal stride of the convolution.
+        \param [in] strideY - a vertical stride of the convolution.
+        \param [in] dilationX - a horizontal dilation of the convolution kernel.
+        \param [in] dilationY - a vertical dilation of the convolution kernel.
+        \param [in] buffer - a pointer to external temporary buffer. It can be NULL.
+        \param [in, out] size - a pointer to the size of external temporary buffer (in bytes). If the size is insufficient, the function allocates 
+                                temporary buffer itself and returns here required size of external buffer. It can be NULL.
+        \param [in, out] dst - a pointer to the delta of convolution input (its layout is [dstDepth][dstHeight][dstWidth]).
+        \param [in] dstWidth - a width of the convolution input.
+        \param [in] dstHeight - a height of the convolution input.
+        \param [in] dstDepth - a number of channels in the convolution input.
+        \param [in] add - a flag of addition of the result to the dst (else dst is overwritten).
+    */
+    SIMD_API void SimdNeuralConvolutionBackward(const float * src, size_t srcWidth, size_t srcHeight, size_t srcDepth, const float * weight,
+        size_t kernelX, size_t kernelY, size_t padX, size_t padY, size_t strideX, size_t strideY, size_t dilationX, size_t dilationY,
+        void * buffer, size_t * size, float * dst, size_t dstWidth, size_t dstHeight, size_t dstDepth, int add);
+
+    /*! @ingroup neural
+
+        \fn void SimdNeuralConvolutionSum(const float * src, size_t srcWidth, size_t srcHeight, size_t srcDepth, const float * dst, size_t dstWidth, size_t dstHeight, size_t dstDepth, size_t kernelX, size_t kernelY, size_t padX, size_t padY, size_t strideX, size_t strideY, size_t dilationX, size_t dilationY, void * buffer, size_t * size, float * sums);
+
+        \short Accumulates changes of weights for generic convolution of 32-bit float multichannel image during backward propagation.
+
+        \verbatim
+        sums[dc, sc, ky, kx] += sum(dst[dc, y, x]*src[sc, y*strideY + ky*dilationY - padY, x*strideX + kx*dilationX - padX]);
+        \endverbatim
+
+        \note This function is used in Simd::Neural.
+
+        \param [in] src - a pointer to the convolution input (its layout is [srcDepth][srcHeight][srcWidth]).
+        \param [in] srcWidth - a width of the convolution input.
+        \param [in] srcHeight - a height of the convolution input.
+        \param [in] srcDepth - a number of channels in the convolution input.
+        \param [in] dst - a pointer to the delta of convolution output (its layout is [dstDepth][dstHeight][dstWidth]).
+        \param [in] dstWidth - a width of the convolution output.
+        \param [in] dstHeight - a height of the convolution output.
+        \param [in] dstDepth - a number of channels in the convolution output.
+        \param [in] kernelX - a width of the convolution kernel.
+        \param [in] kernelY - a height of the convolution kernel.
+        \param [in] padX - a horizontal padding (zeros are added at the left and the right sides of the input image).
+        \param [in] padY - a vertical padding (zeros are added at the top and the bottom sides of the input image).
+        \param [in] strideX - a horizontal stride of the convolution.
+        \param [in] strideY - a vertical stride of the convolution.
+        \param [in] dilationX - a horizontal dilation of the convolution kernel.
+        \param [in] dilationY - a vertical dilation of the convolution kernel.
+        \param [in] buffer - a pointer to external temporary buffer. It can be NULL.
+        \param [in, out] size - a pointer to the size of external temporary buffer (in bytes). If the size is insufficient, the function allocates 
+                                temporary buffer itself and returns here required size of external buffer. It can be NULL.
+        \param [in, out] sums - a pointer to the array with changes of weights (its layout is [dstDepth][srcDepth][kernelY][kernelX]).
+    */
+    SIMD_API void SimdNeuralConvolutionSum(const float * src, size_t srcWidth, size_t srcHeight, size_t srcDepth, const float * dst, size_t dstWidth, size_t dstHeight, size_t dstDepth,
+        size_t kernelX, size_t kernelY, size_t padX, size_t padY, size_t strideX, size_t strideY, size_t dilationX, size_t dilationY,
+        void * buffer, size_t * size, float * sums);
+
+    /*! @ingroup neural
+
+        \fn void SimdNeuralWinograd2x2p3x3SetFilter(const float * src, size_t size, float * dst);
+
+        \short Converts 3x3 convolution kernels into Winograd F(2x2, 3x3) form.
+
+        Every kernel g is converted to 4x4 matrix G*g*GT. The result is stored as 16 matrices: dst[i*size + k] is i-th value of k-th kernel.
+        If kernels have layout [dstDepth][srcDepth][3][3] then every i-th matrix has layout [dstDepth][srcDepth].
+
+        \note This function is used in Simd::Neural.
+
+        \param [in] src - a pointer to the 3x3 kernels.
+        \param [in] size - a number of kernels.
+        \param [out] dst - a pointer to the converted kernels. Its size must be equal to 16*size.
+    */
+    SIMD_API void SimdNeuralWinograd2x2p3x3SetFilter(const float * src, size_t size, float * dst);
+
+    /*! @ingroup neural
+
+        \fn void SimdNeuralWinograd2x2p3x3SetInput(const float * src, size_t srcWidth, size_t srcHeight, size_t srcDepth, float * dst);
+
+        \short Converts input of 3x3 convolution (without padding, with unit stride) into Winograd F(2x2, 3x3) form.
+
+        The output of convolution (srcWidth - 2)x(srcHeight - 2) is divided into 2x2 tiles (tiles = ((srcWidth - 1)/2)*((srcHeight - 1)/2)).
+        Every correspondent 4x4 tile d of the input is converted to BT*d*B (points outside of the image are equal to zero).
+        The result is stored as 16 matrices with layout [srcDepth][tiles].
+
+        \note This function is used in Simd::Neural.
+
+        \param [in] src - a pointer to the input image (its layout is [srcDepth][srcHeight][srcWidth]).
+        \param [in] srcWidth - a width of the input image. It must be greater than 2.
+        \param [in] srcHeight - a height of the input image. It must be greater than 2.
+        \param [in] srcDepth - a number of channels in the input image.
+        \param [out] dst - a pointer to the converted input. Its size must be equal to 16*srcDepth*tiles.
+    */
+    SIMD_API void SimdNeuralWinograd2x2p3x3SetInput(const float * src, size_t srcWidth, size_t srcHeight, size_t srcDepth, float * dst);
+
+    /*! @ingroup neural
+
+        \fn void SimdNeuralWinograd2x2p3x3SetOutput(const float * src, float * dst, size_t dstWidth, size_t dstHeight, size_t dstDepth);
+
+        \short Converts output of 3x3 convolution from Winograd F(2x2, 3x3) form.
+
+        The input contains 16 matrices [dstDepth][tiles] (tiles = ((dstWidth + 1)/2)*((dstHeight + 1)/2)). It is usually the product 
+        of matrices given by ::SimdNeuralWinograd2x2p3x3SetFilter and ::SimdNeuralWinograd2x2p3x3SetInput (see ::SimdGemm32fNN).
+        Every 4x4 tile m is converted to 2x2 output tile AT*m*A.
+
+        \note This function is used in Simd::Neural.
+
+        \param [in] src - a pointer to the converted output. Its size must be equal to 16*dstDepth*tiles.
+        \param [out] dst - a pointer to the output image (its layout is [dstDepth][dstHeight][dstWidth]).
+        \param [in] dstWidth - a width of the output image.
+        \param [in] dstHeight - a height of the output image.
+        \param [in] dstDepth - a number of channels in the output image.
+    */
+    SIMD_API void SimdNeuralWinograd2x2p3x3SetOutput(const float * src, float * dst, size_t dstWidth, size_t dstHeight, size_t dstDepth);
+
+    /*! @ingroup neural
+
+        \fn void SimdNeuralQuantize8u(const float * src, size_t size, const float * scale, const float * shift, uint8_t * dst);
+
+        \short Converts 32-bit float array to 8-bit unsigned integer array (linear quantization).
+
+        Algorithm's details:
+        \verbatim
+        for(i = 0; i < size; ++i)
+            dst[i] = RestrictRange(Round(src[i]*scale[0] + shift[0]), 0, 255);
+        \endverbatim
+
+        \note This function is used in Simd::Neural.
+
+        \param [in] src - a pointer to the input 32-bit float array.
+        \param [in] size - a size of the arrays.
+        \param [in] scale - a pointer to the scale.
+        \param [in] shift - a pointer to the shift (zero point).
+        \param [out] dst - a pointer to the output 8-bit unsigned integer array.
+    */
+    SIMD_API void SimdNeuralQuantize8u(const float * src, size_t size, const float * scale, const float * shift, uint8_t * dst);
+
+    /*! @ingroup neural
+
+        \fn void SimdNeuralProductSum8u8i(const uint8_t * src, const int8_t * weight, size_t size, size_t count, int32_t * sums);
+
+        \short Calculates products of 8-bit unsigned integer vector and 8-bit signed integer matrix.
+
+        Algorithm's details:
+        \verbatim
+        for(i = 0; i < count; ++i)
+        {
+            sums[i] = 0;
+            for(k = 0; k < size; ++k)
+                sums[i] += src[k]*weight[i*size + k];
+        }
+        \endverbatim
+
+        \note The weights must be in range [-63, 63] (SSSE3 and AVX2 versions use saturated addition of pairs of 16-bit products).
+            This function is used in Simd::Neural.
+
+        \param [in] src - a pointer to the input vector.
+        \param [in] weight - a pointer to the weight matrix (its layout is [count][size]).
+        \param [in] size - a size of the input vector.
+        \param [in] count - a number of rows in the weight matrix.
+        \param [out] sums - a pointer to the output 32-bit integer sums. Its size must be equal to count.
+    */
+    SIMD_API void SimdNeuralProductSum8u8i(const uint8_t * src, const int8_t * weight, size_t size, size_t count, int32_t * sums);
+
     /*! @ingroup neural
 
         \fn void SimdNeuralMax2x2(const float * src, size_t srcStride, size_t width, size_t height, float * dst, size_t dstStride);
@@ -3672,6 +4360,74 @@ extern "C"
     */
     SIMD_API void SimdSobelDyAbsSum(const uint8_t * src, size_t stride, size_t width, size_t height, uint64_t * sum);
 
+    /*! @ingroup sobel_filter
+
+        \fn void SimdSobelGradient(const uint8_t * src, size_t srcStride, size_t width, size_t height, uint8_t * dx, size_t dxStride, uint8_t * dy, size_t dyStride, uint8_t * magnitude, size_t magnitudeStride, size_t quantization, uint8_t * direction, size_t directionStride);
+
+        \short Calculates Sobel's filters along x and y axis, L1 magnitude and quantized direction of gradient in one pass. 
+
+        All images must have the same width and height. Input image must has 8-bit gray format. 
+        Images dx, dy and magnitude must have 16-bit integer format, image direction must has 8-bit gray format. 
+        Any of output images can be absent (its pointer is NULL), in this case it is not calculated.
+
+        For every point: 
+        \verbatim
+        dx[x, y] = (src[x+1,y-1] + 2*src[x+1, y] + src[x+1, y+1]) - (src[x-1,y-1] + 2*src[x-1, y] + src[x-1, y+1]);
+        dy[x, y] = (src[x-1,y+1] + 2*src[x, y+1] + src[x+1, y+1]) - (src[x-1,y-1] + 2*src[x, y-1] + src[x+1, y-1]);
+        magnitude[x, y] = abs(dx[x, y]) + abs(dy[x, y]);
+        direction[x, y] = index of the nearest direction (i*2*PI/quantization) to the gradient vector (dx[x, y], dy[x, y]).
+        \endverbatim
+
+        \note This function has a C++ wrappers: Simd::SobelGradient(const View<A>& src, View<A>& dx, View<A>& dy, View<A>& magnitude, size_t quantization, View<A>& direction).
+
+        \param [in] src - a pointer to pixels data of the input image.
+        \param [in] srcStride - a row size of the input image.
+        \param [in] width - an image width.
+        \param [in] height - an image height.
+        \param [out] dx - a pointer to pixels data of the output 16-bit image with Sobel's filter along x axis. Can be NULL.
+        \param [in] dxStride - a row size of the dx image (in bytes).
+        \param [out] dy - a pointer to pixels data of the output 16-bit image with Sobel's filter along y axis. Can be NULL.
+        \param [in] dyStride - a row size of the dy image (in bytes).
+        \param [out] magnitude - a pointer to pixels data of the output 16-bit image with L1 magnitude of gradient. Can be NULL.
+        \param [in] magnitudeStride - a row size of the magnitude image (in bytes).
+        \param [in] quantization - a direction quantization. Must be even and lesser or equal to 256.
+        \param [out] direction - a pointer to pixels data of the output 8-bit image with quantized direction of gradient. Can be NULL.
+        \param [in] directionStride - a row size of the direction image.
+    */
+    SIMD_API void SimdSobelGradient(const uint8_t * src, size_t srcStride, size_t width, size_t height, uint8_t * dx, size_t dxStride, 
+        uint8_t * dy, size_t dyStride, uint8_t * magnitude, size_t magnitudeStride, size_t quantization, uint8_t * direction, size_t directionStride);
+
+    /*! @ingroup sobel_filter
+
+        \fn void SimdSobelGradient32f(const uint8_t * src, size_t srcStride, size_t width, size_t height, uint8_t * magnitude, size_t magnitudeStride, uint8_t * direction, size_t directionStride);
+
+        \short Calculates L2 magnitude and direction of gradient (based on Sobel's filters) in one pass. 
+
+        All images must have the same width and height. Input image must has 8-bit gray format, output images must have 32-bit float format. 
+        Any of output images can be absent (its pointer is NULL), in this case it is not calculated.
+
+        For every point: 
+        \verbatim
+        dx = (src[x+1,y-1] + 2*src[x+1, y] + src[x+1, y+1]) - (src[x-1,y-1] + 2*src[x-1, y] + src[x-1, y+1]);
+        dy = (src[x-1,y+1] + 2*src[x, y+1] + src[x+1, y+1]) - (src[x-1,y-1] + 2*src[x, y-1] + src[x+1, y-1]);
+        magnitude[x, y] = sqrt(dx*dx + dy*dy);
+        direction[x, y] = atan2(dy, dx); // in range [0, 2*PI), maximal absolute error is 0.00001.
+        \endverbatim
+
+        \note This function has a C++ wrappers: Simd::SobelGradient32f(const View<A>& src, View<A>& magnitude, View<A>& direction).
+
+        \param [in] src - a pointer to pixels data of the input image.
+        \param [in] srcStride - a row size of the input image.
+        \param [in] width - an image width.
+        \param [in] height - an image height.
+        \param [out] magnitude - a pointer to pixels data of the output 32-bit float image with magnitude of gradient. Can be NULL.
+        \param [in] magnitudeStride - a row size of the magnitude image (in bytes).
+        \param [out] direction - a pointer to pixels data of the output 32-bit float image with direction of gradient. Can be NULL.
+        \param [in] directionStride - a row size of the direction image (in bytes).
+    */
+    SIMD_API void SimdSobelGradient32f(const uint8_t * src, size_t srcStride, size_t width, size_t height, 
+        uint8_t * magnitude, size_t magnitudeStride, uint8_t * direction, size_t directionStride);
+
     /*! @ingroup contour
 
         \fn void SimdContourMetrics(const uint8_t * src, size_t srcStride, size_t width, size_t height, uint8_t * dst, size_t dstStride)
@@ -3924,6 +4680,35 @@ extern "C"
     SIMD_API void SimdGetMoments(const uint8_t * mask, size_t stride, size_t width, size_t height, uint8_t index,
         uint64_t * area, uint64_t * x, uint64_t * y, uint64_t * xx, uint64_t * xy, uint64_t * yy);
 
+    /*! @ingroup other_statistic
+
+        \fn void SimdGetImageStatistics(const uint8_t * src, size_t srcStride, size_t width, size_t height, const uint8_t * mask, size_t maskStride, uint8_t index, uint32_t flags, size_t rowBegin, size_t rowEnd, SimdImageStatistics * statistics);
+
+        \short Calculates several statistics of 8-bit gray image in one pass.
+
+        It replaces separate calls of functions ::SimdGetStatistic, ::SimdValueSum, ::SimdSquareSum, ::SimdGetMoments, ::SimdHistogram 
+        and ::SimdLaplaceAbsSum: every image row is loaded from memory once. Only pixels with mask[x, y] == index are processed 
+        (if mask is not NULL). The function processes only image rows in range [rowBegin, rowEnd) (neighbor rows are used by Laplace's filter), 
+        so several ranges can be processed in parallel and their statistics can be merged.
+
+        \note This function has C++ wrappers: Simd::GetImageStatistics(const View<A> & src, uint32_t flags, SimdImageStatistics & statistics, size_t threadNumber)
+            and Simd::GetImageStatistics(const View<A> & src, const View<A> & mask, uint8_t index, uint32_t flags, SimdImageStatistics & statistics, size_t threadNumber).
+
+        \param [in] src - a pointer to pixels data of the input image.
+        \param [in] srcStride - a row size of the image.
+        \param [in] width - an image width. It must be less then 65536 (and greater than 1 for Laplace's filter).
+        \param [in] height - an image height.
+        \param [in] mask - a pointer to pixels data of the mask image. It can be NULL.
+        \param [in] maskStride - a row size of the mask image.
+        \param [in] index - a mask index.
+        \param [in] flags - a set of calculated statistics (see ::SimdImageStatisticsFlags).
+        \param [in] rowBegin - a first processed image row.
+        \param [in] rowEnd - an end of processed image rows. It must be less or equal to height.
+        \param [out] statistics - a pointer to structure with calculated statistics.
+    */
+    SIMD_API void SimdGetImageStatistics(const uint8_t * src, size_t srcStride, size_t width, size_t height, const uint8_t * mask, size_t maskStride,
+        uint8_t index, uint32_t flags, size_t rowBegin, size_t rowEnd, SimdImageStatistics * statistics);
+
     /*! @ingroup row_statistic
 
         \fn void SimdGetRowSums(const uint8_t * src, size_t stride, size_t width, size_t height, uint32_t * sums);
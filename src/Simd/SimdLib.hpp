@@ -880,6 +880,29 @@ namespace Simd
         SimdBgrToYuv444p(bgr.data, bgr.width, bgr.height, bgr.stride, y.data, y.stride, u.data, u.stride, v.data, v.stride);
     }
 
+    /*! @ingroup other_filter
+
+        \fn void BilateralFilter(const View<A>& src, size_t radius, float sigmaSpace, float sigmaRange, View<A>& dst)
+
+        \short Performs bilateral (edge-preserving) filtration of the image.
+
+        All images must have the same width, height and format (8-bit gray or 24-bit BGR).
+
+        \note This function is a C++ wrapper for function ::SimdBilateralFilter.
+
+        \param [in] src - a source image.
+        \param [in] radius - a radius of the filter window.
+        \param [in] sigmaSpace - a sigma of the spatial Gaussian. It must be positive.
+        \param [in] sigmaRange - a sigma of the range (intensity difference) Gaussian. It must be positive.
+        \param [out] dst - a destination image.
+    */
+    template<template<class> class A> SIMD_INLINE void BilateralFilter(const View<A>& src, size_t radius, float sigmaSpace, float sigmaRange, View<A>& dst)
+    {
+        assert(Compatible(src, dst) && (src.format == View<A>::Gray8 || src.format == View<A>::Bgr24));
+
+        SimdBilateralFilter(src.data, src.stride, src.width, src.height, src.ChannelCount(), radius, sigmaSpace, sigmaRange, dst.data, dst.stride);
+    }
+
     /*! @ingroup binarization
 
         \fn void Binarization(const View<A>& src, uint8_t value, uint8_t positive, uint8_t negative, View<A>& dst, SimdCompareType compareType)
@@ -1528,6 +1551,35 @@ namespace Simd
         SimdFillBgra(dst.data, dst.stride, dst.width, dst.height, blue, green, red, alpha);
     }
 
+    /*! @ingroup other_filter
+
+        \fn void Filter2D(const View<A>& src, const float * kernel, size_t size, SimdBorderType border, View<A>& dst)
+
+        \short Performs filtration of the image with arbitrary square kernel (2D correlation).
+
+        For every point:
+        \verbatim
+        dst[x, y] = sum(kernel[ky*size + kx]*src[x + kx - size/2, y + ky - size/2]), kx, ky = 0 .. size - 1;
+        \endverbatim
+        Points outside of the image are extrapolated according to border type.
+
+        All images must have the same width, height and format (8-bit gray, 16-bit signed integer or 32-bit float).
+
+        \note This function is a C++ wrapper for function ::SimdFilter2D.
+
+        \param [in] src - a source image.
+        \param [in] kernel - a pointer to kernel weights (size*size values).
+        \param [in] size - a kernel size. It must be odd.
+        \param [in] border - a type of border extrapolation.
+        \param [out] dst - a destination image.
+    */
+    template<template<class> class A> SIMD_INLINE void Filter2D(const View<A>& src, const float * kernel, size_t size, SimdBorderType border, View<A>& dst)
+    {
+        assert(Compatible(src, dst) && (src.format == View<A>::Gray8 || src.format == View<A>::Int16 || src.format == View<A>::Float) && size % 2 == 1);
+
+        SimdFilter2D(src.data, src.stride, src.width, src.height, (SimdPixelFormatType)src.format, kernel, size, border, dst.data, dst.stride);
+    }
+
     /*! @ingroup other_filter
 
         \fn void GaussianBlur3x3(const View<A>& src, View<A>& dst)
@@ -1595,6 +1647,28 @@ namespace Simd
         SimdGrayToBgra(gray.data, gray.width, gray.height, gray.stride, bgra.data, bgra.stride, alpha);
     }
 
+    /*! @ingroup other_filter
+
+        \fn void GuidedFilter(const View<A>& src, size_t radius, float eps, View<A>& dst)
+
+        \short Performs edge-preserving smoothing of the image with using of guided filter (the image is its own guide).
+
+        All images must have the same width, height and format (8-bit gray, 16-bit UV, 24-bit BGR or 32-bit BGRA).
+
+        \note This function is a C++ wrapper for function ::SimdGuidedFilter.
+
+        \param [in] src - a source image.
+        \param [in] radius - a radius of the box window.
+        \param [in] eps - a regularization parameter (it is compared with variance of intensity).
+        \param [out] dst - a destination image.
+    */
+    template<template<class> class A> SIMD_INLINE void GuidedFilter(const View<A>& src, size_t radius, float eps, View<A>& dst)
+    {
+        assert(Compatible(src, dst) && src.ChannelSize() == 1);
+
+        SimdGuidedFilter(src.data, src.stride, src.width, src.height, src.ChannelCount(), radius, eps, dst.data, dst.stride);
+    }
+
     /*! @ingroup histogram
 
         \fn void AbsSecondDerivativeHistogram(const View<A>& src, size_t step, size_t indent, uint32_t * histogram)
@@ -1718,6 +1792,32 @@ namespace Simd
         SimdNormalizeHistogram(src.data, src.stride, src.width, src.height, dst.data, dst.stride);
     }
 
+    /*! @ingroup histogram
+
+        \fn void Clahe(const View<A> & src, size_t tilesX, size_t tilesY, float clipLimit, View<A> & dst)
+
+        \short Performs contrast limited adaptive histogram equalization (CLAHE) of 8-bit gray image.
+
+        The input and output 8-bit gray images must have the same size. 
+
+        \note This function is a C++ wrapper for functions ::SimdClaheLuts and ::SimdClaheApply. 
+            Its multithreaded version is defined in file SimdParallel.hpp.
+
+        \param [in] src - an input 8-bit gray image.
+        \param [in] tilesX - a number of tiles in horizontal direction.
+        \param [in] tilesY - a number of tiles in vertical direction.
+        \param [in] clipLimit - a clip limit relative to height of uniform histogram (for example 2.0 or 4.0). Zero or negative value disables clipping.
+        \param [out] dst - an output 8-bit gray image.
+    */
+    template<template<class> class A> SIMD_INLINE void Clahe(const View<A> & src, size_t tilesX, size_t tilesY, float clipLimit, View<A> & dst)
+    {
+        assert(Compatible(src, dst) && src.format == View<A>::Gray8 && tilesX > 0 && tilesY > 0 && src.width >= tilesX && src.height >= tilesY);
+
+        std::vector<uint8_t> luts(tilesX*tilesY*256);
+        SimdClaheLuts(src.data, src.stride, src.width, src.height, tilesX, tilesY, clipLimit, 0, tilesY, luts.data());
+        SimdClaheApply(src.data, src.stride, src.width, src.height, tilesX, tilesY, luts.data(), 0, src.height, dst.data, dst.stride);
+    }
+
     /*! @ingroup face_recognition
 
         \fn void SimdHogDirectionHistograms(const uint8_t * src, size_t stride, size_t width, size_t height, size_t cellX, size_t cellY, size_t quantization, float * histograms);
@@ -1837,6 +1937,41 @@ namespace Simd
             (SimdPixelFormatType)sum.format, (SimdPixelFormatType)sqsum.format);
     }
 
+    /*! @ingroup integral
+
+        \fn void IntegralUpdate(const View<A>& src, const std::vector<Rectangle<ptrdiff_t>> & rects, View<A>& sum, View<A>& sqsum, View<A>& tilted)
+
+        \short Updates integral images of partially changed 8-bit gray image. 
+
+        The integral images must be estimated earlier (see Simd::Integral) for previous image which differs from current image only inside given rectangles. 
+        Square sum and tilted sum integral images are optional (they can be empty).
+
+        \note This function is a C++ wrapper for function ::SimdIntegralUpdate.
+
+        \param [in] src - a current 8-bit gray image.
+        \param [in] rects - changed rectangles.
+        \param [in, out] sum - a 32-bit integer sum image. 
+        \param [in, out] sqsum - a 32-bit integer or 64-bit float point square sum image. It can be empty.
+        \param [in, out] tilted - a 32-bit integer tilted sum image. It can be empty.
+    */
+    template<template<class> class A> SIMD_INLINE void IntegralUpdate(const View<A>& src, const std::vector<Rectangle<ptrdiff_t>> & rects, View<A>& sum, View<A>& sqsum, View<A>& tilted)
+    {
+        assert(src.width + 1 == sum.width && src.height + 1 == sum.height && src.format == View<A>::Gray8 && sum.format == View<A>::Int32);
+        assert(sqsum.format == View<A>::None || (EqualSize(sum, sqsum) && (sqsum.format == View<A>::Int32 || sqsum.format == View<A>::Double)));
+        assert(tilted.format == View<A>::None || Compatible(sum, tilted));
+
+        std::vector<ptrdiff_t> buffer(rects.size() * 4);
+        for (size_t i = 0; i < rects.size(); ++i)
+        {
+            buffer[i * 4 + 0] = rects[i].left;
+            buffer[i * 4 + 1] = rects[i].top;
+            buffer[i * 4 + 2] = rects[i].right;
+            buffer[i * 4 + 3] = rects[i].bottom;
+        }
+        SimdIntegralUpdate(src.data, src.stride, src.width, src.height, buffer.data(), rects.size(), sum.data, sum.stride, 
+            sqsum.data, sqsum.stride, tilted.data, tilted.stride, (SimdPixelFormatType)sum.format, (SimdPixelFormatType)sqsum.format);
+    }
+
     /*! @ingroup interference
 
         \fn void InterferenceIncrement(View<A> & dst, uint8_t increment, int16_t saturation)
@@ -2745,6 +2880,77 @@ namespace Simd
         SimdSobelDyAbs(src.data, src.stride, src.width, src.height, dst.data, dst.stride);
     }
 
+    /*! @ingroup sobel_filter
+
+        \fn void SobelGradient(const View<A>& src, View<A>& dx, View<A>& dy, View<A>& magnitude, size_t quantization, View<A>& direction)
+
+        \short Calculates Sobel's filters along x and y axis, L1 magnitude and quantized direction of gradient in one pass. 
+
+        All images must have the same width and height. Input image must has 8-bit gray format. 
+        Images dx, dy and magnitude must have 16-bit integer format, image direction must has 8-bit gray format. 
+        Any of output images can be empty (its data is NULL), in this case it is not calculated.
+
+        For every point: 
+        \verbatim
+        dx[x, y] = (src[x+1,y-1] + 2*src[x+1, y] + src[x+1, y+1]) - (src[x-1,y-1] + 2*src[x-1, y] + src[x-1, y+1]);
+        dy[x, y] = (src[x-1,y+1] + 2*src[x, y+1] + src[x+1, y+1]) - (src[x-1,y-1] + 2*src[x, y-1] + src[x+1, y-1]);
+        magnitude[x, y] = abs(dx[x, y]) + abs(dy[x, y]);
+        direction[x, y] = index of the nearest direction (i*2*PI/quantization) to the gradient vector (dx[x, y], dy[x, y]).
+        \endverbatim
+
+        \note This function is a C++ wrapper for function ::SimdSobelGradient.
+
+        \param [in] src - an input image.
+        \param [out] dx - an output image with Sobel's filter along x axis.
+        \param [out] dy - an output image with Sobel's filter along y axis.
+        \param [out] magnitude - an output image with L1 magnitude of gradient.
+        \param [in] quantization - a direction quantization. Must be even and lesser or equal to 256.
+        \param [out] direction - an output image with quantized direction of gradient.
+    */
+    template<template<class> class A> SIMD_INLINE void SobelGradient(const View<A>& src, View<A>& dx, View<A>& dy, View<A>& magnitude, size_t quantization, View<A>& direction)
+    {
+        assert(src.format == View<A>::Gray8 && quantization%2 == 0 && quantization <= 256);
+        assert(dx.data == NULL || (EqualSize(src, dx) && dx.format == View<A>::Int16));
+        assert(dy.data == NULL || (EqualSize(src, dy) && dy.format == View<A>::Int16));
+        assert(magnitude.data == NULL || (EqualSize(src, magnitude) && magnitude.format == View<A>::Int16));
+        assert(direction.data == NULL || (EqualSize(src, direction) && direction.format == View<A>::Gray8));
+
+        SimdSobelGradient(src.data, src.stride, src.width, src.height, dx.data, dx.stride, dy.data, dy.stride, 
+            magnitude.data, magnitude.stride, quantization, direction.data, direction.stride);
+    }
+
+    /*! @ingroup sobel_filter
+
+        \fn void SobelGradient32f(const View<A>& src, View<A>& magnitude, View<A>& direction)
+
+        \short Calculates L2 magnitude and direction of gradient (based on Sobel's filters) in one pass. 
+
+        All images must have the same width and height. Input image must has 8-bit gray format, output images must have 32-bit float format. 
+        Any of output images can be empty (its data is NULL), in this case it is not calculated.
+
+        For every point: 
+        \verbatim
+        dx = (src[x+1,y-1] + 2*src[x+1, y] + src[x+1, y+1]) - (src[x-1,y-1] + 2*src[x-1, y] + src[x-1, y+1]);
+        dy = (src[x-1,y+1] + 2*src[x, y+1] + src[x+1, y+1]) - (src[x-1,y-1] + 2*src[x, y-1] + src[x+1, y-1]);
+        magnitude[x, y] = sqrt(dx*dx + dy*dy);
+        direction[x, y] = atan2(dy, dx); // in range [0, 2*PI), maximal absolute error is 0.00001.
+        \endverbatim
+
+        \note This function is a C++ wrapper for function ::SimdSobelGradient32f.
+
+        \param [in] src - an input image.
+        \param [out] magnitude - an output image with magnitude of gradient.
+        \param [out] direction - an output image with direction of gradient.
+    */
+    template<template<class> class A> SIMD_INLINE void SobelGradient32f(const View<A>& src, View<A>& magnitude, View<A>& direction)
+    {
+        assert(src.format == View<A>::Gray8);
+        assert(magnitude.data == NULL || (EqualSize(src, magnitude) && magnitude.format == View<A>::Float));
+        assert(direction.data == NULL || (EqualSize(src, direction) && direction.format == View<A>::Float));
+
+        SimdSobelGradient32f(src.data, src.stride, src.width, src.height, magnitude.data, magnitude.stride, direction.data, direction.stride);
+    }
+
     /*! @ingroup sobel_statistic
 
         \fn void SobelDyAbsSum(const View<A>& src, uint64_t & sum)
@@ -2977,6 +3183,46 @@ namespace Simd
         SimdGetMoments(mask.data, mask.stride, mask.width, mask.height, index, &area, &x, &y, &xx, &xy, &yy);
     }
 
+    /*! @ingroup other_statistic
+
+        \fn void GetImageStatistics(const View<A> & src, const View<A> & mask, uint8_t index, uint32_t flags, SimdImageStatistics & statistics)
+
+        \short Calculates several statistics of 8-bit gray image in one pass. Only pixels with mask[x, y] == index are processed.
+
+        \note This function is a C++ wrapper for function ::SimdGetImageStatistics. 
+            Its multithreaded version is defined in file SimdParallel.hpp.
+
+        \param [in] src - an input 8-bit gray image.
+        \param [in] mask - a 8-bit mask image. It must have the same size as the input image.
+        \param [in] index - a mask index.
+        \param [in] flags - a set of calculated statistics (see ::SimdImageStatisticsFlags).
+        \param [out] statistics - a reference to structure with calculated statistics.
+    */
+    template<template<class> class A> SIMD_INLINE void GetImageStatistics(const View<A> & src, const View<A> & mask, uint8_t index, uint32_t flags, SimdImageStatistics & statistics)
+    {
+        assert(src.format == View<A>::Gray8 && (mask.data == NULL || Compatible(src, mask)));
+
+        SimdGetImageStatistics(src.data, src.stride, src.width, src.height, mask.data, mask.stride, index, flags, 0, src.height, &statistics);
+    }
+
+    /*! @ingroup other_statistic
+
+        \fn void GetImageStatistics(const View<A> & src, uint32_t flags, SimdImageStatistics & statistics)
+
+        \short Calculates several statistics of 8-bit gray image in one pass.
+
+        \note This function is a C++ wrapper for function ::SimdGetImageStatistics. 
+            Its multithreaded version is defined in file SimdParallel.hpp.
+
+        \param [in] src - an input 8-bit gray image.
+        \param [in] flags - a set of calculated statistics (see ::SimdImageStatisticsFlags).
+        \param [out] statistics - a reference to structure with calculated statistics.
+    */
+    template<template<class> class A> SIMD_INLINE void GetImageStatistics(const View<A> & src, uint32_t flags, SimdImageStatistics & statistics)
+    {
+        GetImageStatistics(src, View<A>(), 0, flags, statistics);
+    }
+
     /*! @ingroup row_statistic
 
         \fn void GetRowSums(const View<A>& src, uint32_t * sums)
@@ -260,6 +260,30 @@ namespace Simd
             gradient[offset] += d*d;
             weight[offset] -= alpha * d / ::sqrt(gradient[offset] + epsilon);
         }
+
+        SIMD_INLINE void AdamUpdate(const float * delta, size_t offset, float norm, float alpha, float beta1, float beta2, float epsilon, float decay, float * moment1, float * moment2, float * weight)
+        {
+            float d = delta[offset]*norm;
+            moment1[offset] = beta1*moment1[offset] + (1.0f - beta1)*d;
+            moment2[offset] = beta2*moment2[offset] + (1.0f - beta2)*d*d;
+            weight[offset] -= alpha*moment1[offset]/(::sqrt(moment2[offset]) + epsilon) + decay*weight[offset];
+        }
+
+        SIMD_INLINE float Atan2(float y, float x) // maximal absolute error 0.00001, result is in range [0, 2*pi)
+        {
+            float ax = ::fabs(x), ay = ::fabs(y);
+            float max = Simd::Max(ax, ay), min = Simd::Min(ax, ay);
+            float a = max > 0.0f ? min/max : 0.0f;
+            float s = a*a;
+            float r = ((-0.0464964749f*s + 0.15931422f)*s - 0.327622764f)*s*a + a;
+            if (ay > ax)
+                r = 1.57079637f - r;
+            if (x < 0.0f)
+                r = 3.14159274f - r;
+            if (y < 0.0f)
+                r = 6.28318548f - r;
+            return r;
+        }
 	}
 
 #ifdef SIMD_SSE_ENABLE
@@ -280,6 +304,21 @@ namespace Simd
             const int32_t mask[DF] = { 0, 0, 0, 0, -1, -1, -1, -1 };
             return _mm_loadu_ps((float*)(mask + count));
         }
+
+        SIMD_INLINE __m128 Atan2(__m128 y, __m128 x)
+        {
+            const __m128 sign = _mm_set1_ps(-0.0f);
+            __m128 ax = _mm_andnot_ps(sign, x), ay = _mm_andnot_ps(sign, y);
+            __m128 max = _mm_max_ps(ax, ay), min = _mm_min_ps(ax, ay);
+            __m128 a = _mm_and_ps(_mm_cmpgt_ps(max, _mm_setzero_ps()), _mm_div_ps(min, max));
+            __m128 s = _mm_mul_ps(a, a);
+            __m128 r = _mm_add_ps(_mm_mul_ps(_mm_mul_ps(_mm_sub_ps(_mm_mul_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(-0.0464964749f), s), 
+                _mm_set1_ps(0.15931422f)), s), _mm_set1_ps(0.327622764f)), s), a), a);
+            r = Combine(_mm_cmpgt_ps(ay, ax), _mm_sub_ps(_mm_set1_ps(1.57079637f), r), r);
+            r = Combine(_mm_cmplt_ps(x, _mm_setzero_ps()), _mm_sub_ps(_mm_set1_ps(3.14159274f), r), r);
+            r = Combine(_mm_cmplt_ps(y, _mm_setzero_ps()), _mm_sub_ps(_mm_set1_ps(6.28318548f), r), r);
+            return r;
+        }
     }
 #endif//SIMD_SSE_ENABLE
 
@@ -447,6 +486,21 @@ namespace Simd
             return _mm256_loadu_ps((float*)(mask + count));
         }
 
+        SIMD_INLINE __m256 Atan2(__m256 y, __m256 x)
+        {
+            const __m256 sign = _mm256_set1_ps(-0.0f);
+            __m256 ax = _mm256_andnot_ps(sign, x), ay = _mm256_andnot_ps(sign, y);
+            __m256 max = _mm256_max_ps(ax, ay), min = _mm256_min_ps(ax, ay);
+            __m256 a = _mm256_and_ps(_mm256_cmp_ps(max, _mm256_setzero_ps(), _CMP_GT_OQ), _mm256_div_ps(min, max));
+            __m256 s = _mm256_mul_ps(a, a);
+            __m256 r = _mm256_add_ps(_mm256_mul_ps(_mm256_mul_ps(_mm256_sub_ps(_mm256_mul_ps(_mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(-0.0464964749f), s), 
+                _mm256_set1_ps(0.15931422f)), s), _mm256_set1_ps(0.327622764f)), s), a), a);
+            r = _mm256_blendv_ps(r, _mm256_sub_ps(_mm256_set1_ps(1.57079637f), r), _mm256_cmp_ps(ay, ax, _CMP_GT_OQ));
+            r = _mm256_blendv_ps(r, _mm256_sub_ps(_mm256_set1_ps(3.14159274f), r), _mm256_cmp_ps(x, _mm256_setzero_ps(), _CMP_LT_OQ));
+            r = _mm256_blendv_ps(r, _mm256_sub_ps(_mm256_set1_ps(6.28318548f), r), _mm256_cmp_ps(y, _mm256_setzero_ps(), _CMP_LT_OQ));
+            return r;
+        }
+
         SIMD_INLINE __m256 PermutedHorizontalAdd(__m256 a, __m256 b)
         {
             return _mm256_hadd_ps(_mm256_permute2f128_ps(a, b, 0x20), _mm256_permute2f128_ps(a, b, 0x31));
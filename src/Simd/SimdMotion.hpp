@@ -171,7 +171,7 @@ namespace Simd
                 if (output && output->format == Frame::Bgr24)
                 {
                     const View & src = _scene.difference[1];
-                    Simd::GrayToBgr(src, output->planes[0].Region(src.Size(), View::BottomRight));
+                    Simd::GrayToBgr(src, output->planes[0].Region(src.Size(), View::BottomRight).Ref());
                 }
 
                 return true;
@@ -0,0 +1,335 @@
+/*
+* Simd Library (http://simd.sourceforge.net).
+*
+* Copyright (c) 2011-2017 Yermalayeu Ihar.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+#ifndef __SimdNeural_h__
+#define __SimdNeural_h__
+
+#include "Simd/SimdMemory.h"
+
+namespace Simd
+{
+    namespace Base
+    {
+        typedef void(*Gemm32fNNPtr)(size_t M, size_t N, size_t K, const float * alpha, const float * A, size_t lda, 
+            const float * B, size_t ldb, const float * beta, float * C, size_t ldc);
+
+        /*
+        * Geometry of generic convolution: input image (srcWidth x srcHeight x srcDepth) is convolved with 
+        * dstDepth kernels (kernelX x kernelY x srcDepth) with given padding, stride and dilation.
+        */
+        struct NeuralConvolutionShape
+        {
+            size_t srcWidth, srcHeight, srcDepth, kernelX, kernelY, padX, padY, strideX, strideY, dilationX, dilationY, dstWidth, dstHeight, dstDepth;
+
+            SIMD_INLINE NeuralConvolutionShape(size_t srcWidth_, size_t srcHeight_, size_t srcDepth_, size_t kernelX_, size_t kernelY_, 
+                size_t padX_, size_t padY_, size_t strideX_, size_t strideY_, size_t dilationX_, size_t dilationY_, size_t dstWidth_, size_t dstHeight_, size_t dstDepth_)
+                : srcWidth(srcWidth_), srcHeight(srcHeight_), srcDepth(srcDepth_), kernelX(kernelX_), kernelY(kernelY_), padX(padX_), padY(padY_)
+                , strideX(strideX_), strideY(strideY_), dilationX(dilationX_), dilationY(dilationY_), dstWidth(dstWidth_), dstHeight(dstHeight_), dstDepth(dstDepth_)
+            {
+                assert(dstWidth == (srcWidth + 2 * padX - (dilationX * (kernelX - 1) + 1)) / strideX + 1);
+                assert(dstHeight == (srcHeight + 2 * padY - (dilationY * (kernelY - 1) + 1)) / strideY + 1);
+            }
+
+            // A size of kernel (a row of weight matrix).
+            SIMD_INLINE size_t Kernel() const 
+            { 
+                return srcDepth*kernelY*kernelX; 
+            }
+
+            SIMD_INLINE size_t DstArea() const 
+            { 
+                return dstHeight*dstWidth; 
+            }
+
+            // Convolution 1x1 with unit stride and without padding is a simple matrix product, it does not need im2col transformation.
+            SIMD_INLINE bool Is1x1() const
+            {
+                return kernelX == 1 && kernelY == 1 && strideX == 1 && strideY == 1 && padX == 0 && padY == 0;
+            }
+        };
+
+        /*
+        * Temporary buffer of generic convolution: external buffer is used if it has enough size, else internal one is allocated.
+        */
+        class NeuralConvolutionBuffer
+        {
+        public:
+            SIMD_INLINE NeuralConvolutionBuffer(void * buffer, size_t * size, size_t required)
+                : _p(NULL)
+            {
+                required *= sizeof(float);
+                if (buffer && size && *size >= required)
+                    data = (float*)buffer;
+                else
+                {
+                    if (size)
+                        *size = required;
+                    _p = Allocate(required);
+                    data = (float*)_p;
+                }
+            }
+
+            SIMD_INLINE ~NeuralConvolutionBuffer()
+            {
+                if (_p)
+                    Free(_p);
+            }
+
+            float * data;
+
+        private:
+            void * _p;
+        };
+
+        // Converts image to matrix [kernel][dstArea] (column of the matrix is a patch of the image under the kernel).
+        SIMD_INLINE void NeuralConvolutionIm2Col(const NeuralConvolutionShape & s, const float * src, float * dst)
+        {
+            for (size_t c = 0; c < s.srcDepth; ++c)
+            {
+                for (size_t ky = 0; ky < s.kernelY; ++ky)
+                {
+                    for (size_t kx = 0; kx < s.kernelX; ++kx)
+                    {
+                        for (size_t dy = 0; dy < s.dstHeight; ++dy)
+                        {
+                            size_t sy = dy*s.strideY + ky*s.dilationY - s.padY;
+                            if (sy < s.srcHeight)
+                            {
+                                const float * ps = src + (c*s.srcHeight + sy)*s.srcWidth;
+                                for (size_t dx = 0; dx < s.dstWidth; ++dx)
+                                {
+                                    size_t sx = dx*s.strideX + kx*s.dilationX - s.padX;
+                                    dst[dx] = sx < s.srcWidth ? ps[sx] : 0;
+                                }
+                            }
+                            else
+                                memset(dst, 0, s.dstWidth * sizeof(float));
+                            dst += s.dstWidth;
+                        }
+                    }
+                }
+            }
+        }
+
+        // Accumulates matrix [kernel][dstArea] to image (inverse operation to NeuralConvolutionIm2Col).
+        SIMD_INLINE void NeuralConvolutionCol2Im(const NeuralConvolutionShape & s, const float * src, float * dst)
+        {
+            for (size_t c = 0; c < s.srcDepth; ++c)
+            {
+                for (size_t ky = 0; ky < s.kernelY; ++ky)
+                {
+                    for (size_t kx = 0; kx < s.kernelX; ++kx)
+                    {
+                        for (size_t dy = 0; dy < s.dstHeight; ++dy)
+                        {
+                            size_t sy = dy*s.strideY + ky*s.dilationY - s.padY;
+                            if (sy < s.srcHeight)
+                            {
+                                float * pd = dst + (c*s.srcHeight + sy)*s.srcWidth;
+                                for (size_t dx = 0; dx < s.dstWidth; ++dx)
+                                {
+                                    size_t sx = dx*s.strideX + kx*s.dilationX - s.padX;
+                                    if (sx < s.srcWidth)
+                                        pd[sx] += src[dx];
+                                }
+                            }
+                            src += s.dstWidth;
+                        }
+                    }
+                }
+            }
+        }
+
+        // Converts image to matrix [dstArea][kernel] (row of the matrix is a patch of the image under the kernel).
+        SIMD_INLINE void NeuralConvolutionIm2Row(const NeuralConvolutionShape & s, const float * src, float * dst)
+        {
+            size_t kernel = s.Kernel();
+            for (size_t c = 0, k = 0; c < s.srcDepth; ++c)
+            {
+                for (size_t ky = 0; ky < s.kernelY; ++ky)
+                {
+                    for (size_t kx = 0; kx < s.kernelX; ++kx, ++k)
+                    {
+                        float * pd = dst + k;
+                        for (size_t dy = 0; dy < s.dstHeight; ++dy)
+                        {
+                            size_t sy = dy*s.strideY + ky*s.dilationY - s.padY;
+                            if (sy < s.srcHeight)
+                            {
+                                const float * ps = src + (c*s.srcHeight + sy)*s.srcWidth;
+                                for (size_t dx = 0; dx < s.dstWidth; ++dx, pd += kernel)
+                                {
+                                    size_t sx = dx*s.strideX + kx*s.dilationX - s.padX;
+                                    *pd = sx < s.srcWidth ? ps[sx] : 0;
+                                }
+                            }
+                            else
+                            {
+                                for (size_t dx = 0; dx < s.dstWidth; ++dx, pd += kernel)
+                                    *pd = 0;
+                            }
+                        }
+                    }
+                }
+            }
+        }
+
+        /*
+        * Generic drivers of convolution (forward propagation, backward propagation of delta and accumulation of weight changes). 
+        * They reduce the convolution to product of matrices (it is performed by gemm). Weight has layout [dstDepth][srcDepth][kernelY][kernelX].
+        */
+        template <Gemm32fNNPtr gemm> void NeuralConvolutionForwardRun(const NeuralConvolutionShape & s, const float * src, const float * weight, 
+            void * buffer, size_t * size, float * dst, int add)
+        {
+            const float alpha = 1.0f, beta = add ? 1.0f : 0.0f;
+            size_t K = s.Kernel(), N = s.DstArea();
+            if (s.Is1x1())
+                gemm(s.dstDepth, N, K, &alpha, weight, K, src, N, &beta, dst, N);
+            else
+            {
+                NeuralConvolutionBuffer cols(buffer, size, K*N);
+                NeuralConvolutionIm2Col(s, src, cols.data);
+                gemm(s.dstDepth, N, K, &alpha, weight, K, cols.data, N, &beta, dst, N);
+            }
+        }
+
+        template <Gemm32fNNPtr gemm> void NeuralConvolutionBackwardRun(const NeuralConvolutionShape & s, const float * src, const float * weight,
+            void * buffer, size_t * size, float * dst, int add)
+        {
+            const float alpha = 1.0f, zero = 0.0f, beta = add ? 1.0f : 0.0f;
+            size_t K = s.Kernel(), N = s.DstArea();
+            NeuralConvolutionBuffer tmp(buffer, size, K*s.dstDepth + (s.Is1x1() ? 0 : K*N));
+            float * transposed = tmp.data;
+            for (size_t i = 0; i < s.dstDepth; ++i)
+                for (size_t k = 0; k < K; ++k)
+                    transposed[k*s.dstDepth + i] = weight[i*K + k];
+            if (s.Is1x1())
+                gemm(K, N, s.dstDepth, &alpha, transposed, s.dstDepth, src, N, &beta, dst, N);
+            else
+            {
+                float * cols = transposed + K*s.dstDepth;
+                gemm(K, N, s.dstDepth, &alpha, transposed, s.dstDepth, src, N, &zero, cols, N);
+                if (!add)
+                    memset(dst, 0, s.srcWidth*s.srcHeight*s.srcDepth * sizeof(float));
+                NeuralConvolutionCol2Im(s, cols, dst);
+            }
+        }
+
+        template <Gemm32fNNPtr gemm> void NeuralConvolutionSumRun(const NeuralConvolutionShape & s, const float * src, const float * dst,
+            void * buffer, size_t * size, float * sums)
+        {
+            const float alpha = 1.0f, beta = 1.0f;
+            size_t K = s.Kernel(), N = s.DstArea();
+            NeuralConvolutionBuffer rows(buffer, size, N*K);
+            NeuralConvolutionIm2Row(s, src, rows.data);
+            gemm(s.dstDepth, K, N, &alpha, dst, N, rows.data, K, &beta, sums, K);
+        }
+
+        /*
+        * Winograd convolution F(2x2, 3x3): every 2x2 output tile is computed from 4x4 input tile with using of 16 multiplications
+        * instead of 36 (Y = AT*((G*g*GT) .* (BT*d*B))*A). Transformed filters, inputs and outputs are stored as 16 matrices:
+        * filter - [16][dstDepth][srcDepth], input - [16][srcDepth][tiles], output - [16][dstDepth][tiles].
+        * So the product in transformed space is 16 independent matrix multiplications.
+        */
+        SIMD_INLINE void NeuralWinograd2x2p3x3SetFilter1(const float * src, float * dst, size_t stride)
+        {
+            const float r2 = 1.0f / 2.0f;
+            const float r4 = 1.0f / 4.0f;
+            dst[0 * stride] = src[0];
+            dst[1 * stride] = (src[0] + src[1] + src[2])*r2;
+            dst[2 * stride] = (src[0] - src[1] + src[2])*r2;
+            dst[3 * stride] = src[2];
+            dst[4 * stride] = (src[0] + src[3] + src[6])*r2;
+            dst[5 * stride] = (src[0] + src[1] + src[2] + src[3] + src[4] + src[5] + src[6] + src[7] + src[8])*r4;
+            dst[6 * stride] = (src[0] - src[1] + src[2] + src[3] - src[4] + src[5] + src[6] - src[7] + src[8])*r4;
+            dst[7 * stride] = (src[2] + src[5] + src[8])*r2;
+            dst[8 * stride] = (src[0] - src[3] + src[6])*r2;
+            dst[9 * stride] = (src[0] + src[1] + src[2] - src[3] - src[4] - src[5] + src[6] + src[7] + src[8])*r4;
+            dst[10 * stride] = (src[0] - src[1] + src[2] - src[3] + src[4] - src[5] + src[6] - src[7] + src[8])*r4;
+            dst[11 * stride] = (src[2] - src[5] + src[8])*r2;
+            dst[12 * stride] = src[6];
+            dst[13 * stride] = (src[6] + src[7] + src[8])*r2;
+            dst[14 * stride] = (src[6] - src[7] + src[8])*r2;
+            dst[15 * stride] = src[8];
+        }
+
+        SIMD_INLINE void NeuralWinograd2x2p3x3SetInput1(const float * src, size_t srcStride, float * dst, size_t dstStride)
+        {
+            float tmp[16];
+            const float * src0 = src + 0 * srcStride;
+            const float * src1 = src + 1 * srcStride;
+            const float * src2 = src + 2 * srcStride;
+            const float * src3 = src + 3 * srcStride;
+            for (size_t i = 0; i < 4; ++i)
+            {
+                tmp[0 + i] = src0[i] - src2[i];
+                tmp[4 + i] = src1[i] + src2[i];
+                tmp[8 + i] = src2[i] - src1[i];
+                tmp[12 + i] = src1[i] - src3[i];
+            }
+            for (size_t i = 0; i < 16; i += 4)
+            {
+                dst[(i + 0)*dstStride] = tmp[i + 0] - tmp[i + 2];
+                dst[(i + 1)*dstStride] = tmp[i + 1] + tmp[i + 2];
+                dst[(i + 2)*dstStride] = tmp[i + 2] - tmp[i + 1];
+                dst[(i + 3)*dstStride] = tmp[i + 1] - tmp[i + 3];
+            }
+        }
+
+        // Transforms input tile which is cropped by image border (rows x cols, missing points are equal to zero).
+        SIMD_INLINE void NeuralWinograd2x2p3x3SetInput1(const float * src, size_t srcStride, size_t rows, size_t cols, float * dst, size_t dstStride)
+        {
+            float tmp[16] = { 0 };
+            for (size_t row = 0; row < rows; ++row)
+                for (size_t col = 0; col < cols; ++col)
+                    tmp[row * 4 + col] = src[row*srcStride + col];
+            NeuralWinograd2x2p3x3SetInput1(tmp, 4, dst, dstStride);
+        }
+
+        // Transforms output tile and stores its visible part (rows x cols).
+        SIMD_INLINE void NeuralWinograd2x2p3x3SetOutput1(const float * src, size_t srcStride, float * dst, size_t dstStride, size_t rows = 2, size_t cols = 2)
+        {
+            float tmp[8];
+            for (size_t i = 0; i < 4; ++i)
+            {
+                tmp[0 + i] = src[i*srcStride] + src[(i + 4)*srcStride] + src[(i + 8)*srcStride];
+                tmp[4 + i] = src[(i + 4)*srcStride] - src[(i + 8)*srcStride] - src[(i + 12)*srcStride];
+            }
+            float out[4];
+            out[0] = tmp[0] + tmp[1] + tmp[2];
+            out[1] = tmp[1] - tmp[2] - tmp[3];
+            out[2] = tmp[4] + tmp[5] + tmp[6];
+            out[3] = tmp[5] - tmp[6] - tmp[7];
+            for (size_t row = 0; row < rows; ++row)
+                for (size_t col = 0; col < cols; ++col)
+                    dst[row*dstStride + col] = out[row * 2 + col];
+        }
+
+        SIMD_INLINE size_t NeuralWinograd2x2p3x3Tiles(size_t dstWidth, size_t dstHeight)
+        {
+            return ((dstWidth + 1) / 2)*((dstHeight + 1) / 2);
+        }
+    }
+}
+
+#endif//__SimdNeural_h__
@@ -29,6 +29,9 @@
 
 #include <numeric>
 #include <random>
+#include <limits>
+#include <fstream>
+#include <chrono>
 
 #ifndef SIMD_CHECK_PERFORMANCE
 #define SIMD_CHECK_PERFORMANCE()
@@ -57,12 +60,6 @@ namespace Simd
                 memset(vector.data(), 0, vector.size()*sizeof(T));
             }
 
-            SIMD_INLINE void AddTo(const Vector & src, Vector & dst)
-            {
-                const float one = 1;
-                ::SimdNeuralAddVectorMultipliedByValue(src.data(), src.size(), &one, dst.data());
-            }
-
             SIMD_INLINE int RandomUniform(int min, int max)
             {
                 static std::mt19937 gen(1);
@@ -76,6 +73,44 @@ namespace Simd
                 std::uniform_real_distribution<float> dst(min, max);
                 return dst(gen);
             }
+
+            /*
+            * Read only array of weights (or biases) of a layer. It either owns its elements (weights are trained or loaded 
+            * from text file) or refers to memory mapped binary network file (see Network::LoadBinary). 
+            * Weights are modified only through Array::Own which copies referred elements to own memory at first.
+            */
+            class Array
+            {
+            public:
+                Array() : _data(NULL), _size(0) {}
+
+                void resize(size_t size) { _vector.resize(size); _data = _vector.data(); _size = size; }
+                void clear() { Vector().swap(_vector); _data = NULL; _size = 0; }
+                void Refer(const float * data, size_t size) { Vector().swap(_vector); _data = data; _size = size; }
+                bool Refers() const { return _data != _vector.data(); }
+
+                Vector & Own()
+                {
+                    if (Refers())
+                    {
+                        _vector.assign(_data, _data + _size);
+                        _data = _vector.data();
+                    }
+                    return _vector;
+                }
+
+                size_t size() const { return _size; }
+                const float * data() const { return _data; }
+                const float & operator[](size_t i) const { assert(i < _size); return _data[i]; }
+
+            private:
+                Vector _vector;
+                const float * _data;
+                size_t _size;
+
+                Array(const Array &);
+                Array & operator = (const Array &);
+            };
         }
 
         /*! @ingroup cpp_neural
@@ -376,6 +411,22 @@ namespace Simd
                 return v.data() + offset;
             }
 
+            /*!
+                Gets constant address of 3D-point in array of weights (which can refer to memory mapped file).
+
+                \param [in] a - an array of weights.
+                \param [in] x - x-coordinate of 3D-point.
+                \param [in] y - y-coordinate of 3D-point.
+                \param [in] c - z-coordinate(channel) of 3D-point.
+                \return - a constant address of the point in the array.
+            */
+            SIMD_INLINE const float * Get(const Detail::Array & a, ptrdiff_t x, ptrdiff_t y, ptrdiff_t c) const
+            {
+                size_t offset = Offset(x, y, c);
+                assert(offset < a.size());
+                return a.data() + offset;
+            }
+
             /*!
                 Gets 2D-size (width and height) of the channel in the Index.
 
@@ -428,6 +479,7 @@ namespace Simd
                 MaxPooling, /*!< \brief Layer type corresponding to Simd::Neural::MaxPoolingLayer. */
                 FullyConnected, /*!< \brief Layer type corresponding to Simd::Neural::FullyConnectedLayer. */
                 Dropout, /*!< \brief Layer type corresponding to Simd::Neural::DropoutLayer. */
+                DepthwiseConvolutional, /*!< \brief Layer type corresponding to Simd::Neural::DepthwiseConvolutionalLayer. */
             };
 
             /*!
@@ -440,6 +492,8 @@ namespace Simd
                 Fast, /*!< \brief The fastest method. It is incompatible with train process.*/
                 Check, /*!< \brief Control checking during train process.*/
                 Train, /*!< \brief Forward propagation in train process.*/
+                Int8, /*!< \brief Fast method with using of 8-bit integer arithmetic in convolutional and fully connected layers (see Network::Quantize). 
+                           Layers without quantized weights use Layer::Fast method. */
             };
 
             /*!
@@ -451,12 +505,41 @@ namespace Simd
 
             virtual void Forward(const Vector & src, size_t thread, Method method) = 0;
 
+            virtual void ForwardBatch(const float * src, size_t count, float * dst, float * buffer) = 0;
+
+            // Returns size (in floats) of temporary buffer which is required by ForwardBatch for given number of samples.
+            virtual size_t BatchBuffer(size_t count) const
+            {
+                return 0;
+            }
+
             virtual void Backward(const Vector & src, size_t thread) = 0;
 
             virtual size_t FanSrc() const = 0;
 
             virtual size_t FanDst() const = 0;
 
+            /*!
+                Gets weights of the layer. After Network::LoadBinary they refer to memory mapped binary file.
+
+                \return a pointer to weights of the layer (NULL if the layer has no weights). FullyConnectedLayer returns 
+                    weights in [dst][src] layout used in prediction if they are prepared.
+            */
+            virtual const float * Weight() const
+            {
+                return _weight.data();
+            }
+
+            /*!
+                Gets biases of the layer.
+
+                \return a pointer to biases of the layer (NULL if the layer has no biases).
+            */
+            const float * Bias() const
+            {
+                return _bias.data();
+            }
+
             virtual void SetThreadNumber(size_t number, bool train)
             {
                 _common.resize(number);
@@ -475,6 +558,8 @@ namespace Simd
                 {
                     _gWeight.resize(_weight.size());
                     _gBias.resize(_bias.size());
+                    _mWeight.resize(_weight.size());
+                    _mBias.resize(_bias.size());
                 }
             }
 
@@ -484,6 +569,7 @@ namespace Simd
                 , _function(f)
                 , _prev(0)
                 , _next(0)
+                , _inEpilogue(false)
             {
             }
 
@@ -508,28 +594,105 @@ namespace Simd
             {
                 return _common[thread].prevDelta;
             }
+
+            // Quantizes weights with given input range [min, max] (see Network::Quantize). Layers without weights ignore it.
+            virtual void Quantize(float min, float max)
+            {
+            }
+
+            // Copies weights which refer to memory mapped binary file to own memory (it is called before modification of weights).
+            virtual void Detach()
+            {
+                _weight.Own();
+                _bias.Own();
+            }
+
+            // Number of weights in the training layout (see Network::LoadBinary).
+            virtual size_t WeightSize() const
+            {
+                return _weight.size();
+            }
+
+            /*
+            * Input values are quantized to 8-bit unsigned integers: q = Round(x*scale + shift) (0 is represented exactly). 
+            * Weights [rows][cols] are quantized to 7-bit signed integers (with the same Round) with own scale for every row: 
+            * so ::SimdNeuralProductSum8u8i can't overflow the 16-bit intermediate sums of pairs of products.
+            * Rows are padded by zeros to SIMD alignment in order to avoid of scalar tails in ::SimdNeuralProductSum8u8i.
+            */
+            void QuantizeWeight(const float * weight, size_t rows, size_t cols, float min, float max)
+            {
+                min = std::min(min, 0.0f);
+                max = std::max(max, 0.0f);
+                _quantized.scale = max > min ? 255.0f / (max - min) : 1.0f;
+                _quantized.shift = (float)Round(-min*_quantized.scale);
+                _quantized.stride = Allocator<int8_t>::Align(cols, Allocator<int8_t>::Alignment());
+                _quantized.weight.assign(rows*_quantized.stride, 0);
+                _quantized.zero.resize(rows);
+                _quantized.norm.resize(rows);
+                for (size_t i = 0; i < rows; ++i)
+                {
+                    const float * w = weight + i*cols;
+                    int8_t * q = _quantized.weight.data() + i*_quantized.stride;
+                    float range = 0;
+                    for (size_t j = 0; j < cols; ++j)
+                        range = std::max(range, std::abs(w[j]));
+                    float scale = range > 0 ? 63.0f / range : 1.0f;
+                    int32_t sum = 0;
+                    for (size_t j = 0; j < cols; ++j)
+                    {
+                        q[j] = (int8_t)Round(w[j] * scale);
+                        sum += q[j];
+                    }
+                    _quantized.zero[i] = sum*(int32_t)_quantized.shift;
+                    _quantized.norm[i] = 1.0f / (scale*_quantized.scale);
+                }
+            }
+
+            // Restores float sums from the products of quantized input and quantized weights.
+            void Dequantize(const int32_t * src, size_t count, size_t stride, float * dst) const
+            {
+                for (size_t i = 0; i < count; ++i)
+                    dst[i*stride] = float(src[i] - _quantized.zero[i])*_quantized.norm[i];
+            }
             
             const Type _type;
             const Function _function;
 
             Layer * _prev, *_next;
 
+            bool _inEpilogue; // Forward propagation of this layer is performed in epilogue of previous layer in Layer::Fast and Layer::Int8 modes.
+
             Index _src, _dst;
-            Vector _weight, _bias, _gWeight, _gBias;
+            Detail::Array _weight, _bias;
+            Vector _gWeight, _gBias, _mWeight, _mBias;
 
             struct Common
             {
                 Vector sum, dst;
 
                 Vector dWeight, dBias, prevDelta;
+
+                std::vector<uint8_t> src8;
+                std::vector<int32_t> sum32;
             };
             std::vector<Common> _common;
 
+            struct Quantized
+            {
+                float scale, shift;
+                size_t stride;
+                std::vector<int8_t> weight;
+                std::vector<int32_t> zero;
+                Vector norm;
+            };
+            Quantized _quantized;
+
             friend class InputLayer;
             friend class ConvolutionalLayer;
             friend class MaxPoolingLayer;
             friend class FullyConnectedLayer;
             friend class DropoutLayer;
+            friend class DepthwiseConvolutionalLayer;
             friend class Network;
         };
         typedef std::shared_ptr<Layer> LayerPtr;
@@ -549,6 +712,11 @@ namespace Simd
                 _common[thread].dst = src;
             }
 
+            void ForwardBatch(const float * src, size_t count, float * dst, float * buffer) override
+            {
+                memcpy(dst, src, count*_dst.Volume()*sizeof(float));
+            }
+
             void Backward(const Vector & src, size_t thread) override
             {
             }
@@ -574,11 +742,123 @@ namespace Simd
             friend class Network;
         };
 
+        namespace Detail
+        {
+            // Helpers of convolutional layers: core, padded (input) and dst are the shapes of a layer (only width and height are used).
+
+            SIMD_INLINE void AddConvolution(const Index & core, const Index & padded, const Index & dst, const float * src, const float * weight, float * sum)
+            {
+                if (core.width == 3 && core.height == 3)
+                    ::SimdNeuralAddConvolution3x3(src, padded.width, dst.width, dst.height, weight, sum, dst.width);
+                else if (core.width == 5 && core.height == 5)
+                    ::SimdNeuralAddConvolution5x5(src, padded.width, dst.width, dst.height, weight, sum, dst.width);
+                else
+                {
+                    for (ptrdiff_t y = 0; y < dst.height; y++)
+                    {
+                        for (ptrdiff_t x = 0; x < dst.width; x++)
+                        {
+                            const float * pw = weight;
+                            const float * ps = src + y * padded.width + x;
+                            float s = 0;
+                            for (ptrdiff_t wy = 0; wy < core.height; wy++)
+                                for (ptrdiff_t wx = 0; wx < core.width; wx++)
+                                    s += *pw++ * ps[wy * padded.width + wx];
+                            sum[y * dst.width + x] += s;
+                        }
+                    }
+                }
+            }
+
+            SIMD_INLINE void AddConvolutionBack(const Index & core, const Index & padded, const Index & dst, const float * delta, const float * weight, float * prevDelta)
+            {
+                if (core.width == 3 && core.height == 3)
+                    ::SimdNeuralAddConvolution3x3Back(delta, dst.width, dst.width, dst.height, weight, prevDelta, padded.width);
+                else if (core.width == 5 && core.height == 5)
+                    ::SimdNeuralAddConvolution5x5Back(delta, dst.width, dst.width, dst.height, weight, prevDelta, padded.width);
+                else
+                {
+                    for (ptrdiff_t y = 0; y < dst.height; y++)
+                    {
+                        for (ptrdiff_t x = 0; x < dst.width; x++)
+                        {
+                            const float * pw = weight;
+                            const float d = delta[y*dst.width + x];
+                            float * pd = prevDelta + y*padded.width + x;
+                            for (ptrdiff_t wy = 0; wy < core.height; wy++)
+                                for (ptrdiff_t wx = 0; wx < core.width; wx++)
+                                    pd[wy * padded.width + wx] += *pw++ * d;
+                        }
+                    }
+                }
+            }
+
+            SIMD_INLINE void AddConvolutionSum(const Index & core, const Index & padded, const Index & dst, const float * src, const float * delta, float * sums)
+            {
+                if (core.width == 3 && core.height == 3)
+                    ::SimdNeuralAddConvolution3x3Sum(src, padded.width, delta, dst.width, dst.width, dst.height, sums);
+                else if (core.width == 5 && core.height == 5)
+                    ::SimdNeuralAddConvolution5x5Sum(src, padded.width, delta, dst.width, dst.width, dst.height, sums);
+                else
+                {
+                    for (ptrdiff_t wy = 0; wy < core.height; wy++)
+                    {
+                        for (ptrdiff_t wx = 0; wx < core.width; wx++)
+                        {
+                            float sum = 0;
+                            for (ptrdiff_t y = 0; y < dst.height; y++)
+                            {
+                                float product;
+                                ::SimdNeuralProductSum(src + (y + wy)*padded.width + wx, delta + y*dst.width, dst.width, &product);
+                                sum += product;
+                            }
+                            sums[wy*core.width + wx] += sum;
+                        }
+                    }
+                }
+            }
+
+            SIMD_INLINE void AddBias(float bias, size_t size, float * sum)
+            {
+                for (size_t i = 0; i < size; ++i)
+                    sum[i] += bias;
+            }
+
+            // Copies image into the middle of padded image (borders of padded image are not changed).
+            SIMD_INLINE void Pad(const Index & src, const Index & padded, size_t indent, const float * s, float * d)
+            {
+                size_t size = src.width*sizeof(float);
+                for (ptrdiff_t c = 0; c < src.depth; ++c)
+                    for (ptrdiff_t y = 0; y < src.height; ++y)
+                        memcpy(d + padded.Offset(indent, indent + y, c), s + src.Offset(0, y, c), size);
+            }
+
+            SIMD_INLINE void PadBatch(const Index & src, const Index & padded, size_t indent, const float * s, size_t count, float * d)
+            {
+                memset(d, 0, count*padded.Volume()*sizeof(float));
+                for (size_t i = 0; i < count; ++i)
+                    Pad(src, padded, indent, s + i*src.Volume(), d + i*padded.Volume());
+            }
+
+            SIMD_INLINE void Unpad(const Index & src, const Index & padded, size_t indent, const float * s, float * d)
+            {
+                size_t size = src.width*sizeof(float);
+                for (ptrdiff_t c = 0; c < src.depth; ++c)
+                    for (ptrdiff_t y = 0; y < src.height; ++y)
+                        memcpy(d + src.Offset(0, y, c), s + padded.Offset(indent, indent + y, c), size);
+            }
+        }
+
         /*! @ingroup cpp_neural
 
             \short ConfolutionLayer class.
 
             Convolutional layer in neural network.
+
+            \note Big layers with 3x3 core use Winograd F(2x2, 3x3) convolution in Layer::Fast mode and in batch prediction 
+            (see ::SimdNeuralWinograd2x2p3x3SetInput). Transformed weights are prepared by Network::Load and Network::Train.
+            Layers with 1x1 core (pointwise convolution) are performed as a direct product of weight matrix and input image 
+            (see ::SimdNeuralConvolutionForward) without padding and intermediate buffers.
         */
         class ConvolutionalLayer : public Layer
         {
@@ -600,7 +880,7 @@ namespace Simd
                 bool valid = true, bool bias = true, const View & connection = View())
                 : Layer(Convolutional, f)
             {
-                _valid = valid;
+                _valid = valid || coreSize == 1;
                 _indent = coreSize/2;
                 Size pad(coreSize - 1, coreSize - 1);
                 _src.Resize(srcSize, srcDepth);
@@ -610,13 +890,18 @@ namespace Simd
                 _weight.resize(_core.Volume());
                 if (bias)
                     _bias.resize(dstDepth);
-                SetThreadNumber(1, false);
 
                 _connection.Recreate(dstDepth, srcDepth, View::Gray8);
                 if (Simd::Compatible(connection, _connection))
                     Simd::Copy(connection, _connection);
                 else
                     Simd::Fill(_connection, 1);
+
+                _gemm = coreSize != 3 && coreSize != 5;
+                for (size_t dc = 0; dc < dstDepth; ++dc)
+                    for (size_t sc = 0; sc < srcDepth; ++sc)
+                        _gemm = _gemm && _connection.At<bool>(dc, sc);
+                SetThreadNumber(1, false);
             }
 
             void Forward(const Vector & src, size_t thread, Method method) override
@@ -624,55 +909,95 @@ namespace Simd
                 const Vector & padded = PaddedSrc(src, thread);
                 Vector & sum = _common[thread].sum;
                 Vector & dst = _common[thread].dst;
-                Detail::SetZero(sum);
-                for (ptrdiff_t dc = 0; dc < _dst.depth; ++dc)
+                bool epilogue = _next && _next->_inEpilogue && (method == Layer::Fast || method == Layer::Int8), direct = false;
+                if (method == Layer::Int8 && _quantized.weight.size())
+                    Int8(padded.data(), sum.data(), thread);
+                else if ((method == Layer::Fast || method == Layer::Int8) && _winograd.size())
+                    Winograd(padded.data(), sum.data(), _specific[thread].buffer.data());
+                else if (_gemm)
+                    Convolution(padded.data(), sum.data(), _specific[thread].buffer.data());
+                else
                 {
-                    for (ptrdiff_t sc = 0; sc < _src.depth; ++sc)
+                    direct = true;
+                    Detail::SetZero(sum);
+                    for (ptrdiff_t dc = 0; dc < _dst.depth; ++dc)
                     {
-                        if (!_connection.At<bool>(dc, sc))
-                            return;
-
-                        const float * pweight = _core.Get(_weight, 0, 0, _src.depth*dc + sc);
-                        const float * psrc = _padded.Get(padded, 0, 0, sc);
-                        float * psum = _dst.Get(sum, 0, 0, dc);
-
-                        if (_core.width == 3 && _core.height == 3)
-                        {
-                            ::SimdNeuralAddConvolution3x3(psrc, _padded.width, _dst.width, _dst.height, pweight, psum, _dst.width);
-                        }
-                        else if (_core.width == 5 && _core.height == 5)
+                        for (ptrdiff_t sc = 0; sc < _src.depth; ++sc)
                         {
-                            ::SimdNeuralAddConvolution5x5(psrc, _padded.width, _dst.width, _dst.height, pweight, psum, _dst.width);
-                        }
-                        else
-                        {
-                            for (ptrdiff_t y = 0; y < _dst.height; y++)
-                            {
-                                for (ptrdiff_t x = 0; x < _dst.width; x++)
-                                {
-                                    const float * pw = pweight;
-                                    const float * ps = psrc + y * _padded.width + x;
-                                    float s = 0;
-                                    for (ptrdiff_t wy = 0; wy < _core.height; wy++)
-                                        for (ptrdiff_t wx = 0; wx < _core.width; wx++)
-                                            s += *pw++ * ps[wy * _padded.width + wx];
-                                    psum[y * _dst.width + x] += s;
-                                }
-                            }
+                            if (!_connection.At<bool>(dc, sc))
+                                continue;
+                            Detail::AddConvolution(_core, _padded, _dst, _padded.Get(padded, 0, 0, sc), _core.Get(_weight, 0, 0, _src.depth*dc + sc), _dst.Get(sum, 0, 0, dc));
                         }
+                        if (epilogue)
+                            Epilogue(dc, thread);
                     }
-                    if (_bias.size())
+                }
+                if (epilogue)
+                {
+                    if (!direct)
                     {
-                        float bias = _bias[dc];
-                        size_t size = _dst.Area();
-                        float * psum = _dst.Get(sum, 0, 0, dc);
-                        for (size_t i = 0; i < size; ++i)
-                            psum[i] += bias;
+                        for (ptrdiff_t dc = 0; dc < _dst.depth; ++dc)
+                            Epilogue(dc, thread);
                     }
+                    return;
+                }
+                if (_bias.size())
+                {
+                    for (ptrdiff_t dc = 0; dc < _dst.depth; ++dc)
+                        Detail::AddBias(_bias[dc], _dst.Area(), _dst.Get(sum, 0, 0, dc));
                 }
                 _function.function(sum.data(), sum.size(), dst.data());
             }
 
+            void ForwardBatch(const float * src, size_t count, float * dst, float * buffer) override
+            {
+                size_t srcVolume = _padded.Volume(), dstVolume = _dst.Volume();
+                const float * padded = src;
+                if (!_valid)
+                {
+                    Detail::PadBatch(_src, _padded, _indent, src, count, buffer);
+                    padded = buffer;
+                    buffer += count*srcVolume;
+                }
+                if (_winograd.size())
+                {
+                    for (size_t i = 0; i < count; ++i)
+                        Winograd(padded + i*srcVolume, dst + i*dstVolume, buffer);
+                }
+                else if (_gemm)
+                {
+                    for (size_t i = 0; i < count; ++i)
+                        Convolution(padded + i*srcVolume, dst + i*dstVolume, buffer);
+                }
+                else
+                {
+                    memset(dst, 0, count*dstVolume*sizeof(float));
+                    for (ptrdiff_t dc = 0; dc < _dst.depth; ++dc)
+                    {
+                        for (ptrdiff_t sc = 0; sc < _src.depth; ++sc)
+                        {
+                            if (!_connection.At<bool>(dc, sc))
+                                continue;
+                            const float * pweight = _core.Get(_weight, 0, 0, _src.depth*dc + sc);
+                            for (size_t i = 0; i < count; ++i)
+                                Detail::AddConvolution(_core, _padded, _dst, padded + _padded.Offset(0, 0, sc) + i*srcVolume, pweight, dst + _dst.Offset(0, 0, dc) + i*dstVolume);
+                        }
+                    }
+                }
+                if (_bias.size())
+                {
+                    for (ptrdiff_t dc = 0; dc < _dst.depth; ++dc)
+                        for (size_t i = 0; i < count; ++i)
+                            Detail::AddBias(_bias[dc], _dst.Area(), dst + _dst.Offset(0, 0, dc) + i*dstVolume);
+                }
+                _function.function(dst, count*dstVolume, dst);
+            }
+
+            size_t BatchBuffer(size_t count) const override
+            {
+                return (_valid ? 0 : count*_padded.Volume()) + BufferSize();
+            }
+
             void Backward(const Vector & currDelta, size_t thread) override
             {
                 const Vector & prevDst = _valid ? _prev->Dst(thread) : _specific[thread].paddedSrc;
@@ -680,80 +1005,47 @@ namespace Simd
                 Vector & dWeight = _common[thread].dWeight;
                 Vector & dBias = _common[thread].dBias;
 
-                Detail::SetZero(prevDelta);
-
-                for (ptrdiff_t sc = 0; sc < _src.depth; ++sc)
+                if (_gemm)
                 {
-                    for (ptrdiff_t dc = 0; dc < _dst.depth; ++dc)
+                    size_t size;
+                    void * buffer = Buffer(thread, size);
+                    ::SimdNeuralConvolutionBackward(currDelta.data(), _dst.width, _dst.height, _dst.depth, _weight.data(), _core.width, _core.height, 
+                        0, 0, 1, 1, 1, 1, buffer, &size, prevDelta.data(), _padded.width, _padded.height, _padded.depth, 0);
+                }
+                else
+                {
+                    Detail::SetZero(prevDelta);
+                    for (ptrdiff_t sc = 0; sc < _src.depth; ++sc)
                     {
-                        if (!_connection.At<bool>(dc, sc))
-                            return;
-
-                        const float * pweight = _core.Get(_weight, 0, 0, _src.depth*dc + sc);
-                        const float * psrc = _dst.Get(currDelta, 0, 0, dc);
-                        float * pdst = _padded.Get(prevDelta, 0, 0, sc);
-
-                        if (_core.width == 3 && _core.height == 3)
-                        {
-                            ::SimdNeuralAddConvolution3x3Back(psrc, _dst.width, _dst.width, _dst.height, pweight, pdst, _padded.width);
-                        }
-                        else if (_core.width == 5 && _core.height == 5)
+                        for (ptrdiff_t dc = 0; dc < _dst.depth; ++dc)
                         {
-                            ::SimdNeuralAddConvolution5x5Back(psrc, _dst.width, _dst.width, _dst.height, pweight, pdst, _padded.width);
-                        }
-                        else
-                        {
-                            for (ptrdiff_t y = 0; y < _dst.height; y++)
-                            {
-                                for (ptrdiff_t x = 0; x < _dst.width; x++)
-                                {
-                                    const float * ppweight = pweight;
-                                    const float ppsrc = psrc[y*_dst.width + x];
-                                    float * ppdst = pdst + y*_padded.width + x;
-                                    for (ptrdiff_t wy = 0; wy < _core.height; wy++)
-                                        for (ptrdiff_t wx = 0; wx < _core.width; wx++)
-                                            ppdst[wy * _padded.width + wx] += *ppweight++ * ppsrc;
-                                }
-                            }
+                            if (!_connection.At<bool>(dc, sc))
+                                continue;
+                            Detail::AddConvolutionBack(_core, _padded, _dst, _dst.Get(currDelta, 0, 0, dc), 
+                                _core.Get(_weight, 0, 0, _src.depth*dc + sc), _padded.Get(prevDelta, 0, 0, sc));
                         }
                     }
                 }
 
                 _prev->_function.derivative(&prevDst[0], prevDst.size(), &prevDelta[0]);
 
-                for (ptrdiff_t sc = 0; sc < _src.depth; ++sc)
+                if (_gemm)
                 {
-                    for (ptrdiff_t dc = 0; dc < _dst.depth; ++dc)
+                    size_t size;
+                    void * buffer = Buffer(thread, size);
+                    ::SimdNeuralConvolutionSum(prevDst.data(), _padded.width, _padded.height, _padded.depth, currDelta.data(), _dst.width, _dst.height, _dst.depth,
+                        _core.width, _core.height, 0, 0, 1, 1, 1, 1, buffer, &size, dWeight.data());
+                }
+                else
+                {
+                    for (ptrdiff_t sc = 0; sc < _src.depth; ++sc)
                     {
-                        const float * delta = _dst.Get(currDelta, 0, 0, dc);
-                        const float * prevo = _padded.Get(prevDst, 0, 0, sc);
-                        float * sums = _core.Get(dWeight, 0, 0, _src.depth*dc + sc);
-
-                        if (_core.width == 3 && _core.height == 3)
-                        {
-                            ::SimdNeuralAddConvolution3x3Sum(prevo, _padded.width, delta, _dst.width, _dst.width, _dst.height, sums);
-                        }
-                        else if (_core.width == 5 && _core.height == 5)
+                        for (ptrdiff_t dc = 0; dc < _dst.depth; ++dc)
                         {
-                            ::SimdNeuralAddConvolution5x5Sum(prevo, _padded.width, delta, _dst.width, _dst.width, _dst.height, sums);
-                        }
-                        else
-                        {
-                            for (ptrdiff_t wy = 0; wy < _core.height; wy++)
-                            {
-                                for (ptrdiff_t wx = 0; wx < _core.width; wx++)
-                                {
-                                    float dst = 0;
-                                    const float * prevo = _padded.Get(prevDst, wx, wy, sc);
-                                    for (ptrdiff_t y = 0; y < _dst.height; y++)
-                                    {
-                                        float sum;
-                                        ::SimdNeuralProductSum(prevo + y*_padded.width, delta + y*_dst.width, _dst.width, &sum);
-                                        dst += sum;
-                                    }
-                                    dWeight[_core.Offset(wx, wy, _src.depth *dc + sc)] += dst;
-                                }
-                            }
+                            if (!_connection.At<bool>(dc, sc))
+                                continue;
+                            Detail::AddConvolutionSum(_core, _padded, _dst, _padded.Get(prevDst, 0, 0, sc), 
+                                _dst.Get(currDelta, 0, 0, dc), _core.Get(dWeight, 0, 0, _src.depth*dc + sc));
                         }
                     }
                 }
@@ -792,53 +1084,330 @@ namespace Simd
                         if (train)
                             _specific[i].paddedDelta.resize(_padded.Volume(), 0);
                     }
+                    _specific[i].buffer.resize(BufferSize());
                 }
             }
 
         private:
 
-            const Vector & PaddedSrc(const Vector & src, size_t thread)
+            SIMD_INLINE void * Buffer(size_t thread, size_t & size)
             {
-                if (_valid)
-                    return src;
-                else
+                Vector & buffer = _specific[thread].buffer;
+                size = buffer.size() * sizeof(float);
+                return buffer.data();
+            }
+
+            // Size (in floats) of temporary buffer for convolution with using of matrix multiplication or Winograd transform.
+            size_t BufferSize() const
+            {
+                size_t size = 0;
+                if (_gemm)
+                    size = _core.width*_core.height*_src.depth*(_dst.Area() + _dst.depth);
+                if (WinogradEnable())
+                    size = std::max<size_t>(size, 16 * WinogradTiles()*(_src.depth + _dst.depth));
+                return size;
+            }
+
+            // Generic convolution with using of matrix multiplication (see ::SimdNeuralConvolutionForward).
+            void Convolution(const float * src, float * dst, float * buffer)
+            {
+                size_t size = BufferSize()*sizeof(float);
+                ::SimdNeuralConvolutionForward(src, _padded.width, _padded.height, _padded.depth, _weight.data(), _core.width, _core.height, 
+                    0, 0, 1, 1, 1, 1, buffer, &size, dst, _dst.width, _dst.height, _dst.depth, 0);
+            }
+
+            // Winograd transform pays off only for big enough layers (small layers are faster with ::SimdNeuralAddConvolution3x3).
+            SIMD_INLINE bool WinogradEnable() const
+            {
+                return _core.width == 3 && _core.height == 3 && _src.depth >= 16 && _dst.depth >= 16 && _src.depth*_dst.depth*_dst.Area() >= 16 * 16 * 144;
+            }
+
+            SIMD_INLINE size_t WinogradTiles() const
+            {
+                return ((_dst.width + 1) / 2)*((_dst.height + 1) / 2);
+            }
+
+            // Fast 3x3 convolution with using of Winograd F(2x2, 3x3) transform (see ::SimdNeuralWinograd2x2p3x3SetInput).
+            void Winograd(const float * src, float * dst, float * buffer)
+            {
+                size_t tiles = WinogradTiles();
+                float * input = buffer;
+                float * output = input + 16 * tiles*_src.depth;
+                const float alpha = 1.0f, beta = 0.0f;
+                ::SimdNeuralWinograd2x2p3x3SetInput(src, _padded.width, _padded.height, _padded.depth, input);
+                for (size_t i = 0; i < 16; ++i)
+                    ::SimdGemm32fNN(_dst.depth, tiles, _src.depth, &alpha, _winograd.data() + i*_dst.depth*_src.depth, _src.depth, 
+                        input + i*_src.depth*tiles, tiles, &beta, output + i*_dst.depth*tiles, tiles);
+                ::SimdNeuralWinograd2x2p3x3SetOutput(output, dst, _dst.width, _dst.height, _dst.depth);
+            }
+
+            // Caches transformed weights for Winograd convolution (unconnected channels have zero kernels). Empty cache disables it.
+            void UpdateWinograd(bool enable)
+            {
+                _winograd.clear();
+                if (enable && WinogradEnable())
                 {
-                    Vector & padded = _specific[thread].paddedSrc;
-                    size_t size = _src.width*sizeof(float);
-                    for (ptrdiff_t c = 0; c < _src.depth; ++c)
-                    {
-                        for (ptrdiff_t y = 0; y < _src.height; ++y)
-                            memcpy(_padded.Get(padded, _indent, _indent + y, c), _src.Get(src, 0, y, c), size);
-                    }
-                    return padded;
+                    Vector weight(_weight.data(), _weight.data() + _weight.size());
+                    for (ptrdiff_t dc = 0; dc < _dst.depth; ++dc)
+                        for (ptrdiff_t sc = 0; sc < _src.depth; ++sc)
+                            if (!_connection.At<bool>(dc, sc))
+                                std::fill_n(_core.Get(weight, 0, 0, _src.depth*dc + sc), _core.Area(), 0.0f);
+                    _winograd.resize(16 * _src.depth*_dst.depth);
+                    ::SimdNeuralWinograd2x2p3x3SetFilter(weight.data(), _src.depth*_dst.depth, _winograd.data());
                 }
             }
 
-            void UnpadDelta(const Vector & src, size_t thread)
+            virtual void Quantize(float min, float max) override
             {
-                if (!_valid)
+                Vector weight(_weight.data(), _weight.data() + _weight.size());
+                for (ptrdiff_t dc = 0; dc < _dst.depth; ++dc)
+                    for (ptrdiff_t sc = 0; sc < _src.depth; ++sc)
+                        if (!_connection.At<bool>(dc, sc))
+                            std::fill_n(_core.Get(weight, 0, 0, _src.depth*dc + sc), _core.Area(), 0.0f);
+                QuantizeWeight(weight.data(), _dst.depth, _core.Area()*_src.depth, min, max);
+            }
+
+            // 8-bit integer convolution: every output point is a product of quantized weights and a column of quantized input (see ::SimdNeuralProductSum8u8i).
+            void Int8(const float * src, float * dst, size_t thread)
+            {
+                std::vector<uint8_t> & src8 = _common[thread].src8;
+                std::vector<int32_t> & sum32 = _common[thread].sum32;
+                size_t size = _padded.Volume(), stride = _quantized.stride;
+                src8.resize(size + stride, 0);
+                sum32.resize(_dst.depth);
+                uint8_t * padded = src8.data(), * col = padded + size;
+                ::SimdNeuralQuantize8u(src, size, &_quantized.scale, &_quantized.shift, padded);
+                for (ptrdiff_t y = 0; y < _dst.height; ++y)
                 {
-                    Vector & dst = _common[thread].prevDelta;
-                    size_t size = _src.width*sizeof(float);
-                    for (ptrdiff_t c = 0; c < _src.depth; c++)
+                    for (ptrdiff_t x = 0; x < _dst.width; ++x)
                     {
-                        for (ptrdiff_t y = 0; y < _src.height; ++y)
-                            memcpy(_src.Get(dst, 0, y, c), _padded.Get(src, _indent, _indent + y, c), size);
+                        uint8_t * pcol = col;
+                        for (ptrdiff_t sc = 0; sc < _src.depth; ++sc)
+                        {
+                            for (ptrdiff_t ky = 0; ky < _core.height; ++ky, pcol += _core.width)
+                                memcpy(pcol, padded + _padded.Offset(x, y + ky, sc), _core.width);
+                        }
+                        ::SimdNeuralProductSum8u8i(col, _quantized.weight.data(), stride, _dst.depth, sum32.data());
+                        Dequantize(sum32.data(), _dst.depth, _dst.Area(), dst + _dst.Offset(x, y, 0));
                     }
                 }
             }
 
-            struct Specific
+            /*
+            * Epilogue of one output channel: bias, activation, 2x2 max pooling and activation of the next MaxPoolingLayer (see Network::UpdateEpilogue).
+            * It is shared by all convolution methods. Direct convolution calls it right after the channel is accumulated,
+            * GEMM, Winograd and Int8 methods call it for every channel after the whole convolution.
+            */
+            void Epilogue(ptrdiff_t dc, size_t thread)
             {
-                Vector paddedSrc, paddedDelta;
-            };
-            std::vector<Specific> _specific;
+                float * sum = _dst.Get(_common[thread].sum, 0, 0, dc);
+                float * dst = _dst.Get(_common[thread].dst, 0, 0, dc);
+                if (_bias.size())
+                    Detail::AddBias(_bias[dc], _dst.Area(), sum);
+                _function.function(sum, _dst.Area(), dst);
+                Layer & next = *_next;
+                float * pooled = next._dst.Get(next._common[thread].sum, 0, 0, dc);
+                ::SimdNeuralMax2x2(dst, _dst.width, _dst.width, _dst.height, pooled, next._dst.width);
+                next._function.function(pooled, next._dst.Area(), next._dst.Get(next._common[thread].dst, 0, 0, dc));
+            }
 
-            Index _core;
-            Index _padded;
-            size_t _indent;
-            bool _valid;
-            View _connection;
+            const Vector & PaddedSrc(const Vector & src, size_t thread)
+            {
+                if (_valid)
+                    return src;
+                Vector & padded = _specific[thread].paddedSrc;
+                Detail::Pad(_src, _padded, _indent, src.data(), padded.data());
+                return padded;
+            }
+
+            void UnpadDelta(const Vector & src, size_t thread)
+            {
+                if (!_valid)
+                    Detail::Unpad(_src, _padded, _indent, src.data(), _common[thread].prevDelta.data());
+            }
+
+            struct Specific
+            {
+                Vector paddedSrc, paddedDelta, buffer;
+            };
+            std::vector<Specific> _specific;
+
+            Index _core;
+            Index _padded;
+            size_t _indent;
+            bool _valid, _gemm;
+            View _connection;
+            Vector _winograd;
+
+            friend class Network;
+        };
+
+        /*! @ingroup cpp_neural
+
+            \short DepthwiseConvolutionalLayer class.
+
+            Depthwise convolutional layer in neural network: every channel of input image is convolved with own core 
+            (the number of output channels is equal to the number of input channels). Together with following pointwise 
+            (1x1) ConvolutionalLayer it forms depthwise separable convolution which needs much less weights and operations 
+            than ConvolutionalLayer with the same core.
+
+            \note Layers with 3x3 and 5x5 cores use ::SimdNeuralAddConvolution3x3 and ::SimdNeuralAddConvolution5x5 (and their 
+            Back and Sum counterparts) for every channel.
+        */
+        class DepthwiseConvolutionalLayer : public Layer
+        {
+        public:
+            /*!
+                \short Creates new DepthwiseConvolutionalLayer class.
+
+                \param [in] f - a type of activation function used in this layer.
+                \param [in] srcSize - a size (width and height) of input image.
+                \param [in] depth - a number of input (and output) channels.
+                \param [in] coreSize - a size of convolution core.
+                \param [in] valid - a boolean flag (True - only original image points are used in convolution, so output image is decreased; 
+                                    False - input image is padded by zeros and output image has the same size). By default its true.
+                \param [in] bias - a boolean flag (enabling of bias). By default its True.
+            */
+            DepthwiseConvolutionalLayer(Function::Type f, const Size & srcSize, size_t depth, size_t coreSize, bool valid = true, bool bias = true)
+                : Layer(DepthwiseConvolutional, f)
+            {
+                _valid = valid || coreSize == 1;
+                _indent = coreSize / 2;
+                Size pad(coreSize - 1, coreSize - 1);
+                _src.Resize(srcSize, depth);
+                _dst.Resize(srcSize - (_valid ? pad : Size()), depth);
+                _padded.Resize(srcSize + (_valid ? Size() : pad), depth);
+                _core.Resize(coreSize, coreSize, depth);
+                _weight.resize(_core.Volume());
+                if (bias)
+                    _bias.resize(depth);
+                SetThreadNumber(1, false);
+            }
+
+            void Forward(const Vector & src, size_t thread, Method method) override
+            {
+                const Vector & padded = PaddedSrc(src, thread);
+                Vector & sum = _common[thread].sum;
+                Vector & dst = _common[thread].dst;
+                Detail::SetZero(sum);
+                for (ptrdiff_t c = 0; c < _dst.depth; ++c)
+                {
+                    Detail::AddConvolution(_core, _padded, _dst, _padded.Get(padded, 0, 0, c), _core.Get(_weight, 0, 0, c), _dst.Get(sum, 0, 0, c));
+                    if (_bias.size())
+                        Detail::AddBias(_bias[c], _dst.Area(), _dst.Get(sum, 0, 0, c));
+                }
+                _function.function(sum.data(), sum.size(), dst.data());
+            }
+
+            void ForwardBatch(const float * src, size_t count, float * dst, float * buffer) override
+            {
+                size_t srcVolume = _padded.Volume(), dstVolume = _dst.Volume();
+                const float * padded = src;
+                if (!_valid)
+                {
+                    Detail::PadBatch(_src, _padded, _indent, src, count, buffer);
+                    padded = buffer;
+                }
+                memset(dst, 0, count*dstVolume*sizeof(float));
+                for (ptrdiff_t c = 0; c < _dst.depth; ++c)
+                {
+                    const float * pweight = _core.Get(_weight, 0, 0, c);
+                    for (size_t i = 0; i < count; ++i)
+                    {
+                        float * pdst = dst + _dst.Offset(0, 0, c) + i*dstVolume;
+                        Detail::AddConvolution(_core, _padded, _dst, padded + _padded.Offset(0, 0, c) + i*srcVolume, pweight, pdst);
+                        if (_bias.size())
+                            Detail::AddBias(_bias[c], _dst.Area(), pdst);
+                    }
+                }
+                _function.function(dst, count*dstVolume, dst);
+            }
+
+            size_t BatchBuffer(size_t count) const override
+            {
+                return _valid ? 0 : count*_padded.Volume();
+            }
+
+            void Backward(const Vector & currDelta, size_t thread) override
+            {
+                const Vector & prevDst = _valid ? _prev->Dst(thread) : _specific[thread].paddedSrc;
+                Vector & prevDelta = _valid ? _common[thread].prevDelta : _specific[thread].paddedDelta;
+                Vector & dWeight = _common[thread].dWeight;
+                Vector & dBias = _common[thread].dBias;
+
+                Detail::SetZero(prevDelta);
+                for (ptrdiff_t c = 0; c < _dst.depth; ++c)
+                    Detail::AddConvolutionBack(_core, _padded, _dst, _dst.Get(currDelta, 0, 0, c), _core.Get(_weight, 0, 0, c), _padded.Get(prevDelta, 0, 0, c));
+
+                _prev->_function.derivative(prevDst.data(), prevDst.size(), prevDelta.data());
+
+                for (ptrdiff_t c = 0; c < _dst.depth; ++c)
+                    Detail::AddConvolutionSum(_core, _padded, _dst, _padded.Get(prevDst, 0, 0, c), _dst.Get(currDelta, 0, 0, c), _core.Get(dWeight, 0, 0, c));
+
+                if (dBias.size())
+                {
+                    for (ptrdiff_t c = 0; c < _dst.depth; ++c)
+                    {
+                        const float * delta = _dst.Get(currDelta, 0, 0, c);
+                        dBias[c] += std::accumulate(delta, delta + _dst.Area(), float(0));
+                    }
+                }
+
+                UnpadDelta(prevDelta, thread);
+            }
+
+            size_t FanSrc() const override
+            {
+                return _core.Area();
+            }
+
+            size_t FanDst() const override
+            {
+                return _core.Area();
+            }
+
+            virtual void SetThreadNumber(size_t number, bool train) override
+            {
+                Layer::SetThreadNumber(number, train);
+                _specific.resize(number);
+                for (size_t i = 0; i < _specific.size(); ++i)
+                {
+                    if (!_valid)
+                    {
+                        _specific[i].paddedSrc.resize(_padded.Volume(), 0);
+                        if (train)
+                            _specific[i].paddedDelta.resize(_padded.Volume(), 0);
+                    }
+                }
+            }
+
+        private:
+
+            const Vector & PaddedSrc(const Vector & src, size_t thread)
+            {
+                if (_valid)
+                    return src;
+                Vector & padded = _specific[thread].paddedSrc;
+                Detail::Pad(_src, _padded, _indent, src.data(), padded.data());
+                return padded;
+            }
+
+            void UnpadDelta(const Vector & src, size_t thread)
+            {
+                if (!_valid)
+                    Detail::Unpad(_src, _padded, _indent, src.data(), _common[thread].prevDelta.data());
+            }
+
+            struct Specific
+            {
+                Vector paddedSrc, paddedDelta;
+            };
+            std::vector<Specific> _specific;
+
+            Index _core;
+            Index _padded;
+            size_t _indent;
+            bool _valid;
         };
 
         /*! @ingroup cpp_neural
@@ -869,46 +1438,27 @@ namespace Simd
 
             void Forward(const Vector & src, size_t thread, Method method) override
             {
+                if (_inEpilogue && (method == Layer::Fast || method == Layer::Int8))
+                    return;
                 Vector & sum = _common[thread].sum;
                 Vector & dst = _common[thread].dst;
                 if (method != Layer::Train && _poolingSize == 2)
-                {
                     ::SimdNeuralMax2x2(src.data(), _src.width, _src.width, _src.height*_src.depth, sum.data(), _dst.width);
-                }
+                else
+                    Pooling(src.data(), sum.data(), _specific[thread].index.data());
+                _function.function(sum.data(), sum.size(), dst.data());
+            }
+
+            void ForwardBatch(const float * src, size_t count, float * dst, float * buffer) override
+            {
+                if (_poolingSize == 2)
+                    ::SimdNeuralMax2x2(src, _src.width, _src.width, _src.height*_src.depth*count, dst, _dst.width);
                 else
                 {
-                    ptrdiff_t * idx = _specific[thread].index.data();
-                    for (ptrdiff_t c = 0; c < _dst.depth; ++c)
-                    {
-                        for (ptrdiff_t y = 0; y < _dst.height; y++)
-                        {
-                            for (ptrdiff_t x = 0; x < _dst.width; x++)
-                            {
-                                ptrdiff_t srcOffset = _src.Offset(x*_poolingSize, y*_poolingSize, c);
-                                const float * psrc = src.data() + srcOffset;
-                                ptrdiff_t maxIndex = 0;
-                                float maxValue = std::numeric_limits<float>::lowest();
-                                for (size_t dy = 0; dy < _poolingSize; dy++)
-                                {
-                                    for (size_t dx = 0; dx < _poolingSize; dx++)
-                                    {
-                                        ptrdiff_t index = dy*_src.width + dx;
-                                        float value = psrc[index];
-                                        if (value > maxValue)
-                                        {
-                                            maxValue = value;
-                                            maxIndex = index;
-                                        }
-                                    }
-                                }
-                                ptrdiff_t dstOffset = _dst.Offset(x, y, c);
-                                sum[dstOffset] = maxValue;
-                                idx[dstOffset] = srcOffset + maxIndex;
-                            }
-                        }
-                    }                    
+                    for (size_t i = 0; i < count; ++i)
+                        Pooling(src + i*_src.Volume(), dst + i*_dst.Volume(), NULL);
                 }
-                _function.function(sum.data(), sum.size(), dst.data());
+                _function.function(dst, count*_dst.Volume(), dst);
             }
 
             void Backward(const Vector & currDelta, size_t thread) override
@@ -950,6 +1500,40 @@ namespace Simd
 
         protected:
 
+            void Pooling(const float * src, float * sum, ptrdiff_t * idx) const
+            {
+                for (ptrdiff_t c = 0; c < _dst.depth; ++c)
+                {
+                    for (ptrdiff_t y = 0; y < _dst.height; y++)
+                    {
+                        for (ptrdiff_t x = 0; x < _dst.width; x++)
+                        {
+                            ptrdiff_t srcOffset = _src.Offset(x*_poolingSize, y*_poolingSize, c);
+                            const float * psrc = src + srcOffset;
+                            ptrdiff_t maxIndex = 0;
+                            float maxValue = std::numeric_limits<float>::lowest();
+                            for (size_t dy = 0; dy < _poolingSize; dy++)
+                            {
+                                for (size_t dx = 0; dx < _poolingSize; dx++)
+                                {
+                                    ptrdiff_t index = dy*_src.width + dx;
+                                    float value = psrc[index];
+                                    if (value > maxValue)
+                                    {
+                                        maxValue = value;
+                                        maxIndex = index;
+                                    }
+                                }
+                            }
+                            ptrdiff_t dstOffset = _dst.Offset(x, y, c);
+                            sum[dstOffset] = maxValue;
+                            if (idx)
+                                idx[dstOffset] = srcOffset + maxIndex;
+                        }
+                    }
+                }
+            }
+
             struct Specific
             {
                 std::vector<ptrdiff_t, Allocator<ptrdiff_t>> index;
@@ -957,6 +1541,8 @@ namespace Simd
             std::vector<Specific> _specific;
 
             size_t _poolingSize;
+
+            friend class Network;
         };
 
         /*! @ingroup cpp_neural
@@ -978,7 +1564,6 @@ namespace Simd
             */            
             FullyConnectedLayer(Function::Type f, size_t srcSize, size_t dstSize, bool bias = true)
                 : Layer(FullyConnected, f)
-                , _reordered(false)
             {
                 _src.Resize(srcSize, 1, 1);
                 _dst.Resize(dstSize, 1, 1);
@@ -993,23 +1578,23 @@ namespace Simd
                 Vector & sum = _common[thread].sum;
                 Vector & dst = _common[thread].dst;
 
-                if (method == Layer::Fast)
+                if (method == Layer::Int8 && _quantized.weight.size())
+                {
+                    std::vector<uint8_t> & src8 = _common[thread].src8;
+                    std::vector<int32_t> & sum32 = _common[thread].sum32;
+                    src8.resize(_quantized.stride, 0);
+                    sum32.resize(_dst.width);
+                    ::SimdNeuralQuantize8u(src.data(), src.size(), &_quantized.scale, &_quantized.shift, src8.data());
+                    ::SimdNeuralProductSum8u8i(src8.data(), _quantized.weight.data(), _quantized.stride, _dst.width, sum32.data());
+                    Dequantize(sum32.data(), _dst.width, 1, sum.data());
+                }
+                else if ((method == Layer::Fast || method == Layer::Int8 || _weight.size() == 0) && _reordered.size())
                 {
-                    if (!_reordered)
-                    {
-                        Vector buffer(_weight.size());
-                        for (ptrdiff_t i = 0; i < _dst.width; ++i)
-                            for (ptrdiff_t j = 0; j < _src.width; ++j)
-                                buffer[i*_src.width + j] = _weight[j*_dst.width + i];
-                        _weight.swap(buffer);
-                        _reordered = true;
-                    }
                     for (size_t i = 0; i < sum.size(); ++i)
-                        ::SimdNeuralProductSum(src.data(), &_weight[i*_src.width], src.size(), &sum[i]);
+                        ::SimdNeuralProductSum(src.data(), &_reordered[i*_src.width], src.size(), &sum[i]);
                 }
                 else
                 {
-                    assert(!_reordered);
                     Detail::SetZero(sum);
                     for (size_t i = 0; i < src.size(); i++)
                         ::SimdNeuralAddVectorMultipliedByValue(&_weight[i*_dst.width], sum.size(), &src[i], sum.data());
@@ -1045,6 +1630,34 @@ namespace Simd
                 }
             }
 
+            void ForwardBatch(const float * src, size_t count, float * dst, float * buffer) override
+            {
+                const float alpha = 1.0f, beta = 0.0f;
+                if (_weight.size())
+                    ::SimdGemm32fNN(count, _dst.width, _src.width, &alpha, src, _src.width, _weight.data(), _dst.width, &beta, dst, _dst.width);
+                else
+                {
+                    // Weights refer to memory mapped file in [dst][src] layout (see Network::LoadBinary): dst^T = weight*src^T.
+                    float * srcT = buffer, * dstT = buffer + count*_src.width;
+                    Transpose(src, count, _src.width, srcT);
+                    ::SimdGemm32fNN(_dst.width, count, _src.width, &alpha, _reordered.data(), _src.width, srcT, count, &beta, dstT, count);
+                    Transpose(dstT, _dst.width, count, dst);
+                }
+
+                if (_bias.size())
+                {
+                    for (size_t j = 0; j < count; ++j)
+                        for (ptrdiff_t i = 0; i < _dst.width; ++i)
+                            dst[j*_dst.width + i] += _bias[i];
+                }
+                _function.function(dst, count*_dst.width, dst);
+            }
+
+            size_t BatchBuffer(size_t count) const override
+            {
+                return _weight.size() ? 0 : count*(_src.width + _dst.width);
+            }
+
             size_t FanSrc() const override
             {
                 return _src.width;
@@ -1055,8 +1668,66 @@ namespace Simd
                 return _dst.width;
             }
 
+            const float * Weight() const override
+            {
+                return _reordered.size() ? _reordered.data() : _weight.data();
+            }
+
         protected:
-            bool _reordered;
+            Detail::Array _reordered;
+
+            // Transposes matrix [rows][cols] to [cols][rows].
+            static void Transpose(const float * src, size_t rows, size_t cols, float * dst)
+            {
+                for (size_t i = 0; i < rows; ++i)
+                    for (size_t j = 0; j < cols; ++j)
+                        dst[j*rows + i] = src[i*cols + j];
+            }
+
+            // Caches weights transposed from [src][dst] (used in training and batch prediction) to [dst][src] (used in fast single prediction).
+            // Empty cache disables it. Weights themselves are never changed by prediction, so it is safe to call prediction from many threads.
+            // Weights loaded from memory mapped binary file are kept only in [dst][src] layout (see Network::LoadBinary).
+            void UpdateReorder(bool enable)
+            {
+                if (_reordered.Refers())
+                    return;
+                _reordered.clear();
+                if (enable)
+                {
+                    _reordered.resize(_weight.size());
+                    Transpose(_weight.data(), _src.width, _dst.width, _reordered.Own().data());
+                }
+            }
+
+            virtual void Quantize(float min, float max) override
+            {
+                if (_reordered.size())
+                    QuantizeWeight(_reordered.data(), _dst.width, _src.width, min, max);
+                else
+                {
+                    Vector weight(_weight.size());
+                    Transpose(_weight.data(), _src.width, _dst.width, weight.data());
+                    QuantizeWeight(weight.data(), _dst.width, _src.width, min, max);
+                }
+            }
+
+            virtual void Detach() override
+            {
+                if (_reordered.Refers())
+                {
+                    _weight.resize(WeightSize());
+                    Transpose(_reordered.data(), _dst.width, _src.width, _weight.Own().data());
+                    _reordered.clear();
+                }
+                _bias.Own();
+            }
+
+            virtual size_t WeightSize() const override
+            {
+                return _src.width*_dst.width;
+            }
+
+            friend class Network;
         };
 
         /*! @ingroup cpp_neural
@@ -1100,6 +1771,11 @@ namespace Simd
                     dst = src;
             }
 
+            void ForwardBatch(const float * src, size_t count, float * dst, float * buffer) override
+            {
+                memcpy(dst, src, count*_dst.Volume()*sizeof(float));
+            }
+
             void Backward(const Vector & currDelta, size_t thread) override
             {
                 const Vector & prevDst = _prev->Dst(thread);
@@ -1172,6 +1848,13 @@ namespace Simd
                      Proc. AISTATS 10, May 2010, vol.9, pp249-256
                 */
                 Xavier,
+                /*!
+                     Use fan-in for scaling (it is more suitable for ReLU activations).
+                     Kaiming He, Xiangyu Zhang, Shaoqing Ren, Jian Sun.
+                     "Delving Deep into Rectifiers: Surpassing Human-Level Performance on ImageNet Classification"
+                     Proc. ICCV 2015, pp1026-1034
+                */
+                He,
             };
 
             /*!
@@ -1185,6 +1868,12 @@ namespace Simd
                     Mean-Squared-Error loss function for regression.
                 */
                 Mse,
+                /*!
+                    Softmax with cross-entropy loss function for classification. 
+                    Outputs of the last layer are treated as logits, so its activation function must be Function::Identity.
+                    Network::Predict returns logits (softmax is monotone, so index of maximal output is the same).
+                */
+                CrossEntropy,
             };
 
             /*!
@@ -1203,6 +1892,26 @@ namespace Simd
                     \note See ::SimdNeuralAdaptiveGradientUpdate.
                 */
                 AdaptiveGradient,
+                /*!
+                    Stochastic gradient descent with momentum.
+
+                    \note See ::SimdNeuralUpdateWeights.
+                */
+                Momentum,
+                /*!
+                    Adam method.
+                    D Kingma, J Ba, "Adam: A Method for Stochastic Optimization", ICLR 2015.
+
+                    \note See ::SimdNeuralAdamUpdate.
+                */
+                Adam,
+                /*!
+                    Adam method with decoupled weight decay.
+                    I Loshchilov, F Hutter, "Decoupled Weight Decay Regularization", ICLR 2019.
+
+                    \note See ::SimdNeuralAdamUpdate.
+                */
+                AdamW,
             };
 
             InitType initType; /*!< \brief Method to initialize weights. */
@@ -1214,6 +1923,10 @@ namespace Simd
             size_t batchSize; /*!< \brief A batch size. */
             float alpha; /*!< \brief Describes training speed. */
             float epsilon; /*!< \brief Used to prevent division by zero. */
+            float momentum; /*!< \brief Momentum of TrainOptions::Momentum update. */
+            float beta1; /*!< \brief Decay rate of the first moment of TrainOptions::Adam and TrainOptions::AdamW updates. */
+            float beta2; /*!< \brief Decay rate of the second moment of TrainOptions::Adam and TrainOptions::AdamW updates. */
+            float weightDecay; /*!< \brief Weight decay of TrainOptions::AdamW update (it is multiplied by alpha). */
 
             /*!
                 \short Default constructor.
@@ -1228,6 +1941,10 @@ namespace Simd
                 , epochFinish(100)
                 , alpha(0.01f)
                 , epsilon(0.0001f)
+                , momentum(0.9f)
+                , beta1(0.9f)
+                , beta2(0.999f)
+                , weightDecay(0.01f)
             {
             }
         };
@@ -1243,6 +1960,13 @@ namespace Simd
                     dst[i] = RandomUniform(-halfRange, halfRange);
             }
 
+            template<> void InitWeight<TrainOptions::He>(Vector & dst, const Layer & layer)
+            {
+                float halfRange = (float)(std::sqrt(6.0 / layer.FanSrc()));
+                for (size_t i = 0; i < dst.size(); ++i)
+                    dst[i] = RandomUniform(-halfRange, halfRange);
+            }
+
             template<TrainOptions::LossType type> void Gradient(const Vector & current, const Vector & control, Vector & delta);
             
             template<> SIMD_INLINE void Gradient<TrainOptions::Mse>(const Vector & current, const Vector & control, Vector & delta)
@@ -1251,11 +1975,198 @@ namespace Simd
                     delta[i] = current[i] - control[i];
             }
 
-            template<TrainOptions::UpdateType type> void UpdateWeight(const TrainOptions & o, const Vector & d, Vector & g, Vector & v);
+            template<> SIMD_INLINE void Gradient<TrainOptions::CrossEntropy>(const Vector & current, const Vector & control, Vector & delta)
+            {
+                float max = *std::max_element(current.begin(), current.end()), sum = 0;
+                for (size_t i = 0; i < current.size(); ++i)
+                {
+                    delta[i] = std::exp(current[i] - max);
+                    sum += delta[i];
+                }
+                for (size_t i = 0; i < current.size(); ++i)
+                    delta[i] = delta[i] / sum - control[i];
+            }
+
+            // Parameter alpha is the bias corrected training speed of current step (it is used by Adam and AdamW).
+            template<TrainOptions::UpdateType type> void UpdateWeight(const TrainOptions & o, float alpha, const float * d, size_t size, float * m, float * g, float * v);
+
+            template<> SIMD_INLINE void UpdateWeight<TrainOptions::AdaptiveGradient>(const TrainOptions & o, float alpha, const float * d, size_t size, float * m, float * g, float * v)
+            {
+                ::SimdNeuralAdaptiveGradientUpdate(d, size, o.batchSize, &o.alpha, &o.epsilon, g, v);
+            }
+
+            template<> SIMD_INLINE void UpdateWeight<TrainOptions::Momentum>(const TrainOptions & o, float alpha, const float * d, size_t size, float * m, float * g, float * v)
+            {
+                const float b = -o.alpha / o.batchSize;
+                ::SimdNeuralUpdateWeights(d, size, &o.momentum, &b, g, v);
+            }
+
+            template<> SIMD_INLINE void UpdateWeight<TrainOptions::Adam>(const TrainOptions & o, float alpha, const float * d, size_t size, float * m, float * g, float * v)
+            {
+                const float decay = 0.0f;
+                ::SimdNeuralAdamUpdate(d, size, o.batchSize, &alpha, &o.beta1, &o.beta2, &o.epsilon, &decay, m, g, v);
+            }
+
+            template<> SIMD_INLINE void UpdateWeight<TrainOptions::AdamW>(const TrainOptions & o, float alpha, const float * d, size_t size, float * m, float * g, float * v)
+            {
+                const float decay = o.alpha*o.weightDecay;
+                ::SimdNeuralAdamUpdate(d, size, o.batchSize, &alpha, &o.beta1, &o.beta2, &o.epsilon, &decay, m, g, v);
+            }
 
-            template<> SIMD_INLINE void UpdateWeight<TrainOptions::AdaptiveGradient>(const TrainOptions & o, const Vector & d, Vector & g, Vector & v)
+            // A part of weights (or biases) of a layer which is reduced and updated by one thread.
+            struct Shard
+            {
+                Layer * layer;
+                bool bias;
+                size_t offset, size;
+
+                Shard(Layer * l, bool b, size_t o, size_t s) : layer(l), bias(b), offset(o), size(s) {}
+            };
+
+            // Size of shard: 16 KB of float gradients (it is multiple of cache line and of SIMD vector).
+            const size_t SHARD_SIZE = 4096;
+        }
+
+        namespace Detail
+        {
+            /*
+            * Binary network file: header, descriptions of all layers and aligned blobs with weights and biases.
+            * Blobs are stored by offsets from the file beginning (the file is relocatable) and are aligned by ALIGN bytes,
+            * so 32-bit weights can be used directly from memory mapped file. Weights are stored as 32-bit or 16-bit floats.
+            */
+            namespace Binary
             {
-                ::SimdNeuralAdaptiveGradientUpdate(d.data(), d.size(), o.batchSize, &o.alpha, &o.epsilon, g.data(), v.data());
+                const char MAGIC[8] = { 'S', 'i', 'm', 'd', 'N', 'e', 'u', 'r' };
+                const uint32_t VERSION = 1;
+                const uint32_t ENDIANNESS = 0x01020304;
+                const size_t ALIGN = 64;
+
+                struct Header
+                {
+                    char magic[8];
+                    uint32_t version;
+                    uint32_t endianness;
+                    uint32_t layerCount;
+                    uint32_t half;
+                    uint64_t fileSize;
+                };
+
+                struct LayerHeader
+                {
+                    int32_t type;
+                    int32_t function;
+                    int32_t src[3];
+                    int32_t dst[3];
+                    uint32_t reordered; // weights of fully connected layer are stored as [dst][src] (SaveBinary always does it), otherwise as [src][dst].
+                    uint32_t reserved;
+                    uint64_t weightCount;
+                    uint64_t weightOffset;
+                    uint64_t biasCount;
+                    uint64_t biasOffset;
+                };
+
+                // Checks an aligned blob of count items without overflow of offset + count*itemSize.
+                SIMD_INLINE bool Valid(uint64_t offset, uint64_t count, size_t itemSize, uint64_t fileSize)
+                {
+                    return offset % ALIGN == 0 && offset <= fileSize && count <= (fileSize - offset) / itemSize;
+                }
+
+                SIMD_INLINE uint64_t AlignHi(uint64_t size)
+                {
+                    return (size + ALIGN - 1) & ~uint64_t(ALIGN - 1);
+                }
+
+                // Converts 32-bit float to 16-bit float (IEEE 754 half precision) with rounding to nearest even.
+                SIMD_INLINE uint16_t Float32ToFloat16(float value)
+                {
+                    uint32_t f;
+                    memcpy(&f, &value, sizeof(f));
+                    uint32_t sign = (f >> 16) & 0x8000, mant = f & 0x7FFFFF;
+                    int32_t exp = int32_t((f >> 23) & 0xFF) - 127 + 15;
+                    if ((f & 0x7FFFFFFF) >= 0x7F800000)
+                        return uint16_t(sign | 0x7C00 | (mant ? 0x200 : 0));
+                    if (exp >= 31)
+                        return uint16_t(sign | 0x7C00);
+                    uint32_t shift = 13;
+                    if (exp <= 0)
+                    {
+                        if (exp < -10)
+                            return uint16_t(sign);
+                        mant |= 0x800000;
+                        shift = 14 - exp;
+                        exp = 0;
+                    }
+                    uint32_t half = (uint32_t(exp) << 10) + (mant >> shift);
+                    uint32_t rest = mant & ((1 << shift) - 1), middle = 1 << (shift - 1);
+                    if (rest > middle || (rest == middle && (half & 1)))
+                        half++;
+                    return uint16_t(sign | half);
+                }
+
+                SIMD_INLINE float Float16ToFloat32(uint16_t value)
+                {
+                    uint32_t sign = uint32_t(value & 0x8000) << 16, exp = (value >> 10) & 0x1F, mant = value & 0x3FF, f;
+                    if (exp == 0)
+                    {
+                        if (mant == 0)
+                            f = sign;
+                        else
+                        {
+                            exp = 113;
+                            while ((mant & 0x400) == 0)
+                            {
+                                mant <<= 1;
+                                exp--;
+                            }
+                            f = sign | (exp << 23) | ((mant & 0x3FF) << 13);
+                        }
+                    }
+                    else if (exp == 31)
+                        f = sign | 0x7F800000 | (mant << 13);
+                    else
+                        f = sign | ((exp + 112) << 23) | (mant << 13);
+                    float result;
+                    memcpy(&result, &f, sizeof(result));
+                    return result;
+                }
+
+                SIMD_INLINE void Write(const float * src, size_t size, bool half, uint8_t * dst)
+                {
+                    if (half)
+                    {
+                        uint16_t * pdst = (uint16_t*)dst;
+                        for (size_t i = 0; i < size; ++i)
+                            pdst[i] = Float32ToFloat16(src[i]);
+                    }
+                    else if (size)
+                        memcpy(dst, src, size*sizeof(float));
+                }
+
+                SIMD_INLINE void Read(const uint8_t * src, bool half, Vector & dst)
+                {
+                    if (half)
+                    {
+                        for (size_t i = 0; i < dst.size(); ++i)
+                        {
+                            uint16_t value;
+                            memcpy(&value, src + i*sizeof(uint16_t), sizeof(value));
+                            dst[i] = Float16ToFloat32(value);
+                        }
+                    }
+                    else
+                        memcpy(dst.data(), src, dst.size()*sizeof(float));
+                }
+
+                // Read only memory mapped binary network file (see ::SimdMapFile). Weights of layers can refer to it.
+                struct Mapping
+                {
+                    void * data;
+                    size_t size;
+
+                    Mapping(const std::string & path) : size(0) { data = ::SimdMapFile(path.c_str(), &size); }
+                    ~Mapping() { ::SimdUnmapFile(data, size); }
+                };
+                typedef std::shared_ptr<Mapping> MappingPtr;
             }
         }
 
@@ -1274,6 +2185,7 @@ namespace Simd
                 Creates empty network without any layers.
             */
             Network()
+                : _updateType(-1)
             {
             }
 
@@ -1283,6 +2195,8 @@ namespace Simd
             void Clear()
             {
                 _layers.clear();
+                _mapping.reset();
+                _updateType = -1;
             }
 
             /*!
@@ -1304,6 +2218,16 @@ namespace Simd
                     return false;
             }
 
+            /*!
+                \short Gets layers of the neural network.
+
+                \return a list of layers. The first layer is InputLayer which is added automatically.
+            */
+            const LayerPtrs & Layers() const
+            {
+                return _layers;
+            }
+
             /*!
                 \short Gets dimensions of input data.
 
@@ -1330,7 +2254,8 @@ namespace Simd
                 \param [in] src - a set of input training samples.
                 \param [in] dst - a set of classification results.
                 \param [in] options - an options of training process.
-                \param [in] logger - a functor to log training process.
+                \param [in] logger - a functor to log training process. It is called after every epoch as logger(epoch, speed), 
+                    where epoch is the index of finished epoch and speed is the training throughput of the epoch (samples per second).
                 \return a result of the training.
             */
             template <class Logger> bool Train(const Vectors & src, const Labels & dst, const TrainOptions & options, Logger logger)
@@ -1339,7 +2264,7 @@ namespace Simd
                     return false;
 
                 Vectors converted;
-                Convert(dst, converted);
+                Convert(dst, converted, options.lossType);
 
                 return Train(src, converted, options, logger);
             }
@@ -1350,40 +2275,89 @@ namespace Simd
                 \param [in] src - a set of input training samples.
                 \param [in] dst - a set of classification results.
                 \param [in] options - an options of training process.
-                \param [in] logger - a functor to log training process.
-                \return a result of the training.
+                \param [in] logger - a functor to log training process. It is called after every epoch as logger(epoch, speed), 
+                    where epoch is the index of finished epoch and speed is the training throughput of the epoch (samples per second).
+                \return a result of the training. It fails if TrainOptions::CrossEntropy loss is used with the last layer 
+                    which activation function is not Function::Identity. Continued training (TrainOptions::epochStart > 0) 
+                    fails if the training state of the network (see Network::Load) was accumulated by other TrainOptions::UpdateType.
             */
             template <class Logger> bool Train(const Vectors & src, const Vectors & dst, const TrainOptions & options, Logger logger)
             {
                 SIMD_CHECK_PERFORMANCE();
 
-                if (src.size() != dst.size())
+                if (src.size() != dst.size() || _layers.empty())
+                    return false;
+                if (options.lossType == TrainOptions::CrossEntropy && _layers.back()->_function.type != Function::Identity)
+                    return false;
+                if (options.epochStart > 0 && _updateType >= 0 && _updateType != options.updateType)
                     return false;
 
                 options.threadNumber = std::max<size_t>(1, std::min<size_t>(options.threadNumber, std::thread::hardware_concurrency()));
 
+                Detach();
                 for (size_t i = 0; i < _layers.size(); ++i)
+                {
                     _layers[i]->SetThreadNumber(options.threadNumber, true);
+                }
 
                 if (options.epochStart == 0)
                     InitWeight(options);
+                _updateType = options.updateType;
+
+                UpdateWinograd(false);
+                UpdateReorder(false);
+                UpdateEpilogue(false);
+                ClearQuantized();
 
+                size_t batches = (src.size() + options.batchSize - 1) / options.batchSize;
                 for (size_t epoch = options.epochStart; epoch < options.epochFinish; ++epoch)
                 {
+                    std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now();
                     for (size_t i = 0; i < src.size(); i += options.batchSize)
                     {
                         Propagate(src, dst, i, std::min(i + options.batchSize, src.size()), options);
-                        UpdateWeight(options);
+                        UpdateWeight(options, epoch*batches + i / options.batchSize + 1);
                     }
-                    logger();
+                    double time = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count();
+                    logger(epoch, time > 0 ? double(src.size()) / time : 0.0);
                 }
 
+                UpdateWinograd(true);
+                UpdateReorder(true);
+                UpdateEpilogue(true);
+
                 return true;
             }
 
+            /*!
+                \short Initializes weights of the neural network with random values.
+
+                Training state (accumulated gradients and moments of weight update) is cleared. Network::Train calls it 
+                if TrainOptions::epochStart is equal to 0.
+
+                \param [in] options - an options of training process (TrainOptions::initType is used).
+            */
+            void InitWeight(const TrainOptions & options)
+            {
+                Detach();
+                switch (options.initType)
+                {
+                case TrainOptions::Xavier: InitWeight<TrainOptions::Xavier>(); break;
+                case TrainOptions::He: InitWeight<TrainOptions::He>(); break;
+                }
+                _updateType = -1;
+                UpdateWinograd(true);
+                UpdateReorder(true);
+                UpdateEpilogue(true);
+                ClearQuantized();
+            }
+
             /*!
                 \short Classifies given sample.
 
+                \note The result and intermediate outputs are stored in own buffers of every layer (which are allocated once), 
+                so the returned reference is valid until the next prediction.
+
                 \param [in] x - an input sample.
                 \param [in] method - a method of prediction. By default it is equal to Layer::Fast.
                 \return a result of classification (vector with predicted probabilities).
@@ -1394,16 +2368,103 @@ namespace Simd
             }
 
             /*!
-                \short Loads the neural network from file stream.
+                \short Classifies given set of samples.
+
+                Samples are divided between threads. Every thread propagates its samples through the network by small batches: 
+                fully connected layers use matrix multiplication (::SimdGemm32fNN), convolutional layers apply every weight core 
+                to all samples of the batch. So weights are loaded from memory once per batch instead of once per sample.
+
+                All intermediate results of a thread are placed in one aligned arena. An output of a layer is needed only until 
+                the next layer is computed, so outputs of odd and even layers share two buffers (ping-pong), and the rest of the arena 
+                is temporary memory of layers (padding, matrices of convolution). Therefore the required memory depends on the biggest 
+                layer only, not on the depth of the network. This plan is used only here: prediction of single sample (see Network::Predict) 
+                still uses buffers of every layer (outputs, sums and 8-bit inputs in Layer::Int8 mode) which are kept between calls.
+
+                \param [in] src - a set of input samples.
+                \param [out] dst - a set of results of classification (vectors with predicted probabilities).
+                \param [in] threadNumber - a number of used threads. By default it is equal to number of hardware threads.
+                \param [in] batchSize - a maximal number of samples processed together by one thread. By default it is equal to 32.
+            */
+            void Predict(const Vectors & src, Vectors & dst, size_t threadNumber = std::thread::hardware_concurrency(), size_t batchSize = 32)
+            {
+                SIMD_CHECK_PERFORMANCE();
+
+                threadNumber = std::max<size_t>(1, std::min<size_t>(threadNumber, std::thread::hardware_concurrency()));
+                batchSize = std::max<size_t>(1, batchSize);
+
+                size_t half = 0, buffer = 0;
+                for (size_t i = 0; i < _layers.size(); ++i)
+                {
+                    half = std::max(half, batchSize*_layers[i]->_dst.Volume());
+                    buffer = std::max(buffer, _layers[i]->BatchBuffer(batchSize));
+                }
+                half = Allocator<float>::Align(half, Allocator<float>::Alignment());
+
+                dst.resize(src.size());
+                size_t size = _layers.back()->_dst.Volume();
+                Parallel(0, src.size(), [&](size_t thread, size_t begin, size_t end)
+                {
+                    Vector arena(2 * half + buffer);
+                    for (size_t i = begin; i < end; i += batchSize)
+                    {
+                        size_t count = std::min(batchSize, end - i);
+                        const float * batch = ForwardBatch(src, i, count, arena.data(), half);
+                        for (size_t j = 0; j < count; ++j)
+                            dst[i + j].assign(batch + j*size, batch + (j + 1)*size);
+                    }
+                }, threadNumber);
+            }
+
+            /*!
+                \short Prepares the neural network to prediction with using of 8-bit integer arithmetic (see Layer::Int8).
+
+                Ranges of inputs of all layers are collected over given calibration samples. After that weights of convolutional and 
+                fully connected layers are quantized to 8-bit integers (with separate scale for every output channel) and inputs of 
+                these layers are quantized with using of collected ranges. Quantized weights are 4 times smaller than original ones. 
+                Original weights are kept unchanged, so the network can be trained or saved after quantization. 
+
+                \note Training and loading of the network reset quantized weights.
+
+                \param [in] src - a set of calibration samples. It is usually a small representative subset of training samples.
+                \return a result of quantization.
+            */
+            bool Quantize(const Vectors & src)
+            {
+                if (src.empty() || _layers.empty())
+                    return false;
+                std::vector<float> min(_layers.size(), std::numeric_limits<float>::max());
+                std::vector<float> max(_layers.size(), -std::numeric_limits<float>::max());
+                for (size_t s = 0; s < src.size(); ++s)
+                {
+                    Forward(src[s], 0, Layer::Fast);
+                    for (size_t i = 1; i < _layers.size(); ++i)
+                    {
+                        const Vector & input = _layers[i - 1]->Dst(0);
+                        for (size_t j = 0; j < input.size(); ++j)
+                        {
+                            min[i] = std::min(min[i], input[j]);
+                            max[i] = std::max(max[i], input[j]);
+                        }
+                    }
+                }
+                for (size_t i = 1; i < _layers.size(); ++i)
+                    _layers[i]->Quantize(min[i], max[i]);
+                return true;
+            }
+
+            /*!
+                \short Loads the neural network from input stream.
 
                 \note The network has to be created previously with using of methods Clear/Add.
 
-                \param [in] ifs - a input file stream.
-                \param [in] train - a boolean flag (True - if we need to load temporary training data, False - otherwise). By default it is equal to False.
+                \param [in] ifs - a input stream (file stream for example).
+                \param [in] train - a boolean flag (True - if we need to load training state: accumulated gradients and moments 
+                    of weight update and its type, False - otherwise). By default it is equal to False. 
                 \return a result of loading.
             */
-            bool Load(std::ifstream & ifs, bool train = false)
+            bool Load(std::istream & ifs, bool train = false)
             {
+                Detach();
                 if (train)
                 {
                     for (size_t i = 0; i < _layers.size(); ++i)
@@ -1411,11 +2472,12 @@ namespace Simd
                 }
                 for (size_t i = 0; i < _layers.size(); ++i)
                 {
-                    Layer & layer = *_layers[i];
-                    for (size_t j = 0; j < layer._weight.size(); ++j)
-                        ifs >> layer._weight[j];
-                    for (size_t j = 0; j < layer._bias.size(); ++j)
-                        ifs >> layer._bias[j];
+                    Vector & weight = _layers[i]->_weight.Own();
+                    for (size_t j = 0; j < weight.size(); ++j)
+                        ifs >> weight[j];
+                    Vector & bias = _layers[i]->_bias.Own();
+                    for (size_t j = 0; j < bias.size(); ++j)
+                        ifs >> bias[j];
                 }
                 if (train)
                 {
@@ -1427,7 +2489,35 @@ namespace Simd
                         for (size_t j = 0; j < level._gBias.size(); ++j)
                             ifs >> level._gBias[j];
                     }
+                    // Files without type of weight update contain only state of TrainOptions::AdaptiveGradient (it has no moments).
+                    if (ifs >> _updateType)
+                    {
+                        for (size_t i = 0; i < _layers.size(); ++i)
+                        {
+                            Layer & level = *_layers[i];
+                            for (size_t j = 0; j < level._mWeight.size(); ++j)
+                                ifs >> level._mWeight[j];
+                            for (size_t j = 0; j < level._mBias.size(); ++j)
+                                ifs >> level._mBias[j];
+                        }
+                    }
+                    else
+                    {
+                        ifs.clear();
+                        _updateType = TrainOptions::AdaptiveGradient;
+                        for (size_t i = 0; i < _layers.size(); ++i)
+                        {
+                            Detail::SetZero(_layers[i]->_mWeight);
+                            Detail::SetZero(_layers[i]->_mBias);
+                        }
+                    }
                 }
+                else
+                    _updateType = -1;
+                UpdateWinograd(true);
+                UpdateReorder(true);
+                UpdateEpilogue(true);
+                ClearQuantized();
                 return true;
             }
 
@@ -1437,7 +2527,7 @@ namespace Simd
                 \note The network has to be created previously with using of methods Clear/Add.
 
                 \param [in] path - a path to input file.
-                \param [in] train - a boolean flag (True - if we need to load temporary training data, False - otherwise). By default it is equal to False.
+                \param [in] train - a boolean flag (True - if we need to load training state, False - otherwise). By default it is equal to False.
                 \return a result of loading.
             */
             bool Load(const std::string & path, bool train = false)
@@ -1453,19 +2543,35 @@ namespace Simd
             }
 
             /*!
-                \short Saves the neural network to file stream.
+                \short Saves the neural network to output stream.
 
-                \param [out] ofs - a output file stream.
-                \param [in] train - a boolean flag (True - if we need to save temporary training data, False - otherwise). By default it is equal to False.
+                Values are saved with full precision, so training which is continued after saving and loading of training state 
+                gives the same result as uninterrupted training.
+
+                \param [out] ofs - a output stream (file stream for example).
+                \param [in] train - a boolean flag (True - if we need to save training state: accumulated gradients and moments 
+                    of weight update and its type, False - otherwise). By default it is equal to False.
                 \return a result of saving.
             */
-            bool Save(std::ofstream & ofs, bool train = false) const
+            bool Save(std::ostream & ofs, bool train = false) const
             {
+                std::streamsize precision = ofs.precision(std::numeric_limits<float>::max_digits10);
                 for (size_t i = 0; i < _layers.size(); ++i)
                 {
                     const Layer & layer = *_layers[i];
-                    for (size_t j = 0; j < layer._weight.size(); ++j)
-                        ofs << layer._weight[j] << " ";
+                    if (layer._weight.size() < layer.WeightSize())
+                    {
+                        // Weights of fully connected layer refer to memory mapped binary file in [dst][src] layout (see Network::LoadBinary).
+                        Vector weight(layer.WeightSize());
+                        FullyConnectedLayer::Transpose(layer.Weight(), layer._dst.width, layer._src.width, weight.data());
+                        for (size_t j = 0; j < weight.size(); ++j)
+                            ofs << weight[j] << " ";
+                    }
+                    else
+                    {
+                        for (size_t j = 0; j < layer._weight.size(); ++j)
+                            ofs << layer._weight[j] << " ";
+                    }
                     for (size_t j = 0; j < layer._bias.size(); ++j)
                         ofs << layer._bias[j] << " ";
                 }
@@ -1480,7 +2586,17 @@ namespace Simd
                         for (size_t j = 0; j < level._gBias.size(); ++j)
                             ofs << level._gBias[j] << " ";
                     }
+                    ofs << std::endl << _updateType << " ";
+                    for (size_t i = 0; i < _layers.size(); ++i)
+                    {
+                        const Layer & level = *_layers[i];
+                        for (size_t j = 0; j < level._mWeight.size(); ++j)
+                            ofs << level._mWeight[j] << " ";
+                        for (size_t j = 0; j < level._mBias.size(); ++j)
+                            ofs << level._mBias[j] << " ";
+                    }
                 }
+                ofs.precision(precision);
                 return true;
             }
 
@@ -1488,7 +2604,7 @@ namespace Simd
                 \short Saves the neural network to file.
 
                 \param [in] path - a path to output file.
-                \param [in] train - a boolean flag (True - if we need to save temporary training data, False - otherwise). By default it is equal to False.
+                \param [in] train - a boolean flag (True - if we need to save training state, False - otherwise). By default it is equal to False.
                 \return a result of saving.
             */
             bool Save(const std::string & path, bool train = false) const
@@ -1503,17 +2619,140 @@ namespace Simd
                 return false;
             }
 
+            /*!
+                \short Saves the neural network to file in binary format.
+
+                The binary format is versioned and relocatable: a header with descriptions of all layers (types, activation functions and 
+                dimensions) is followed by blobs with weights and biases which are stored by offsets and aligned by 64 bytes. 
+                Weights of fully connected layers are stored in [dst][src] layout which is used in prediction, so 32-bit weights of all layers 
+                can be used directly from memory mapped file (see Network::LoadBinary). Temporary training data are not saved.
+
+                \param [in] path - a path to output file.
+                \param [in] half - a boolean flag (True - weights are stored as 16-bit floats, False - as 32-bit floats). By default it is equal to False.
+                \return a result of saving.
+            */
+            bool SaveBinary(const std::string & path, bool half = false) const
+            {
+                using namespace Detail::Binary;
+                size_t itemSize = half ? sizeof(uint16_t) : sizeof(float);
+                Header header;
+                memset(&header, 0, sizeof(header));
+                memcpy(header.magic, MAGIC, sizeof(header.magic));
+                header.version = VERSION;
+                header.endianness = ENDIANNESS;
+                header.layerCount = (uint32_t)_layers.size();
+                header.half = half ? 1 : 0;
+                std::vector<LayerHeader> layers(_layers.size());
+                uint64_t offset = AlignHi(sizeof(Header) + layers.size()*sizeof(LayerHeader));
+                for (size_t i = 0; i < _layers.size(); ++i)
+                {
+                    const Layer & layer = *_layers[i];
+                    LayerHeader & desc = layers[i];
+                    memset(&desc, 0, sizeof(desc));
+                    desc.type = layer._type;
+                    desc.function = layer._function.type;
+                    desc.src[0] = (int32_t)layer._src.width, desc.src[1] = (int32_t)layer._src.height, desc.src[2] = (int32_t)layer._src.depth;
+                    desc.dst[0] = (int32_t)layer._dst.width, desc.dst[1] = (int32_t)layer._dst.height, desc.dst[2] = (int32_t)layer._dst.depth;
+                    desc.reordered = layer._type == Layer::FullyConnected ? 1 : 0;
+                    desc.weightCount = layer.WeightSize();
+                    desc.weightOffset = offset;
+                    offset = AlignHi(offset + desc.weightCount*itemSize);
+                    desc.biasCount = layer._bias.size();
+                    desc.biasOffset = offset;
+                    offset = AlignHi(offset + desc.biasCount*itemSize);
+                }
+                header.fileSize = offset;
+
+                std::vector<uint8_t> buffer((size_t)header.fileSize, 0);
+                memcpy(buffer.data(), &header, sizeof(header));
+                if (layers.size())
+                    memcpy(buffer.data() + sizeof(header), layers.data(), layers.size()*sizeof(LayerHeader));
+                for (size_t i = 0; i < _layers.size(); ++i)
+                {
+                    const Layer & layer = *_layers[i];
+                    if (layer._type == Layer::FullyConnected && ((const FullyConnectedLayer&)layer)._reordered.size() == 0)
+                    {
+                        Vector reordered(layer._weight.size());
+                        FullyConnectedLayer::Transpose(layer._weight.data(), layer._src.width, layer._dst.width, reordered.data());
+                        Write(reordered.data(), reordered.size(), half, buffer.data() + layers[i].weightOffset);
+                    }
+                    else
+                        Write(layer.Weight(), layers[i].weightCount, half, buffer.data() + layers[i].weightOffset);
+                    Write(layer._bias.data(), layer._bias.size(), half, buffer.data() + layers[i].biasOffset);
+                }
+
+                std::ofstream ofs(path.c_str(), std::ofstream::binary);
+                if (!ofs.is_open())
+                    return false;
+                ofs.write((const char*)buffer.data(), buffer.size());
+                ofs.close();
+                return !ofs.fail();
+            }
+
+            /*!
+                \short Loads the neural network from memory buffer with binary data (see Network::SaveBinary).
+
+                The buffer is only read (so it can be for example a read only memory mapped file) and is not used after loading: 
+                weights are copied (and converted from 16-bit floats if need) to the network.
+                Descriptions of all layers are checked before loading of weights: on error the network stays unchanged.
+
+                \note The network has to be created previously with using of methods Clear/Add.
+
+                \param [in] data - a pointer to the binary data.
+                \param [in] size - a size of the binary data.
+                \return a result of loading.
+            */
+            bool LoadBinary(const void * data, size_t size)
+            {
+                return LoadBinary((const uint8_t*)data, size, Detail::Binary::MappingPtr());
+            }
+
+            /*!
+                \short Loads the neural network from file in binary format (see Network::SaveBinary).
+
+                The file is memory mapped (see ::SimdMapFile) and is not parsed. 32-bit weights and biases of all layers are not copied: 
+                they refer to the mapped file which is kept until the network is cleared or loaded again. So loading takes almost no time 
+                and memory, and pages of the file are shared between all processes which load the same network. Weights stored 
+                as 16-bit floats are converted and copied. Training and other loading methods copy mapped weights to own memory.
+
+                \note The network has to be created previously with using of methods Clear/Add.
+
+                \param [in] path - a path to input binary file.
+                \return a result of loading.
+            */
+            bool LoadBinary(const std::string & path)
+            {
+                Detail::Binary::MappingPtr mapping(new Detail::Binary::Mapping(path));
+                if (mapping->data == NULL)
+                    return false;
+                return LoadBinary((const uint8_t*)mapping->data, mapping->size, mapping);
+            }
+
+            /*!
+                \short Gets memory mapped binary file which weights of the network refer to (see Network::LoadBinary).
+
+                \param [out] size - a size of the mapped file.
+                \return a pointer to the mapped file. It is NULL if weights of the network don't refer to memory mapped file.
+            */
+            const void * Mapped(size_t & size) const
+            {
+                size = _mapping ? _mapping->size : 0;
+                return _mapping ? _mapping->data : NULL;
+            }
+
             /*!
                 \short Converts format of classification results.
 
                 \param [in] src - a set of class indexes.
                 \param [out] dst - a set of vectors with predicted probabilities.
+                \param [in] loss - a loss function used in training. TrainOptions::CrossEntropy requires one-hot vectors (0 and 1), 
+                    other losses use output range of activation function of the last layer. By default it is equal to TrainOptions::Mse.
             */
-            void Convert(const Labels & src, Vectors & dst) const
+            void Convert(const Labels & src, Vectors & dst, TrainOptions::LossType loss = TrainOptions::Mse) const
             {
                 size_t size = _layers.back()->_dst.Volume();
-                float min = _layers.back()->_function.min;
-                float max = _layers.back()->_function.max;
+                float min = loss == TrainOptions::CrossEntropy ? 0.0f : _layers.back()->_function.min;
+                float max = loss == TrainOptions::CrossEntropy ? 1.0f : _layers.back()->_function.max;
                 dst.resize(src.size());
                 for (size_t i = 0; i < dst.size(); ++i)
                 {
@@ -1525,6 +2764,8 @@ namespace Simd
 
  private:
             LayerPtrs _layers;
+            Detail::Binary::MappingPtr _mapping;
+            int _updateType; // Type of weight update (see TrainOptions::UpdateType) which training state belongs to. It is negative if there is no state.
 
             const Vector & Forward(const Vector & src, size_t thread, Layer::Method method)
             {
@@ -1536,6 +2777,23 @@ namespace Simd
                 return _layers.back()->Dst(thread);
             }
 
+            // The arena consists of two buffers (with given size) for outputs of layers and temporary buffer of layers.
+            const float * ForwardBatch(const Vectors & src, size_t begin, size_t count, float * arena, size_t half)
+            {
+                SIMD_CHECK_PERFORMANCE();
+
+                size_t size = _layers.front()->_dst.Volume();
+                for (size_t i = 0; i < count; ++i)
+                {
+                    assert(src[begin + i].size() == size);
+                    memcpy(arena + i*size, src[begin + i].data(), size*sizeof(float));
+                }
+                float * buffer = arena + 2 * half;
+                for (size_t i = 1; i < _layers.size(); ++i)
+                    _layers[i]->ForwardBatch(arena + (1 - i % 2)*half, count, arena + (i % 2)*half, buffer);
+                return arena + (1 - _layers.size() % 2)*half;
+            }
+
             void Backward(const Vector & current, const Vector & control, size_t thread, const TrainOptions & options)
             {
                 SIMD_CHECK_PERFORMANCE();
@@ -1568,58 +2826,184 @@ namespace Simd
                 for (size_t l = 0; l < _layers.size(); ++l)
                 {
                     Layer & layer = *_layers[l];
-                    Detail::InitWeight<type>(layer._weight, layer);
-                    Detail::InitWeight<type>(layer._bias, layer);
+                    Detail::InitWeight<type>(layer._weight.Own(), layer);
+                    Detail::InitWeight<type>(layer._bias.Own(), layer);
                     Detail::SetZero(layer._gWeight);
                     Detail::SetZero(layer._gBias);
+                    Detail::SetZero(layer._mWeight);
+                    Detail::SetZero(layer._mBias);
                 }
             }
 
-            void InitWeight(const TrainOptions & options)
+            void LossGradient(const TrainOptions & options, const Vector & current, const Vector & control, Vector & delta)
             {
-                switch (options.initType)
+                switch (options.lossType)
                 {
-                case TrainOptions::Xavier: InitWeight<TrainOptions::Xavier>(); break;
+                case TrainOptions::Mse: Detail::Gradient<TrainOptions::Mse>(current, control, delta); break;
+                case TrainOptions::CrossEntropy: Detail::Gradient<TrainOptions::CrossEntropy>(current, control, delta); break;
                 }
             }
 
-            void LossGradient(const TrainOptions & options, const Vector & current, const Vector & control, Vector & delta)
+            /*
+            * Gradients of all threads are split into shards (parts of weights or biases of a layer). Every shard is reduced 
+            * (sum of gradients of all threads), updated and cleared by one thread, so threads work with disjoint memory without any locks.
+            */
+            template<TrainOptions::UpdateType type> void UpdateWeight(const TrainOptions & options, size_t step)
             {
-                switch (options.lossType)
+                float alpha = float(options.alpha*std::sqrt(1.0 - std::pow(options.beta2, step)) / (1.0 - std::pow(options.beta1, step)));
+                std::vector<Detail::Shard> shards;
+                for (size_t l = 0; l < _layers.size(); ++l)
                 {
-                case TrainOptions::Mse: Detail::Gradient<TrainOptions::Mse>(current, control, delta); break;
+                    Layer * layer = _layers[l].get();
+                    for (size_t i = 0; i < layer->_weight.size(); i += Detail::SHARD_SIZE)
+                        shards.push_back(Detail::Shard(layer, false, i, std::min(Detail::SHARD_SIZE, layer->_weight.size() - i)));
+                    for (size_t i = 0; i < layer->_bias.size(); i += Detail::SHARD_SIZE)
+                        shards.push_back(Detail::Shard(layer, true, i, std::min(Detail::SHARD_SIZE, layer->_bias.size() - i)));
                 }
+
+                Parallel(0, shards.size(), [&](size_t thread, size_t begin, size_t end)
+                {
+                    const float one = 1.0f;
+                    for (size_t s = begin; s < end; ++s)
+                    {
+                        const Detail::Shard & shard = shards[s];
+                        Layer & layer = *shard.layer;
+                        Vector & m = shard.bias ? layer._mBias : layer._mWeight;
+                        Vector & g = shard.bias ? layer._gBias : layer._gWeight;
+                        Vector & v = shard.bias ? layer._bias.Own() : layer._weight.Own();
+                        float * d = (shard.bias ? layer._common[0].dBias : layer._common[0].dWeight).data() + shard.offset;
+                        for (size_t t = 1; t < layer._common.size(); ++t)
+                        {
+                            float * dt = (shard.bias ? layer._common[t].dBias : layer._common[t].dWeight).data() + shard.offset;
+                            ::SimdNeuralAddVectorMultipliedByValue(dt, shard.size, &one, d);
+                            memset(dt, 0, shard.size * sizeof(float));
+                        }
+                        Detail::UpdateWeight<type>(options, alpha, d, shard.size, m.data() + shard.offset, g.data() + shard.offset, v.data() + shard.offset);
+                        memset(d, 0, shard.size * sizeof(float));
+                    }
+                }, std::min(options.threadNumber, shards.size()));
             }
 
-            template<TrainOptions::UpdateType type> void UpdateWeight(const TrainOptions & options)
+            void UpdateWeight(const TrainOptions & options, size_t step)
             {
-                for (size_t l = 0; l < _layers.size(); ++l)
+                SIMD_CHECK_PERFORMANCE();
+
+                switch (options.updateType)
                 {
-                    Layer & layer = *_layers[l];
-                    for (size_t t = 1; t < layer._common.size(); ++t)
+                case TrainOptions::AdaptiveGradient: UpdateWeight<TrainOptions::AdaptiveGradient>(options, step); break;
+                case TrainOptions::Momentum: UpdateWeight<TrainOptions::Momentum>(options, step); break;
+                case TrainOptions::Adam: UpdateWeight<TrainOptions::Adam>(options, step); break;
+                case TrainOptions::AdamW: UpdateWeight<TrainOptions::AdamW>(options, step); break;
+                }
+            }
+
+            // Checks descriptions of all layers and loads weights. 32-bit weights refer to the memory mapped file if it is given.
+            bool LoadBinary(const uint8_t * file, size_t size, const Detail::Binary::MappingPtr & mapping)
+            {
+                using namespace Detail::Binary;
+                Header header;
+                if (file == NULL || size < sizeof(header))
+                    return false;
+                memcpy(&header, file, sizeof(header));
+                if (memcmp(header.magic, MAGIC, sizeof(header.magic)) != 0 || header.version != VERSION || header.endianness != ENDIANNESS || 
+                    header.fileSize > size || header.layerCount != _layers.size() || sizeof(header) + header.layerCount*sizeof(LayerHeader) > size)
+                    return false;
+                size_t itemSize = header.half ? sizeof(uint16_t) : sizeof(float);
+                std::vector<LayerHeader> layers(_layers.size());
+                if (layers.size())
+                    memcpy(layers.data(), file + sizeof(header), layers.size()*sizeof(LayerHeader));
+                for (size_t i = 0; i < _layers.size(); ++i)
+                {
+                    const Layer & layer = *_layers[i];
+                    const LayerHeader & desc = layers[i];
+                    if (desc.type != layer._type || desc.function != layer._function.type || 
+                        desc.src[0] != layer._src.width || desc.src[1] != layer._src.height || desc.src[2] != layer._src.depth ||
+                        desc.dst[0] != layer._dst.width || desc.dst[1] != layer._dst.height || desc.dst[2] != layer._dst.depth ||
+                        desc.weightCount != layer.WeightSize() || desc.biasCount != layer._bias.size() ||
+                        !Valid(desc.weightOffset, desc.weightCount, itemSize, header.fileSize) || 
+                        !Valid(desc.biasOffset, desc.biasCount, itemSize, header.fileSize))
+                        return false;
+                }
+                bool refer = mapping && header.half == 0;
+                for (size_t i = 0; i < _layers.size(); ++i)
+                {
+                    Layer & layer = *_layers[i];
+                    const LayerHeader & desc = layers[i];
+                    const float * weight = (const float*)(file + desc.weightOffset), * bias = (const float*)(file + desc.biasOffset);
+                    if (layer._type == Layer::FullyConnected)
+                        ((FullyConnectedLayer&)layer)._reordered.clear();
+                    if (refer && layer._type == Layer::FullyConnected && desc.reordered)
+                    {
+                        layer._weight.clear();
+                        ((FullyConnectedLayer&)layer)._reordered.Refer(weight, (size_t)desc.weightCount);
+                    }
+                    else if (refer && layer._type != Layer::FullyConnected)
+                        layer._weight.Refer(weight, (size_t)desc.weightCount);
+                    else
                     {
-                        Detail::AddTo(layer._common[t].dWeight, layer._common[0].dWeight);
-                        Detail::AddTo(layer._common[t].dBias, layer._common[0].dBias);
+                        layer._weight.resize((size_t)desc.weightCount);
+                        Vector & own = layer._weight.Own();
+                        Read(file + desc.weightOffset, header.half != 0, own);
+                        if (layer._type == Layer::FullyConnected && desc.reordered)
+                        {
+                            Vector reordered(own);
+                            FullyConnectedLayer::Transpose(reordered.data(), layer._dst.width, layer._src.width, own.data());
+                        }
                     }
-                    Detail::UpdateWeight<type>(options, layer._common[0].dWeight, layer._gWeight, layer._weight);
-                    Detail::UpdateWeight<type>(options, layer._common[0].dBias, layer._gBias, layer._bias);
-                    for (size_t t = 0; t < layer._common.size(); ++t)
+                    if (refer)
+                        layer._bias.Refer(bias, (size_t)desc.biasCount);
+                    else
                     {
-                        Detail::SetZero(layer._common[t].dWeight);
-                        Detail::SetZero(layer._common[t].dBias);
+                        layer._bias.resize((size_t)desc.biasCount);
+                        Read(file + desc.biasOffset, header.half != 0, layer._bias.Own());
                     }
                 }
+                _mapping = refer ? mapping : MappingPtr();
+                UpdateWinograd(true);
+                UpdateReorder(true);
+                UpdateEpilogue(true);
+                ClearQuantized();
+                return true;
             }
 
-            void UpdateWeight(const TrainOptions & options)
+            // Copies weights which refer to memory mapped binary file to own memory of layers (before their modification) and releases the file.
+            void Detach()
             {
-                SIMD_CHECK_PERFORMANCE();
+                for (size_t i = 0; i < _layers.size(); ++i)
+                    _layers[i]->Detach();
+                _mapping.reset();
+            }
 
-                switch (options.updateType)
+            void UpdateWinograd(bool enable)
+            {
+                for (size_t i = 0; i < _layers.size(); ++i)
+                    if (_layers[i]->_type == Layer::Convolutional)
+                        ((ConvolutionalLayer*)_layers[i].get())->UpdateWinograd(enable);
+            }
+
+            void UpdateReorder(bool enable)
+            {
+                for (size_t i = 0; i < _layers.size(); ++i)
+                    if (_layers[i]->_type == Layer::FullyConnected)
+                        ((FullyConnectedLayer*)_layers[i].get())->UpdateReorder(enable);
+            }
+
+            // Moves 2x2 max pooling (with its activation) into epilogue of previous convolutional layer (in Layer::Fast and Layer::Int8 modes).
+            void UpdateEpilogue(bool enable)
+            {
+                for (size_t i = 1; i < _layers.size(); ++i)
                 {
-                case TrainOptions::AdaptiveGradient: UpdateWeight<TrainOptions::AdaptiveGradient>(options); break;
+                    Layer & layer = *_layers[i];
+                    layer._inEpilogue = enable && layer._type == Layer::MaxPooling && _layers[i - 1]->_type == Layer::Convolutional && 
+                        ((MaxPoolingLayer&)layer)._poolingSize == 2 && layer._src.width % 2 == 0 && layer._src.height % 2 == 0;
                 }
             }
+
+            void ClearQuantized()
+            {
+                for (size_t i = 0; i < _layers.size(); ++i)
+                    _layers[i]->_quantized.weight.clear();
+            }
         };
     }
 }
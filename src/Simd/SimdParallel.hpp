@@ -24,6 +24,8 @@
 #ifndef __SimdParallel_hpp__
 #define __SimdParallel_hpp__
 
+#include "Simd/SimdLib.hpp"
+
 #include <thread>
 #include <future>
 
@@ -55,6 +57,116 @@ namespace Simd
                 futures[i].wait();        
         }
     }
+
+    /*! @ingroup histogram
+
+        \fn void Clahe(const View<A> & src, size_t tilesX, size_t tilesY, float clipLimit, View<A> & dst, size_t threadNumber)
+
+        \short Performs contrast limited adaptive histogram equalization (CLAHE) of 8-bit gray image in several threads.
+
+        The input and output 8-bit gray images must have the same size. Lookup tables of tile rows and rows of output image 
+        are processed in parallel.
+
+        \note This function is a C++ wrapper for functions ::SimdClaheLuts and ::SimdClaheApply.
+
+        \param [in] src - an input 8-bit gray image.
+        \param [in] tilesX - a number of tiles in horizontal direction.
+        \param [in] tilesY - a number of tiles in vertical direction.
+        \param [in] clipLimit - a clip limit relative to height of uniform histogram (for example 2.0 or 4.0). Zero or negative value disables clipping.
+        \param [out] dst - an output 8-bit gray image.
+        \param [in] threadNumber - a maximal number of used threads.
+    */
+    template<template<class> class A> SIMD_INLINE void Clahe(const View<A> & src, size_t tilesX, size_t tilesY, float clipLimit, View<A> & dst, size_t threadNumber)
+    {
+        assert(Compatible(src, dst) && src.format == View<A>::Gray8 && tilesX > 0 && tilesY > 0 && src.width >= tilesX && src.height >= tilesY);
+
+        std::vector<uint8_t> luts(tilesX*tilesY*256);
+        Parallel(0, tilesY, [&](size_t thread, size_t begin, size_t end)
+        {
+            SimdClaheLuts(src.data, src.stride, src.width, src.height, tilesX, tilesY, clipLimit, begin, end, luts.data());
+        }, threadNumber);
+        Parallel(0, src.height, [&](size_t thread, size_t begin, size_t end)
+        {
+            SimdClaheApply(src.data, src.stride, src.width, src.height, tilesX, tilesY, luts.data(), begin, end, dst.data, dst.stride);
+        }, threadNumber);
+    }
+
+    /*! @ingroup other_statistic
+
+        \fn void GetImageStatistics(const View<A> & src, const View<A> & mask, uint8_t index, uint32_t flags, SimdImageStatistics & statistics, size_t threadNumber)
+
+        \short Calculates several statistics of 8-bit gray image in several threads. Only pixels with mask[x, y] == index are processed.
+
+        The image is divided into horizontal stripes which are processed in parallel, their statistics are merged.
+
+        \note This function is a C++ wrapper for function ::SimdGetImageStatistics.
+
+        \param [in] src - an input 8-bit gray image.
+        \param [in] mask - a 8-bit mask image. It must have the same size as the input image.
+        \param [in] index - a mask index.
+        \param [in] flags - a set of calculated statistics (see ::SimdImageStatisticsFlags).
+        \param [out] statistics - a reference to structure with calculated statistics.
+        \param [in] threadNumber - a maximal number of used threads.
+    */
+    template<template<class> class A> SIMD_INLINE void GetImageStatistics(const View<A> & src, const View<A> & mask, uint8_t index, uint32_t flags, 
+        SimdImageStatistics & statistics, size_t threadNumber)
+    {
+        assert(src.format == View<A>::Gray8 && (mask.data == NULL || Compatible(src, mask)));
+
+        std::vector<SimdImageStatistics> partial(std::max<size_t>(threadNumber, 1));
+        Parallel(0, src.height, [&](size_t thread, size_t begin, size_t end)
+        {
+            SimdGetImageStatistics(src.data, src.stride, src.width, src.height, mask.data, mask.stride, index, flags, begin, end, &partial[thread]);
+        }, threadNumber);
+
+        statistics = partial[0];
+        for (size_t i = 1; i < partial.size(); ++i)
+        {
+            const SimdImageStatistics & p = partial[i];
+            if (p.count == 0)
+                continue;
+            if (statistics.count == 0)
+            {
+                statistics = p;
+                continue;
+            }
+            statistics.min = std::min(statistics.min, p.min);
+            statistics.max = std::max(statistics.max, p.max);
+            statistics.count += p.count;
+            statistics.sum += p.sum;
+            statistics.squareSum += p.squareSum;
+            statistics.x += p.x;
+            statistics.y += p.y;
+            statistics.xx += p.xx;
+            statistics.xy += p.xy;
+            statistics.yy += p.yy;
+            statistics.laplaceAbsSum += p.laplaceAbsSum;
+            for (size_t j = 0; j < 256; ++j)
+                statistics.histogram[j] += p.histogram[j];
+        }
+        if ((flags & SimdImageStatisticsMinMax) && statistics.count)
+            statistics.average = (uint8_t)((statistics.sum + statistics.count / 2) / statistics.count);
+    }
+
+    /*! @ingroup other_statistic
+
+        \fn void GetImageStatistics(const View<A> & src, uint32_t flags, SimdImageStatistics & statistics, size_t threadNumber)
+
+        \short Calculates several statistics of 8-bit gray image in several threads.
+
+        The image is divided into horizontal stripes which are processed in parallel, their statistics are merged.
+
+        \note This function is a C++ wrapper for function ::SimdGetImageStatistics.
+
+        \param [in] src - an input 8-bit gray image.
+        \param [in] flags - a set of calculated statistics (see ::SimdImageStatisticsFlags).
+        \param [out] statistics - a reference to structure with calculated statistics.
+        \param [in] threadNumber - a maximal number of used threads.
+    */
+    template<template<class> class A> SIMD_INLINE void GetImageStatistics(const View<A> & src, uint32_t flags, SimdImageStatistics & statistics, size_t threadNumber)
+    {
+        GetImageStatistics(src, View<A>(), 0, flags, statistics, threadNumber);
+    }
 }
 
 #endif//__SimdParallel_hpp__
@@ -0,0 +1,117 @@
+/*
+* Simd Library (http://simd.sourceforge.net).
+*
+* Copyright (c) 2011-2017 Yermalayeu Ihar.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+#include "Simd/SimdGemm.h"
+#include "Simd/SimdStore.h"
+
+namespace Simd
+{
+#ifdef SIMD_SSE_ENABLE    
+    namespace Sse
+    {
+        template <size_t M> SIMD_INLINE void GemmKernel2F(size_t K, const __m128 & alpha, const float * A, size_t lda, const float * B, size_t ldb, float * C, size_t ldc)
+        {
+            __m128 c[M][2];
+            for (size_t i = 0; i < M; ++i)
+                c[i][0] = _mm_setzero_ps(), c[i][1] = _mm_setzero_ps();
+            for (size_t k = 0; k < K; ++k)
+            {
+                __m128 b0 = _mm_loadu_ps(B + k*ldb + 0);
+                __m128 b1 = _mm_loadu_ps(B + k*ldb + F);
+                for (size_t i = 0; i < M; ++i)
+                {
+                    __m128 a = _mm_set1_ps(A[i*lda + k]);
+                    c[i][0] = _mm_add_ps(c[i][0], _mm_mul_ps(a, b0));
+                    c[i][1] = _mm_add_ps(c[i][1], _mm_mul_ps(a, b1));
+                }
+            }
+            for (size_t i = 0; i < M; ++i)
+            {
+                _mm_storeu_ps(C + i*ldc + 0, _mm_add_ps(_mm_loadu_ps(C + i*ldc + 0), _mm_mul_ps(alpha, c[i][0])));
+                _mm_storeu_ps(C + i*ldc + F, _mm_add_ps(_mm_loadu_ps(C + i*ldc + F), _mm_mul_ps(alpha, c[i][1])));
+            }
+        }
+
+        template <size_t M> SIMD_INLINE void GemmKernel1F(size_t K, const __m128 & alpha, const float * A, size_t lda, const float * B, size_t ldb, float * C, size_t ldc)
+        {
+            __m128 c[M];
+            for (size_t i = 0; i < M; ++i)
+                c[i] = _mm_setzero_ps();
+            for (size_t k = 0; k < K; ++k)
+            {
+                __m128 b0 = _mm_loadu_ps(B + k*ldb);
+                for (size_t i = 0; i < M; ++i)
+                    c[i] = _mm_add_ps(c[i], _mm_mul_ps(_mm_set1_ps(A[i*lda + k]), b0));
+            }
+            for (size_t i = 0; i < M; ++i)
+                _mm_storeu_ps(C + i*ldc, _mm_add_ps(_mm_loadu_ps(C + i*ldc), _mm_mul_ps(alpha, c[i])));
+        }
+
+        template <size_t M> SIMD_INLINE void GemmKernel1(size_t K, float alpha, const float * A, size_t lda, const float * B, size_t ldb, float * C, size_t ldc)
+        {
+            float c[M] = { 0 };
+            for (size_t k = 0; k < K; ++k)
+            {
+                float b = B[k*ldb];
+                for (size_t i = 0; i < M; ++i)
+                    c[i] += A[i*lda + k] * b;
+            }
+            for (size_t i = 0; i < M; ++i)
+                C[i*ldc] += alpha*c[i];
+        }
+
+        template <size_t M> void GemmKernel(size_t N, size_t K, float alpha, const float * A, size_t lda, const float * B, size_t ldb, float * C, size_t ldc)
+        {
+            __m128 _alpha = _mm_set1_ps(alpha);
+            size_t j = 0;
+            for (; j + DF <= N; j += DF)
+                GemmKernel2F<M>(K, _alpha, A, lda, B + j, ldb, C + j, ldc);
+            for (; j + F <= N; j += F)
+                GemmKernel1F<M>(K, _alpha, A, lda, B + j, ldb, C + j, ldc);
+            for (; j < N; ++j)
+                GemmKernel1<M>(K, alpha, A, lda, B + j, ldb, C + j, ldc);
+        }
+
+        struct Gemm32fNNKernels
+        {
+            static void Kernel(size_t M, size_t N, size_t K, float alpha, const float * A, size_t lda, const float * B, size_t ldb, float * C, size_t ldc)
+            {
+                switch (M)
+                {
+                case 1: GemmKernel<1>(N, K, alpha, A, lda, B, ldb, C, ldc); break;
+                case 2: GemmKernel<2>(N, K, alpha, A, lda, B, ldb, C, ldc); break;
+                case 3: GemmKernel<3>(N, K, alpha, A, lda, B, ldb, C, ldc); break;
+                case 4: GemmKernel<4>(N, K, alpha, A, lda, B, ldb, C, ldc); break;
+                default: assert(0);
+                }
+            }
+        };
+
+        void Gemm32fNN(size_t M, size_t N, size_t K, const float * alpha, const float * A, size_t lda,
+            const float * B, size_t ldb, const float * beta, float * C, size_t ldc)
+        {
+            Base::Gemm32fNNRun<Gemm32fNNKernels>(M, N, K, *alpha, A, lda, B, ldb, *beta, C, ldc);
+        }
+    }
+#endif// SIMD_SSE_ENABLE
+}
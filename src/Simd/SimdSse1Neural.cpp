@@ -24,6 +24,8 @@
 #include "Simd/SimdMemory.h"
 #include "Simd/SimdExtract.h"
 #include "Simd/SimdStore.h"
+#include "Simd/SimdNeural.h"
+#include "Simd/SimdSse1.h"
 
 namespace Simd
 {
@@ -447,6 +449,73 @@ namespace Simd
                 NeuralAdaptiveGradientUpdate<false>(delta, size, batch, alpha, epsilon, gradient, weight);
         }
 
+        struct AdamParam
+        {
+            __m128 norm, alpha, beta1, beta2, gamma1, gamma2, epsilon, decay;
+
+            AdamParam(size_t batch, const float * alpha_, const float * beta1_, const float * beta2_, const float * epsilon_, const float * decay_)
+                : norm(_mm_set1_ps(float(1.0 / batch)))
+                , alpha(_mm_set1_ps(*alpha_))
+                , beta1(_mm_set1_ps(*beta1_))
+                , beta2(_mm_set1_ps(*beta2_))
+                , gamma1(_mm_set1_ps(1.0f - *beta1_))
+                , gamma2(_mm_set1_ps(1.0f - *beta2_))
+                , epsilon(_mm_set1_ps(*epsilon_))
+                , decay(_mm_set1_ps(*decay_))
+            {
+            }
+        };
+
+        template <bool align> SIMD_INLINE void AdamUpdate(const float * delta, size_t offset, const AdamParam & p, float * moment1, float * moment2, float * weight)
+        {
+            __m128 d = _mm_mul_ps(Load<align>(delta + offset), p.norm);
+            __m128 m1 = _mm_add_ps(_mm_mul_ps(p.beta1, Load<align>(moment1 + offset)), _mm_mul_ps(p.gamma1, d));
+            __m128 m2 = _mm_add_ps(_mm_mul_ps(p.beta2, Load<align>(moment2 + offset)), _mm_mul_ps(p.gamma2, _mm_mul_ps(d, d)));
+            Store<align>(moment1 + offset, m1);
+            Store<align>(moment2 + offset, m2);
+            __m128 w = Load<align>(weight + offset);
+            __m128 step = _mm_div_ps(_mm_mul_ps(p.alpha, m1), _mm_add_ps(_mm_sqrt_ps(m2), p.epsilon));
+            Store<align>(weight + offset, _mm_sub_ps(w, _mm_add_ps(step, _mm_mul_ps(p.decay, w))));
+        }
+
+        template <bool align> void NeuralAdamUpdate(const float * delta, size_t size, size_t batch, const float * alpha, const float * beta1, const float * beta2,
+            const float * epsilon, const float * decay, float * moment1, float * moment2, float * weight)
+        {
+            if (align)
+                assert(Aligned(delta) && Aligned(moment1) && Aligned(moment2) && Aligned(weight));
+
+            size_t partialAlignedSize = AlignLo(size, F);
+            size_t fullAlignedSize = AlignLo(size, QF);
+            AdamParam param(batch, alpha, beta1, beta2, epsilon, decay);
+            size_t i = 0;
+            if (partialAlignedSize)
+            {
+                if (fullAlignedSize)
+                {
+                    for (; i < fullAlignedSize; i += QF)
+                    {
+                        AdamUpdate<align>(delta, i + F * 0, param, moment1, moment2, weight);
+                        AdamUpdate<align>(delta, i + F * 1, param, moment1, moment2, weight);
+                        AdamUpdate<align>(delta, i + F * 2, param, moment1, moment2, weight);
+                        AdamUpdate<align>(delta, i + F * 3, param, moment1, moment2, weight);
+                    }
+                }
+                for (; i < partialAlignedSize; i += F)
+                    AdamUpdate<align>(delta, i, param, moment1, moment2, weight);
+            }
+            for (; i < size; ++i)
+                Base::AdamUpdate(delta, i, float(1.0 / batch), *alpha, *beta1, *beta2, *epsilon, *decay, moment1, moment2, weight);
+        }
+
+        void NeuralAdamUpdate(const float * delta, size_t size, size_t batch, const float * alpha, const float * beta1, const float * beta2,
+            const float * epsilon, const float * decay, float * moment1, float * moment2, float * weight)
+        {
+            if (Aligned(delta) && Aligned(moment1) && Aligned(moment2) && Aligned(weight))
+                NeuralAdamUpdate<true>(delta, size, batch, alpha, beta1, beta2, epsilon, decay, moment1, moment2, weight);
+            else
+                NeuralAdamUpdate<false>(delta, size, batch, alpha, beta1, beta2, epsilon, decay, moment1, moment2, weight);
+        }
+
         template <size_t size> SIMD_INLINE void LoadWeights(const float * src, __m128 * dst)
         {
             for (size_t i = 0; i < size; ++i)
@@ -879,6 +948,131 @@ namespace Simd
             else
                 NeuralMax2x2<false>(src, srcStride, width, height, dst, dstStride);
         }
+
+        void NeuralConvolutionForward(const float * src, size_t srcWidth, size_t srcHeight, size_t srcDepth, const float * weight,
+            size_t kernelX, size_t kernelY, size_t padX, size_t padY, size_t strideX, size_t strideY, size_t dilationX, size_t dilationY,
+            void * buffer, size_t * size, float * dst, size_t dstWidth, size_t dstHeight, size_t dstDepth, int add)
+        {
+            Base::NeuralConvolutionShape shape(srcWidth, srcHeight, srcDepth, kernelX, kernelY, padX, padY, strideX, strideY, dilationX, dilationY, dstWidth, dstHeight, dstDepth);
+            Base::NeuralConvolutionForwardRun<Gemm32fNN>(shape, src, weight, buffer, size, dst, add);
+        }
+
+        void NeuralConvolutionBackward(const float * src, size_t srcWidth, size_t srcHeight, size_t srcDepth, const float * weight,
+            size_t kernelX, size_t kernelY, size_t padX, size_t padY, size_t strideX, size_t strideY, size_t dilationX, size_t dilationY,
+            void * buffer, size_t * size, float * dst, size_t dstWidth, size_t dstHeight, size_t dstDepth, int add)
+        {
+            Base::NeuralConvolutionShape shape(dstWidth, dstHeight, dstDepth, kernelX, kernelY, padX, padY, strideX, strideY, dilationX, dilationY, srcWidth, srcHeight, srcDepth);
+            Base::NeuralConvolutionBackwardRun<Gemm32fNN>(shape, src, weight, buffer, size, dst, add);
+        }
+
+        void NeuralConvolutionSum(const float * src, size_t srcWidth, size_t srcHeight, size_t srcDepth, const float * dst, size_t dstWidth, size_t dstHeight, size_t dstDepth,
+            size_t kernelX, size_t kernelY, size_t padX, size_t padY, size_t strideX, size_t strideY, size_t dilationX, size_t dilationY,
+            void * buffer, size_t * size, float * sums)
+        {
+            Base::NeuralConvolutionShape shape(srcWidth, srcHeight, srcDepth, kernelX, kernelY, padX, padY, strideX, strideY, dilationX, dilationY, dstWidth, dstHeight, dstDepth);
+            Base::NeuralConvolutionSumRun<Gemm32fNN>(shape, src, dst, buffer, size, sums);
+        }
+
+        SIMD_INLINE void NeuralWinograd2x2p3x3SetInputLoad4(const float * src, __m128 * dst)
+        {
+            __m128 a0 = _mm_loadu_ps(src + 0);
+            __m128 a1 = _mm_loadu_ps(src + 4);
+            __m128 b0 = _mm_loadu_ps(src + 2);
+            __m128 b1 = _mm_loadu_ps(src + 6);
+            dst[0] = _mm_shuffle_ps(a0, a1, 0x88);
+            dst[1] = _mm_shuffle_ps(a0, a1, 0xDD);
+            dst[2] = _mm_shuffle_ps(b0, b1, 0x88);
+            dst[3] = _mm_shuffle_ps(b0, b1, 0xDD);
+        }
+
+        SIMD_INLINE void NeuralWinograd2x2p3x3SetInput4(const float * src, size_t srcStride, float * dst, size_t dstStride)
+        {
+            __m128 s[16], t[16];
+            for (size_t i = 0; i < 4; ++i)
+                NeuralWinograd2x2p3x3SetInputLoad4(src + i*srcStride, s + i * 4);
+            for (size_t i = 0; i < 4; ++i)
+            {
+                t[0 + i] = _mm_sub_ps(s[0 + i], s[8 + i]);
+                t[4 + i] = _mm_add_ps(s[4 + i], s[8 + i]);
+                t[8 + i] = _mm_sub_ps(s[8 + i], s[4 + i]);
+                t[12 + i] = _mm_sub_ps(s[4 + i], s[12 + i]);
+            }
+            for (size_t i = 0; i < 16; i += 4)
+            {
+                _mm_storeu_ps(dst + (i + 0)*dstStride, _mm_sub_ps(t[i + 0], t[i + 2]));
+                _mm_storeu_ps(dst + (i + 1)*dstStride, _mm_add_ps(t[i + 1], t[i + 2]));
+                _mm_storeu_ps(dst + (i + 2)*dstStride, _mm_sub_ps(t[i + 2], t[i + 1]));
+                _mm_storeu_ps(dst + (i + 3)*dstStride, _mm_sub_ps(t[i + 1], t[i + 3]));
+            }
+        }
+
+        void NeuralWinograd2x2p3x3SetInput(const float * src, size_t srcWidth, size_t srcHeight, size_t srcDepth, float * dst)
+        {
+            assert(srcWidth > 2 && srcHeight > 2);
+            size_t tileH = (srcHeight - 1) / 2, tileW = (srcWidth - 1) / 2, dstStride = srcDepth*tileH*tileW;
+            size_t tileW4 = AlignLo(Simd::Min(tileW, (srcWidth - 2) / 2), 4);
+            for (size_t c = 0; c < srcDepth; ++c)
+            {
+                for (size_t row = 0; row < tileH; ++row)
+                {
+                    size_t rows = Simd::Min<size_t>(4, srcHeight - row * 2), col = 0;
+                    const float * s = src + row * 2 * srcWidth;
+                    if (rows == 4)
+                    {
+                        for (; col < tileW4; col += 4, dst += 4)
+                            NeuralWinograd2x2p3x3SetInput4(s + col * 2, srcWidth, dst, dstStride);
+                    }
+                    for (; col < tileW; ++col)
+                    {
+                        size_t cols = Simd::Min<size_t>(4, srcWidth - col * 2);
+                        Base::NeuralWinograd2x2p3x3SetInput1(s + col * 2, srcWidth, rows, cols, dst++, dstStride);
+                    }
+                }
+                src += srcWidth*srcHeight;
+            }
+        }
+
+        SIMD_INLINE void NeuralWinograd2x2p3x3SetOutput4(const float * src, size_t srcStride, float * dst, size_t dstStride)
+        {
+            __m128 s[16], t[8];
+            for (size_t i = 0; i < 16; ++i)
+                s[i] = _mm_loadu_ps(src + i*srcStride);
+            for (size_t i = 0; i < 4; ++i)
+            {
+                t[0 + i] = _mm_add_ps(_mm_add_ps(s[0 + i], s[4 + i]), s[8 + i]);
+                t[4 + i] = _mm_sub_ps(_mm_sub_ps(s[4 + i], s[8 + i]), s[12 + i]);
+            }
+            __m128 d00 = _mm_add_ps(_mm_add_ps(t[0], t[1]), t[2]);
+            __m128 d01 = _mm_sub_ps(_mm_sub_ps(t[1], t[2]), t[3]);
+            __m128 d10 = _mm_add_ps(_mm_add_ps(t[4], t[5]), t[6]);
+            __m128 d11 = _mm_sub_ps(_mm_sub_ps(t[5], t[6]), t[7]);
+            _mm_storeu_ps(dst + 0, _mm_unpacklo_ps(d00, d01));
+            _mm_storeu_ps(dst + 4, _mm_unpackhi_ps(d00, d01));
+            _mm_storeu_ps(dst + dstStride + 0, _mm_unpacklo_ps(d10, d11));
+            _mm_storeu_ps(dst + dstStride + 4, _mm_unpackhi_ps(d10, d11));
+        }
+
+        void NeuralWinograd2x2p3x3SetOutput(const float * src, float * dst, size_t dstWidth, size_t dstHeight, size_t dstDepth)
+        {
+            size_t tileH = (dstHeight + 1) / 2, tileW = (dstWidth + 1) / 2, srcStride = dstDepth*tileH*tileW;
+            size_t tileW4 = AlignLo(dstWidth / 2, 4);
+            for (size_t c = 0; c < dstDepth; ++c)
+            {
+                for (size_t row = 0; row < tileH; ++row)
+                {
+                    size_t rows = Simd::Min<size_t>(2, dstHeight - row * 2), col = 0;
+                    float * d = dst + row * 2 * dstWidth;
+                    if (rows == 2)
+                    {
+                        for (; col < tileW4; col += 4, src += 4)
+                            NeuralWinograd2x2p3x3SetOutput4(src, srcStride, d + col * 2, dstWidth);
+                    }
+                    for (; col < tileW; ++col)
+                        Base::NeuralWinograd2x2p3x3SetOutput1(src++, srcStride, d + col * 2, dstWidth, rows, Simd::Min<size_t>(2, dstWidth - col * 2));
+                }
+                dst += dstWidth*dstHeight;
+            }
+        }
     }
 #endif// SIMD_SSE_ENABLE
 }
@@ -144,6 +144,9 @@ namespace Simd
 
         void FillBgra(uint8_t * dst, size_t stride, size_t width, size_t height, uint8_t blue, uint8_t green, uint8_t red, uint8_t alpha);
 
+        void Filter2D(const uint8_t * src, size_t srcStride, size_t width, size_t height, SimdPixelFormatType format,
+            const float * kernel, size_t size, SimdBorderType border, uint8_t * dst, size_t dstStride);
+
         void GaussianBlur3x3(const uint8_t * src, size_t srcStride, size_t width, size_t height, 
             size_t channelCount, uint8_t * dst, size_t dstStride);
 
@@ -195,6 +198,8 @@ namespace Simd
 
         void NeuralConvert(const uint8_t * src, size_t stride, size_t width, size_t height, float * dst, int inversion);
 
+        void NeuralQuantize8u(const float * src, size_t size, const float * scale, const float * shift, uint8_t * dst);
+
         void OperationBinary8u(const uint8_t * a, size_t aStride, const uint8_t * b, size_t bStride,
             size_t width, size_t height, size_t channelCount, uint8_t * dst, size_t dstStride, SimdOperationBinary8uType type);
 
@@ -240,6 +245,12 @@ namespace Simd
 
         void SobelDy(const uint8_t * src, size_t srcStride, size_t width, size_t height, uint8_t * dst, size_t dstStride);
 
+        void SobelGradient(const uint8_t * src, size_t srcStride, size_t width, size_t height, uint8_t * dx, size_t dxStride, 
+            uint8_t * dy, size_t dyStride, uint8_t * magnitude, size_t magnitudeStride, size_t quantization, uint8_t * direction, size_t directionStride);
+
+        void SobelGradient32f(const uint8_t * src, size_t srcStride, size_t width, size_t height, 
+            uint8_t * magnitude, size_t magnitudeStride, uint8_t * direction, size_t directionStride);
+
         void ContourAnchors(const uint8_t * src, size_t srcStride, size_t width, size_t height, 
             size_t step, int16_t threshold, uint8_t * dst, size_t dstStride);
 
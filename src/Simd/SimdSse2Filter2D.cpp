@@ -0,0 +1,264 @@
+/*
+* Simd Library (http://simd.sourceforge.net).
+*
+* Copyright (c) 2011-2017 Yermalayeu Ihar.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy 
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell 
+* copies of the Software, and to permit persons to whom the Software is 
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in 
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE 
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+#include "Simd/SimdMemory.h"
+#include "Simd/SimdStore.h"
+#include "Simd/SimdBase.h"
+#include "Simd/SimdFilter2D.h"
+
+namespace Simd
+{
+#ifdef SIMD_SSE2_ENABLE    
+    namespace Sse2
+    {
+        SIMD_INLINE void Filter2DMadd8u(const uint8_t * src, const int16_t * weights, __m128i * sums)
+        {
+            __m128i w = _mm_set1_epi32(*(int32_t*)weights);
+            __m128i s0 = _mm_loadu_si128((__m128i*)src);
+            __m128i s1 = _mm_loadu_si128((__m128i*)(src + 1));
+            __m128i lo0 = _mm_unpacklo_epi8(s0, K_ZERO), lo1 = _mm_unpacklo_epi8(s1, K_ZERO);
+            __m128i hi0 = _mm_unpackhi_epi8(s0, K_ZERO), hi1 = _mm_unpackhi_epi8(s1, K_ZERO);
+            sums[0] = _mm_add_epi32(sums[0], _mm_madd_epi16(_mm_unpacklo_epi16(lo0, lo1), w));
+            sums[1] = _mm_add_epi32(sums[1], _mm_madd_epi16(_mm_unpackhi_epi16(lo0, lo1), w));
+            sums[2] = _mm_add_epi32(sums[2], _mm_madd_epi16(_mm_unpacklo_epi16(hi0, hi1), w));
+            sums[3] = _mm_add_epi32(sums[3], _mm_madd_epi16(_mm_unpackhi_epi16(hi0, hi1), w));
+        }
+
+        SIMD_INLINE void Filter2DMadd16i(const int16_t * src0, const int16_t * src1, const int16_t * weights, __m128i * sums)
+        {
+            __m128i w = _mm_set1_epi32(*(int32_t*)weights);
+            __m128i s0 = _mm_loadu_si128((__m128i*)src0);
+            __m128i s1 = _mm_loadu_si128((__m128i*)src1);
+            sums[0] = _mm_add_epi32(sums[0], _mm_madd_epi16(_mm_unpacklo_epi16(s0, s1), w));
+            sums[1] = _mm_add_epi32(sums[1], _mm_madd_epi16(_mm_unpackhi_epi16(s0, s1), w));
+        }
+
+        SIMD_INLINE __m128i Filter2DDescale(__m128i sum, __m128i round, __m128i shift)
+        {
+            return _mm_sra_epi32(_mm_add_epi32(sum, round), shift);
+        }
+
+        SIMD_INLINE __m128i Filter2DDescale(const __m128i * sums, __m128i round, __m128i shift)
+        {
+            return _mm_packs_epi32(Filter2DDescale(sums[0], round, shift), Filter2DDescale(sums[1], round, shift));
+        }
+
+        SIMD_INLINE __m128i Filter2DRound(int shift)
+        {
+            return _mm_set1_epi32(shift ? 1 << (shift - 1) : 0);
+        }
+
+        SIMD_INLINE __m128i Filter2DDirect8u(const uint8_t * const * rows, const int16_t * weights, size_t size, size_t x, __m128i round, __m128i shift)
+        {
+            size_t pairs = AlignHi(size, 2);
+            __m128i sums[4] = { _mm_setzero_si128(), _mm_setzero_si128(), _mm_setzero_si128(), _mm_setzero_si128() };
+            for (size_t ky = 0; ky < size; ++ky)
+            {
+                const uint8_t * r = rows[ky] + x;
+                const int16_t * w = weights + ky*pairs;
+                for (size_t kx = 0; kx < size; kx += 2)
+                    Filter2DMadd8u(r + kx, w + kx, sums);
+            }
+            return _mm_packus_epi16(Filter2DDescale(sums + 0, round, shift), Filter2DDescale(sums + 2, round, shift));
+        }
+
+        SIMD_INLINE void Filter2DHor8u(const uint8_t * src, const int16_t * weights, size_t size, size_t x, __m128i round, __m128i shift, int16_t * dst)
+        {
+            __m128i sums[4] = { _mm_setzero_si128(), _mm_setzero_si128(), _mm_setzero_si128(), _mm_setzero_si128() };
+            for (size_t kx = 0; kx < size; kx += 2)
+                Filter2DMadd8u(src + x + kx, weights + kx, sums);
+            _mm_storeu_si128((__m128i*)(dst + x), Filter2DDescale(sums + 0, round, shift));
+            _mm_storeu_si128((__m128i*)(dst + x + HA), Filter2DDescale(sums + 2, round, shift));
+        }
+
+        SIMD_INLINE __m128i Filter2DVer8u(const int16_t * const * rows, const int16_t * weights, size_t size, size_t x, __m128i round, __m128i shift)
+        {
+            __m128i lo[2] = { _mm_setzero_si128(), _mm_setzero_si128() };
+            __m128i hi[2] = { _mm_setzero_si128(), _mm_setzero_si128() };
+            for (size_t ky = 0; ky < size; ky += 2)
+            {
+                Filter2DMadd16i(rows[ky] + x, rows[ky + 1] + x, weights + ky, lo);
+                Filter2DMadd16i(rows[ky] + x + HA, rows[ky + 1] + x + HA, weights + ky, hi);
+            }
+            return _mm_packus_epi16(Filter2DDescale(lo, round, shift), Filter2DDescale(hi, round, shift));
+        }
+
+        SIMD_INLINE void Filter2DHor8uSmall(const uint8_t * src, const int16_t * weights, size_t size, size_t x, int16_t * dst)
+        {
+            __m128i lo = _mm_setzero_si128(), hi = _mm_setzero_si128();
+            for (size_t kx = 0; kx < size; ++kx)
+            {
+                __m128i s = _mm_loadu_si128((__m128i*)(src + x + kx)), w = _mm_set1_epi16(weights[kx]);
+                lo = _mm_add_epi16(lo, _mm_mullo_epi16(_mm_unpacklo_epi8(s, K_ZERO), w));
+                hi = _mm_add_epi16(hi, _mm_mullo_epi16(_mm_unpackhi_epi8(s, K_ZERO), w));
+            }
+            _mm_storeu_si128((__m128i*)(dst + x), lo);
+            _mm_storeu_si128((__m128i*)(dst + x + HA), hi);
+        }
+
+        SIMD_INLINE __m128i Filter2DVer8uSmall(const int16_t * const * rows, const int16_t * weights, size_t size, size_t x, __m128i round, __m128i shift)
+        {
+            __m128i sum = _mm_setzero_si128();
+            for (size_t ky = 0; ky < size; ++ky)
+                sum = _mm_add_epi16(sum, _mm_mullo_epi16(_mm_loadu_si128((__m128i*)(rows[ky] + x)), _mm_set1_epi16(weights[ky])));
+            return _mm_sra_epi16(_mm_add_epi16(sum, round), shift);
+        }
+
+        SIMD_INLINE __m128 Filter2DDirect32f(const float * const * rows, const float * weights, size_t size, size_t x)
+        {
+            __m128 sum = _mm_setzero_ps();
+            for (size_t ky = 0; ky < size; ++ky)
+            {
+                const float * r = rows[ky] + x;
+                const float * w = weights + ky*size;
+                for (size_t kx = 0; kx < size; ++kx)
+                    sum = _mm_add_ps(sum, _mm_mul_ps(_mm_loadu_ps(r + kx), _mm_set1_ps(w[kx])));
+            }
+            return sum;
+        }
+
+        SIMD_INLINE __m128 Filter2DHor32f(const float * src, const float * weights, size_t size, size_t x)
+        {
+            __m128 sum = _mm_setzero_ps();
+            for (size_t kx = 0; kx < size; ++kx)
+                sum = _mm_add_ps(sum, _mm_mul_ps(_mm_loadu_ps(src + x + kx), _mm_set1_ps(weights[kx])));
+            return sum;
+        }
+
+        SIMD_INLINE __m128 Filter2DVer32f(const float * const * rows, const float * weights, size_t size, size_t x)
+        {
+            __m128 sum = _mm_setzero_ps();
+            for (size_t ky = 0; ky < size; ++ky)
+                sum = _mm_add_ps(sum, _mm_mul_ps(_mm_loadu_ps(rows[ky] + x), _mm_set1_ps(weights[ky])));
+            return sum;
+        }
+
+        SIMD_INLINE __m128i Filter2DConvert32fTo16i(const float * src, __m128 min, __m128 max)
+        {
+            __m128i lo = _mm_cvtps_epi32(_mm_min_ps(_mm_max_ps(_mm_loadu_ps(src + 0), min), max));
+            __m128i hi = _mm_cvtps_epi32(_mm_min_ps(_mm_max_ps(_mm_loadu_ps(src + F), min), max));
+            return _mm_packs_epi32(lo, hi);
+        }
+
+        struct Filter2DRows
+        {
+            static void Direct8u(const uint8_t * const * rows, const int16_t * weights, size_t size, size_t width, int shift, uint8_t * dst)
+            {
+                __m128i _round = Filter2DRound(shift), _shift = _mm_cvtsi32_si128(shift);
+                size_t alignedWidth = AlignLo(width, A);
+                for (size_t x = 0; x < alignedWidth; x += A)
+                    _mm_storeu_si128((__m128i*)(dst + x), Filter2DDirect8u(rows, weights, size, x, _round, _shift));
+                if (alignedWidth != width)
+                    _mm_storeu_si128((__m128i*)(dst + width - A), Filter2DDirect8u(rows, weights, size, width - A, _round, _shift));
+            }
+
+            static void Hor8u(const uint8_t * src, const int16_t * weights, size_t size, size_t width, int shift, int16_t * dst)
+            {
+                __m128i _round = Filter2DRound(shift), _shift = _mm_cvtsi32_si128(shift);
+                size_t alignedWidth = AlignLo(width, A);
+                for (size_t x = 0; x < alignedWidth; x += A)
+                    Filter2DHor8u(src, weights, size, x, _round, _shift, dst);
+                if (alignedWidth != width)
+                    Filter2DHor8u(src, weights, size, width - A, _round, _shift, dst);
+            }
+
+            static void Ver8u(const int16_t * const * rows, const int16_t * weights, size_t size, size_t width, int shift, uint8_t * dst)
+            {
+                __m128i _round = Filter2DRound(shift), _shift = _mm_cvtsi32_si128(shift);
+                size_t alignedWidth = AlignLo(width, A);
+                for (size_t x = 0; x < alignedWidth; x += A)
+                    _mm_storeu_si128((__m128i*)(dst + x), Filter2DVer8u(rows, weights, size, x, _round, _shift));
+                if (alignedWidth != width)
+                    _mm_storeu_si128((__m128i*)(dst + width - A), Filter2DVer8u(rows, weights, size, width - A, _round, _shift));
+            }
+
+            static void Hor8uSmall(const uint8_t * src, const int16_t * weights, size_t size, size_t width, int16_t * dst)
+            {
+                size_t alignedWidth = AlignLo(width, A);
+                for (size_t x = 0; x < alignedWidth; x += A)
+                    Filter2DHor8uSmall(src, weights, size, x, dst);
+                if (alignedWidth != width)
+                    Filter2DHor8uSmall(src, weights, size, width - A, dst);
+            }
+
+            static void Ver8uSmall(const int16_t * const * rows, const int16_t * weights, size_t size, size_t width, int shift, uint8_t * dst)
+            {
+                __m128i _round = _mm_set1_epi16(shift ? 1 << (shift - 1) : 0), _shift = _mm_cvtsi32_si128(shift);
+                size_t alignedWidth = AlignLo(width, A);
+                for (size_t x = 0; x < alignedWidth; x += A)
+                    _mm_storeu_si128((__m128i*)(dst + x), _mm_packus_epi16(
+                        Filter2DVer8uSmall(rows, weights, size, x, _round, _shift), Filter2DVer8uSmall(rows, weights, size, x + HA, _round, _shift)));
+                if (alignedWidth != width)
+                    _mm_storeu_si128((__m128i*)(dst + width - A), _mm_packus_epi16(
+                        Filter2DVer8uSmall(rows, weights, size, width - A, _round, _shift), Filter2DVer8uSmall(rows, weights, size, width - HA, _round, _shift)));
+            }
+
+            static void Direct32f(const float * const * rows, const float * weights, size_t size, size_t width, float * dst)
+            {
+                size_t alignedWidth = AlignLo(width, F);
+                for (size_t x = 0; x < alignedWidth; x += F)
+                    _mm_storeu_ps(dst + x, Filter2DDirect32f(rows, weights, size, x));
+                if (alignedWidth != width)
+                    _mm_storeu_ps(dst + width - F, Filter2DDirect32f(rows, weights, size, width - F));
+            }
+
+            static void Hor32f(const float * src, const float * weights, size_t size, size_t width, float * dst)
+            {
+                size_t alignedWidth = AlignLo(width, F);
+                for (size_t x = 0; x < alignedWidth; x += F)
+                    _mm_storeu_ps(dst + x, Filter2DHor32f(src, weights, size, x));
+                if (alignedWidth != width)
+                    _mm_storeu_ps(dst + width - F, Filter2DHor32f(src, weights, size, width - F));
+            }
+
+            static void Ver32f(const float * const * rows, const float * weights, size_t size, size_t width, float * dst)
+            {
+                size_t alignedWidth = AlignLo(width, F);
+                for (size_t x = 0; x < alignedWidth; x += F)
+                    _mm_storeu_ps(dst + x, Filter2DVer32f(rows, weights, size, x));
+                if (alignedWidth != width)
+                    _mm_storeu_ps(dst + width - F, Filter2DVer32f(rows, weights, size, width - F));
+            }
+
+            static void Convert32fTo16i(const float * src, size_t width, int16_t * dst)
+            {
+                __m128 min = _mm_set1_ps(-32768.0f), max = _mm_set1_ps(32767.0f);
+                size_t alignedWidth = AlignLo(width, HA);
+                for (size_t x = 0; x < alignedWidth; x += HA)
+                    _mm_storeu_si128((__m128i*)(dst + x), Filter2DConvert32fTo16i(src + x, min, max));
+                if (alignedWidth != width)
+                    _mm_storeu_si128((__m128i*)(dst + width - HA), Filter2DConvert32fTo16i(src + width - HA, min, max));
+            }
+        };
+
+        void Filter2D(const uint8_t * src, size_t srcStride, size_t width, size_t height, SimdPixelFormatType format,
+            const float * kernel, size_t size, SimdBorderType border, uint8_t * dst, size_t dstStride)
+        {
+            if (width < A)
+                Base::Filter2D(src, srcStride, width, height, format, kernel, size, border, dst, dstStride);
+            else
+                Base::Filter2DRun<Filter2DRows>(src, srcStride, width, height, format, kernel, size, border, dst, dstStride);
+        }
+    }
+#endif// SIMD_SSE2_ENABLE
+}
@@ -25,6 +25,7 @@
 #include "Simd/SimdExtract.h"
 #include "Simd/SimdLoad.h"
 #include "Simd/SimdStream.h"
+#include "Simd/SimdBase.h"
 
 namespace Simd
 {
@@ -98,6 +99,29 @@ namespace Simd
 			else
 				NeuralConvert<false>(src, stride, width, height, dst);
 		}
+
+        SIMD_INLINE __m128i NeuralQuantize32i(const float * src, __m128 scale, __m128 shift)
+        {
+            return _mm_cvtps_epi32(_mm_add_ps(_mm_mul_ps(_mm_loadu_ps(src), scale), shift));
+        }
+
+        SIMD_INLINE __m128i NeuralQuantize8u(const float * src, __m128 scale, __m128 shift)
+        {
+            __m128i lo = _mm_packs_epi32(NeuralQuantize32i(src + 0, scale, shift), NeuralQuantize32i(src + 4, scale, shift));
+            __m128i hi = _mm_packs_epi32(NeuralQuantize32i(src + 8, scale, shift), NeuralQuantize32i(src + 12, scale, shift));
+            return _mm_packus_epi16(lo, hi);
+        }
+
+        void NeuralQuantize8u(const float * src, size_t size, const float * scale, const float * shift, uint8_t * dst)
+        {
+            size_t alignedSize = AlignLo(size, A);
+            __m128 _scale = _mm_set1_ps(scale[0]);
+            __m128 _shift = _mm_set1_ps(shift[0]);
+            for (size_t i = 0; i < alignedSize; i += A)
+                _mm_storeu_si128((__m128i*)(dst + i), NeuralQuantize8u(src + i, _scale, _shift));
+            if (alignedSize != size)
+                Base::NeuralQuantize8u(src + alignedSize, size - alignedSize, scale, shift, dst + alignedSize);
+        }
     }
 #endif// SIMD_SSE2_ENABLE
 }
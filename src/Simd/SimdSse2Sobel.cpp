@@ -23,6 +23,7 @@
 */
 #include "Simd/SimdMemory.h"
 #include "Simd/SimdStore.h"
+#include "Simd/SimdBase.h"
 
 namespace Simd
 {
@@ -150,6 +151,229 @@ namespace Simd
                 SobelDy<false>(src, srcStride, width, height, (int16_t *)dst, dstStride/sizeof(int16_t));
         }
 
+        SIMD_INLINE __m128i SobelDirection32(__m128i dxdy, const __m128i * table, size_t size)
+        {
+            __m128i best = K_ZERO, index = K_ZERO;
+            for (size_t i = 0; i < size; ++i)
+            {
+                __m128i dot = _mm_madd_epi16(dxdy, table[i]);
+                __m128i neg = _mm_sub_epi32(K_ZERO, dot);
+                __m128i isPos = _mm_cmpgt_epi32(dot, best);
+                __m128i isNeg = _mm_cmpgt_epi32(neg, best);
+                best = Combine(isPos, dot, Combine(isNeg, neg, best));
+                index = Combine(isPos, _mm_set1_epi32((int)i), Combine(isNeg, _mm_set1_epi32(int(i + size)), index));
+            }
+            return index;
+        }
+
+        SIMD_INLINE __m128i SobelDirection(__m128i dx, __m128i dy, const __m128i * table, size_t size)
+        {
+            __m128i lo = SobelDirection32(_mm_unpacklo_epi16(dx, dy), table, size);
+            __m128i hi = SobelDirection32(_mm_unpackhi_epi16(dx, dy), table, size);
+            return _mm_packs_epi32(lo, hi);
+        }
+
+        SIMD_INLINE __m128i AbsI16(__m128i value)
+        {
+            return _mm_max_epi16(value, _mm_sub_epi16(K_ZERO, value));
+        }
+
+        template<int part> SIMD_INLINE void SobelGradient(__m128i a[3][3], __m128i & dx, __m128i & dy)
+        {
+            dx = BinomialSum16(
+                _mm_sub_epi16(UnpackU8<part>(a[0][2]), UnpackU8<part>(a[0][0])),
+                _mm_sub_epi16(UnpackU8<part>(a[1][2]), UnpackU8<part>(a[1][0])),
+                _mm_sub_epi16(UnpackU8<part>(a[2][2]), UnpackU8<part>(a[2][0])));
+            dy = BinomialSum16(
+                _mm_sub_epi16(UnpackU8<part>(a[2][0]), UnpackU8<part>(a[0][0])),
+                _mm_sub_epi16(UnpackU8<part>(a[2][1]), UnpackU8<part>(a[0][1])),
+                _mm_sub_epi16(UnpackU8<part>(a[2][2]), UnpackU8<part>(a[0][2])));
+        }
+
+        template<bool align> SIMD_INLINE void SobelGradient(__m128i a[3][3], size_t col, int16_t * dx, int16_t * dy, 
+            uint16_t * magnitude, const __m128i * table, size_t size, uint8_t * direction)
+        {
+            __m128i _dx[2], _dy[2];
+            SobelGradient<0>(a, _dx[0], _dy[0]);
+            SobelGradient<1>(a, _dx[1], _dy[1]);
+            if (dx)
+            {
+                Store<align>((__m128i*)(dx + col) + 0, _dx[0]);
+                Store<align>((__m128i*)(dx + col) + 1, _dx[1]);
+            }
+            if (dy)
+            {
+                Store<align>((__m128i*)(dy + col) + 0, _dy[0]);
+                Store<align>((__m128i*)(dy + col) + 1, _dy[1]);
+            }
+            if (magnitude)
+            {
+                Store<align>((__m128i*)(magnitude + col) + 0, _mm_add_epi16(AbsI16(_dx[0]), AbsI16(_dy[0])));
+                Store<align>((__m128i*)(magnitude + col) + 1, _mm_add_epi16(AbsI16(_dx[1]), AbsI16(_dy[1])));
+            }
+            if (direction)
+            {
+                Store<align>((__m128i*)(direction + col), _mm_packus_epi16(
+                    SobelDirection(_dx[0], _dy[0], table, size), SobelDirection(_dx[1], _dy[1], table, size)));
+            }
+        }
+
+        template <bool align> void SobelGradient(const uint8_t * src, size_t srcStride, size_t width, size_t height, int16_t * dx, size_t dxStride,
+            int16_t * dy, size_t dyStride, uint16_t * magnitude, size_t magnitudeStride, size_t quantization, uint8_t * direction, size_t directionStride)
+        {
+            assert(width > A);
+
+            size_t size = quantization/2;
+            __m128i table[Base::SOBEL_DIRECTION_TABLE_SIZE/2];
+            if (direction)
+            {
+                int16_t buffer[Base::SOBEL_DIRECTION_TABLE_SIZE];
+                Base::SobelDirectionTable(quantization, buffer);
+                for (size_t i = 0; i < size; ++i)
+                    table[i] = _mm_set1_epi32(int32_t(uint16_t(buffer[2*i + 0]) | uint32_t(uint16_t(buffer[2*i + 1])) << 16));
+            }
+
+            size_t bodyWidth = Simd::AlignHi(width, A) - A;
+            const uint8_t *src0, *src1, *src2;
+            __m128i a[3][3];
+
+            for (size_t row = 0; row < height; ++row)
+            {
+                src0 = src + srcStride*(row - 1);
+                src1 = src0 + srcStride;
+                src2 = src1 + srcStride;
+                if (row == 0)
+                    src0 = src1;
+                if (row == height - 1)
+                    src2 = src1;
+
+                LoadNose3<align, 1>(src0 + 0, a[0]);
+                LoadNose3<align, 1>(src1 + 0, a[1]);
+                LoadNose3<align, 1>(src2 + 0, a[2]);
+                SobelGradient<align>(a, 0, dx, dy, magnitude, table, size, direction);
+                for (size_t col = A; col < bodyWidth; col += A)
+                {
+                    LoadBody3<align, 1>(src0 + col, a[0]);
+                    LoadBody3<align, 1>(src1 + col, a[1]);
+                    LoadBody3<align, 1>(src2 + col, a[2]);
+                    SobelGradient<align>(a, col, dx, dy, magnitude, table, size, direction);
+                }
+                LoadTail3<false, 1>(src0 + width - A, a[0]);
+                LoadTail3<false, 1>(src1 + width - A, a[1]);
+                LoadTail3<false, 1>(src2 + width - A, a[2]);
+                SobelGradient<false>(a, width - A, dx, dy, magnitude, table, size, direction);
+
+                if (dx)
+                    dx += dxStride;
+                if (dy)
+                    dy += dyStride;
+                if (magnitude)
+                    magnitude += magnitudeStride;
+                if (direction)
+                    direction += directionStride;
+            }
+        }
+
+        SIMD_INLINE bool AlignedOrEmpty(const uint8_t * data, size_t stride)
+        {
+            return data == NULL || (Aligned(data) && Aligned(stride));
+        }
+
+        void SobelGradient(const uint8_t * src, size_t srcStride, size_t width, size_t height, uint8_t * dx, size_t dxStride,
+            uint8_t * dy, size_t dyStride, uint8_t * magnitude, size_t magnitudeStride, size_t quantization, uint8_t * direction, size_t directionStride)
+        {
+            assert(dxStride%sizeof(int16_t) == 0 && dyStride%sizeof(int16_t) == 0 && magnitudeStride%sizeof(uint16_t) == 0);
+
+            if (AlignedOrEmpty(src, srcStride) && AlignedOrEmpty(dx, dxStride) && AlignedOrEmpty(dy, dyStride) && 
+                AlignedOrEmpty(magnitude, magnitudeStride) && AlignedOrEmpty(direction, directionStride))
+                SobelGradient<true>(src, srcStride, width, height, (int16_t*)dx, dxStride/sizeof(int16_t), (int16_t*)dy, dyStride/sizeof(int16_t),
+                    (uint16_t*)magnitude, magnitudeStride/sizeof(uint16_t), quantization, direction, directionStride);
+            else
+                SobelGradient<false>(src, srcStride, width, height, (int16_t*)dx, dxStride/sizeof(int16_t), (int16_t*)dy, dyStride/sizeof(int16_t),
+                    (uint16_t*)magnitude, magnitudeStride/sizeof(uint16_t), quantization, direction, directionStride);
+        }
+
+        template<int part> SIMD_INLINE __m128 ToFloat(__m128i value)
+        {
+            return _mm_cvtepi32_ps(_mm_srai_epi32(UnpackU16<part>(value, value), 16));
+        }
+
+        template<bool align> SIMD_INLINE void SobelGradient32f(__m128 dx, __m128 dy, float * magnitude, float * direction)
+        {
+            if (magnitude)
+                Sse::Store<align>(magnitude, _mm_sqrt_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy))));
+            if (direction)
+                Sse::Store<align>(direction, Atan2(dy, dx));
+        }
+
+        template<bool align> SIMD_INLINE void SobelGradient32f(__m128i a[3][3], size_t col, float * magnitude, float * direction)
+        {
+            __m128i dx[2], dy[2];
+            SobelGradient<0>(a, dx[0], dy[0]);
+            SobelGradient<1>(a, dx[1], dy[1]);
+            for (size_t i = 0; i < 2; ++i)
+            {
+                size_t offset = col + i*HA;
+                SobelGradient32f<align>(ToFloat<0>(dx[i]), ToFloat<0>(dy[i]), magnitude ? magnitude + offset : NULL, direction ? direction + offset : NULL);
+                SobelGradient32f<align>(ToFloat<1>(dx[i]), ToFloat<1>(dy[i]), magnitude ? magnitude + offset + F : NULL, direction ? direction + offset + F : NULL);
+            }
+        }
+
+        template <bool align> void SobelGradient32f(const uint8_t * src, size_t srcStride, size_t width, size_t height,
+            float * magnitude, size_t magnitudeStride, float * direction, size_t directionStride)
+        {
+            assert(width > A);
+
+            size_t bodyWidth = Simd::AlignHi(width, A) - A;
+            const uint8_t *src0, *src1, *src2;
+            __m128i a[3][3];
+
+            for (size_t row = 0; row < height; ++row)
+            {
+                src0 = src + srcStride*(row - 1);
+                src1 = src0 + srcStride;
+                src2 = src1 + srcStride;
+                if (row == 0)
+                    src0 = src1;
+                if (row == height - 1)
+                    src2 = src1;
+
+                LoadNose3<align, 1>(src0 + 0, a[0]);
+                LoadNose3<align, 1>(src1 + 0, a[1]);
+                LoadNose3<align, 1>(src2 + 0, a[2]);
+                SobelGradient32f<align>(a, 0, magnitude, direction);
+                for (size_t col = A; col < bodyWidth; col += A)
+                {
+                    LoadBody3<align, 1>(src0 + col, a[0]);
+                    LoadBody3<align, 1>(src1 + col, a[1]);
+                    LoadBody3<align, 1>(src2 + col, a[2]);
+                    SobelGradient32f<align>(a, col, magnitude, direction);
+                }
+                LoadTail3<false, 1>(src0 + width - A, a[0]);
+                LoadTail3<false, 1>(src1 + width - A, a[1]);
+                LoadTail3<false, 1>(src2 + width - A, a[2]);
+                SobelGradient32f<false>(a, width - A, magnitude, direction);
+
+                if (magnitude)
+                    magnitude += magnitudeStride;
+                if (direction)
+                    direction += directionStride;
+            }
+        }
+
+        void SobelGradient32f(const uint8_t * src, size_t srcStride, size_t width, size_t height,
+            uint8_t * magnitude, size_t magnitudeStride, uint8_t * direction, size_t directionStride)
+        {
+            assert(magnitudeStride%sizeof(float) == 0 && directionStride%sizeof(float) == 0);
+
+            if (AlignedOrEmpty(src, srcStride) && AlignedOrEmpty(magnitude, magnitudeStride) && AlignedOrEmpty(direction, directionStride))
+                SobelGradient32f<true>(src, srcStride, width, height, (float*)magnitude, magnitudeStride/sizeof(float), 
+                    (float*)direction, directionStride/sizeof(float));
+            else
+                SobelGradient32f<false>(src, srcStride, width, height, (float*)magnitude, magnitudeStride/sizeof(float), 
+                    (float*)direction, directionStride/sizeof(float));
+        }
+
         template<bool align> SIMD_INLINE __m128i AnchorComponent(const int16_t * src, size_t step, const __m128i & current, const __m128i & threshold, const __m128i & mask)
         {
             __m128i last = _mm_srli_epi16(Load<align>((__m128i*)(src - step)), 1);
@@ -0,0 +1,86 @@
+/*
+* Simd Library (http://simd.sourceforge.net).
+*
+* Copyright (c) 2011-2017 Yermalayeu Ihar.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+#include "Simd/SimdMemory.h"
+#include "Simd/SimdExtract.h"
+#include "Simd/SimdSsse3.h"
+
+namespace Simd
+{
+#ifdef SIMD_SSSE3_ENABLE    
+    namespace Ssse3
+    {
+        SIMD_INLINE __m128i NeuralProductSum8u8i(__m128i src, const int8_t * weight)
+        {
+            return _mm_madd_epi16(_mm_maddubs_epi16(src, _mm_loadu_si128((__m128i*)weight)), Sse2::K16_0001);
+        }
+
+        SIMD_INLINE void NeuralProductSum8u8i4(const uint8_t * src, const int8_t * weight, size_t size, size_t alignedSize, int32_t * sums)
+        {
+            const int8_t * w0 = weight + 0 * size;
+            const int8_t * w1 = weight + 1 * size;
+            const int8_t * w2 = weight + 2 * size;
+            const int8_t * w3 = weight + 3 * size;
+            __m128i s0 = _mm_setzero_si128();
+            __m128i s1 = _mm_setzero_si128();
+            __m128i s2 = _mm_setzero_si128();
+            __m128i s3 = _mm_setzero_si128();
+            for (size_t k = 0; k < alignedSize; k += A)
+            {
+                __m128i _src = _mm_loadu_si128((__m128i*)(src + k));
+                s0 = _mm_add_epi32(s0, NeuralProductSum8u8i(_src, w0 + k));
+                s1 = _mm_add_epi32(s1, NeuralProductSum8u8i(_src, w1 + k));
+                s2 = _mm_add_epi32(s2, NeuralProductSum8u8i(_src, w2 + k));
+                s3 = _mm_add_epi32(s3, NeuralProductSum8u8i(_src, w3 + k));
+            }
+            _mm_storeu_si128((__m128i*)sums, _mm_hadd_epi32(_mm_hadd_epi32(s0, s1), _mm_hadd_epi32(s2, s3)));
+            for (size_t k = alignedSize; k < size; ++k)
+            {
+                sums[0] += src[k] * w0[k];
+                sums[1] += src[k] * w1[k];
+                sums[2] += src[k] * w2[k];
+                sums[3] += src[k] * w3[k];
+            }
+        }
+
+        SIMD_INLINE void NeuralProductSum8u8i1(const uint8_t * src, const int8_t * weight, size_t size, size_t alignedSize, int32_t * sums)
+        {
+            __m128i sum = _mm_setzero_si128();
+            for (size_t k = 0; k < alignedSize; k += A)
+                sum = _mm_add_epi32(sum, NeuralProductSum8u8i(_mm_loadu_si128((__m128i*)(src + k)), weight + k));
+            sums[0] = _mm_cvtsi128_si32(_mm_hadd_epi32(_mm_hadd_epi32(sum, sum), sum));
+            for (size_t k = alignedSize; k < size; ++k)
+                sums[0] += src[k] * weight[k];
+        }
+
+        void NeuralProductSum8u8i(const uint8_t * src, const int8_t * weight, size_t size, size_t count, int32_t * sums)
+        {
+            size_t alignedSize = AlignLo(size, A), alignedCount = AlignLo(count, 4), i = 0;
+            for (; i < alignedCount; i += 4)
+                NeuralProductSum8u8i4(src, weight + i*size, size, alignedSize, sums + i);
+            for (; i < count; ++i)
+                NeuralProductSum8u8i1(src, weight + i*size, size, alignedSize, sums + i);
+        }
+    }
+#endif// SIMD_SSSE3_ENABLE
+}
@@ -0,0 +1,92 @@
+/*
+* Simd Library (http://simd.sourceforge.net).
+*
+* Copyright (c) 2011-2017 Yermalayeu Ihar.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy 
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell 
+* copies of the Software, and to permit persons to whom the Software is 
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in 
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE 
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+#ifndef __SimdStatistic_h__
+#define __SimdStatistic_h__
+
+#include "Simd/SimdConst.h"
+#include "Simd/SimdMath.h"
+#include "Simd/SimdMemory.h"
+
+namespace Simd
+{
+    namespace Base
+    {
+        typedef uint32_t ImageStatisticsHistograms[4][HISTOGRAM_SIZE + 4];
+
+        SIMD_INLINE void ImageStatisticsHistogram(const uint8_t * src, const uint8_t * mask, uint8_t index, size_t width, ImageStatisticsHistograms & histograms)
+        {
+            size_t col = 0, alignedWidth = Simd::AlignLo(width, 4);
+            if (mask)
+            {
+                for (; col < alignedWidth; col += 4)
+                {
+                    ++histograms[0][(4 + src[col + 0])*(mask[col + 0] == index)];
+                    ++histograms[1][(4 + src[col + 1])*(mask[col + 1] == index)];
+                    ++histograms[2][(4 + src[col + 2])*(mask[col + 2] == index)];
+                    ++histograms[3][(4 + src[col + 3])*(mask[col + 3] == index)];
+                }
+                for (; col < width; ++col)
+                    ++histograms[0][(4 + src[col])*(mask[col] == index)];
+            }
+            else
+            {
+                for (; col < alignedWidth; col += 4)
+                {
+                    ++histograms[0][4 + src[col + 0]];
+                    ++histograms[1][4 + src[col + 1]];
+                    ++histograms[2][4 + src[col + 2]];
+                    ++histograms[3][4 + src[col + 3]];
+                }
+                for (; col < width; ++col)
+                    ++histograms[0][4 + src[col]];
+            }
+        }
+
+        SIMD_INLINE void ImageStatisticsMoments(size_t row, uint64_t count, uint64_t x, uint64_t xx, SimdImageStatistics & statistics)
+        {
+            statistics.x += x;
+            statistics.y += row*count;
+            statistics.xx += xx;
+            statistics.xy += row*x;
+            statistics.yy += row*row*count;
+        }
+
+        SIMD_INLINE void ImageStatisticsFinalize(uint32_t flags, int min, int max, const ImageStatisticsHistograms & histograms, SimdImageStatistics & statistics)
+        {
+            if (flags & SimdImageStatisticsHistogram)
+            {
+                for (size_t i = 0; i < HISTOGRAM_SIZE; ++i)
+                    statistics.histogram[i] = histograms[0][4 + i] + histograms[1][4 + i] + histograms[2][4 + i] + histograms[3][4 + i];
+            }
+            if ((flags & SimdImageStatisticsMinMax) && statistics.count)
+            {
+                statistics.min = (uint8_t)min;
+                statistics.max = (uint8_t)max;
+                statistics.average = (uint8_t)((statistics.sum + statistics.count / 2) / statistics.count);
+            }
+        }
+    }
+}
+
+#endif//__SimdStatistic_h__
@@ -139,11 +139,14 @@ namespace Test
 
     TEST_ADD_GROUP(DetectionHaarDetect32fp);
     TEST_ADD_GROUP(DetectionHaarDetect32fi);
+    TEST_ADD_GROUP(DetectionHaarDetect16ip);
+    TEST_ADD_GROUP(DetectionHaarDetect16ii);
     TEST_ADD_GROUP(DetectionLbpDetect32fp);
     TEST_ADD_GROUP(DetectionLbpDetect32fi);
     TEST_ADD_GROUP(DetectionLbpDetect16ip);
     TEST_ADD_GROUP(DetectionLbpDetect16ii);
     TEST_ADD_GROUP_ONLY_SPECIAL(Detection);
+    TEST_ADD_GROUP_ONLY_SPECIAL(DetectionGroup);
 
     TEST_ADD_GROUP(AlphaBlending);
     TEST_ADD_GROUP_ONLY_SPECIAL(DrawLine);
@@ -168,6 +171,9 @@ namespace Test
     TEST_ADD_GROUP(MedianFilterSquare3x3);
     TEST_ADD_GROUP(MedianFilterSquare5x5);
     TEST_ADD_GROUP(GaussianBlur3x3);
+    TEST_ADD_GROUP(Filter2D);
+    TEST_ADD_GROUP(BilateralFilter);
+    TEST_ADD_GROUP(GuidedFilter);
     TEST_ADD_GROUP(AbsGradientSaturatedSum);
     TEST_ADD_GROUP(LbpEstimate);
     TEST_ADD_GROUP(NormalizeHistogram);
@@ -175,6 +181,8 @@ namespace Test
     TEST_ADD_GROUP(SobelDxAbs);
     TEST_ADD_GROUP(SobelDy);
     TEST_ADD_GROUP(SobelDyAbs);
+    TEST_ADD_GROUP(SobelGradient);
+    TEST_ADD_GROUP(SobelGradient32f);
     TEST_ADD_GROUP(ContourMetrics);
     TEST_ADD_GROUP(Laplace);
     TEST_ADD_GROUP(LaplaceAbs);
@@ -182,11 +190,13 @@ namespace Test
     TEST_ADD_GROUP(Histogram);
     TEST_ADD_GROUP(HistogramMasked);
     TEST_ADD_GROUP(HistogramConditional);
+    TEST_ADD_GROUP(ClaheApply);
     TEST_ADD_GROUP(AbsSecondDerivativeHistogram);
 
     TEST_ADD_GROUP(HogDirectionHistograms);
 
     TEST_ADD_GROUP(Integral);
+    TEST_ADD_GROUP(IntegralUpdate);
 
     TEST_ADD_GROUP(InterferenceIncrement);
     TEST_ADD_GROUP(InterferenceIncrementMasked);
@@ -199,6 +209,7 @@ namespace Test
 
     TEST_ADD_GROUP_ONLY_SPECIAL(Motion);
 
+    TEST_ADD_GROUP(Gemm32fNN);
     TEST_ADD_GROUP(NeuralConvert);
     TEST_ADD_GROUP(NeuralProductSum);
     TEST_ADD_GROUP(NeuralAddVectorMultipliedByValue);
@@ -213,6 +224,7 @@ namespace Test
     TEST_ADD_GROUP(NeuralDerivativeRelu);
     TEST_ADD_GROUP(NeuralUpdateWeights);
     TEST_ADD_GROUP(NeuralAdaptiveGradientUpdate);
+    TEST_ADD_GROUP(NeuralAdamUpdate);
     TEST_ADD_GROUP(NeuralAddConvolution3x3);
     TEST_ADD_GROUP(NeuralAddConvolution5x5);
     TEST_ADD_GROUP(NeuralAddConvolution3x3Back);
@@ -220,8 +232,19 @@ namespace Test
     TEST_ADD_GROUP(NeuralAddConvolution3x3Sum);
     TEST_ADD_GROUP(NeuralAddConvolution5x5Sum);
     TEST_ADD_GROUP(NeuralMax2x2);
+    TEST_ADD_GROUP(NeuralConvolutionForward);
+    TEST_ADD_GROUP(NeuralConvolutionBackward);
+    TEST_ADD_GROUP(NeuralConvolutionSum);
+    TEST_ADD_GROUP(NeuralWinograd2x2p3x3SetInput);
+    TEST_ADD_GROUP(NeuralWinograd2x2p3x3SetOutput);
+    TEST_ADD_GROUP(NeuralQuantize8u);
+    TEST_ADD_GROUP(NeuralProductSum8u8i);
+    TEST_ADD_GROUP_ONLY_SPECIAL(NeuralConvolutionWinograd);
     TEST_ADD_GROUP_ONLY_SPECIAL(NeuralPredict);
+    TEST_ADD_GROUP_ONLY_SPECIAL(NeuralBinary);
+    TEST_ADD_GROUP_ONLY_SPECIAL(NeuralDepthwise);
     TEST_ADD_GROUP_ONLY_SPECIAL(NeuralTrain);
+    TEST_ADD_GROUP_ONLY_SPECIAL(NeuralTrainOptions);
 
     TEST_ADD_GROUP(OperationBinary8u);
     TEST_ADD_GROUP(OperationBinary16i);
@@ -249,6 +272,7 @@ namespace Test
 
     TEST_ADD_GROUP(GetStatistic);
     TEST_ADD_GROUP(GetMoments);
+    TEST_ADD_GROUP(GetImageStatistics);
     TEST_ADD_GROUP(GetRowSums);
     TEST_ADD_GROUP(GetColSums);
     TEST_ADD_GROUP(GetAbsDyRowSums);
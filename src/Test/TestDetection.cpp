@@ -284,6 +284,44 @@ namespace Test
         return result;
     }
 
+    bool DetectionHaarDetect16ipAutoTest()
+    {
+        bool result = true;
+
+        result = result && DetectionDetectAutoTest(0, 0, 1, FUNC_D(Simd::Base::DetectionHaarDetect16ip), FUNC_D(SimdDetectionHaarDetect16ip));
+
+#ifdef SIMD_SSE41_ENABLE
+        if (Simd::Sse41::Enable)
+            result = result && DetectionDetectAutoTest(0, 0, 1, FUNC_D(Simd::Sse41::DetectionHaarDetect16ip), FUNC_D(SimdDetectionHaarDetect16ip));
+#endif
+
+#ifdef SIMD_AVX2_ENABLE
+        if (Simd::Avx2::Enable)
+            result = result && DetectionDetectAutoTest(0, 0, 1, FUNC_D(Simd::Avx2::DetectionHaarDetect16ip), FUNC_D(SimdDetectionHaarDetect16ip));
+#endif
+
+        return result;
+    }
+
+    bool DetectionHaarDetect16iiAutoTest()
+    {
+        bool result = true;
+
+        result = result && DetectionDetectAutoTest(0, 1, 1, FUNC_D(Simd::Base::DetectionHaarDetect16ii), FUNC_D(SimdDetectionHaarDetect16ii));
+
+#ifdef SIMD_SSE41_ENABLE
+        if (Simd::Sse41::Enable)
+            result = result && DetectionDetectAutoTest(0, 1, 1, FUNC_D(Simd::Sse41::DetectionHaarDetect16ii), FUNC_D(SimdDetectionHaarDetect16ii));
+#endif
+
+#ifdef SIMD_AVX2_ENABLE
+        if (Simd::Avx2::Enable)
+            result = result && DetectionDetectAutoTest(0, 1, 1, FUNC_D(Simd::Avx2::DetectionHaarDetect16ii), FUNC_D(SimdDetectionHaarDetect16ii));
+#endif
+
+        return result;
+    }
+
     bool DetectionLbpDetect32fpAutoTest()
     {
         bool result = true;
@@ -486,6 +524,16 @@ namespace Test
         return DetectionDetectDataTest(create, 0, 1, 0, FUNC_D(SimdDetectionHaarDetect32fi));
     }
 
+    bool DetectionHaarDetect16ipDataTest(bool create)
+    {
+        return DetectionDetectDataTest(create, 0, 0, 1, FUNC_D(SimdDetectionHaarDetect16ip));
+    }
+
+    bool DetectionHaarDetect16iiDataTest(bool create)
+    {
+        return DetectionDetectDataTest(create, 0, 1, 1, FUNC_D(SimdDetectionHaarDetect16ii));
+    }
+
     bool DetectionLbpDetect32fpDataTest(bool create)
     {
         return DetectionDetectDataTest(create, 1, 0, 0, FUNC_D(SimdDetectionLbpDetect32fp));
@@ -546,51 +594,524 @@ namespace Test
         dst.Save(String("faces_") + ToString(threadNumber) + ".pgm");
     }
 
+    static bool Compare(const Objects & o1, const Objects & o2, const String & d1, const String & d2)
+    {
+        bool result = o1.size() == o2.size();
+        for (size_t i = 0; i < o1.size() && result; ++i)
+        {
+            if (o1[i].rect != o2[i].rect || o1[i].weight != o2[i].weight)
+                result = false;
+        }
+
+        if (!result)
+        {
+            TEST_LOG_SS(Error, "Detection " << d1 << ": ");
+            for (size_t i = 0; i < o1.size(); ++i)
+            {
+                TEST_LOG_SS(Error, "(" << o1[i].rect.left << ", " << o1[i].rect.top << ", " 
+                    << o1[i].rect.right << ", " << o1[i].rect.bottom << ") - " << o1[i].weight);
+            }
+
+            TEST_LOG_SS(Error, "Detection " << d2 << ": ");
+            for (size_t i = 0; i < o2.size(); ++i)
+            {
+                TEST_LOG_SS(Error, "(" << o2[i].rect.left << ", " << o2[i].rect.top << ", "
+                    << o2[i].rect.right << ", " << o2[i].rect.bottom << ") - " << o2[i].weight);
+            }
+        }
+
+        return result;
+    }
+
+    static bool Covered(const Objects & objects, const Objects & by, int weightMin, const String & d1, const String & d2)
+    {
+        for (size_t i = 0; i < objects.size(); ++i)
+        {
+            if (objects[i].weight < weightMin)
+                continue;
+            bool covered = false;
+            for (size_t j = 0; j < by.size() && !covered; ++j)
+            {
+                Rect intersection = objects[i].rect.Intersection(by[j].rect);
+                covered = objects[i].tag == by[j].tag && intersection.Area() * 2 > objects[i].rect.Area() &&
+                    intersection.Area() * 2 > by[j].rect.Area();
+            }
+            if (!covered)
+            {
+                const Rect & r = objects[i].rect;
+                TEST_LOG_SS(Error, "Object (" << r.left << ", " << r.top << ", " << r.right << ", " << r.bottom << ") - " 
+                    << objects[i].weight << " of " << d1 << " is not found at " << d2 << " !");
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Binary cascade with corrupted sections (cross references are out of range) has to be rejected.
+    static bool BinaryCorruptionTest(const String & src, const String & dst)
+    {
+        std::vector<uint8_t> buffer;
+        FILE * file = fopen(src.c_str(), "rb");
+        if (file)
+        {
+            fseek(file, 0, SEEK_END);
+            buffer.resize(ftell(file));
+            fseek(file, 0, SEEK_SET);
+            if (fread(buffer.data(), 1, buffer.size(), file) != buffer.size())
+                buffer.clear();
+            fclose(file);
+        }
+        const size_t header = 256;
+        if (buffer.size() <= header)
+        {
+            TEST_LOG_SS(Error, "Can't read binary cascade '" << src << "' !");
+            return false;
+        }
+        for (size_t i = header; i < buffer.size(); ++i)
+            buffer[i] = 0xFF;
+        file = fopen(dst.c_str(), "wb");
+        bool written = file && fwrite(buffer.data(), 1, buffer.size(), file) == buffer.size();
+        if (file)
+            fclose(file);
+        Detection detection;
+        bool loaded = written && detection.LoadBinary(dst);
+        remove(dst.c_str());
+        if (!written || loaded)
+        {
+            TEST_LOG_SS(Error, "Corrupted binary cascade '" << dst << "' is not rejected!");
+            return false;
+        }
+        return true;
+    }
+
     bool DetectionSpecialTest()
     {
+        const String names[3] = { "haar_face_0", "haar_face_1", "lbp_face" };
+
         Detection detection;
 
         double time = GetTime();
-        detection.Load(ROOT_PATH + "/data/cascade/haar_face_0.xml", 0);
-        detection.Load(ROOT_PATH + "/data/cascade/haar_face_1.xml", 1);
-        detection.Load(ROOT_PATH + "/data/cascade/lbp_face.xml", 2);
+        for (int i = 0; i < 3; ++i)
+            detection.Load(ROOT_PATH + "/data/cascade/" + names[i] + ".xml", i);
         TEST_LOG_SS(Info, "Load: " << (GetTime() - time)*1000 << " ms " << std::endl);
 
-        Objects os, om;
+        Objects os, om, ob;
 
         DetectionSpecialTest(detection, os, 1);
 
         DetectionSpecialTest(detection, om, std::thread::hardware_concurrency());
 
-        bool result = true;
-        if (os.size() != om.size())
+        bool result = Compare(os, om, "single thread", "multi threads");
+
+        for (int i = 0; i < 3; ++i)
+        {
+            void * data = SimdDetectionLoadA((ROOT_PATH + "/data/cascade/" + names[i] + ".xml").c_str());
+            if (!SimdDetectionSaveBinary(data, (names[i] + ".bin").c_str()))
+            {
+                TEST_LOG_SS(Error, "Can't save binary cascade '" << names[i] << ".bin' !");
+                result = false;
+            }
+            SimdDetectionFree(data);
+        }
+
+        Detection binary;
+
+        time = GetTime();
+        for (int i = 0; i < 3; ++i)
+        {
+            if (!binary.LoadBinary(names[i] + ".bin", i))
+            {
+                TEST_LOG_SS(Error, "Can't load binary cascade '" << names[i] << ".bin' !");
+                result = false;
+            }
+        }
+        TEST_LOG_SS(Info, "LoadBinary: " << (GetTime() - time) * 1000 << " ms " << std::endl);
+
+        if (!BinaryCorruptionTest(names[0] + ".bin", "corrupted.bin"))
             result = false;
-        else
+
+        DetectionSpecialTest(binary, ob, 1);
+
+        result = result && Compare(os, ob, "XML cascades", "binary cascades");
+
+        std::vector<View> frames;
+        frames.push_back(GetSample(Size(W, H), true));
+        frames.push_back(GetSample(Size(W, H), true).Region(Size(W, H) * 3 / 4, View::TopLeft));
+        frames.push_back(frames[0]);
+        std::vector<Objects> batch, single(frames.size());
+        for (size_t i = 0; i < frames.size(); ++i)
+        {
+            Detection reference;
+            reference.LoadBinary(names[0] + ".bin", 0);
+            reference.LoadBinary(names[2] + ".bin", 2);
+            reference.SetHaarInt16(-1);
+            reference.Init(frames[i].Size(), 1.1, Size(), Size(INT_MAX, INT_MAX), View(), 1);
+            reference.Detect(frames[i], single[i]);
+        }
+
+        Detection batchDetection;
+        batchDetection.LoadBinary(names[0] + ".bin", 0);
+        batchDetection.LoadBinary(names[2] + ".bin", 2);
+        batchDetection.SetHaarInt16(-1);
+        batchDetection.Init(frames[0].Size());
+        time = GetTime();
+        batchDetection.DetectBatch(frames, batch);
+        TEST_LOG_SS(Info, "DetectBatch for " << frames.size() << " frames: " << (GetTime() - time) * 1000 << " ms " << std::endl);
+
+        for (size_t i = 0; i < frames.size() && i < batch.size(); ++i)
+            result = result && Compare(single[i], batch[i], "single frame", "batch");
+        result = result && batch.size() == frames.size();
+
+        std::vector<View> small(1);
+        small[0].Recreate(8, 8, View::Gray8);
+        Simd::Fill(small[0], 0);
+        std::vector<Objects> empty;
+        if (!batchDetection.DetectBatch(small, empty) || empty.size() != 1 || empty[0].size())
+        {
+            TEST_LOG_SS(Error, "DetectBatch fails for image smaller than cascade windows!");
+            result = false;
+        }
+        Objects afterSmall;
+        batchDetection.Detect(frames[0], afterSmall);
+        result = result && Compare(single[0], afterSmall, "single frame", "single frame after small batch");
+        batchDetection.DetectBatch(frames, batch);
+        for (size_t i = 0; i < frames.size() && i < batch.size(); ++i)
+            result = result && Compare(single[i], batch[i], "single frame", "batch after small batch");
+
+        Detection tracker;
+        tracker.LoadBinary(names[0] + ".bin", 0);
+        tracker.LoadBinary(names[2] + ".bin", 2);
+        tracker.SetHaarInt16(-1);
+        tracker.Init(frames[0].Size(), 1.1, Size(), Size(INT_MAX, INT_MAX), View(), 1);
+        tracker.SetTracking(3);
+        for (size_t i = 0; i < 6; ++i)
+        {
+            Objects tracked;
+            Detection::TrackMode mode;
+            time = GetTime();
+            if (!tracker.Track(frames[0], tracked, mode))
+            {
+                TEST_LOG_SS(Error, "Can't track objects at frame " << i << " !");
+                return false;
+            }
+            TEST_LOG_SS(Info, "Track (" << (mode == Detection::TrackFull ? "full" : "regions") << "): " << (GetTime() - time) * 1000 << " ms ");
+            if (mode != (i % 3 ? Detection::TrackRegions : Detection::TrackFull))
+            {
+                TEST_LOG_SS(Error, "Wrong tracking mode at frame " << i << " !");
+                result = false;
+            }
+            if (mode == Detection::TrackFull)
+                result = result && Compare(single[0], tracked, "full frame", "tracking");
+            else
+                result = result && Covered(single[0], tracked, 10, "full frame", "tracking") && Covered(tracked, single[0], 10, "tracking", "full frame");
+        }
+
+        View changed(frames[0].Size(), View::Gray8);
+        Simd::Copy(frames[0], changed);
+        Simd::Fill(changed.Region(Rect(W / 8, H / 4, W / 4, H / 2)).Ref(), 0);
+        Detection::Rects changedRegions(1, Rect(0, 0, W / 2, H));
+        const int cascades[2] = { 2, 0 };
+        for (int c = 0; c < 2; ++c)
+        {
+            const String & name = names[cascades[c]];
+            Detection incremental, recomputed;
+            incremental.LoadBinary(name + ".bin", cascades[c]);
+            incremental.SetHaarInt16(-1);
+            incremental.Init(frames[0].Size(), 1.1, Size(), Size(INT_MAX, INT_MAX), View(), 1);
+            incremental.SetIncrementalIntegral(10);
+            recomputed.LoadBinary(name + ".bin", cascades[c]);
+            recomputed.SetHaarInt16(-1);
+            recomputed.Init(frames[0].Size(), 1.1, Size(), Size(INT_MAX, INT_MAX), View(), 1);
+            Objects previous, updated, reference;
+            incremental.Detect(frames[0], previous, 3, 0.2, true, Detection::Rects(1, Rect(frames[0].Size())));
+            time = GetTime();
+            incremental.Detect(changed, updated, 3, 0.2, true, changedRegions);
+            TEST_LOG_SS(Info, "Detect " << name << " (incremental integral): " << (GetTime() - time) * 1000 << " ms ");
+            time = GetTime();
+            recomputed.Detect(changed, reference, 3, 0.2, true, changedRegions);
+            TEST_LOG_SS(Info, "Detect " << name << " (full integral): " << (GetTime() - time) * 1000 << " ms, " << reference.size() << " objects " << std::endl);
+            result = result && Compare(reference, updated, "full integral", "incremental integral");
+
+            // Full scan of the frame (tracking key frame) uses integral images outside of changed regions too.
+            Rect filled(W / 8, H / 4, W / 4, H / 2);
+            View brighter(changed.Size(), View::Gray8);
+            Simd::Copy(changed, brighter);
+            Simd::Fill(brighter.Region(filled).Ref(), 255);
+            Detection::TrackMode mode;
+            incremental.SetTracking(1);
+            recomputed.SetTracking(1);
+            if (!incremental.Track(brighter, updated, mode, 3, 0.2, Detection::Rects(1, filled)) ||
+                !recomputed.Track(brighter, reference, mode, 3, 0.2, Detection::Rects(1, filled)))
+            {
+                TEST_LOG_SS(Error, "Can't track objects with " << name << " !");
+                result = false;
+            }
+            result = result && Compare(reference, updated, "full integral (full scan)", "incremental integral (full scan)");
+        }
+
+        Detection profiler;
+        profiler.LoadBinary(names[0] + ".bin", 0);
+        profiler.LoadBinary(names[2] + ".bin", 2);
+        profiler.Init(frames[0].Size());
+        profiler.SetProfiling(true);
+        Objects profiled;
+        profiler.Detect(frames[0], profiled);
+        result = result && Compare(single[0], profiled, "usual mode", "profiling mode");
+
+        const Detection::Profile & profile = profiler.GetProfile();
+        size_t passed = 0;
+        for (size_t i = 0; i < profile.levels.size(); ++i)
         {
-            for (size_t i = 0; i < os.size(); ++i)
+            const Detection::Profile::Level & level = profile.levels[i];
+            std::stringstream ss;
+            ss << "Level " << i << " (scale " << level.scale << "): resize " << level.resize * 1000 << " ms, integral " << level.integral * 1000 << " ms";
+            for (size_t j = 0; j < level.cascades.size(); ++j)
             {
-                if (os[i].rect != om[i].rect || os[i].weight != om[i].weight)
+                const Detection::Profile::Cascade & cascade = level.cascades[j];
+                if (cascade.windows.empty())
+                    continue;
+                ss << ", cascade " << cascade.tag << ": " << cascade.windows.front() << " -> " << cascade.windows.back() << " windows, " << cascade.evaluation * 1000 << " ms";
+                for (size_t k = 1; k < cascade.windows.size(); ++k)
                 {
-                    result = false;
-                    break;
+                    if (cascade.windows[k] > cascade.windows[k - 1])
+                    {
+                        TEST_LOG_SS(Error, "Wrong profile window counters at level " << i << " for cascade " << cascade.tag << " !");
+                        result = false;
+                        break;
+                    }
                 }
+                passed += cascade.windows.back();
             }
+            TEST_LOG_SS(Info, ss.str());
+        }
+        if (profile.frames != 1 || profile.levels.empty() || passed == 0)
+        {
+            TEST_LOG_SS(Error, "Wrong profile: " << profile.frames << " frames, " << profile.levels.size() << " levels, " << passed << " passed windows !");
+            result = false;
         }
 
-        if (!result)
+        Detection batchProfiler;
+        batchProfiler.LoadBinary(names[0] + ".bin", 0);
+        batchProfiler.LoadBinary(names[2] + ".bin", 2);
+        batchProfiler.Init(frames[0].Size());
+        batchProfiler.SetProfiling(true);
+        std::vector<Objects> batchProfiled;
+        batchProfiler.DetectBatch(frames, batchProfiled);
+        const Detection::Profile & batchProfile = batchProfiler.GetProfile();
+        for (size_t i = 1; i < batchProfile.levels.size(); ++i)
         {
-            TEST_LOG_SS(Error, "Detection single thread: ");
-            for (size_t i = 0; i < os.size(); ++i)
+            if (batchProfile.levels[i].scale <= batchProfile.levels[i - 1].scale)
             {
-                TEST_LOG_SS(Error, "(" << os[i].rect.left << ", " << os[i].rect.top << ", " 
-                    << os[i].rect.right << ", " << os[i].rect.bottom << ") - " << os[i].weight);
+                TEST_LOG_SS(Error, "Batch profile levels " << i - 1 << " and " << i << " are not sorted by scale !");
+                result = false;
             }
+        }
+        if (batchProfile.frames != frames.size() || batchProfile.levels.size() < profile.levels.size())
+        {
+            TEST_LOG_SS(Error, "Wrong batch profile: " << batchProfile.frames << " frames, " << batchProfile.levels.size() << " levels !");
+            result = false;
+        }
 
-            TEST_LOG_SS(Error, "Detection multi threads: ");
-            for (size_t i = 0; i < om.size(); ++i)
+        Objects floating, calibrated, quantized;
+        Detection haar32f, haar16i;
+        for (int i = 0; i < 2; ++i)
+        {
+            haar32f.LoadBinary(names[i] + ".bin", i);
+            haar16i.LoadBinary(names[i] + ".bin", i);
+        }
+        haar32f.SetHaarInt16(-1);
+        haar32f.Init(frames[0].Size(), 1.1, Size(), Size(INT_MAX, INT_MAX), View(), 1);
+        haar16i.Init(frames[0].Size(), 1.1, Size(), Size(INT_MAX, INT_MAX), View(), 1);
+        time = GetTime();
+        haar32f.Detect(frames[0], floating);
+        TEST_LOG_SS(Info, "Detect (HAAR 32-bit float): " << (GetTime() - time) * 1000 << " ms ");
+        time = GetTime();
+        haar16i.Detect(frames[0], calibrated);
+        TEST_LOG_SS(Info, "Detect (HAAR calibration): " << (GetTime() - time) * 1000 << " ms ");
+        time = GetTime();
+        haar16i.Detect(frames[0], quantized);
+        TEST_LOG_SS(Info, "Detect (HAAR 16-bit integer): " << (GetTime() - time) * 1000 << " ms " << std::endl);
+        result = result && Compare(floating, calibrated, "32-bit float", "calibration");
+        result = result && Covered(floating, quantized, 10, "32-bit float", "16-bit integer") && Covered(quantized, floating, 10, "16-bit integer", "32-bit float");
+
+        Detection delayed;
+        for (int i = 0; i < 2; ++i)
+            delayed.LoadBinary(names[i] + ".bin", i);
+        delayed.SetHaarInt16(0.05, size_t(-1), 2);
+        delayed.Init(frames[0].Size(), 1.1, Size(), Size(INT_MAX, INT_MAX), View(), 1);
+        delayed.SetProfiling(true);
+        for (int frame = 0; frame < 3; ++frame)
+        {
+            Objects objects;
+            delayed.Detect(frames[0], objects);
+            bool int16 = false;
+            const Detection::Profile & delayedProfile = delayed.GetProfile();
+            for (size_t i = 0; i < delayedProfile.levels.size(); ++i)
+                for (size_t j = 0; j < delayedProfile.levels[i].cascades.size(); ++j)
+                    int16 = int16 || delayedProfile.levels[i].cascades[j].int16;
+            if (int16 != (frame == 2))
             {
-                TEST_LOG_SS(Error, "(" << om[i].rect.left << ", " << om[i].rect.top << ", "
-                    << om[i].rect.right << ", " << om[i].rect.bottom << ") - " << om[i].weight);
+                TEST_LOG_SS(Error, "Wrong HAAR calibration at frame " << frame << ": it has to last 2 frames!");
+                result = false;
+            }
+            if (frame < 2)
+                result = result && Compare(floating, objects, "32-bit float", "long calibration");
+        }
+
+        Objects disabled;
+        haar16i.SetHaarInt16(-1);
+        result = result && haar16i.Detect(frames[0], disabled);
+        result = result && Compare(floating, disabled, "32-bit float", "16-bit integer disabled after Init");
+
+        return result;
+    }
+
+    //-----------------------------------------------------------------------------
+
+    static bool Similar(const Detection::Object & o1, const Detection::Object & o2, double sizeDifferenceMax)
+    {
+        const Rect & r1 = o1.rect;
+        const Rect & r2 = o2.rect;
+        double delta = sizeDifferenceMax*(std::min(r1.Width(), r2.Width()) + std::min(r1.Height(), r2.Height()))*0.5;
+        return
+            std::abs(r1.left - r2.left) <= delta && std::abs(r1.top - r2.top) <= delta &&
+            std::abs(r1.right - r2.right) <= delta && std::abs(r1.bottom - r2.bottom) <= delta;
+    }
+
+    static int Root(std::vector<int> & parents, int i)
+    {
+        while (parents[i] != i)
+            i = parents[i];
+        return i;
+    }
+
+    static void GroupReference(const Objects & src, Objects & dst, int groupSizeMin, double sizeDifferenceMax)
+    {
+        dst.clear();
+        std::map<int, Objects> tagged;
+        for (size_t i = 0; i < src.size(); ++i)
+            tagged[src[i].tag].push_back(src[i]);
+        for (std::map<int, Objects>::iterator it = tagged.begin(); it != tagged.end(); ++it)
+        {
+            const Objects & objects = it->second;
+            int N = (int)objects.size();
+            if (N < groupSizeMin)
+                continue;
+
+            std::vector<int> parents(N), labels(N), classes(N, -1);
+            for (int i = 0; i < N; ++i)
+                parents[i] = i;
+            for (int i = 0; i < N; ++i)
+                for (int j = i + 1; j < N; ++j)
+                    if (Similar(objects[i], objects[j], sizeDifferenceMax))
+                        parents[std::max(Root(parents, i), Root(parents, j))] = std::min(Root(parents, i), Root(parents, j));
+            int nclasses = 0;
+            for (int i = 0; i < N; ++i)
+            {
+                int root = Root(parents, i);
+                if (classes[root] < 0)
+                    classes[root] = nclasses++;
+                labels[i] = classes[root];
+            }
+
+            Objects buffer(nclasses);
+            for (int i = 0; i < N; ++i)
+            {
+                buffer[labels[i]].rect += objects[i].rect;
+                buffer[labels[i]].weight++;
+                buffer[labels[i]].tag = objects[i].tag;
+            }
+            for (size_t i = 0; i < buffer.size(); i++)
+                buffer[i].rect = buffer[i].rect / double(buffer[i].weight);
+
+            for (size_t i = 0; i < buffer.size(); i++)
+            {
+                Rect r1 = buffer[i].rect;
+                int n1 = buffer[i].weight;
+                if (n1 < groupSizeMin)
+                    continue;
+                size_t j;
+                for (j = 0; j < buffer.size(); j++)
+                {
+                    int n2 = buffer[j].weight;
+                    if (j == i || n2 < groupSizeMin)
+                        continue;
+                    Rect r2 = buffer[j].rect;
+                    int dx = Simd::Round(r2.Width() * sizeDifferenceMax);
+                    int dy = Simd::Round(r2.Height() * sizeDifferenceMax);
+                    if ((n2 > std::max(3, n1) || n1 < 3) &&
+                        r1.left >= r2.left - dx && r1.top >= r2.top - dy &&
+                        r1.right <= r2.right + dx && r1.bottom <= r2.bottom + dy)
+                        break;
+                }
+                if (j == buffer.size())
+                    dst.push_back(buffer[i]);
+            }
+        }
+    }
+
+    static void DenseCandidates(size_t count, const Size & size, Objects & candidates)
+    {
+        candidates.clear();
+        size_t clusters = count / 100 + 1;
+        for (size_t c = 0; c < clusters; ++c)
+        {
+            ptrdiff_t s = 24 + Random(int(size.y / 4));
+            Point center(Random(int(size.x - s)) + s / 2, Random(int(size.y - s)) + s / 2);
+            int tag = Random(3);
+            for (size_t i = 0; i < 100 && candidates.size() < count; ++i)
+            {
+                ptrdiff_t si = s + Random(int(s / 5 + 1)) - s / 10;
+                Point p = center + Point(Random(int(si / 5 + 1)) - si / 10, Random(int(si / 5 + 1)) - si / 10);
+                candidates.push_back(Detection::Object(Rect(p.x - si / 2, p.y - si / 2, p.x + si / 2, p.y + si / 2), 1, tag));
+            }
+        }
+    }
+
+    bool DetectionGroupSpecialTest()
+    {
+        bool result = true;
+
+        Detection detection;
+        const size_t counts[3] = { 1000, 10000, 40000 };
+        for (size_t k = 0; k < 3 && result; ++k)
+        {
+            Objects candidates, o1, o2, o3;
+            DenseCandidates(counts[k], Size(1920, 1080), candidates);
+
+            double time = GetTime();
+            GroupReference(candidates, o1, 3, 0.2);
+            double reference = GetTime() - time;
+
+            time = GetTime();
+            detection.Group(candidates, o2, 3, 0.2);
+            double grid = GetTime() - time;
+
+            detection.SetNonMaximumSuppression(0.3);
+            time = GetTime();
+            detection.Group(candidates, o3, 3, 0.2);
+            double nms = GetTime() - time;
+            detection.SetNonMaximumSuppression(0);
+
+            TEST_LOG_SS(Info, "Group " << candidates.size() << " candidates: reference " << reference * 1000 << " ms, grid " 
+                << grid * 1000 << " ms (" << o2.size() << " objects), NMS " << nms * 1000 << " ms (" << o3.size() << " objects).");
+
+            result = result && Compare(o1, o2, "reference grouping", "grid grouping");
+
+            for (size_t i = 0; i < o3.size() && result; ++i)
+            {
+                for (size_t j = i + 1; j < o3.size() && result; ++j)
+                {
+                    if (o3[i].tag != o3[j].tag)
+                        continue;
+                    Rect r = o3[i].rect.Intersection(o3[j].rect);
+                    double overlap = double(r.Area()) / double(o3[i].rect.Area() + o3[j].rect.Area() - r.Area());
+                    if (overlap > 0.3 || o3[i].weight < o3[j].weight)
+                    {
+                        TEST_LOG_SS(Error, "Invalid non-maximum suppression result!");
+                        result = false;
+                    }
+                }
             }
         }
 
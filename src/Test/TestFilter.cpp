@@ -612,6 +612,465 @@ namespace Test
         return result;
     }
 
+    namespace
+    {
+        struct FuncSG
+        {
+            typedef void(*FuncPtr)(const uint8_t * src, size_t srcStride, size_t width, size_t height, uint8_t * dx, size_t dxStride,
+                uint8_t * dy, size_t dyStride, uint8_t * magnitude, size_t magnitudeStride, size_t quantization, uint8_t * direction, size_t directionStride);
+
+            FuncPtr func;
+            String description;
+
+            FuncSG(const FuncPtr & f, const String & d) : func(f), description(d) {}
+
+            void Call(const View & src, View & dx, View & dy, View & magnitude, size_t quantization, View & direction) const
+            {
+                TEST_PERFORMANCE_TEST(description);
+                func(src.data, src.stride, src.width, src.height, dx.data, dx.stride, dy.data, dy.stride, 
+                    magnitude.data, magnitude.stride, quantization, direction.data, direction.stride);
+            }
+        };
+    }
+
+#define FUNC_SG(function) \
+    FuncSG(function, std::string(#function))
+
+    bool SobelGradientAutoTest(int width, int height, size_t quantization, const FuncSG & f1, const FuncSG & f2)
+    {
+        bool result = true;
+
+        TEST_LOG_SS(Info, "Test " << f1.description << " & " << f2.description << " [" << width << ", " << height << "] <" << quantization << ">.");
+
+        View src(width, height, View::Gray8, NULL, TEST_ALIGN(width));
+        FillRandom(src);
+
+        View dx1(width, height, View::Int16, NULL, TEST_ALIGN(width));
+        View dy1(width, height, View::Int16, NULL, TEST_ALIGN(width));
+        View magnitude1(width, height, View::Int16, NULL, TEST_ALIGN(width));
+        View direction1(width, height, View::Gray8, NULL, TEST_ALIGN(width));
+        View dx2(width, height, View::Int16, NULL, TEST_ALIGN(width));
+        View dy2(width, height, View::Int16, NULL, TEST_ALIGN(width));
+        View magnitude2(width, height, View::Int16, NULL, TEST_ALIGN(width));
+        View direction2(width, height, View::Gray8, NULL, TEST_ALIGN(width));
+        View empty;
+
+        TEST_EXECUTE_AT_LEAST_MIN_TIME(f1.Call(src, dx1, dy1, magnitude1, quantization, direction1));
+
+        TEST_EXECUTE_AT_LEAST_MIN_TIME(f2.Call(src, dx2, dy2, magnitude2, quantization, direction2));
+
+        result = result && Compare(dx1, dx2, 0, true, 32, 0, "dx");
+        result = result && Compare(dy1, dy2, 0, true, 32, 0, "dy");
+        result = result && Compare(magnitude1, magnitude2, 0, true, 32, 0, "magnitude");
+        result = result && Compare(direction1, direction2, 0, true, 32, 0, "direction");
+
+        Simd::Fill(direction2, 0);
+        f2.Call(src, empty, empty, empty, quantization, direction2);
+        result = result && Compare(direction1, direction2, 0, true, 32, 0, "direction only");
+
+        return result;
+    }
+
+    bool SobelGradientAutoTest(const FuncSG & f1, const FuncSG & f2)
+    {
+        bool result = true;
+
+        result = result && SobelGradientAutoTest(W, H, 18, f1, f2);
+        result = result && SobelGradientAutoTest(W + O, H - O, 8, f1, f2);
+        result = result && SobelGradientAutoTest(W - O, H + O, 256, f1, f2);
+
+        return result;
+    }
+
+    bool SobelGradientAutoTest()
+    {
+        bool result = true;
+
+        result = result && SobelGradientAutoTest(FUNC_SG(Simd::Base::SobelGradient), FUNC_SG(SimdSobelGradient));
+
+#ifdef SIMD_SSE2_ENABLE
+        if (Simd::Sse2::Enable)
+            result = result && SobelGradientAutoTest(FUNC_SG(Simd::Sse2::SobelGradient), FUNC_SG(SimdSobelGradient));
+#endif 
+
+#ifdef SIMD_AVX2_ENABLE
+        if (Simd::Avx2::Enable)
+            result = result && SobelGradientAutoTest(FUNC_SG(Simd::Avx2::SobelGradient), FUNC_SG(SimdSobelGradient));
+#endif 
+
+        return result;
+    }
+
+    namespace
+    {
+        struct FuncSG32f
+        {
+            typedef void(*FuncPtr)(const uint8_t * src, size_t srcStride, size_t width, size_t height, 
+                uint8_t * magnitude, size_t magnitudeStride, uint8_t * direction, size_t directionStride);
+
+            FuncPtr func;
+            String description;
+
+            FuncSG32f(const FuncPtr & f, const String & d) : func(f), description(d) {}
+
+            void Call(const View & src, View & magnitude, View & direction) const
+            {
+                TEST_PERFORMANCE_TEST(description);
+                func(src.data, src.stride, src.width, src.height, magnitude.data, magnitude.stride, direction.data, direction.stride);
+            }
+        };
+    }
+
+#define FUNC_SG32F(function) \
+    FuncSG32f(function, std::string(#function))
+
+    bool SobelGradient32fAutoTest(int width, int height, const FuncSG32f & f1, const FuncSG32f & f2)
+    {
+        bool result = true;
+
+        TEST_LOG_SS(Info, "Test " << f1.description << " & " << f2.description << " [" << width << ", " << height << "].");
+
+        View src(width, height, View::Gray8, NULL, TEST_ALIGN(width));
+        FillRandom(src);
+
+        View magnitude1(width, height, View::Float, NULL, TEST_ALIGN(width));
+        View direction1(width, height, View::Float, NULL, TEST_ALIGN(width));
+        View magnitude2(width, height, View::Float, NULL, TEST_ALIGN(width));
+        View direction2(width, height, View::Float, NULL, TEST_ALIGN(width));
+
+        TEST_EXECUTE_AT_LEAST_MIN_TIME(f1.Call(src, magnitude1, direction1));
+
+        TEST_EXECUTE_AT_LEAST_MIN_TIME(f2.Call(src, magnitude2, direction2));
+
+        result = result && Compare(magnitude1, magnitude2, EPS, true, 32, false, "magnitude");
+        result = result && Compare(direction1, direction2, EPS, true, 32, false, "direction");
+
+        return result;
+    }
+
+    bool SobelGradient32fAutoTest(const FuncSG32f & f1, const FuncSG32f & f2)
+    {
+        bool result = true;
+
+        result = result && SobelGradient32fAutoTest(W, H, f1, f2);
+        result = result && SobelGradient32fAutoTest(W + O, H - O, f1, f2);
+        result = result && SobelGradient32fAutoTest(W - O, H + O, f1, f2);
+
+        return result;
+    }
+
+    bool SobelGradient32fAutoTest()
+    {
+        bool result = true;
+
+        result = result && SobelGradient32fAutoTest(FUNC_SG32F(Simd::Base::SobelGradient32f), FUNC_SG32F(SimdSobelGradient32f));
+
+#ifdef SIMD_SSE2_ENABLE
+        if (Simd::Sse2::Enable)
+            result = result && SobelGradient32fAutoTest(FUNC_SG32F(Simd::Sse2::SobelGradient32f), FUNC_SG32F(SimdSobelGradient32f));
+#endif 
+
+#ifdef SIMD_AVX2_ENABLE
+        if (Simd::Avx2::Enable)
+            result = result && SobelGradient32fAutoTest(FUNC_SG32F(Simd::Avx2::SobelGradient32f), FUNC_SG32F(SimdSobelGradient32f));
+#endif 
+
+        return result;
+    }
+
+    namespace
+    {
+        struct FuncF2D
+        {
+            typedef void(*FuncPtr)(const uint8_t * src, size_t srcStride, size_t width, size_t height, SimdPixelFormatType format,
+                const float * kernel, size_t size, SimdBorderType border, uint8_t * dst, size_t dstStride);
+
+            FuncPtr func;
+            String description;
+
+            FuncF2D(const FuncPtr & f, const String & d) : func(f), description(d) {}
+
+            void Call(const View & src, const Buffer32f & kernel, size_t size, SimdBorderType border, View & dst) const
+            {
+                TEST_PERFORMANCE_TEST(description);
+                func(src.data, src.stride, src.width, src.height, (SimdPixelFormatType)src.format, &kernel[0], size, border, dst.data, dst.stride);
+            }
+        };
+    }
+
+#define FUNC_F2D(function) \
+    FuncF2D(function, std::string(#function))
+
+    enum Filter2DKernelType
+    {
+        Filter2DKernelFull,
+        Filter2DKernelSeparable,
+        Filter2DKernelSmall, // separable kernel with small integer weights (divided by power of 2)
+    };
+
+    void FillFilter2DKernel(Buffer32f & kernel, size_t size, Filter2DKernelType type)
+    {
+        kernel.resize(size*size);
+        if (type == Filter2DKernelSmall)
+        {
+            size_t half = size / 2;
+            for (size_t i = 0; i < size*size; ++i)
+            {
+                size_t x = i%size, y = i / size;
+                float row = x == 0 || x == size - 1 ? 1.0f : 2.0f;
+                float col = y == half ? 4.0f : (y + 1 == half || y == half + 1 ? -1.0f : 0.0f);
+                kernel[i] = row*col / 16.0f;
+            }
+        }
+        else if (type == Filter2DKernelSeparable)
+        {
+            Buffer32f row(size), col(size);
+            for (size_t i = 0; i < size; ++i)
+            {
+                row[i] = float(Random()) + 0.5f;
+                col[i] = float(Random()) + 0.5f;
+            }
+            float sum = 0;
+            for (size_t i = 0; i < size*size; ++i)
+                sum += (kernel[i] = row[i%size] * col[i / size]);
+            for (size_t i = 0; i < size*size; ++i)
+                kernel[i] /= sum;
+        }
+        else
+        {
+            for (size_t i = 0; i < size*size; ++i)
+                kernel[i] = float(Random()*4.0 - 1.0) / float(size*size);
+        }
+    }
+
+    void FillFilter2DSource(View & src)
+    {
+        if (src.format == View::Int16)
+        {
+            for (size_t row = 0; row < src.height; ++row)
+                for (size_t col = 0; col < src.width; ++col)
+                    src.At<int16_t>(col, row) = int16_t(Random(4096) - 2048);
+        }
+        else if (src.format == View::Float)
+            FillRandom32f(src, -256.0f, 256.0f);
+        else
+            FillRandom(src);
+    }
+
+    bool Filter2DAutoTest(int width, int height, View::Format format, size_t size, SimdBorderType border, Filter2DKernelType type, const FuncF2D & f1, const FuncF2D & f2)
+    {
+        bool result = true;
+
+        const char * borders[] = { "Replicate", "Mirror", "Zero" };
+        const char * types[] = { " ", " sep ", " small " };
+        std::stringstream ss;
+        ss << FormatDescription(format) << "[" << size << "x" << size << types[type] << borders[border] << "]";
+        FuncF2D _f1(f1.func, f1.description + ss.str()), _f2(f2.func, f2.description + ss.str());
+
+        TEST_LOG_SS(Info, "Test " << _f1.description << " & " << _f2.description << " [" << width << ", " << height << "].");
+
+        View src(width, height, format, NULL, TEST_ALIGN(width));
+        FillFilter2DSource(src);
+
+        Buffer32f kernel;
+        FillFilter2DKernel(kernel, size, type);
+
+        View dst1(width, height, format, NULL, TEST_ALIGN(width));
+        View dst2(width, height, format, NULL, TEST_ALIGN(width));
+
+        TEST_EXECUTE_AT_LEAST_MIN_TIME(_f1.Call(src, kernel, size, border, dst1));
+
+        TEST_EXECUTE_AT_LEAST_MIN_TIME(_f2.Call(src, kernel, size, border, dst2));
+
+        if (format == View::Float)
+            result = result && Compare(dst1, dst2, EPS, true, 32, false);
+        else
+            result = result && Compare(dst1, dst2, format == View::Int16 ? 1 : 0, true, 32);
+
+        return result;
+    }
+
+    bool Filter2DAutoTest(const FuncF2D & f1, const FuncF2D & f2)
+    {
+        bool result = true;
+
+        View::Format formats[] = { View::Gray8, View::Int16, View::Float };
+        for (int i = 0; i < 3; ++i)
+        {
+            result = result && Filter2DAutoTest(W, H, formats[i], 3, SimdBorderReplicate, Filter2DKernelFull, f1, f2);
+            result = result && Filter2DAutoTest(W, H, formats[i], 3, SimdBorderReplicate, Filter2DKernelSeparable, f1, f2);
+            result = result && Filter2DAutoTest(W + O, H - O, formats[i], 3, SimdBorderMirror, Filter2DKernelSmall, f1, f2);
+            result = result && Filter2DAutoTest(W - O, H + O, formats[i], 3, SimdBorderZero, Filter2DKernelSmall, f1, f2);
+            result = result && Filter2DAutoTest(W + O, H - O, formats[i], 5, SimdBorderMirror, Filter2DKernelSeparable, f1, f2);
+            result = result && Filter2DAutoTest(W, H, formats[i], 5, SimdBorderReplicate, Filter2DKernelSmall, f1, f2);
+            result = result && Filter2DAutoTest(W - O, H + O, formats[i], 7, SimdBorderZero, Filter2DKernelFull, f1, f2);
+        }
+
+        return result;
+    }
+
+    bool Filter2DAutoTest()
+    {
+        bool result = true;
+
+        result = result && Filter2DAutoTest(FUNC_F2D(Simd::Base::Filter2D), FUNC_F2D(SimdFilter2D));
+
+#ifdef SIMD_SSE2_ENABLE
+        if (Simd::Sse2::Enable)
+            result = result && Filter2DAutoTest(FUNC_F2D(Simd::Sse2::Filter2D), FUNC_F2D(SimdFilter2D));
+#endif 
+
+#ifdef SIMD_AVX2_ENABLE
+        if (Simd::Avx2::Enable)
+            result = result && Filter2DAutoTest(FUNC_F2D(Simd::Avx2::Filter2D), FUNC_F2D(SimdFilter2D));
+#endif 
+
+        return result;
+    }
+
+    namespace
+    {
+        struct FuncBF
+        {
+            typedef void(*FuncPtr)(const uint8_t * src, size_t srcStride, size_t width, size_t height, size_t channelCount,
+                size_t radius, float sigmaSpace, float sigmaRange, uint8_t * dst, size_t dstStride);
+
+            FuncPtr func;
+            String description;
+
+            FuncBF(const FuncPtr & f, const String & d) : func(f), description(d) {}
+
+            void Call(const View & src, size_t radius, float sigmaSpace, float sigmaRange, View & dst) const
+            {
+                TEST_PERFORMANCE_TEST(description);
+                func(src.data, src.stride, src.width, src.height, src.ChannelCount(), radius, sigmaSpace, sigmaRange, dst.data, dst.stride);
+            }
+        };
+    }
+
+#define FUNC_BF(function) \
+    FuncBF(function, std::string(#function))
+
+    bool BilateralFilterAutoTest(int width, int height, View::Format format, size_t radius, float sigmaRange, const FuncBF & f1, const FuncBF & f2)
+    {
+        bool result = true;
+
+        std::stringstream ss;
+        ss << "[" << View::ChannelCount(format) << "-" << radius << "-" << sigmaRange << "]";
+        FuncBF _f1(f1.func, f1.description + ss.str()), _f2(f2.func, f2.description + ss.str());
+
+        TEST_LOG_SS(Info, "Test " << _f1.description << " & " << _f2.description << " [" << width << ", " << height << "].");
+
+        View src(width, height, format, NULL, TEST_ALIGN(width));
+        FillRandom(src);
+
+        View dst1(width, height, format, NULL, TEST_ALIGN(width));
+        View dst2(width, height, format, NULL, TEST_ALIGN(width));
+
+        TEST_EXECUTE_AT_LEAST_MIN_TIME(_f1.Call(src, radius, float(radius), sigmaRange, dst1));
+
+        TEST_EXECUTE_AT_LEAST_MIN_TIME(_f2.Call(src, radius, float(radius), sigmaRange, dst2));
+
+        result = result && Compare(dst1, dst2, 0, true, 32);
+
+        return result;
+    }
+
+    bool BilateralFilterAutoTest(const FuncBF & f1, const FuncBF & f2)
+    {
+        bool result = true;
+
+        result = result && BilateralFilterAutoTest(W, H, View::Gray8, 2, 30.0f, f1, f2);
+        result = result && BilateralFilterAutoTest(W + O, H - O, View::Gray8, 3, 30.0f, f1, f2);
+        result = result && BilateralFilterAutoTest(W - O, H + O, View::Bgr24, 2, 30.0f, f1, f2);
+        result = result && BilateralFilterAutoTest(W, H, View::Gray8, 2, 0.0f, f1, f2);
+        result = result && BilateralFilterAutoTest(W - O, H + O, View::Bgr24, 2, 0.0f, f1, f2);
+
+        return result;
+    }
+
+    bool BilateralFilterAutoTest()
+    {
+        bool result = true;
+
+        result = result && BilateralFilterAutoTest(FUNC_BF(Simd::Base::BilateralFilter), FUNC_BF(SimdBilateralFilter));
+
+#ifdef SIMD_AVX2_ENABLE
+        if (Simd::Avx2::Enable)
+            result = result && BilateralFilterAutoTest(FUNC_BF(Simd::Avx2::BilateralFilter), FUNC_BF(SimdBilateralFilter));
+#endif 
+
+        return result;
+    }
+
+    namespace
+    {
+        struct FuncGF
+        {
+            typedef void(*FuncPtr)(const uint8_t * src, size_t srcStride, size_t width, size_t height, size_t channelCount,
+                size_t radius, float eps, uint8_t * dst, size_t dstStride);
+
+            FuncPtr func;
+            String description;
+
+            FuncGF(const FuncPtr & f, const String & d) : func(f), description(d) {}
+
+            void Call(const View & src, size_t radius, float eps, View & dst) const
+            {
+                TEST_PERFORMANCE_TEST(description);
+                func(src.data, src.stride, src.width, src.height, src.ChannelCount(), radius, eps, dst.data, dst.stride);
+            }
+        };
+    }
+
+#define FUNC_GF(function) \
+    FuncGF(function, std::string(#function))
+
+    bool GuidedFilterAutoTest(int width, int height, View::Format format, size_t radius, const FuncGF & f1, const FuncGF & f2)
+    {
+        bool result = true;
+
+        std::stringstream ss;
+        ss << "[" << View::ChannelCount(format) << "-" << radius << "]";
+        FuncGF _f1(f1.func, f1.description + ss.str()), _f2(f2.func, f2.description + ss.str());
+
+        TEST_LOG_SS(Info, "Test " << _f1.description << " & " << _f2.description << " [" << width << ", " << height << "].");
+
+        View src(width, height, format, NULL, TEST_ALIGN(width));
+        FillRandom(src);
+
+        View dst1(width, height, format, NULL, TEST_ALIGN(width));
+        View dst2(width, height, format, NULL, TEST_ALIGN(width));
+
+        TEST_EXECUTE_AT_LEAST_MIN_TIME(_f1.Call(src, radius, 400.0f, dst1));
+
+        TEST_EXECUTE_AT_LEAST_MIN_TIME(_f2.Call(src, radius, 400.0f, dst2));
+
+        result = result && Compare(dst1, dst2, 0, true, 32);
+
+        return result;
+    }
+
+    bool GuidedFilterAutoTest(const FuncGF & f1, const FuncGF & f2)
+    {
+        bool result = true;
+
+        result = result && GuidedFilterAutoTest(W, H, View::Gray8, 8, f1, f2);
+        result = result && GuidedFilterAutoTest(W + O, H - O, View::Gray8, 16, f1, f2);
+        result = result && GuidedFilterAutoTest(W - O, H + O, View::Bgr24, 8, f1, f2);
+
+        return result;
+    }
+
+    bool GuidedFilterAutoTest()
+    {
+        bool result = true;
+
+        result = result && GuidedFilterAutoTest(FUNC_GF(Simd::Base::GuidedFilter), FUNC_GF(SimdGuidedFilter));
+
+        return result;
+    }
+
     //-----------------------------------------------------------------------
 
     bool ColorFilterDataTest(bool create, int width, int height, View::Format format, const FuncC & f)
@@ -847,4 +1306,281 @@ namespace Test
 
         return result;
     }
+
+    bool SobelGradientDataTest(bool create)
+    {
+        bool result = true;
+
+        const int width = DW, height = DH;
+        const size_t quantization = 18;
+        FuncSG f = FUNC_SG(SimdSobelGradient);
+
+        Data data(f.description);
+
+        TEST_LOG_SS(Info, (create ? "Create" : "Verify") << " test " << f.description << " [" << width << ", " << height << "].");
+
+        View src(width, height, View::Gray8, NULL, TEST_ALIGN(width));
+
+        View dx1(width, height, View::Int16, NULL, TEST_ALIGN(width));
+        View dy1(width, height, View::Int16, NULL, TEST_ALIGN(width));
+        View magnitude1(width, height, View::Int16, NULL, TEST_ALIGN(width));
+        View direction1(width, height, View::Gray8, NULL, TEST_ALIGN(width));
+        View dx2(width, height, View::Int16, NULL, TEST_ALIGN(width));
+        View dy2(width, height, View::Int16, NULL, TEST_ALIGN(width));
+        View magnitude2(width, height, View::Int16, NULL, TEST_ALIGN(width));
+        View direction2(width, height, View::Gray8, NULL, TEST_ALIGN(width));
+
+        if (create)
+        {
+            FillRandom(src);
+
+            TEST_SAVE(src);
+
+            f.Call(src, dx1, dy1, magnitude1, quantization, direction1);
+
+            TEST_SAVE(dx1);
+            TEST_SAVE(dy1);
+            TEST_SAVE(magnitude1);
+            TEST_SAVE(direction1);
+        }
+        else
+        {
+            TEST_LOAD(src);
+
+            TEST_LOAD(dx1);
+            TEST_LOAD(dy1);
+            TEST_LOAD(magnitude1);
+            TEST_LOAD(direction1);
+
+            f.Call(src, dx2, dy2, magnitude2, quantization, direction2);
+
+            TEST_SAVE(dx2);
+            TEST_SAVE(dy2);
+            TEST_SAVE(magnitude2);
+            TEST_SAVE(direction2);
+
+            result = result && Compare(dx1, dx2, 0, true, 32, 0, "dx");
+            result = result && Compare(dy1, dy2, 0, true, 32, 0, "dy");
+            result = result && Compare(magnitude1, magnitude2, 0, true, 32, 0, "magnitude");
+            result = result && Compare(direction1, direction2, 0, true, 32, 0, "direction");
+        }
+
+        return result;
+    }
+
+    bool SobelGradient32fDataTest(bool create)
+    {
+        bool result = true;
+
+        const int width = DW, height = DH;
+        FuncSG32f f = FUNC_SG32F(SimdSobelGradient32f);
+
+        Data data(f.description);
+
+        TEST_LOG_SS(Info, (create ? "Create" : "Verify") << " test " << f.description << " [" << width << ", " << height << "].");
+
+        View src(width, height, View::Gray8, NULL, TEST_ALIGN(width));
+
+        View magnitude1(width, height, View::Float, NULL, TEST_ALIGN(width));
+        View direction1(width, height, View::Float, NULL, TEST_ALIGN(width));
+        View magnitude2(width, height, View::Float, NULL, TEST_ALIGN(width));
+        View direction2(width, height, View::Float, NULL, TEST_ALIGN(width));
+
+        if (create)
+        {
+            FillRandom(src);
+
+            TEST_SAVE(src);
+
+            f.Call(src, magnitude1, direction1);
+
+            TEST_SAVE(magnitude1);
+            TEST_SAVE(direction1);
+        }
+        else
+        {
+            TEST_LOAD(src);
+
+            TEST_LOAD(magnitude1);
+            TEST_LOAD(direction1);
+
+            f.Call(src, magnitude2, direction2);
+
+            TEST_SAVE(magnitude2);
+            TEST_SAVE(direction2);
+
+            result = result && Compare(magnitude1, magnitude2, EPS, true, 32, false, "magnitude");
+            result = result && Compare(direction1, direction2, EPS, true, 32, false, "direction");
+        }
+
+        return result;
+    }
+
+    bool Filter2DDataTest(bool create, View::Format format, const FuncF2D & f)
+    {
+        bool result = true;
+
+        const int width = DW, height = DH;
+        const size_t size = 5;
+
+        Data data(f.description);
+
+        TEST_LOG_SS(Info, (create ? "Create" : "Verify") << " test " << f.description << " [" << width << ", " << height << "].");
+
+        Buffer32f kernel(size*size);
+        for (size_t i = 0; i < size*size; ++i)
+            kernel[i] = float(int(i % 7) - 2) / float(size*size);
+
+        View src(width, height, format, NULL, TEST_ALIGN(width));
+
+        View dst1(width, height, format, NULL, TEST_ALIGN(width));
+        View dst2(width, height, format, NULL, TEST_ALIGN(width));
+
+        if (create)
+        {
+            FillFilter2DSource(src);
+
+            TEST_SAVE(src);
+
+            f.Call(src, kernel, size, SimdBorderMirror, dst1);
+
+            TEST_SAVE(dst1);
+        }
+        else
+        {
+            TEST_LOAD(src);
+
+            TEST_LOAD(dst1);
+
+            f.Call(src, kernel, size, SimdBorderMirror, dst2);
+
+            TEST_SAVE(dst2);
+
+            if (format == View::Float)
+                result = result && Compare(dst1, dst2, EPS, true, 32, false);
+            else
+                result = result && Compare(dst1, dst2, format == View::Int16 ? 1 : 0, true, 32);
+        }
+
+        return result;
+    }
+
+    bool Filter2DDataTest(bool create)
+    {
+        bool result = true;
+
+        FuncF2D f = FUNC_F2D(SimdFilter2D);
+
+        result = result && Filter2DDataTest(create, View::Gray8, FuncF2D(f.func, f.description + Data::Description(View::Gray8)));
+        result = result && Filter2DDataTest(create, View::Int16, FuncF2D(f.func, f.description + Data::Description(View::Int16)));
+        result = result && Filter2DDataTest(create, View::Float, FuncF2D(f.func, f.description + Data::Description(View::Float)));
+
+        return result;
+    }
+
+    bool BilateralFilterDataTest(bool create, View::Format format, const FuncBF & f)
+    {
+        bool result = true;
+
+        const int width = DW, height = DH;
+
+        Data data(f.description);
+
+        TEST_LOG_SS(Info, (create ? "Create" : "Verify") << " test " << f.description << " [" << width << ", " << height << "].");
+
+        View src(width, height, format, NULL, TEST_ALIGN(width));
+
+        View dst1(width, height, format, NULL, TEST_ALIGN(width));
+        View dst2(width, height, format, NULL, TEST_ALIGN(width));
+
+        if (create)
+        {
+            FillRandom(src);
+
+            TEST_SAVE(src);
+
+            f.Call(src, 3, 3.0f, 30.0f, dst1);
+
+            TEST_SAVE(dst1);
+        }
+        else
+        {
+            TEST_LOAD(src);
+
+            TEST_LOAD(dst1);
+
+            f.Call(src, 3, 3.0f, 30.0f, dst2);
+
+            TEST_SAVE(dst2);
+
+            result = result && Compare(dst1, dst2, 1, true, 32);
+        }
+
+        return result;
+    }
+
+    bool BilateralFilterDataTest(bool create)
+    {
+        bool result = true;
+
+        FuncBF f = FUNC_BF(SimdBilateralFilter);
+
+        result = result && BilateralFilterDataTest(create, View::Gray8, FuncBF(f.func, f.description + Data::Description(View::Gray8)));
+        result = result && BilateralFilterDataTest(create, View::Bgr24, FuncBF(f.func, f.description + Data::Description(View::Bgr24)));
+
+        return result;
+    }
+
+    bool GuidedFilterDataTest(bool create, View::Format format, const FuncGF & f)
+    {
+        bool result = true;
+
+        const int width = DW, height = DH;
+
+        Data data(f.description);
+
+        TEST_LOG_SS(Info, (create ? "Create" : "Verify") << " test " << f.description << " [" << width << ", " << height << "].");
+
+        View src(width, height, format, NULL, TEST_ALIGN(width));
+
+        View dst1(width, height, format, NULL, TEST_ALIGN(width));
+        View dst2(width, height, format, NULL, TEST_ALIGN(width));
+
+        if (create)
+        {
+            FillRandom(src);
+
+            TEST_SAVE(src);
+
+            f.Call(src, 4, 400.0f, dst1);
+
+            TEST_SAVE(dst1);
+        }
+        else
+        {
+            TEST_LOAD(src);
+
+            TEST_LOAD(dst1);
+
+            f.Call(src, 4, 400.0f, dst2);
+
+            TEST_SAVE(dst2);
+
+            result = result && Compare(dst1, dst2, 0, true, 32);
+        }
+
+        return result;
+    }
+
+    bool GuidedFilterDataTest(bool create)
+    {
+        bool result = true;
+
+        FuncGF f = FUNC_GF(SimdGuidedFilter);
+
+        result = result && GuidedFilterDataTest(create, View::Gray8, FuncGF(f.func, f.description + Data::Description(View::Gray8)));
+        result = result && GuidedFilterDataTest(create, View::Bgr24, FuncGF(f.func, f.description + Data::Description(View::Bgr24)));
+
+        return result;
+    }
 }
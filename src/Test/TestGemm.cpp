@@ -0,0 +1,173 @@
+/*
+* Tests for Simd Library (http://simd.sourceforge.net).
+*
+* Copyright (c) 2011-2016 Yermalayeu Ihar.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+#include "Test/TestUtils.h"
+#include "Test/TestPerformance.h"
+#include "Test/TestData.h"
+
+namespace Test
+{
+    namespace
+    {
+        struct FuncGemm
+        {
+            typedef void(*FuncPtr)(size_t M, size_t N, size_t K, const float * alpha, const float * A, size_t lda,
+                const float * B, size_t ldb, const float * beta, float * C, size_t ldc);
+
+            FuncPtr func;
+            String description;
+
+            FuncGemm(const FuncPtr & f, const String & d) : func(f), description(d) {}
+
+            void Call(float alpha, const View & A, const View & B, float beta, const View & C0, View & C) const
+            {
+                Simd::Copy(C0, C);
+                TEST_PERFORMANCE_TEST(description);
+                func(C.height, C.width, A.width, &alpha, (float*)A.data, A.stride / sizeof(float),
+                    (float*)B.data, B.stride / sizeof(float), &beta, (float*)C.data, C.stride / sizeof(float));
+            }
+        };
+    }
+
+#define FUNC_GEMM(function) FuncGemm(function, #function)
+
+    bool Gemm32fNNAutoTest(int M, int N, int K, float alpha, float beta, float eps, const FuncGemm & f1, const FuncGemm & f2)
+    {
+        bool result = true;
+
+        TEST_LOG_SS(Info, "Test " << f1.description << " & " << f2.description << " [" << M << ", " << N << ", " << K << "].");
+
+        View A(K, M, View::Float, NULL, TEST_ALIGN(K));
+        FillRandom32f(A, -1.0f, 1.0f);
+
+        View B(N, K, View::Float, NULL, TEST_ALIGN(N));
+        FillRandom32f(B, -1.0f, 1.0f);
+
+        View C0(N, M, View::Float, NULL, TEST_ALIGN(N));
+        FillRandom32f(C0, -1.0f, 1.0f);
+
+        View C1(N, M, View::Float, NULL, TEST_ALIGN(N));
+        View C2(N, M, View::Float, NULL, TEST_ALIGN(N));
+
+        TEST_EXECUTE_AT_LEAST_MIN_TIME(f1.Call(alpha, A, B, beta, C0, C1));
+
+        TEST_EXECUTE_AT_LEAST_MIN_TIME(f2.Call(alpha, A, B, beta, C0, C2));
+
+        result = Compare(C1, C2, eps, true, 32, false);
+
+        return result;
+    }
+
+    bool Gemm32fNNAutoTest(float eps, const FuncGemm & f1, const FuncGemm & f2)
+    {
+        bool result = true;
+
+        result = result && Gemm32fNNAutoTest(32, 512, 800, 1.0f, 0.0f, eps, f1, f2);
+        result = result && Gemm32fNNAutoTest(30, 500, 300, 1.0f, 1.0f, eps, f1, f2);
+        result = result && Gemm32fNNAutoTest(33, 515, 301, 0.5f, 0.3f, eps, f1, f2);
+        result = result && Gemm32fNNAutoTest(7, 9, 1000, 1.0f, 0.0f, eps, f1, f2);
+
+        return result;
+    }
+
+    bool Gemm32fNNAutoTest()
+    {
+        bool result = true;
+
+        result = result && Gemm32fNNAutoTest(EPS, FUNC_GEMM(Simd::Base::Gemm32fNN), FUNC_GEMM(SimdGemm32fNN));
+
+#ifdef SIMD_SSE_ENABLE
+        if (Simd::Sse::Enable)
+            result = result && Gemm32fNNAutoTest(EPS, FUNC_GEMM(Simd::Sse::Gemm32fNN), FUNC_GEMM(SimdGemm32fNN));
+#endif 
+
+#ifdef SIMD_AVX_ENABLE
+        if (Simd::Avx::Enable)
+            result = result && Gemm32fNNAutoTest(EPS, FUNC_GEMM(Simd::Avx::Gemm32fNN), FUNC_GEMM(SimdGemm32fNN));
+#endif
+
+#ifdef SIMD_AVX2_ENABLE
+        if (Simd::Avx2::Enable)
+            result = result && Gemm32fNNAutoTest(EPS, FUNC_GEMM(Simd::Avx2::Gemm32fNN), FUNC_GEMM(SimdGemm32fNN));
+#endif
+
+        return result;
+    }
+
+    //-----------------------------------------------------------------------
+
+    bool Gemm32fNNDataTest(bool create, int M, int N, int K, float eps, const FuncGemm & f)
+    {
+        bool result = true;
+
+        Data data(f.description);
+
+        TEST_LOG_SS(Info, (create ? "Create" : "Verify") << " test " << f.description << " [" << M << ", " << N << ", " << K << "].");
+
+        View A(K, M, View::Float, NULL, TEST_ALIGN(K));
+        View B(N, K, View::Float, NULL, TEST_ALIGN(N));
+        View C0(N, M, View::Float, NULL, TEST_ALIGN(N));
+        View C1(N, M, View::Float, NULL, TEST_ALIGN(N));
+        View C2(N, M, View::Float, NULL, TEST_ALIGN(N));
+
+        if (create)
+        {
+            FillRandom32f(A, -1.0f, 1.0f);
+            FillRandom32f(B, -1.0f, 1.0f);
+            FillRandom32f(C0, -1.0f, 1.0f);
+
+            TEST_SAVE(A);
+            TEST_SAVE(B);
+            TEST_SAVE(C0);
+
+            f.Call(1.0f, A, B, 1.0f, C0, C1);
+
+            TEST_SAVE(C1);
+        }
+        else
+        {
+            TEST_LOAD(A);
+            TEST_LOAD(B);
+            TEST_LOAD(C0);
+
+            TEST_LOAD(C1);
+
+            f.Call(1.0f, A, B, 1.0f, C0, C2);
+
+            TEST_SAVE(C2);
+
+            result = result && Compare(C1, C2, eps, true, 32, false);
+        }
+
+        return result;
+    }
+
+    bool Gemm32fNNDataTest(bool create)
+    {
+        bool result = true;
+
+        result = result && Gemm32fNNDataTest(create, 31, 129, 257, EPS, FUNC_GEMM(SimdGemm32fNN));
+
+        return result;
+    }
+}
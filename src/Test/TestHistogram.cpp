@@ -345,6 +345,93 @@ namespace Test
         return result;
     }
 
+    namespace
+    {
+        struct FuncCA
+        {
+            typedef void(*FuncPtr)(const uint8_t * src, size_t srcStride, size_t width, size_t height, size_t tilesX, size_t tilesY,
+                const uint8_t * luts, size_t rowBegin, size_t rowEnd, uint8_t * dst, size_t dstStride);
+
+            FuncPtr func;
+            String description;
+
+            FuncCA(const FuncPtr & f, const String & d) : func(f), description(d) {}
+
+            void Call(const View & src, size_t tilesX, size_t tilesY, const std::vector<uint8_t> & luts, View & dst) const
+            {
+                TEST_PERFORMANCE_TEST(description);
+                func(src.data, src.stride, src.width, src.height, tilesX, tilesY, luts.data(), 0, src.height, dst.data, dst.stride);
+            }
+        };
+    }
+
+#define FUNC_CA(function) \
+    FuncCA(function, std::string(#function))
+
+    bool ClaheApplyAutoTest(int width, int height, size_t tilesX, size_t tilesY, const FuncCA & f1, const FuncCA & f2)
+    {
+        bool result = true;
+
+        TEST_LOG_SS(Info, "Test " << f1.description << " & " << f2.description << " [" << width << ", " << height << "].");
+
+        View src(width, height, View::Gray8, NULL, TEST_ALIGN(width));
+        FillRandom(src);
+        FillRandom(src.Region(0, 0, width / 3, height).Ref(), 64, 128);
+
+        std::vector<uint8_t> luts(tilesX*tilesY*Simd::HISTOGRAM_SIZE), parts(luts.size());
+        SimdClaheLuts(src.data, src.stride, src.width, src.height, tilesX, tilesY, 3.0f, 0, tilesY, luts.data());
+        SimdClaheLuts(src.data, src.stride, src.width, src.height, tilesX, tilesY, 3.0f, 0, tilesY / 2, parts.data());
+        SimdClaheLuts(src.data, src.stride, src.width, src.height, tilesX, tilesY, 3.0f, tilesY / 2, tilesY, parts.data());
+        if (luts != parts)
+        {
+            TEST_LOG_SS(Error, "Lookup tables calculated by tile row ranges are different!");
+            return false;
+        }
+
+        View dst1(width, height, View::Gray8, NULL, TEST_ALIGN(width));
+        View dst2(width, height, View::Gray8, NULL, TEST_ALIGN(width));
+        View dst3(width, height, View::Gray8, NULL, TEST_ALIGN(width));
+
+        TEST_EXECUTE_AT_LEAST_MIN_TIME(f1.Call(src, tilesX, tilesY, luts, dst1));
+
+        TEST_EXECUTE_AT_LEAST_MIN_TIME(f2.Call(src, tilesX, tilesY, luts, dst2));
+
+        result = result && Compare(dst1, dst2, 0, true, 32);
+
+        size_t middle = height / 3;
+        f1.func(src.data, src.stride, width, height, tilesX, tilesY, luts.data(), 0, middle, dst3.data, dst3.stride);
+        f1.func(src.data, src.stride, width, height, tilesX, tilesY, luts.data(), middle, height, dst3.data, dst3.stride);
+
+        result = result && Compare(dst1, dst3, 0, true, 32);
+
+        return result;
+    }
+
+    bool ClaheApplyAutoTest(const FuncCA & f1, const FuncCA & f2)
+    {
+        bool result = true;
+
+        result = result && ClaheApplyAutoTest(W, H, 8, 8, f1, f2);
+        result = result && ClaheApplyAutoTest(W + O, H - O, 5, 3, f1, f2);
+        result = result && ClaheApplyAutoTest(W - O, H + O, 1, 4, f1, f2);
+
+        return result;
+    }
+
+    bool ClaheApplyAutoTest()
+    {
+        bool result = true;
+
+        result = result && ClaheApplyAutoTest(FUNC_CA(Simd::Base::ClaheApply), FUNC_CA(SimdClaheApply));
+
+#ifdef SIMD_AVX2_ENABLE
+        if (Simd::Avx2::Enable)
+            result = result && ClaheApplyAutoTest(FUNC_CA(Simd::Avx2::ClaheApply), FUNC_CA(SimdClaheApply));
+#endif 
+
+        return result;
+    }
+
     //-----------------------------------------------------------------------
 
     bool HistogramDataTest(bool create, int width, int height, const FuncH & f)
@@ -549,4 +636,56 @@ namespace Test
 
         return result;
     }
+
+    bool ClaheApplyDataTest(bool create, int width, int height, const FuncCA & f)
+    {
+        bool result = true;
+
+        Data data(f.description);
+
+        TEST_LOG_SS(Info, (create ? "Create" : "Verify") << " test " << f.description << " [" << width << ", " << height << "].");
+
+        const size_t tilesX = 4, tilesY = 4;
+        View src(width, height, View::Gray8, NULL, TEST_ALIGN(width));
+        View dst1(width, height, View::Gray8, NULL, TEST_ALIGN(width));
+        View dst2(width, height, View::Gray8, NULL, TEST_ALIGN(width));
+        std::vector<uint8_t> luts(tilesX*tilesY*Simd::HISTOGRAM_SIZE);
+
+        if (create)
+        {
+            FillRandom(src);
+            FillRandom(src.Region(0, 0, width / 3, height).Ref(), 64, 128);
+
+            TEST_SAVE(src);
+
+            SimdClaheLuts(src.data, src.stride, src.width, src.height, tilesX, tilesY, 3.0f, 0, tilesY, luts.data());
+            f.Call(src, tilesX, tilesY, luts, dst1);
+
+            TEST_SAVE(dst1);
+        }
+        else
+        {
+            TEST_LOAD(src);
+
+            TEST_LOAD(dst1);
+
+            SimdClaheLuts(src.data, src.stride, src.width, src.height, tilesX, tilesY, 3.0f, 0, tilesY, luts.data());
+            f.Call(src, tilesX, tilesY, luts, dst2);
+
+            TEST_SAVE(dst2);
+
+            result = result && Compare(dst1, dst2, 0, true, 32);
+        }
+
+        return result;
+    }
+
+    bool ClaheApplyDataTest(bool create)
+    {
+        bool result = true;
+
+        result = result && ClaheApplyDataTest(create, DW, DH, FUNC_CA(SimdClaheApply));
+
+        return result;
+    }
 }
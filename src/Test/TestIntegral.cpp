@@ -191,4 +191,218 @@ namespace Test
 
         return result;
     }
+
+    //-----------------------------------------------------------------------
+
+    namespace
+    {
+        struct FuncU
+        {
+            typedef void(*FuncPtr)(const uint8_t * src, size_t srcStride, size_t width, size_t height, const ptrdiff_t * rects, size_t rectNumber,
+                uint8_t * sum, size_t sumStride, uint8_t * sqsum, size_t sqsumStride, uint8_t * tilted, size_t tiltedStride,
+                SimdPixelFormatType sumFormat, SimdPixelFormatType sqsumFormat);
+
+            FuncPtr func;
+            String description;
+
+            FuncU(const FuncPtr & f, const String & d) : func(f), description(d) {}
+
+            void Call(const View & src, const std::vector<ptrdiff_t> & rects, View & sum, View & sqsum, View & tilted) const
+            {
+                TEST_PERFORMANCE_TEST(description);
+                func(src.data, src.stride, src.width, src.height, rects.data(), rects.size() / 4, sum.data, sum.stride, sqsum.data, sqsum.stride, 
+                    tilted.data, tilted.stride, (SimdPixelFormatType)sum.format, (SimdPixelFormatType)sqsum.format);
+            }
+        };
+    }
+
+#define FUNC_U(function) FuncU(function, #function)
+
+    static void ChangeRandomRects(View & src, size_t count, std::vector<ptrdiff_t> & rects)
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            ptrdiff_t w = 1 + Random(int(src.width / 4)), h = 1 + Random(int(src.height / 4));
+            ptrdiff_t l = Random(int(src.width + w)) - w / 2, t = Random(int(src.height + h)) - h / 2;
+            rects.push_back(l);
+            rects.push_back(t);
+            rects.push_back(l + w);
+            rects.push_back(t + h);
+            Rect r = Rect(l, t, l + w, t + h).Intersection(Rect(src.Size()));
+            if (!r.Empty())
+                FillRandom(src.Region(r).Ref());
+        }
+    }
+
+    bool IntegralUpdateAutoTest(int width, int height, bool sqsumEnable, bool tiltedEnable, View::Format sqsumFormat, const FuncU & f)
+    {
+        bool result = true;
+
+        TEST_LOG_SS(Info, "Test " << f.description << " & SimdIntegral [" << width << ", " << height << "].");
+
+        View src(width, height, View::Gray8, NULL, TEST_ALIGN(width));
+        FillRandom(src);
+
+        View sum1(width + 1, height + 1, View::Int32, NULL, TEST_ALIGN(width));
+        View sum2(width + 1, height + 1, View::Int32, NULL, TEST_ALIGN(width));
+        View sqsum1, sqsum2, tilted1, tilted2;
+        if (sqsumEnable)
+        {
+            sqsum1.Recreate(width + 1, height + 1, sqsumFormat, NULL, TEST_ALIGN(width));
+            sqsum2.Recreate(width + 1, height + 1, sqsumFormat, NULL, TEST_ALIGN(width));
+        }
+        if (tiltedEnable)
+        {
+            tilted1.Recreate(width + 1, height + 1, View::Int32, NULL, TEST_ALIGN(width));
+            tilted2.Recreate(width + 1, height + 1, View::Int32, NULL, TEST_ALIGN(width));
+        }
+        SimdIntegral(src.data, src.stride, src.width, src.height, sum2.data, sum2.stride, sqsum2.data, sqsum2.stride, tilted2.data, tilted2.stride, 
+            (SimdPixelFormatType)sum2.format, (SimdPixelFormatType)sqsum2.format);
+
+        std::vector<ptrdiff_t> rects;
+        ChangeRandomRects(src, 3, rects);
+
+        SimdIntegral(src.data, src.stride, src.width, src.height, sum1.data, sum1.stride, sqsum1.data, sqsum1.stride, tilted1.data, tilted1.stride,
+            (SimdPixelFormatType)sum1.format, (SimdPixelFormatType)sqsum1.format);
+
+        TEST_EXECUTE_AT_LEAST_MIN_TIME(f.Call(src, rects, sum2, sqsum2, tilted2));
+
+        result = result && Compare(sum1, sum2, 0, true, 32, 0, "sum");
+        if (sqsumEnable)
+            result = result && Compare(sqsum1, sqsum2, 0, true, 32, 0, "sqsum");
+        if (tiltedEnable)
+            result = result && Compare(tilted1, tilted2, 0, true, 32, 0, "tilted");
+
+        return result;
+    }
+
+    bool IntegralUpdateAutoTest(View::Format sqsumFormat, const FuncU & f)
+    {
+        bool result = true;
+
+        for (int sqsumEnable = 0; sqsumEnable <= 1; ++sqsumEnable)
+        {
+            for (int tiltedEnable = 0; tiltedEnable <= 1; ++tiltedEnable)
+            {
+                std::stringstream ss;
+                ss << ColorDescription(View::Int32) + ColorDescription(sqsumFormat);
+                ss << "<1" << sqsumEnable << tiltedEnable << ">";
+
+                FuncU fd = FuncU(f.func, f.description + ss.str());
+                result = result && IntegralUpdateAutoTest(W, H, sqsumEnable != 0, tiltedEnable != 0, sqsumFormat, fd);
+                result = result && IntegralUpdateAutoTest(W + O, H - O, sqsumEnable != 0, tiltedEnable != 0, sqsumFormat, fd);
+                result = result && IntegralUpdateAutoTest(W - O, H + O, sqsumEnable != 0, tiltedEnable != 0, sqsumFormat, fd);
+            }
+        }
+
+        return result;
+    }
+
+    bool IntegralUpdateAutoTest(const FuncU & f)
+    {
+        bool result = true;
+
+        result = result && IntegralUpdateAutoTest(View::Int32, f);
+        result = result && IntegralUpdateAutoTest(View::Double, f);
+
+        return result;
+    }
+
+    bool IntegralUpdateAutoTest()
+    {
+        bool result = true;
+
+        result = result && IntegralUpdateAutoTest(FUNC_U(Simd::Base::IntegralUpdate));
+
+        result = result && IntegralUpdateAutoTest(FUNC_U(SimdIntegralUpdate));
+
+        return result;
+    }
+
+    //-----------------------------------------------------------------------
+
+    bool IntegralUpdateDataTest(bool create, int width, int height, const FuncU & f)
+    {
+        bool result = true;
+
+        Data data(f.description);
+
+        TEST_LOG_SS(Info, (create ? "Create" : "Verify") << " test " << f.description << " [" << width << ", " << height << "].");
+
+        View src(width, height, View::Gray8, NULL, TEST_ALIGN(width));
+
+        View sum0(width + 1, height + 1, View::Int32, NULL, TEST_ALIGN(width));
+        View sum1(width + 1, height + 1, View::Int32, NULL, TEST_ALIGN(width));
+        View sum2(width + 1, height + 1, View::Int32, NULL, TEST_ALIGN(width));
+        View sqsum0(width + 1, height + 1, View::Int32, NULL, TEST_ALIGN(width));
+        View sqsum1(width + 1, height + 1, View::Int32, NULL, TEST_ALIGN(width));
+        View sqsum2(width + 1, height + 1, View::Int32, NULL, TEST_ALIGN(width));
+        View tilted0(width + 1, height + 1, View::Int32, NULL, TEST_ALIGN(width));
+        View tilted1(width + 1, height + 1, View::Int32, NULL, TEST_ALIGN(width));
+        View tilted2(width + 1, height + 1, View::Int32, NULL, TEST_ALIGN(width));
+
+        std::vector<ptrdiff_t> rects;
+        rects.push_back(width / 4);
+        rects.push_back(height / 3);
+        rects.push_back(width / 2);
+        rects.push_back(height / 2);
+
+        if (create)
+        {
+            FillRandom(src);
+            Simd::Integral(src, sum0, sqsum0, tilted0);
+            FillRandom(src.Region(Rect(rects[0], rects[1], rects[2], rects[3])).Ref());
+
+            TEST_SAVE(src);
+            TEST_SAVE(sum0);
+            TEST_SAVE(sqsum0);
+            TEST_SAVE(tilted0);
+
+            Simd::Copy(sum0, sum1);
+            Simd::Copy(sqsum0, sqsum1);
+            Simd::Copy(tilted0, tilted1);
+
+            f.Call(src, rects, sum1, sqsum1, tilted1);
+
+            TEST_SAVE(sum1);
+            TEST_SAVE(sqsum1);
+            TEST_SAVE(tilted1);
+        }
+        else
+        {
+            TEST_LOAD(src);
+            TEST_LOAD(sum0);
+            TEST_LOAD(sqsum0);
+            TEST_LOAD(tilted0);
+
+            TEST_LOAD(sum1);
+            TEST_LOAD(sqsum1);
+            TEST_LOAD(tilted1);
+
+            Simd::Copy(sum0, sum2);
+            Simd::Copy(sqsum0, sqsum2);
+            Simd::Copy(tilted0, tilted2);
+
+            f.Call(src, rects, sum2, sqsum2, tilted2);
+
+            TEST_SAVE(sum2);
+            TEST_SAVE(sqsum2);
+            TEST_SAVE(tilted2);
+
+            result = result && Compare(sum1, sum2, 0, true, 32, 0, "sum");
+            result = result && Compare(sqsum1, sqsum2, 0, true, 32, 0, "sqsum");
+            result = result && Compare(tilted1, tilted2, 0, true, 32, 0, "tilted");
+        }
+
+        return result;
+    }
+
+    bool IntegralUpdateDataTest(bool create)
+    {
+        bool result = true;
+
+        result = result && IntegralUpdateDataTest(create, DW, DH, FUNC_U(SimdIntegralUpdate));
+
+        return result;
+    }
 }
@@ -778,6 +778,98 @@ namespace Test
         return result;
     }
 
+    namespace
+    {
+        struct FuncAU
+        {
+            typedef void(*FuncPtr)(const float * delta, size_t size, size_t batch, const float * alpha, const float * beta1, const float * beta2,
+                const float * epsilon, const float * decay, float * moment1, float * moment2, float * weight);
+
+            FuncPtr func;
+            String description;
+
+            FuncAU(const FuncPtr & f, const String & d) : func(f), description(d) {}
+
+            void Call(const View & delta, size_t batch, float alpha, float beta1, float beta2, float epsilon, float decay, 
+                const View & moment1Src, const View & moment2Src, const View & weightSrc, View & moment1Dst, View & moment2Dst, View & weightDst) const
+            {
+                Simd::Copy(moment1Src, moment1Dst);
+                Simd::Copy(moment2Src, moment2Dst);
+                Simd::Copy(weightSrc, weightDst);
+                TEST_PERFORMANCE_TEST(description);
+                func((float*)delta.data, delta.width, batch, &alpha, &beta1, &beta2, &epsilon, &decay, 
+                    (float*)moment1Dst.data, (float*)moment2Dst.data, (float*)weightDst.data);
+            }
+        };
+    }
+#define FUNC_AU(function) FuncAU(function, #function)
+
+    bool NeuralAdamUpdateAutoTest(int size, float error, bool relative, const FuncAU & f1, const FuncAU & f2)
+    {
+        bool result = true;
+
+        TEST_LOG_SS(Info, "Test " << f1.description << " & " << f2.description << " [" << size << "].");
+
+        View delta(size, 1, View::Float, NULL, TEST_ALIGN(size));
+        View moment1Src(size, 1, View::Float, NULL, TEST_ALIGN(size));
+        View moment2Src(size, 1, View::Float, NULL, TEST_ALIGN(size));
+        View weightSrc(size, 1, View::Float, NULL, TEST_ALIGN(size));
+        FillRandom32f(delta, -1.0f, 1.0f);
+        FillRandom32f(moment1Src, -0.1f, 0.1f);
+        FillRandom32f(moment2Src, 0.0f, 0.01f);
+        FillRandom32f(weightSrc, -1.0f, 1.0f);
+
+        const size_t batch = 2;
+        const float alpha = 0.01f, beta1 = 0.9f, beta2 = 0.999f, epsilon = 0.0001f, decay = 0.0001f;
+
+        View moment1Dst1(size, 1, View::Float, NULL, TEST_ALIGN(size));
+        View moment2Dst1(size, 1, View::Float, NULL, TEST_ALIGN(size));
+        View weightDst1(size, 1, View::Float, NULL, TEST_ALIGN(size));
+        View moment1Dst2(size, 1, View::Float, NULL, TEST_ALIGN(size));
+        View moment2Dst2(size, 1, View::Float, NULL, TEST_ALIGN(size));
+        View weightDst2(size, 1, View::Float, NULL, TEST_ALIGN(size));
+
+        TEST_EXECUTE_AT_LEAST_MIN_TIME(f1.Call(delta, batch, alpha, beta1, beta2, epsilon, decay, moment1Src, moment2Src, weightSrc, moment1Dst1, moment2Dst1, weightDst1));
+
+        TEST_EXECUTE_AT_LEAST_MIN_TIME(f2.Call(delta, batch, alpha, beta1, beta2, epsilon, decay, moment1Src, moment2Src, weightSrc, moment1Dst2, moment2Dst2, weightDst2));
+
+        result = result && Compare(moment1Dst1, moment1Dst2, error, true, 32, relative, "moment1");
+        result = result && Compare(moment2Dst1, moment2Dst2, error, true, 32, relative, "moment2");
+        result = result && Compare(weightDst1, weightDst2, error, true, 32, relative, "weight");
+
+        return result;
+    }
+
+    bool NeuralAdamUpdateAutoTest(float error, bool relative, const FuncAU & f1, const FuncAU & f2)
+    {
+        bool result = true;
+
+        result = result && NeuralAdamUpdateAutoTest(W*H, error, relative, f1, f2);
+        result = result && NeuralAdamUpdateAutoTest(W*H + O, error, relative, f1, f2);
+        result = result && NeuralAdamUpdateAutoTest(W*H - O, error, relative, f1, f2);
+
+        return result;
+    }
+
+    bool NeuralAdamUpdateAutoTest()
+    {
+        bool result = true;
+
+        result = result && NeuralAdamUpdateAutoTest(EPS, false, FUNC_AU(Simd::Base::NeuralAdamUpdate), FUNC_AU(SimdNeuralAdamUpdate));
+
+#ifdef SIMD_SSE_ENABLE
+        if (Simd::Sse::Enable)
+            result = result && NeuralAdamUpdateAutoTest(EPS, false, FUNC_AU(Simd::Sse::NeuralAdamUpdate), FUNC_AU(SimdNeuralAdamUpdate));
+#endif 
+
+#ifdef SIMD_AVX_ENABLE
+        if (Simd::Avx::Enable)
+            result = result && NeuralAdamUpdateAutoTest(EPS, false, FUNC_AU(Simd::Avx::NeuralAdamUpdate), FUNC_AU(SimdNeuralAdamUpdate));
+#endif
+
+        return result;
+    }
+
     namespace
     {
         struct FuncC2
@@ -1147,168 +1239,694 @@ namespace Test
         return result;
     }
 
-    //-----------------------------------------------------------------------
+    namespace
+    {
+        struct ConvParam
+        {
+            int srcW, srcH, srcD, dstW, dstH, dstD, kernel, pad, stride, dilation;
 
-	bool NeuralConvertDataTest(bool create, int width, int height, float eps, const FuncC1 & f)
-	{
-		bool result = true;
+            ConvParam(int w, int h, int sd, int dd, int k, int p, int s, int d)
+                : srcW(w), srcH(h), srcD(sd), dstD(dd), kernel(k), pad(p), stride(s), dilation(d)
+            {
+                dstW = (srcW + 2 * pad - (dilation * (kernel - 1) + 1)) / stride + 1;
+                dstH = (srcH + 2 * pad - (dilation * (kernel - 1) + 1)) / stride + 1;
+            }
 
-		Data data(f.description);
+            String Description() const
+            {
+                std::stringstream ss;
+                ss << "[" << srcW << "x" << srcH << "x" << srcD << " -> " << dstW << "x" << dstH << "x" << dstD 
+                    << " k=" << kernel << " p=" << pad << " s=" << stride << " d=" << dilation << "]";
+                return ss.str();
+            }
+        };
 
-		TEST_LOG_SS(Info, (create ? "Create" : "Verify") << " test " << f.description << " [" << width << ", " << height << "].");
+        struct FuncCF
+        {
+            typedef void(*FuncPtr)(const float * src, size_t srcWidth, size_t srcHeight, size_t srcDepth, const float * weight,
+                size_t kernelX, size_t kernelY, size_t padX, size_t padY, size_t strideX, size_t strideY, size_t dilationX, size_t dilationY,
+                void * buffer, size_t * size, float * dst, size_t dstWidth, size_t dstHeight, size_t dstDepth, int add);
 
-		View src(width, height, View::Gray8, NULL, TEST_ALIGN(width));
-		FillRandom(src);
+            FuncPtr func;
+            String description;
+            bool backward;
 
-		View dst1(width*height, 1, View::Float, NULL, TEST_ALIGN(width));
-		View dst2(width*height, 1, View::Float, NULL, TEST_ALIGN(width));
+            FuncCF(const FuncPtr & f, const String & d, bool b) : func(f), description(d), backward(b) {}
 
-		if (create)
-		{
-			FillRandom(src);
+            void Call(const ConvParam & p, const View & src, const View & weight, View & dst) const
+            {
+                TEST_PERFORMANCE_TEST(description);
+                if (backward)
+                    func((float*)src.data, p.dstW, p.dstH, p.dstD, (float*)weight.data, p.kernel, p.kernel, p.pad, p.pad, p.stride, p.stride,
+                        p.dilation, p.dilation, NULL, NULL, (float*)dst.data, p.srcW, p.srcH, p.srcD, 0);
+                else
+                    func((float*)src.data, p.srcW, p.srcH, p.srcD, (float*)weight.data, p.kernel, p.kernel, p.pad, p.pad, p.stride, p.stride,
+                        p.dilation, p.dilation, NULL, NULL, (float*)dst.data, p.dstW, p.dstH, p.dstD, 0);
+            }
+        };
+    }
+#define FUNC_CF(function, backward) FuncCF(function, #function, backward)
 
-			TEST_SAVE(src);
+    bool NeuralConvolutionForwardAutoTest(const ConvParam & p, float eps, const FuncCF & f1, const FuncCF & f2)
+    {
+        bool result = true;
 
-			f.Call(src, dst1);
+        TEST_LOG_SS(Info, "Test " << f1.description << " & " << f2.description << " " << p.Description() << ".");
 
-			TEST_SAVE(dst1);
-		}
-		else
-		{
-			TEST_LOAD(src);
+        int srcSize = p.srcW*p.srcH*p.srcD, dstSize = p.dstW*p.dstH*p.dstD, weightSize = p.kernel*p.kernel*p.srcD*p.dstD;
+        if (f1.backward)
+            std::swap(srcSize, dstSize);
 
-			TEST_LOAD(dst1);
+        View src(srcSize, 1, View::Float, NULL, TEST_ALIGN(srcSize));
+        FillRandom32f(src, -1, 1);
 
-			f.Call(src, dst2);
+        View weight(weightSize, 1, View::Float, NULL, TEST_ALIGN(weightSize));
+        FillRandom32f(weight, -1, 1);
 
-			TEST_SAVE(dst2);
+        View dst1(dstSize, 1, View::Float, NULL, TEST_ALIGN(dstSize));
+        View dst2(dstSize, 1, View::Float, NULL, TEST_ALIGN(dstSize));
+        Simd::Fill(dst1, 0);
+        Simd::Fill(dst2, 0);
 
-			result = Compare(dst1, dst2, eps, true);
-		}
+        TEST_EXECUTE_AT_LEAST_MIN_TIME(f1.Call(p, src, weight, dst1));
 
-		return result;
-	}
+        TEST_EXECUTE_AT_LEAST_MIN_TIME(f2.Call(p, src, weight, dst2));
 
-	bool NeuralConvertDataTest(bool create)
-	{
-		bool result = true;
+        result = Compare(dst1, dst2, eps, true, 32, false);
 
-		result = result && NeuralConvertDataTest(create, DW, DH, EPS, FUNC_C1(SimdNeuralConvert, true));
+        return result;
+    }
 
-		return result;
-	}
+    bool NeuralConvolutionForwardAutoTest(float eps, const FuncCF & f1, const FuncCF & f2)
+    {
+        bool result = true;
 
-    bool NeuralProductSumDataTest(bool create, int size, float eps, const FuncPS & f)
+        result = result && NeuralConvolutionForwardAutoTest(ConvParam(W / 9, H / 9, 16, 32, 3, 1, 1, 1), eps, f1, f2);
+        result = result && NeuralConvolutionForwardAutoTest(ConvParam(W / 9, H / 9, 32, 16, 1, 0, 1, 1), eps, f1, f2);
+        result = result && NeuralConvolutionForwardAutoTest(ConvParam(W / 5 + E, H / 5 - E, 3, 16, 7, 3, 2, 1), eps, f1, f2);
+        result = result && NeuralConvolutionForwardAutoTest(ConvParam(W / 9 - O, H / 9 + O, 8, 8, 3, 2, 1, 2), eps, f1, f2);
+
+        return result;
+    }
+
+    bool NeuralConvolutionForwardAutoTest()
     {
         bool result = true;
 
-        Data data(f.description);
+        result = result && NeuralConvolutionForwardAutoTest(EPS, FUNC_CF(Simd::Base::NeuralConvolutionForward, false), FUNC_CF(SimdNeuralConvolutionForward, false));
 
-        TEST_LOG_SS(Info, (create ? "Create" : "Verify") << " test " << f.description << " [" << size << "].");
+#ifdef SIMD_SSE_ENABLE
+        if (Simd::Sse::Enable)
+            result = result && NeuralConvolutionForwardAutoTest(EPS, FUNC_CF(Simd::Sse::NeuralConvolutionForward, false), FUNC_CF(SimdNeuralConvolutionForward, false));
+#endif 
 
-        View a(size, 1, View::Float, NULL, TEST_ALIGN(size));
-        View b(size, 1, View::Float, NULL, TEST_ALIGN(size));
+#ifdef SIMD_AVX_ENABLE
+        if (Simd::Avx::Enable)
+            result = result && NeuralConvolutionForwardAutoTest(EPS, FUNC_CF(Simd::Avx::NeuralConvolutionForward, false), FUNC_CF(SimdNeuralConvolutionForward, false));
+#endif
 
-        float s1, s2;
+#ifdef SIMD_AVX2_ENABLE
+        if (Simd::Avx2::Enable)
+            result = result && NeuralConvolutionForwardAutoTest(EPS, FUNC_CF(Simd::Avx2::NeuralConvolutionForward, false), FUNC_CF(SimdNeuralConvolutionForward, false));
+#endif
 
-        if(create)
-        {
-            FillRandom32f(a);
-            FillRandom32f(b);
+        return result;
+    }
 
-            TEST_SAVE(a);
-            TEST_SAVE(b);
+    bool NeuralConvolutionBackwardAutoTest()
+    {
+        bool result = true;
 
-            f.Call(a, b, &s1);
+        result = result && NeuralConvolutionForwardAutoTest(EPS, FUNC_CF(Simd::Base::NeuralConvolutionBackward, true), FUNC_CF(SimdNeuralConvolutionBackward, true));
 
-            TEST_SAVE(s1);
-        }
-        else
+#ifdef SIMD_SSE_ENABLE
+        if (Simd::Sse::Enable)
+            result = result && NeuralConvolutionForwardAutoTest(EPS, FUNC_CF(Simd::Sse::NeuralConvolutionBackward, true), FUNC_CF(SimdNeuralConvolutionBackward, true));
+#endif 
+
+#ifdef SIMD_AVX_ENABLE
+        if (Simd::Avx::Enable)
+            result = result && NeuralConvolutionForwardAutoTest(EPS, FUNC_CF(Simd::Avx::NeuralConvolutionBackward, true), FUNC_CF(SimdNeuralConvolutionBackward, true));
+#endif
+
+#ifdef SIMD_AVX2_ENABLE
+        if (Simd::Avx2::Enable)
+            result = result && NeuralConvolutionForwardAutoTest(EPS, FUNC_CF(Simd::Avx2::NeuralConvolutionBackward, true), FUNC_CF(SimdNeuralConvolutionBackward, true));
+#endif
+
+        return result;
+    }
+
+    namespace
+    {
+        struct FuncCS2
         {
-            TEST_LOAD(a);
-            TEST_LOAD(b);
+            typedef void(*FuncPtr)(const float * src, size_t srcWidth, size_t srcHeight, size_t srcDepth, const float * dst, size_t dstWidth, size_t dstHeight, size_t dstDepth,
+                size_t kernelX, size_t kernelY, size_t padX, size_t padY, size_t strideX, size_t strideY, size_t dilationX, size_t dilationY,
+                void * buffer, size_t * size, float * sums);
 
-            TEST_LOAD(s1);
+            FuncPtr func;
+            String description;
 
-            f.Call(a, b, &s2);
+            FuncCS2(const FuncPtr & f, const String & d) : func(f), description(d) {}
 
-            TEST_SAVE(s2);
+            void Call(const ConvParam & p, const View & src, const View & dst, View & sums) const
+            {
+                Simd::Fill(sums, 0);
+                TEST_PERFORMANCE_TEST(description);
+                func((float*)src.data, p.srcW, p.srcH, p.srcD, (float*)dst.data, p.dstW, p.dstH, p.dstD, p.kernel, p.kernel, p.pad, p.pad, 
+                    p.stride, p.stride, p.dilation, p.dilation, NULL, NULL, (float*)sums.data);
+            }
+        };
+    }
+#define FUNC_CS2(function) FuncCS2(function, #function)
 
-            result = result && Compare(s1, s2, eps, true);
-        }
+    bool NeuralConvolutionSumAutoTest(const ConvParam & p, float eps, const FuncCS2 & f1, const FuncCS2 & f2)
+    {
+        bool result = true;
+
+        TEST_LOG_SS(Info, "Test " << f1.description << " & " << f2.description << " " << p.Description() << ".");
+
+        int srcSize = p.srcW*p.srcH*p.srcD, dstSize = p.dstW*p.dstH*p.dstD, weightSize = p.kernel*p.kernel*p.srcD*p.dstD;
+
+        View src(srcSize, 1, View::Float, NULL, TEST_ALIGN(srcSize));
+        FillRandom32f(src, -1, 1);
+
+        View dst(dstSize, 1, View::Float, NULL, TEST_ALIGN(dstSize));
+        FillRandom32f(dst, -1, 1);
+
+        View sums1(weightSize, 1, View::Float, NULL, TEST_ALIGN(weightSize));
+        View sums2(weightSize, 1, View::Float, NULL, TEST_ALIGN(weightSize));
+        Simd::Fill(sums1, 0);
+        Simd::Fill(sums2, 0);
+
+        TEST_EXECUTE_AT_LEAST_MIN_TIME(f1.Call(p, src, dst, sums1));
+
+        TEST_EXECUTE_AT_LEAST_MIN_TIME(f2.Call(p, src, dst, sums2));
+
+        result = Compare(sums1, sums2, eps, true, 32, false);
 
         return result;
     }
 
-    bool NeuralProductSumDataTest(bool create)
+    bool NeuralConvolutionSumAutoTest(float eps, const FuncCS2 & f1, const FuncCS2 & f2)
     {
         bool result = true;
 
-        result = result && NeuralProductSumDataTest(create, DH, EPS, FUNC_PS(SimdNeuralProductSum));
+        result = result && NeuralConvolutionSumAutoTest(ConvParam(W / 15, H / 15, 16, 32, 3, 1, 1, 1), eps, f1, f2);
+        result = result && NeuralConvolutionSumAutoTest(ConvParam(W / 15, H / 15, 32, 16, 1, 0, 1, 1), eps, f1, f2);
+        result = result && NeuralConvolutionSumAutoTest(ConvParam(W / 10 + E, H / 10 - E, 3, 16, 7, 3, 2, 1), eps, f1, f2);
+        result = result && NeuralConvolutionSumAutoTest(ConvParam(W / 15 - O, H / 15 + O, 8, 8, 3, 2, 1, 2), eps, f1, f2);
 
         return result;
     }
 
-    bool NeuralAddVectorMultipliedByValueDataTest(bool create, int size, float eps, const FuncAVMV & f)
+    bool NeuralConvolutionSumAutoTest()
     {
         bool result = true;
 
-        Data data(f.description);
+        result = result && NeuralConvolutionSumAutoTest(EPS, FUNC_CS2(Simd::Base::NeuralConvolutionSum), FUNC_CS2(SimdNeuralConvolutionSum));
 
-        TEST_LOG_SS(Info, (create ? "Create" : "Verify") << " test " << f.description << " [" << size << "].");
+#ifdef SIMD_SSE_ENABLE
+        if (Simd::Sse::Enable)
+            result = result && NeuralConvolutionSumAutoTest(EPS, FUNC_CS2(Simd::Sse::NeuralConvolutionSum), FUNC_CS2(SimdNeuralConvolutionSum));
+#endif 
 
-        const float value = 0.3f;
+#ifdef SIMD_AVX_ENABLE
+        if (Simd::Avx::Enable)
+            result = result && NeuralConvolutionSumAutoTest(EPS, FUNC_CS2(Simd::Avx::NeuralConvolutionSum), FUNC_CS2(SimdNeuralConvolutionSum));
+#endif
 
-        View src(size, 1, View::Float, NULL, TEST_ALIGN(size));
-        View dstSrc(size, 1, View::Float, NULL, TEST_ALIGN(size));
-        View dstDst1(size, 1, View::Float, NULL, TEST_ALIGN(size));
-        View dstDst2(size, 1, View::Float, NULL, TEST_ALIGN(size));
+#ifdef SIMD_AVX2_ENABLE
+        if (Simd::Avx2::Enable)
+            result = result && NeuralConvolutionSumAutoTest(EPS, FUNC_CS2(Simd::Avx2::NeuralConvolutionSum), FUNC_CS2(SimdNeuralConvolutionSum));
+#endif
 
-        if (create)
+        return result;
+    }
+
+    namespace
+    {
+        struct FuncWI
         {
-            FillRandom32f(src);
-            FillRandom32f(dstSrc);
+            typedef void(*FuncPtr)(const float * src, size_t srcWidth, size_t srcHeight, size_t srcDepth, float * dst);
 
-            TEST_SAVE(src);
-            TEST_SAVE(dstSrc);
+            FuncPtr func;
+            String description;
 
-            f.Call(src, value, dstSrc, dstDst1);
+            FuncWI(const FuncPtr & f, const String & d) : func(f), description(d) {}
 
-            TEST_SAVE(dstDst1);
-        }
-        else
-        {
-            TEST_LOAD(src);
-            TEST_LOAD(dstSrc);
+            void Call(const ConvParam & p, const View & src, View & dst) const
+            {
+                TEST_PERFORMANCE_TEST(description);
+                func((float*)src.data, p.srcW, p.srcH, p.srcD, (float*)dst.data);
+            }
+        };
+    }
+#define FUNC_WI(function) FuncWI(function, #function)
 
-            TEST_LOAD(dstDst1);
+    bool NeuralWinograd2x2p3x3SetInputAutoTest(const ConvParam & p, float eps, const FuncWI & f1, const FuncWI & f2)
+    {
+        bool result = true;
 
-            f.Call(src, value, dstSrc, dstDst2);
+        TEST_LOG_SS(Info, "Test " << f1.description << " & " << f2.description << " " << p.Description() << ".");
 
-            TEST_SAVE(dstDst2);
+        int srcSize = p.srcW*p.srcH*p.srcD, dstSize = 16 * p.srcD*((p.dstW + 1) / 2)*((p.dstH + 1) / 2);
 
-            result = result && Compare(dstDst1, dstDst2, eps, true);
-        }
+        View src(srcSize, 1, View::Float, NULL, TEST_ALIGN(srcSize));
+        FillRandom32f(src, -1, 1);
+
+        View dst1(dstSize, 1, View::Float, NULL, TEST_ALIGN(dstSize));
+        View dst2(dstSize, 1, View::Float, NULL, TEST_ALIGN(dstSize));
+
+        TEST_EXECUTE_AT_LEAST_MIN_TIME(f1.Call(p, src, dst1));
+
+        TEST_EXECUTE_AT_LEAST_MIN_TIME(f2.Call(p, src, dst2));
+
+        result = Compare(dst1, dst2, eps, true, 32, false);
 
         return result;
     }
 
-    bool NeuralAddVectorMultipliedByValueDataTest(bool create)
+    bool NeuralWinograd2x2p3x3SetInputAutoTest(float eps, const FuncWI & f1, const FuncWI & f2)
     {
         bool result = true;
 
-        result = result && NeuralAddVectorMultipliedByValueDataTest(create, DH, EPS, FUNC_AVMV(SimdNeuralAddVectorMultipliedByValue));
+        result = result && NeuralWinograd2x2p3x3SetInputAutoTest(ConvParam(W / 2, H / 2, 16, 16, 3, 0, 1, 1), eps, f1, f2);
+        result = result && NeuralWinograd2x2p3x3SetInputAutoTest(ConvParam(W / 2 + 1, H / 2 - 1, 16, 16, 3, 0, 1, 1), eps, f1, f2);
+        result = result && NeuralWinograd2x2p3x3SetInputAutoTest(ConvParam(W / 9 - O, H / 9 + O, 3, 3, 3, 0, 1, 1), eps, f1, f2);
 
         return result;
     }
 
-	bool NeuralActivateFunctionDataTest(bool create, int size, float error, bool relative, float slope, const FuncAF & f)
-	{
-		bool result = true;
+    bool NeuralWinograd2x2p3x3SetInputAutoTest()
+    {
+        bool result = true;
 
-		Data data(f.description);
+        result = result && NeuralWinograd2x2p3x3SetInputAutoTest(EPS, FUNC_WI(Simd::Base::NeuralWinograd2x2p3x3SetInput), FUNC_WI(SimdNeuralWinograd2x2p3x3SetInput));
 
-		TEST_LOG_SS(Info, (create ? "Create" : "Verify") << " test " << f.description << " [" << size << "].");
+#ifdef SIMD_SSE_ENABLE
+        if (Simd::Sse::Enable)
+            result = result && NeuralWinograd2x2p3x3SetInputAutoTest(EPS, FUNC_WI(Simd::Sse::NeuralWinograd2x2p3x3SetInput), FUNC_WI(SimdNeuralWinograd2x2p3x3SetInput));
+#endif 
+
+#ifdef SIMD_AVX_ENABLE
+        if (Simd::Avx::Enable)
+            result = result && NeuralWinograd2x2p3x3SetInputAutoTest(EPS, FUNC_WI(Simd::Avx::NeuralWinograd2x2p3x3SetInput), FUNC_WI(SimdNeuralWinograd2x2p3x3SetInput));
+#endif
+
+        return result;
+    }
+
+    namespace
+    {
+        struct FuncWO
+        {
+            typedef void(*FuncPtr)(const float * src, float * dst, size_t dstWidth, size_t dstHeight, size_t dstDepth);
+
+            FuncPtr func;
+            String description;
+
+            FuncWO(const FuncPtr & f, const String & d) : func(f), description(d) {}
+
+            void Call(const ConvParam & p, const View & src, View & dst) const
+            {
+                TEST_PERFORMANCE_TEST(description);
+                func((float*)src.data, (float*)dst.data, p.dstW, p.dstH, p.dstD);
+            }
+        };
+    }
+#define FUNC_WO(function) FuncWO(function, #function)
+
+    bool NeuralWinograd2x2p3x3SetOutputAutoTest(const ConvParam & p, float eps, const FuncWO & f1, const FuncWO & f2)
+    {
+        bool result = true;
+
+        TEST_LOG_SS(Info, "Test " << f1.description << " & " << f2.description << " " << p.Description() << ".");
+
+        int srcSize = 16 * p.dstD*((p.dstW + 1) / 2)*((p.dstH + 1) / 2), dstSize = p.dstW*p.dstH*p.dstD;
+
+        View src(srcSize, 1, View::Float, NULL, TEST_ALIGN(srcSize));
+        FillRandom32f(src, -1, 1);
+
+        View dst1(dstSize, 1, View::Float, NULL, TEST_ALIGN(dstSize));
+        View dst2(dstSize, 1, View::Float, NULL, TEST_ALIGN(dstSize));
+
+        TEST_EXECUTE_AT_LEAST_MIN_TIME(f1.Call(p, src, dst1));
+
+        TEST_EXECUTE_AT_LEAST_MIN_TIME(f2.Call(p, src, dst2));
+
+        result = Compare(dst1, dst2, eps, true, 32, false);
+
+        return result;
+    }
+
+    bool NeuralWinograd2x2p3x3SetOutputAutoTest(float eps, const FuncWO & f1, const FuncWO & f2)
+    {
+        bool result = true;
+
+        result = result && NeuralWinograd2x2p3x3SetOutputAutoTest(ConvParam(W / 2, H / 2, 16, 16, 3, 0, 1, 1), eps, f1, f2);
+        result = result && NeuralWinograd2x2p3x3SetOutputAutoTest(ConvParam(W / 2 + 1, H / 2 - 1, 16, 16, 3, 0, 1, 1), eps, f1, f2);
+        result = result && NeuralWinograd2x2p3x3SetOutputAutoTest(ConvParam(W / 9 - O, H / 9 + O, 3, 3, 3, 0, 1, 1), eps, f1, f2);
+
+        return result;
+    }
+
+    bool NeuralWinograd2x2p3x3SetOutputAutoTest()
+    {
+        bool result = true;
+
+        result = result && NeuralWinograd2x2p3x3SetOutputAutoTest(EPS, FUNC_WO(Simd::Base::NeuralWinograd2x2p3x3SetOutput), FUNC_WO(SimdNeuralWinograd2x2p3x3SetOutput));
+
+#ifdef SIMD_SSE_ENABLE
+        if (Simd::Sse::Enable)
+            result = result && NeuralWinograd2x2p3x3SetOutputAutoTest(EPS, FUNC_WO(Simd::Sse::NeuralWinograd2x2p3x3SetOutput), FUNC_WO(SimdNeuralWinograd2x2p3x3SetOutput));
+#endif 
+
+#ifdef SIMD_AVX_ENABLE
+        if (Simd::Avx::Enable)
+            result = result && NeuralWinograd2x2p3x3SetOutputAutoTest(EPS, FUNC_WO(Simd::Avx::NeuralWinograd2x2p3x3SetOutput), FUNC_WO(SimdNeuralWinograd2x2p3x3SetOutput));
+#endif
+
+        return result;
+    }
+
+    namespace
+    {
+        struct FuncQ
+        {
+            typedef void(*FuncPtr)(const float * src, size_t size, const float * scale, const float * shift, uint8_t * dst);
+
+            FuncPtr func;
+            String description;
+
+            FuncQ(const FuncPtr & f, const String & d) : func(f), description(d) {}
+
+            void Call(const View & src, float scale, float shift, View & dst) const
+            {
+                TEST_PERFORMANCE_TEST(description);
+                func((float*)src.data, src.width, &scale, &shift, dst.data);
+            }
+        };
+    }
+#define FUNC_Q(function) FuncQ(function, #function)
+
+    bool NeuralQuantize8uAutoTest(int size, const FuncQ & f1, const FuncQ & f2)
+    {
+        bool result = true;
+
+        TEST_LOG_SS(Info, "Test " << f1.description << " & " << f2.description << " [" << size << "].");
+
+        View src(size, 1, View::Float, NULL, TEST_ALIGN(size));
+        FillRandom32f(src, -1.0f, 1.0f);
+
+        View dst1(size, 1, View::Gray8, NULL, TEST_ALIGN(size));
+        View dst2(size, 1, View::Gray8, NULL, TEST_ALIGN(size));
+
+        const float scale = 150.0f, shift = 127.0f;
+
+        TEST_EXECUTE_AT_LEAST_MIN_TIME(f1.Call(src, scale, shift, dst1));
+
+        TEST_EXECUTE_AT_LEAST_MIN_TIME(f2.Call(src, scale, shift, dst2));
+
+        result = result && Compare(dst1, dst2, 0, true, 32);
+
+        return result;
+    }
+
+    bool NeuralQuantize8uAutoTest(const FuncQ & f1, const FuncQ & f2)
+    {
+        bool result = true;
+
+        result = result && NeuralQuantize8uAutoTest(W*H, f1, f2);
+        result = result && NeuralQuantize8uAutoTest(W*H + O, f1, f2);
+        result = result && NeuralQuantize8uAutoTest(W*H - O, f1, f2);
+
+        return result;
+    }
+
+    bool NeuralQuantize8uAutoTest()
+    {
+        bool result = true;
+
+        result = result && NeuralQuantize8uAutoTest(FUNC_Q(Simd::Base::NeuralQuantize8u), FUNC_Q(SimdNeuralQuantize8u));
+
+#ifdef SIMD_SSE2_ENABLE
+        if (Simd::Sse2::Enable)
+            result = result && NeuralQuantize8uAutoTest(FUNC_Q(Simd::Sse2::NeuralQuantize8u), FUNC_Q(SimdNeuralQuantize8u));
+#endif 
+
+#ifdef SIMD_AVX2_ENABLE
+        if (Simd::Avx2::Enable)
+            result = result && NeuralQuantize8uAutoTest(FUNC_Q(Simd::Avx2::NeuralQuantize8u), FUNC_Q(SimdNeuralQuantize8u));
+#endif
+
+        return result;
+    }
+
+    namespace
+    {
+        struct FuncPS8
+        {
+            typedef void(*FuncPtr)(const uint8_t * src, const int8_t * weight, size_t size, size_t count, int32_t * sums);
+
+            FuncPtr func;
+            String description;
+
+            FuncPS8(const FuncPtr & f, const String & d) : func(f), description(d) {}
+
+            void Call(const View & src, const View & weight, View & sums) const
+            {
+                TEST_PERFORMANCE_TEST(description);
+                func(src.data, (int8_t*)weight.data, src.width, sums.width, (int32_t*)sums.data);
+            }
+        };
+
+        void FillRandomWeight8i(View & weight)
+        {
+            FillRandom(weight, 0, 126);
+            for (size_t i = 0; i < weight.width; ++i)
+                weight.data[i] = uint8_t(int(weight.data[i]) - 63);
+        }
+    }
+#define FUNC_PS8(function) FuncPS8(function, #function)
+
+    bool NeuralProductSum8u8iAutoTest(int size, int count, const FuncPS8 & f1, const FuncPS8 & f2)
+    {
+        bool result = true;
+
+        TEST_LOG_SS(Info, "Test " << f1.description << " & " << f2.description << " [" << size << ", " << count << "].");
+
+        View src(size, 1, View::Gray8, NULL, TEST_ALIGN(size));
+        FillRandom(src);
+
+        View weight(size*count, 1, View::Gray8, NULL, TEST_ALIGN(size*count));
+        FillRandomWeight8i(weight);
+
+        View sums1(count, 1, View::Int32, NULL, TEST_ALIGN(count));
+        View sums2(count, 1, View::Int32, NULL, TEST_ALIGN(count));
+
+        TEST_EXECUTE_AT_LEAST_MIN_TIME(f1.Call(src, weight, sums1));
+
+        TEST_EXECUTE_AT_LEAST_MIN_TIME(f2.Call(src, weight, sums2));
+
+        result = result && Compare(sums1, sums2, 0, true, 32);
+
+        return result;
+    }
+
+    bool NeuralProductSum8u8iAutoTest(const FuncPS8 & f1, const FuncPS8 & f2)
+    {
+        bool result = true;
+
+        result = result && NeuralProductSum8u8iAutoTest(W*H / 64, 64, f1, f2);
+        result = result && NeuralProductSum8u8iAutoTest(W*H / 64 + O, 64 - 1, f1, f2);
+        result = result && NeuralProductSum8u8iAutoTest(W*H / 64 - O, 64 + 1, f1, f2);
+
+        return result;
+    }
+
+    bool NeuralProductSum8u8iAutoTest()
+    {
+        bool result = true;
+
+        result = result && NeuralProductSum8u8iAutoTest(FUNC_PS8(Simd::Base::NeuralProductSum8u8i), FUNC_PS8(SimdNeuralProductSum8u8i));
+
+#ifdef SIMD_SSSE3_ENABLE
+        if (Simd::Ssse3::Enable)
+            result = result && NeuralProductSum8u8iAutoTest(FUNC_PS8(Simd::Ssse3::NeuralProductSum8u8i), FUNC_PS8(SimdNeuralProductSum8u8i));
+#endif 
+
+#ifdef SIMD_AVX2_ENABLE
+        if (Simd::Avx2::Enable)
+            result = result && NeuralProductSum8u8iAutoTest(FUNC_PS8(Simd::Avx2::NeuralProductSum8u8i), FUNC_PS8(SimdNeuralProductSum8u8i));
+#endif
+
+        return result;
+    }
+
+    //-----------------------------------------------------------------------
+
+	bool NeuralConvertDataTest(bool create, int width, int height, float eps, const FuncC1 & f)
+	{
+		bool result = true;
+
+		Data data(f.description);
+
+		TEST_LOG_SS(Info, (create ? "Create" : "Verify") << " test " << f.description << " [" << width << ", " << height << "].");
+
+		View src(width, height, View::Gray8, NULL, TEST_ALIGN(width));
+		FillRandom(src);
+
+		View dst1(width*height, 1, View::Float, NULL, TEST_ALIGN(width));
+		View dst2(width*height, 1, View::Float, NULL, TEST_ALIGN(width));
+
+		if (create)
+		{
+			FillRandom(src);
+
+			TEST_SAVE(src);
+
+			f.Call(src, dst1);
+
+			TEST_SAVE(dst1);
+		}
+		else
+		{
+			TEST_LOAD(src);
+
+			TEST_LOAD(dst1);
+
+			f.Call(src, dst2);
+
+			TEST_SAVE(dst2);
+
+			result = Compare(dst1, dst2, eps, true);
+		}
+
+		return result;
+	}
+
+	bool NeuralConvertDataTest(bool create)
+	{
+		bool result = true;
+
+		result = result && NeuralConvertDataTest(create, DW, DH, EPS, FUNC_C1(SimdNeuralConvert, true));
+
+		return result;
+	}
+
+    bool NeuralProductSumDataTest(bool create, int size, float eps, const FuncPS & f)
+    {
+        bool result = true;
+
+        Data data(f.description);
+
+        TEST_LOG_SS(Info, (create ? "Create" : "Verify") << " test " << f.description << " [" << size << "].");
+
+        View a(size, 1, View::Float, NULL, TEST_ALIGN(size));
+        View b(size, 1, View::Float, NULL, TEST_ALIGN(size));
+
+        float s1, s2;
+
+        if(create)
+        {
+            FillRandom32f(a);
+            FillRandom32f(b);
+
+            TEST_SAVE(a);
+            TEST_SAVE(b);
+
+            f.Call(a, b, &s1);
+
+            TEST_SAVE(s1);
+        }
+        else
+        {
+            TEST_LOAD(a);
+            TEST_LOAD(b);
+
+            TEST_LOAD(s1);
+
+            f.Call(a, b, &s2);
+
+            TEST_SAVE(s2);
+
+            result = result && Compare(s1, s2, eps, true);
+        }
+
+        return result;
+    }
+
+    bool NeuralProductSumDataTest(bool create)
+    {
+        bool result = true;
+
+        result = result && NeuralProductSumDataTest(create, DH, EPS, FUNC_PS(SimdNeuralProductSum));
+
+        return result;
+    }
+
+    bool NeuralAddVectorMultipliedByValueDataTest(bool create, int size, float eps, const FuncAVMV & f)
+    {
+        bool result = true;
+
+        Data data(f.description);
+
+        TEST_LOG_SS(Info, (create ? "Create" : "Verify") << " test " << f.description << " [" << size << "].");
+
+        const float value = 0.3f;
+
+        View src(size, 1, View::Float, NULL, TEST_ALIGN(size));
+        View dstSrc(size, 1, View::Float, NULL, TEST_ALIGN(size));
+        View dstDst1(size, 1, View::Float, NULL, TEST_ALIGN(size));
+        View dstDst2(size, 1, View::Float, NULL, TEST_ALIGN(size));
+
+        if (create)
+        {
+            FillRandom32f(src);
+            FillRandom32f(dstSrc);
+
+            TEST_SAVE(src);
+            TEST_SAVE(dstSrc);
+
+            f.Call(src, value, dstSrc, dstDst1);
+
+            TEST_SAVE(dstDst1);
+        }
+        else
+        {
+            TEST_LOAD(src);
+            TEST_LOAD(dstSrc);
+
+            TEST_LOAD(dstDst1);
+
+            f.Call(src, value, dstSrc, dstDst2);
+
+            TEST_SAVE(dstDst2);
+
+            result = result && Compare(dstDst1, dstDst2, eps, true);
+        }
+
+        return result;
+    }
+
+    bool NeuralAddVectorMultipliedByValueDataTest(bool create)
+    {
+        bool result = true;
+
+        result = result && NeuralAddVectorMultipliedByValueDataTest(create, DH, EPS, FUNC_AVMV(SimdNeuralAddVectorMultipliedByValue));
+
+        return result;
+    }
+
+	bool NeuralActivateFunctionDataTest(bool create, int size, float error, bool relative, float slope, const FuncAF & f)
+	{
+		bool result = true;
+
+		Data data(f.description);
+
+		TEST_LOG_SS(Info, (create ? "Create" : "Verify") << " test " << f.description << " [" << size << "].");
 
 		View src(size, 1, View::Float, NULL, TEST_ALIGN(size));
 		View dst1(size, 1, View::Float, NULL, TEST_ALIGN(size));
@@ -1522,12 +2140,77 @@ namespace Test
     {
         bool result = true;
 
-        result = result && NeuralUpdateWeightsDataTest(create, DH, EPS, true, FUNC_UW(SimdNeuralUpdateWeights));
+        result = result && NeuralUpdateWeightsDataTest(create, DH, EPS, true, FUNC_UW(SimdNeuralUpdateWeights));
+
+        return result;
+    }
+
+    bool NeuralAdaptiveGradientUpdateDataTest(bool create, int size, float error, bool relative, const FuncAGU & f)
+    {
+        bool result = true;
+
+        Data data(f.description);
+
+        TEST_LOG_SS(Info, (create ? "Create" : "Verify") << " test " << f.description << " [" << size << "].");
+
+        View delta(size, 1, View::Float, NULL, TEST_ALIGN(size));
+        View gradientSrc(size, 1, View::Float, NULL, TEST_ALIGN(size));
+        View weightSrc(size, 1, View::Float, NULL, TEST_ALIGN(size));
+
+        const size_t batch = 64;
+        const float alpha = 0.01f, epsilon = 0.0001f;
+
+        View gradientDst1(size, 1, View::Float, NULL, TEST_ALIGN(size));
+        View weightDst1(size, 1, View::Float, NULL, TEST_ALIGN(size));
+        View gradientDst2(size, 1, View::Float, NULL, TEST_ALIGN(size));
+        View weightDst2(size, 1, View::Float, NULL, TEST_ALIGN(size));
+
+        if (create)
+        {
+            FillRandom32f(delta, -1.0f, 1.0f);
+            FillRandom32f(gradientSrc, 0.0f, 1.0f);
+            FillRandom32f(weightSrc, -1.0f, 1.0f);
+
+            TEST_SAVE(delta);
+            TEST_SAVE(gradientSrc);
+            TEST_SAVE(weightSrc);
+
+            TEST_EXECUTE_AT_LEAST_MIN_TIME(f.Call(delta, batch, alpha, epsilon, gradientSrc, weightSrc, gradientDst1, weightDst1));
+
+            TEST_SAVE(gradientDst1);
+            TEST_SAVE(weightDst1);
+        }
+        else
+        {
+            TEST_LOAD(delta);
+            TEST_LOAD(gradientSrc);
+            TEST_LOAD(weightSrc);
+
+            TEST_LOAD(gradientDst1);
+            TEST_LOAD(weightDst1);
+
+            TEST_EXECUTE_AT_LEAST_MIN_TIME(f.Call(delta, batch, alpha, epsilon, gradientSrc, weightSrc, gradientDst2, weightDst2));
+
+            TEST_SAVE(gradientDst2);
+            TEST_SAVE(weightDst2);
+
+            result = Compare(gradientDst1, gradientDst2, error, true, 32, relative);
+            result = Compare(weightDst1, weightDst2, error, true, 32, relative);
+        }
+
+        return result;
+    }
+
+    bool NeuralAdaptiveGradientUpdateDataTest(bool create)
+    {
+        bool result = true;
+
+        result = result && NeuralAdaptiveGradientUpdateDataTest(create, DH, EPS, true, FUNC_AGU(SimdNeuralAdaptiveGradientUpdate));
 
         return result;
     }
 
-    bool NeuralAdaptiveGradientUpdateDataTest(bool create, int size, float error, bool relative, const FuncAGU & f)
+    bool NeuralAdamUpdateDataTest(bool create, int size, float error, bool relative, const FuncAU & f)
     {
         bool result = true;
 
@@ -1536,58 +2219,68 @@ namespace Test
         TEST_LOG_SS(Info, (create ? "Create" : "Verify") << " test " << f.description << " [" << size << "].");
 
         View delta(size, 1, View::Float, NULL, TEST_ALIGN(size));
-        View gradientSrc(size, 1, View::Float, NULL, TEST_ALIGN(size));
+        View moment1Src(size, 1, View::Float, NULL, TEST_ALIGN(size));
+        View moment2Src(size, 1, View::Float, NULL, TEST_ALIGN(size));
         View weightSrc(size, 1, View::Float, NULL, TEST_ALIGN(size));
 
         const size_t batch = 64;
-        const float alpha = 0.01f, epsilon = 0.0001f;
+        const float alpha = 0.001f, beta1 = 0.9f, beta2 = 0.999f, epsilon = 0.0001f, decay = 0.0001f;
 
-        View gradientDst1(size, 1, View::Float, NULL, TEST_ALIGN(size));
+        View moment1Dst1(size, 1, View::Float, NULL, TEST_ALIGN(size));
+        View moment2Dst1(size, 1, View::Float, NULL, TEST_ALIGN(size));
         View weightDst1(size, 1, View::Float, NULL, TEST_ALIGN(size));
-        View gradientDst2(size, 1, View::Float, NULL, TEST_ALIGN(size));
+        View moment1Dst2(size, 1, View::Float, NULL, TEST_ALIGN(size));
+        View moment2Dst2(size, 1, View::Float, NULL, TEST_ALIGN(size));
         View weightDst2(size, 1, View::Float, NULL, TEST_ALIGN(size));
 
         if (create)
         {
             FillRandom32f(delta, -1.0f, 1.0f);
-            FillRandom32f(gradientSrc, 0.0f, 1.0f);
+            FillRandom32f(moment1Src, -0.1f, 0.1f);
+            FillRandom32f(moment2Src, 0.0f, 0.01f);
             FillRandom32f(weightSrc, -1.0f, 1.0f);
 
             TEST_SAVE(delta);
-            TEST_SAVE(gradientSrc);
+            TEST_SAVE(moment1Src);
+            TEST_SAVE(moment2Src);
             TEST_SAVE(weightSrc);
 
-            TEST_EXECUTE_AT_LEAST_MIN_TIME(f.Call(delta, batch, alpha, epsilon, gradientSrc, weightSrc, gradientDst1, weightDst1));
+            TEST_EXECUTE_AT_LEAST_MIN_TIME(f.Call(delta, batch, alpha, beta1, beta2, epsilon, decay, moment1Src, moment2Src, weightSrc, moment1Dst1, moment2Dst1, weightDst1));
 
-            TEST_SAVE(gradientDst1);
+            TEST_SAVE(moment1Dst1);
+            TEST_SAVE(moment2Dst1);
             TEST_SAVE(weightDst1);
         }
         else
         {
             TEST_LOAD(delta);
-            TEST_LOAD(gradientSrc);
+            TEST_LOAD(moment1Src);
+            TEST_LOAD(moment2Src);
             TEST_LOAD(weightSrc);
 
-            TEST_LOAD(gradientDst1);
+            TEST_LOAD(moment1Dst1);
+            TEST_LOAD(moment2Dst1);
             TEST_LOAD(weightDst1);
 
-            TEST_EXECUTE_AT_LEAST_MIN_TIME(f.Call(delta, batch, alpha, epsilon, gradientSrc, weightSrc, gradientDst2, weightDst2));
+            TEST_EXECUTE_AT_LEAST_MIN_TIME(f.Call(delta, batch, alpha, beta1, beta2, epsilon, decay, moment1Src, moment2Src, weightSrc, moment1Dst2, moment2Dst2, weightDst2));
 
-            TEST_SAVE(gradientDst2);
+            TEST_SAVE(moment1Dst2);
+            TEST_SAVE(moment2Dst2);
             TEST_SAVE(weightDst2);
 
-            result = Compare(gradientDst1, gradientDst2, error, true, 32, relative);
-            result = Compare(weightDst1, weightDst2, error, true, 32, relative);
+            result = result && Compare(moment1Dst1, moment1Dst2, error, true, 32, relative, "moment1");
+            result = result && Compare(moment2Dst1, moment2Dst2, error, true, 32, relative, "moment2");
+            result = result && Compare(weightDst1, weightDst2, error, true, 32, relative, "weight");
         }
 
         return result;
     }
 
-    bool NeuralAdaptiveGradientUpdateDataTest(bool create)
+    bool NeuralAdamUpdateDataTest(bool create)
     {
         bool result = true;
 
-        result = result && NeuralAdaptiveGradientUpdateDataTest(create, DH, EPS, true, FUNC_AGU(SimdNeuralAdaptiveGradientUpdate));
+        result = result && NeuralAdamUpdateDataTest(create, DH, EPS, true, FUNC_AU(SimdNeuralAdamUpdate));
 
         return result;
     }
@@ -1770,23 +2463,408 @@ namespace Test
         {
             TEST_LOAD(src);
 
-            TEST_LOAD(dst1);
+            TEST_LOAD(dst1);
+
+            TEST_EXECUTE_AT_LEAST_MIN_TIME(f.Call(src, dst2));
+
+            TEST_SAVE(dst2);
+
+            result = Compare(dst1, dst2, eps, true, 32);
+        }
+
+        return result;
+    }
+
+    bool NeuralMax2x2DataTest(bool create)
+    {
+        bool result = true;
+
+        result = result && NeuralMax2x2DataTest(create, DW, DH, EPS, FUNC_M(SimdNeuralMax2x2));
+
+        return result;
+    }
+
+    bool NeuralConvolutionForwardDataTest(bool create, const ConvParam & p, float eps, const FuncCF & f)
+    {
+        bool result = true;
+
+        Data data(f.description);
+
+        TEST_LOG_SS(Info, (create ? "Create" : "Verify") << " test " << f.description << " " << p.Description() << ".");
+
+        int srcSize = p.srcW*p.srcH*p.srcD, dstSize = p.dstW*p.dstH*p.dstD, weightSize = p.kernel*p.kernel*p.srcD*p.dstD;
+        if (f.backward)
+            std::swap(srcSize, dstSize);
+
+        View src(srcSize, 1, View::Float, NULL, TEST_ALIGN(srcSize));
+        View weight(weightSize, 1, View::Float, NULL, TEST_ALIGN(weightSize));
+        View dst1(dstSize, 1, View::Float, NULL, TEST_ALIGN(dstSize));
+        View dst2(dstSize, 1, View::Float, NULL, TEST_ALIGN(dstSize));
+        Simd::Fill(dst1, 0);
+        Simd::Fill(dst2, 0);
+
+        if (create)
+        {
+            FillRandom32f(src, -1, 1);
+            FillRandom32f(weight, -1, 1);
+
+            TEST_SAVE(src);
+            TEST_SAVE(weight);
+
+            f.Call(p, src, weight, dst1);
+
+            TEST_SAVE(dst1);
+        }
+        else
+        {
+            TEST_LOAD(src);
+            TEST_LOAD(weight);
+
+            TEST_LOAD(dst1);
+
+            f.Call(p, src, weight, dst2);
+
+            TEST_SAVE(dst2);
+
+            result = Compare(dst1, dst2, eps, true, 32, false);
+        }
+
+        return result;
+    }
+
+    bool NeuralConvolutionForwardDataTest(bool create)
+    {
+        bool result = true;
+
+        result = result && NeuralConvolutionForwardDataTest(create, ConvParam(DW / 9, DH / 9, 8, 8, 3, 1, 2, 1), EPS, FUNC_CF(SimdNeuralConvolutionForward, false));
+
+        return result;
+    }
+
+    bool NeuralConvolutionBackwardDataTest(bool create)
+    {
+        bool result = true;
+
+        result = result && NeuralConvolutionForwardDataTest(create, ConvParam(DW / 9, DH / 9, 8, 8, 3, 1, 2, 1), EPS, FUNC_CF(SimdNeuralConvolutionBackward, true));
+
+        return result;
+    }
+
+    bool NeuralConvolutionSumDataTest(bool create, const ConvParam & p, float eps, const FuncCS2 & f)
+    {
+        bool result = true;
+
+        Data data(f.description);
+
+        TEST_LOG_SS(Info, (create ? "Create" : "Verify") << " test " << f.description << " " << p.Description() << ".");
+
+        int srcSize = p.srcW*p.srcH*p.srcD, dstSize = p.dstW*p.dstH*p.dstD, weightSize = p.kernel*p.kernel*p.srcD*p.dstD;
+
+        View src(srcSize, 1, View::Float, NULL, TEST_ALIGN(srcSize));
+        View dst(dstSize, 1, View::Float, NULL, TEST_ALIGN(dstSize));
+        View sums1(weightSize, 1, View::Float, NULL, TEST_ALIGN(weightSize));
+        View sums2(weightSize, 1, View::Float, NULL, TEST_ALIGN(weightSize));
+        Simd::Fill(sums1, 0);
+        Simd::Fill(sums2, 0);
+
+        if (create)
+        {
+            FillRandom32f(src, -1, 1);
+            FillRandom32f(dst, -1, 1);
+
+            TEST_SAVE(src);
+            TEST_SAVE(dst);
+
+            f.Call(p, src, dst, sums1);
+
+            TEST_SAVE(sums1);
+        }
+        else
+        {
+            TEST_LOAD(src);
+            TEST_LOAD(dst);
+
+            TEST_LOAD(sums1);
+
+            f.Call(p, src, dst, sums2);
+
+            TEST_SAVE(sums2);
+
+            result = Compare(sums1, sums2, eps, true, 32, false);
+        }
+
+        return result;
+    }
+
+    bool NeuralConvolutionSumDataTest(bool create)
+    {
+        bool result = true;
+
+        result = result && NeuralConvolutionSumDataTest(create, ConvParam(DW / 15, DH / 15, 8, 8, 3, 1, 2, 1), EPS, FUNC_CS2(SimdNeuralConvolutionSum));
+
+        return result;
+    }
+
+    bool NeuralWinograd2x2p3x3SetInputDataTest(bool create, const ConvParam & p, float eps, const FuncWI & f)
+    {
+        bool result = true;
+
+        Data data(f.description);
+
+        TEST_LOG_SS(Info, (create ? "Create" : "Verify") << " test " << f.description << " " << p.Description() << ".");
+
+        int srcSize = p.srcW*p.srcH*p.srcD, dstSize = 16 * p.srcD*((p.dstW + 1) / 2)*((p.dstH + 1) / 2);
+
+        View src(srcSize, 1, View::Float, NULL, TEST_ALIGN(srcSize));
+        View dst1(dstSize, 1, View::Float, NULL, TEST_ALIGN(dstSize));
+        View dst2(dstSize, 1, View::Float, NULL, TEST_ALIGN(dstSize));
+
+        if (create)
+        {
+            FillRandom32f(src, -1, 1);
+
+            TEST_SAVE(src);
+
+            f.Call(p, src, dst1);
+
+            TEST_SAVE(dst1);
+        }
+        else
+        {
+            TEST_LOAD(src);
+
+            TEST_LOAD(dst1);
+
+            f.Call(p, src, dst2);
+
+            TEST_SAVE(dst2);
+
+            result = Compare(dst1, dst2, eps, true, 32, false);
+        }
+
+        return result;
+    }
+
+    bool NeuralWinograd2x2p3x3SetInputDataTest(bool create)
+    {
+        bool result = true;
+
+        result = result && NeuralWinograd2x2p3x3SetInputDataTest(create, ConvParam(DW / 2 + 1, DH / 2 - 1, 4, 4, 3, 0, 1, 1), EPS, FUNC_WI(SimdNeuralWinograd2x2p3x3SetInput));
+
+        return result;
+    }
+
+    bool NeuralWinograd2x2p3x3SetOutputDataTest(bool create, const ConvParam & p, float eps, const FuncWO & f)
+    {
+        bool result = true;
+
+        Data data(f.description);
+
+        TEST_LOG_SS(Info, (create ? "Create" : "Verify") << " test " << f.description << " " << p.Description() << ".");
+
+        int srcSize = 16 * p.dstD*((p.dstW + 1) / 2)*((p.dstH + 1) / 2), dstSize = p.dstW*p.dstH*p.dstD;
+
+        View src(srcSize, 1, View::Float, NULL, TEST_ALIGN(srcSize));
+        View dst1(dstSize, 1, View::Float, NULL, TEST_ALIGN(dstSize));
+        View dst2(dstSize, 1, View::Float, NULL, TEST_ALIGN(dstSize));
+
+        if (create)
+        {
+            FillRandom32f(src, -1, 1);
+
+            TEST_SAVE(src);
+
+            f.Call(p, src, dst1);
+
+            TEST_SAVE(dst1);
+        }
+        else
+        {
+            TEST_LOAD(src);
+
+            TEST_LOAD(dst1);
+
+            f.Call(p, src, dst2);
+
+            TEST_SAVE(dst2);
+
+            result = Compare(dst1, dst2, eps, true, 32, false);
+        }
+
+        return result;
+    }
+
+    bool NeuralWinograd2x2p3x3SetOutputDataTest(bool create)
+    {
+        bool result = true;
+
+        result = result && NeuralWinograd2x2p3x3SetOutputDataTest(create, ConvParam(DW / 2 + 1, DH / 2 - 1, 4, 4, 3, 0, 1, 1), EPS, FUNC_WO(SimdNeuralWinograd2x2p3x3SetOutput));
+
+        return result;
+    }
+
+    bool NeuralQuantize8uDataTest(bool create, int size, const FuncQ & f)
+    {
+        bool result = true;
+
+        Data data(f.description);
+
+        TEST_LOG_SS(Info, (create ? "Create" : "Verify") << " test " << f.description << " [" << size << "].");
+
+        View src(size, 1, View::Float, NULL, TEST_ALIGN(size));
+        View dst1(size, 1, View::Gray8, NULL, TEST_ALIGN(size));
+        View dst2(size, 1, View::Gray8, NULL, TEST_ALIGN(size));
+
+        const float scale = 150.0f, shift = 127.0f;
+
+        if (create)
+        {
+            FillRandom32f(src, -1.0f, 1.0f);
+
+            TEST_SAVE(src);
+
+            f.Call(src, scale, shift, dst1);
+
+            TEST_SAVE(dst1);
+        }
+        else
+        {
+            TEST_LOAD(src);
+
+            TEST_LOAD(dst1);
+
+            f.Call(src, scale, shift, dst2);
+
+            TEST_SAVE(dst2);
+
+            result = result && Compare(dst1, dst2, 0, true, 32);
+        }
+
+        return result;
+    }
+
+    bool NeuralQuantize8uDataTest(bool create)
+    {
+        bool result = true;
+
+        result = result && NeuralQuantize8uDataTest(create, DW*DH, FUNC_Q(SimdNeuralQuantize8u));
+
+        return result;
+    }
+
+    bool NeuralProductSum8u8iDataTest(bool create, int size, int count, const FuncPS8 & f)
+    {
+        bool result = true;
+
+        Data data(f.description);
+
+        TEST_LOG_SS(Info, (create ? "Create" : "Verify") << " test " << f.description << " [" << size << ", " << count << "].");
+
+        View src(size, 1, View::Gray8, NULL, TEST_ALIGN(size));
+        View weight(size*count, 1, View::Gray8, NULL, TEST_ALIGN(size*count));
+        View sums1(count, 1, View::Int32, NULL, TEST_ALIGN(count));
+        View sums2(count, 1, View::Int32, NULL, TEST_ALIGN(count));
+
+        if (create)
+        {
+            FillRandom(src);
+            FillRandomWeight8i(weight);
+
+            TEST_SAVE(src);
+            TEST_SAVE(weight);
+
+            f.Call(src, weight, sums1);
+
+            TEST_SAVE(sums1);
+        }
+        else
+        {
+            TEST_LOAD(src);
+            TEST_LOAD(weight);
+
+            TEST_LOAD(sums1);
 
-            TEST_EXECUTE_AT_LEAST_MIN_TIME(f.Call(src, dst2));
+            f.Call(src, weight, sums2);
 
-            TEST_SAVE(dst2);
+            TEST_SAVE(sums2);
 
-            result = Compare(dst1, dst2, eps, true, 32);
+            result = result && Compare(sums1, sums2, 0, true, 32);
         }
 
         return result;
     }
 
-    bool NeuralMax2x2DataTest(bool create)
+    bool NeuralProductSum8u8iDataTest(bool create)
     {
         bool result = true;
 
-        result = result && NeuralMax2x2DataTest(create, DW, DH, EPS, FUNC_M(SimdNeuralMax2x2));
+        result = result && NeuralProductSum8u8iDataTest(create, DW + O, DH / 4 + 1, FUNC_PS8(SimdNeuralProductSum8u8i));
+
+        return result;
+    }
+
+    //-----------------------------------------------------------------------
+
+    /*
+    * Compares 3x3 convolution with using of Winograd F(2x2, 3x3) transform (Simd::Neural::ConvolutionalLayer uses it in Layer::Fast mode)
+    * and direct 3x3 convolution (::SimdNeuralAddConvolution3x3). The transform changes order of floating point operations. 
+    * Measured difference (maximal absolute difference divided by maximal absolute output value) is about 2e-7 - 1e-6 for random 
+    * weights and inputs in range [-1, 1]. It grows slowly with number of input channels.
+    */
+    bool NeuralConvolutionWinogradSpecialTest(const ConvParam & p)
+    {
+        typedef std::vector<float> Buffer;
+        size_t srcArea = p.srcW*p.srcH, dstArea = p.dstW*p.dstH, tiles = ((p.dstW + 1) / 2)*((p.dstH + 1) / 2);
+        Buffer src(srcArea*p.srcD), weight(9 * p.srcD*p.dstD), direct(dstArea*p.dstD, 0), winograd(dstArea*p.dstD);
+        Buffer filter(16 * p.srcD*p.dstD), input(16 * p.srcD*tiles), output(16 * p.dstD*tiles);
+        for (size_t i = 0; i < src.size(); ++i)
+            src[i] = float(Random() * 2.0 - 1.0);
+        for (size_t i = 0; i < weight.size(); ++i)
+            weight[i] = float(Random() * 2.0 - 1.0);
+
+        double time = GetTime();
+        for (int dc = 0; dc < p.dstD; ++dc)
+            for (int sc = 0; sc < p.srcD; ++sc)
+                SimdNeuralAddConvolution3x3(src.data() + sc*srcArea, p.srcW, p.dstW, p.dstH, weight.data() + (dc*p.srcD + sc) * 9, direct.data() + dc*dstArea, p.dstW);
+        double directTime = GetTime() - time;
+
+        SimdNeuralWinograd2x2p3x3SetFilter(weight.data(), p.srcD*p.dstD, filter.data());
+        const float alpha = 1.0f, beta = 0.0f;
+        time = GetTime();
+        SimdNeuralWinograd2x2p3x3SetInput(src.data(), p.srcW, p.srcH, p.srcD, input.data());
+        for (size_t i = 0; i < 16; ++i)
+            SimdGemm32fNN(p.dstD, tiles, p.srcD, &alpha, filter.data() + i*p.dstD*p.srcD, p.srcD, input.data() + i*p.srcD*tiles, tiles, 
+                &beta, output.data() + i*p.dstD*tiles, tiles);
+        SimdNeuralWinograd2x2p3x3SetOutput(output.data(), winograd.data(), p.dstW, p.dstH, p.dstD);
+        double winogradTime = GetTime() - time;
+
+        double maxValue = 0, maxDelta = 0;
+        for (size_t i = 0; i < direct.size(); ++i)
+        {
+            maxValue = std::max(maxValue, (double)::fabs(direct[i]));
+            maxDelta = std::max(maxDelta, (double)::fabs(direct[i] - winograd[i]));
+        }
+        double delta = maxDelta / maxValue;
+
+        TEST_LOG_SS(Info, p.Description() << std::scientific << std::setprecision(2) << " difference = " << delta << std::fixed 
+            << " ; time (ms) : direct = " << directTime*1000.0 << " ; Winograd = " << winogradTime*1000.0 << ".");
+
+        if (delta > EPS*0.01f)
+        {
+            TEST_LOG_SS(Error, "Difference of Winograd and direct convolutions is too big!");
+            return false;
+        }
+        return true;
+    }
+
+    bool NeuralConvolutionWinogradSpecialTest()
+    {
+        bool result = true;
+
+        result = result && NeuralConvolutionWinogradSpecialTest(ConvParam(6, 6, 12, 24, 3, 0, 1, 1));
+        result = result && NeuralConvolutionWinogradSpecialTest(ConvParam(64, 48, 16, 16, 3, 0, 1, 1));
+        result = result && NeuralConvolutionWinogradSpecialTest(ConvParam(129, 95, 32, 32, 3, 0, 1, 1));
+        result = result && NeuralConvolutionWinogradSpecialTest(ConvParam(34, 34, 256, 64, 3, 0, 1, 1));
 
         return result;
     }
@@ -1850,7 +2928,7 @@ namespace Test
         }
     };
 
-    Error Check(Network & net, const TrainSample & sample, float politive, bool train)
+    Error Check(Network & net, const TrainSample & sample, float politive, Simd::Neural::Layer::Method method)
     {
         double sum = 0;
         size_t count = 0, size = net.OutputIndex().Volume();
@@ -1859,7 +2937,7 @@ namespace Test
             const Vector & dst = sample.dst[i];
             Label lbl = sample.lbl[i];
 
-            Vector cur = net.Predict(sample.src[i], train ? Simd::Neural::Layer::Check : Simd::Neural::Layer::Fast);
+            Vector cur = net.Predict(sample.src[i], method);
 
             float difference = 0;
             for (size_t j = 0; j < size; ++j)
@@ -1892,22 +2970,21 @@ namespace Test
 
     struct Logger
     {
-        void operator() ()
+        void operator() (size_t epoch, double speed)
         {
             if (_network && _data && _options)
             {
-                if (_current%_options->logEvery == 0)
+                if (epoch%_options->logEvery == 0)
                 {
-                    Error train = Check(*_network, _data->train, _options->threshold, true);
-                    Error check = Check(*_network, _data->check, _options->threshold, true);
-                    TEST_LOG_SS(Info, std::setprecision(6) << std::fixed << "Epoch " << _current
+                    Error train = Check(*_network, _data->train, _options->threshold, Simd::Neural::Layer::Check);
+                    Error check = Check(*_network, _data->check, _options->threshold, Simd::Neural::Layer::Check);
+                    TEST_LOG_SS(Info, std::setprecision(6) << std::fixed << "Epoch " << epoch
                         << ": train (value = " << train.first << " ; count = " << train.second << ")"
-                        << ", check (value = " << check.first << " ; count = " << check.second << ").");
+                        << ", check (value = " << check.first << " ; count = " << check.second << ")"
+                        << ", speed = " << std::setprecision(0) << speed << " samples/s.");
                 }
                 else
-                    std::cout << "Epoch " << _current << "\r";
-
-                _current++;
+                    std::cout << "Epoch " << epoch << "\r";
             }
         }
 
@@ -1915,12 +2992,10 @@ namespace Test
             : _network(network)
             , _data(data)
             , _options(options)
-            , _current(options ? options->epochStart : 0)
         {
         }
 
     private:
-        size_t _current;
         Network * _network;
         TrainOptions * _options;
         TrainData *_data;
@@ -2001,9 +3076,82 @@ namespace Test
         if (!LoadDigits(net, true, sample))
             return false;
 
-        Error error = Check(net, sample, 0.5, false);
+        Error error = Check(net, sample, 0.5, Simd::Neural::Layer::Fast);
         TEST_LOG_SS(Info, std::setprecision(6) << "Predict error : (value = " << error.first << " ; count = " << error.second << ")." << std::endl);
 
+        double time = GetTime();
+        Vectors single(sample.src.size());
+        for (size_t i = 0; i < sample.src.size(); ++i)
+            single[i] = net.Predict(sample.src[i]);
+        double singleTime = GetTime() - time;
+
+        Vectors batch;
+        time = GetTime();
+        net.Predict(sample.src, batch, 1);
+        double batchTime = GetTime() - time;
+
+        size_t threadNumber = std::thread::hardware_concurrency();
+        time = GetTime();
+        net.Predict(sample.src, batch, threadNumber);
+        double parallelTime = GetTime() - time;
+
+        size_t size = net.OutputIndex().Volume();
+        for (size_t i = 0; i < single.size(); ++i)
+        {
+            for (size_t j = 0; j < size; ++j)
+            {
+                if (::fabs(single[i][j] - batch[i][j]) > EPS)
+                {
+                    TEST_LOG_SS(Error, "Single and batch predictions are different for sample " << i << " : " << single[i][j] << " != " << batch[i][j] << " !");
+                    return false;
+                }
+            }
+        }
+
+        // Batch and single predictions use different layouts of weights of fully connected layers, both have to be kept unchanged.
+        for (size_t i = 0; i < single.size(); ++i)
+        {
+            const Vector & again = net.Predict(sample.src[i]);
+            for (size_t j = 0; j < size; ++j)
+            {
+                if (again[j] != single[i][j])
+                {
+                    TEST_LOG_SS(Error, "Single prediction is changed after batch prediction for sample " << i << " : " << again[j] << " != " << single[i][j] << " !");
+                    return false;
+                }
+            }
+        }
+
+        double count = (double)sample.src.size();
+        TEST_LOG_SS(Info, std::setprecision(0) << std::fixed << "Predict speed (samples/s) : single = " << count / singleTime 
+            << " ; batch = " << count / batchTime << " ; batch in " << threadNumber << " threads = " << count / parallelTime << "." << std::endl);
+
+        Vectors calibration(sample.src.begin(), sample.src.begin() + std::min<size_t>(sample.src.size(), 256));
+        if (!net.Quantize(calibration))
+        {
+            TEST_LOG_SS(Error, "Can't quantize Simd::Neural::Network!");
+            return false;
+        }
+
+        time = GetTime();
+        Vectors int8(sample.src.size());
+        for (size_t i = 0; i < sample.src.size(); ++i)
+            int8[i] = net.Predict(sample.src[i], Simd::Neural::Layer::Int8);
+        double int8Time = GetTime() - time;
+
+        float difference = 0;
+        for (size_t i = 0; i < single.size(); ++i)
+            for (size_t j = 0; j < size; ++j)
+                difference = std::max(difference, ::fabs(single[i][j] - int8[i][j]));
+        Error int8Error = Check(net, sample, 0.5, Simd::Neural::Layer::Int8);
+        TEST_LOG_SS(Info, std::setprecision(0) << std::fixed << "Predict speed (samples/s) : int8 = " << count / int8Time << " ; " << std::setprecision(6)
+            << "int8 error : (value = " << int8Error.first << " ; count = " << int8Error.second << " ; max difference = " << difference << ")." << std::endl);
+        if (int8Error.second > error.second + 0.01)
+        {
+            TEST_LOG_SS(Error, "Int8 prediction error is greater than float prediction error by more than 1%!");
+            return false;
+        }
+
 #ifdef TEST_PERFORMANCE_TEST_ENABLE
         TEST_LOG_SS(Info, PerformanceMeasurerStorage::s_storage.Report(false, true));
         PerformanceMeasurerStorage::s_storage.Clear();
@@ -2012,6 +3160,352 @@ namespace Test
         return true;
     }
 
+    bool NeuralBinarySpecialTest(Network & net, const TrainSample & sample, const Vectors & control, const String & path, bool half)
+    {
+        if (!net.SaveBinary(path, half))
+        {
+            TEST_LOG_SS(Error, "Can't save Simd::Neural::Network to binary file '" << path << "'!");
+            return false;
+        }
+
+        Network binary;
+        CreateNetwork(binary, false);
+        double time = GetTime();
+        if (!binary.LoadBinary(path))
+        {
+            TEST_LOG_SS(Error, "Can't load Simd::Neural::Network from binary file '" << path << "'!");
+            return false;
+        }
+        time = GetTime() - time;
+
+        float difference = 0, eps = half ? 0.01f : 0.0f;
+        for (size_t i = 0; i < sample.src.size(); ++i)
+        {
+            const Vector & dst = binary.Predict(sample.src[i]);
+            for (size_t j = 0; j < dst.size(); ++j)
+                difference = std::max(difference, ::fabs(dst[j] - control[i][j]));
+        }
+        TEST_LOG_SS(Info, std::setprecision(3) << std::fixed << "LoadBinary(" << (half ? "16" : "32") << "-bit) : " << time * 1000 << " ms ; max difference = " 
+            << std::setprecision(6) << difference << "." << std::endl);
+        if (difference > eps)
+        {
+            TEST_LOG_SS(Error, "Predictions of network loaded from binary file '" << path << "' are different: " << difference << " > " << eps << " !");
+            return false;
+        }
+
+        // 32-bit weights of all layers have to refer to the memory mapped file, 16-bit weights are copied.
+        size_t mappedSize = 0;
+        const uint8_t * mapped = (const uint8_t*)binary.Mapped(mappedSize);
+        if ((mapped == NULL) != half)
+        {
+            TEST_LOG_SS(Error, "Network loaded from binary file '" << path << "' has wrong memory mapping!");
+            return false;
+        }
+        for (size_t i = 0; i < binary.Layers().size() && mapped; ++i)
+        {
+            const uint8_t * weight = (const uint8_t*)binary.Layers()[i]->Weight();
+            if (weight && (weight < mapped || weight >= mapped + mappedSize))
+            {
+                TEST_LOG_SS(Error, "Weights of layer " << i << " don't refer to memory mapped binary file '" << path << "'!");
+                return false;
+            }
+        }
+
+        if (!half)
+        {
+            String text = path + ".txt";
+            std::stringstream original, loaded;
+            net.Save(text);
+            original << std::ifstream(text.c_str()).rdbuf();
+            binary.Save(text);
+            loaded << std::ifstream(text.c_str()).rdbuf();
+            if (original.str() != loaded.str())
+            {
+                TEST_LOG_SS(Error, "Network loaded from binary file '" << path << "' is saved to text file incorrectly!");
+                return false;
+            }
+        }
+
+        Vectors batch;
+        binary.Predict(sample.src, batch, 1);
+        for (size_t i = 0; i < batch.size(); ++i)
+        {
+            for (size_t j = 0; j < batch[i].size(); ++j)
+            {
+                if (::fabs(batch[i][j] - control[i][j]) > eps + EPS)
+                {
+                    TEST_LOG_SS(Error, "Batch predictions of network loaded from binary file '" << path << "' are different!");
+                    return false;
+                }
+            }
+        }
+
+        // A blob with offset + count*itemSize beyond 64-bit range has to be rejected.
+        std::ifstream ifs(path.c_str(), std::ifstream::binary);
+        std::vector<uint8_t> buffer((std::istreambuf_iterator<char>(ifs)), std::istreambuf_iterator<char>());
+        typedef Simd::Neural::Detail::Binary::Header Header;
+        typedef Simd::Neural::Detail::Binary::LayerHeader LayerHeader;
+        LayerHeader * layer = (LayerHeader*)(buffer.data() + sizeof(Header));
+        layer->weightOffset = ~uint64_t(Simd::Neural::Detail::Binary::ALIGN - 1);
+        if (binary.LoadBinary(buffer.data(), buffer.size()))
+        {
+            TEST_LOG_SS(Error, "Binary data with invalid weight offset is not rejected!");
+            return false;
+        }
+        return true;
+    }
+
+    bool NeuralBinarySpecialTest()
+    {
+        Network net;
+        CreateNetwork(net, false);
+
+        String path = ROOT_PATH + "/data/network/digit.txt";
+        double time = GetTime();
+        if (!net.Load(path))
+        {
+            TEST_LOG_SS(Error, "Can't load Simd::Neural::Network from file '" << path << "'!");
+            return false;
+        }
+        TEST_LOG_SS(Info, std::setprecision(3) << std::fixed << "Load : " << (GetTime() - time) * 1000 << " ms." << std::endl);
+
+        TrainSample sample;
+        if (!LoadDigits(net, true, sample))
+            return false;
+
+        Vectors control(sample.src.size());
+        for (size_t i = 0; i < sample.src.size(); ++i)
+            control[i] = net.Predict(sample.src[i]);
+
+        bool result = true;
+
+        result = result && NeuralBinarySpecialTest(net, sample, control, "digit.bin", false);
+        result = result && NeuralBinarySpecialTest(net, sample, control, "digit_16.bin", true);
+
+        return result;
+    }
+
+    const size_t DW_SIZE = 32, DW_SRC_DEPTH = 32, DW_DST_DEPTH = 64;
+
+    enum DepthwiseBlock
+    {
+        DepthwiseBlockDense, // ConvolutionalLayer.
+        DepthwiseBlockSeparable, // DepthwiseConvolutionalLayer and following pointwise (1x1) ConvolutionalLayer.
+        DepthwiseBlockDepthwise, // DepthwiseConvolutionalLayer (dstDepth is equal to srcDepth).
+        DepthwiseBlockDiagonal, // ConvolutionalLayer with diagonal connection table: it is equal to DepthwiseConvolutionalLayer.
+    };
+
+    /*
+    * Creates network: [3x3 convolution from stem channels] -> tested block (srcDepth -> dstDepth) -> [2x2 max pooling] -> fully connected layer.
+    * The first convolution is skipped if stem is equal to 0, max pooling is skipped if pooling is false.
+    */
+    void CreateDepthwiseNetwork(Network & net, DepthwiseBlock block, size_t size, size_t stem, size_t srcDepth, size_t dstDepth,
+        size_t core, bool valid, bool pooling, size_t outputs)
+    {
+        using namespace Simd::Neural;
+
+        size_t out = valid ? size - core + 1 : size;
+        if (stem)
+            net.Add(new ConvolutionalLayer(Function::Relu, Size(size, size), stem, srcDepth, 3, false));
+        switch (block)
+        {
+        case DepthwiseBlockDense:
+            net.Add(new ConvolutionalLayer(Function::Relu, Size(size, size), srcDepth, dstDepth, core, valid));
+            break;
+        case DepthwiseBlockSeparable:
+            net.Add(new DepthwiseConvolutionalLayer(Function::Relu, Size(size, size), srcDepth, core, valid));
+            net.Add(new ConvolutionalLayer(Function::Relu, Size(out, out), srcDepth, dstDepth, 1));
+            break;
+        case DepthwiseBlockDepthwise:
+            assert(srcDepth == dstDepth);
+            net.Add(new DepthwiseConvolutionalLayer(Function::Relu, Size(size, size), srcDepth, core, valid));
+            break;
+        case DepthwiseBlockDiagonal:
+        {
+            assert(srcDepth == dstDepth);
+            View diagonal(dstDepth, srcDepth, View::Gray8);
+            Simd::Fill(diagonal, 0);
+            for (size_t c = 0; c < srcDepth; ++c)
+                diagonal.At<uint8_t>(c, c) = 1;
+            net.Add(new ConvolutionalLayer(Function::Relu, Size(size, size), srcDepth, dstDepth, core, valid, true, diagonal));
+            break;
+        }
+        }
+        if (pooling)
+        {
+            net.Add(new MaxPoolingLayer(Function::Identity, Size(out, out), dstDepth, 2));
+            out /= 2;
+        }
+        net.Add(new FullyConnectedLayer(Function::Identity, out*out*dstDepth, outputs));
+    }
+
+    bool NeuralDepthwiseSpecialTest(bool separable, const Vectors & src, double & time)
+    {
+        String desc = separable ? "Depthwise + pointwise" : "Dense";
+        DepthwiseBlock block = separable ? DepthwiseBlockSeparable : DepthwiseBlockDense;
+        Network net;
+        CreateDepthwiseNetwork(net, block, DW_SIZE, 0, DW_SRC_DEPTH, DW_DST_DEPTH, 3, false, true, 10);
+
+        TrainOptions options;
+        options.initType = TrainOptions::He;
+        net.InitWeight(options);
+
+        Vectors control(src.size());
+        time = GetTime();
+        for (size_t i = 0; i < src.size(); ++i)
+            control[i] = net.Predict(src[i]);
+        time = (GetTime() - time) / src.size();
+
+        Vectors batch;
+        net.Predict(src, batch, 1);
+        for (size_t i = 0; i < batch.size(); ++i)
+        {
+            for (size_t j = 0; j < batch[i].size(); ++j)
+            {
+                if (::fabs(batch[i][j] - control[i][j]) > EPS)
+                {
+                    TEST_LOG_SS(Error, desc << ": batch and single predictions are different!");
+                    return false;
+                }
+            }
+        }
+
+        String path = "depthwise.bin";
+        Network binary;
+        CreateDepthwiseNetwork(binary, block, DW_SIZE, 0, DW_SRC_DEPTH, DW_DST_DEPTH, 3, false, true, 10);
+        if (!net.SaveBinary(path) || !binary.LoadBinary(path))
+        {
+            TEST_LOG_SS(Error, desc << ": can't save or load binary file '" << path << "'!");
+            return false;
+        }
+        for (size_t i = 0; i < src.size(); ++i)
+        {
+            if (binary.Predict(src[i]) != control[i])
+            {
+                TEST_LOG_SS(Error, desc << ": predictions of network loaded from binary file '" << path << "' are different!");
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Copies weights of depthwise network to dense network with diagonal connection table (through memory stream).
+    static bool CopyDepthwiseWeights(const Network & depthwise, Network & dense, size_t depth, size_t area)
+    {
+        std::stringstream sd, sg;
+        if (!depthwise.Save(sd))
+            return false;
+        Vector wd, wg;
+        float value;
+        while (sd >> value)
+            wd.push_back(value);
+        const size_t first = 2 * depth * 9 + depth;
+        wg.assign(wd.begin(), wd.begin() + first);
+        for (size_t dc = 0; dc < depth; ++dc)
+            for (size_t sc = 0; sc < depth; ++sc)
+                for (size_t i = 0; i < area; ++i)
+                    wg.push_back(dc == sc ? wd[first + dc*area + i] : 0.0f);
+        wg.insert(wg.end(), wd.begin() + first + depth*area, wd.end());
+        sg.precision(std::numeric_limits<float>::max_digits10);
+        for (size_t i = 0; i < wg.size(); ++i)
+            sg << wg[i] << " ";
+        return dense.Load(sg);
+    }
+
+    static bool CompareDepthwiseWeights(size_t core, const String & name, const float * d, const float * g, size_t size)
+    {
+        for (size_t i = 0; i < size; ++i)
+        {
+            if (::fabs(d[i] - g[i]) > EPS)
+            {
+                TEST_LOG_SS(Error, "Core " << core << "x" << core << ": depthwise and dense " << name << " [" << i << "] are different after training: " << d[i] << " != " << g[i] << " !");
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /*
+    * Depthwise convolution is equal to dense convolution with diagonal connection table. Compares predictions and weights 
+    * after one epoch of training (so forward and backward propagation) of networks with DepthwiseConvolutionalLayer and such ConvolutionalLayer.
+    */
+    bool NeuralDepthwiseSpecialTest(size_t core, bool valid, const Vectors & src, const Vectors & dst)
+    {
+        const size_t size = 12, depth = 6, area = core*core, out = valid ? size - core + 1 : size;
+        Network depthwise, dense;
+        CreateDepthwiseNetwork(depthwise, DepthwiseBlockDepthwise, size, 2, depth, depth, core, valid, false, 4);
+        CreateDepthwiseNetwork(dense, DepthwiseBlockDiagonal, size, 2, depth, depth, core, valid, false, 4);
+
+        TrainOptions options;
+        options.initType = TrainOptions::He;
+        depthwise.InitWeight(options);
+        bool result = CopyDepthwiseWeights(depthwise, dense, depth, area);
+
+        for (size_t i = 0; i < src.size() && result; ++i)
+        {
+            const Vector & d = depthwise.Predict(src[i]), & g = dense.Predict(src[i]);
+            for (size_t j = 0; j < d.size() && result; ++j)
+            {
+                if (::fabs(d[j] - g[j]) > EPS)
+                {
+                    TEST_LOG_SS(Error, "Core " << core << "x" << core << ": depthwise and dense predictions are different: " << d[j] << " != " << g[j] << " !");
+                    result = false;
+                }
+            }
+        }
+
+        options.epochStart = 1;
+        options.epochFinish = 2;
+        options.batchSize = src.size();
+        options.threadNumber = 1;
+        options.updateType = TrainOptions::Momentum;
+        result = result && depthwise.Train(src, dst, options, [](size_t, double) {});
+        result = result && dense.Train(src, dst, options, [](size_t, double) {});
+
+        // Layers: input, first convolution, depthwise (or diagonal) convolution, fully connected.
+        const Simd::Neural::LayerPtrs & ld = depthwise.Layers(), & lg = dense.Layers();
+        result = result && CompareDepthwiseWeights(core, "first weights", ld[1]->Weight(), lg[1]->Weight(), depth * 2 * 9);
+        result = result && CompareDepthwiseWeights(core, "first biases", ld[1]->Bias(), lg[1]->Bias(), depth);
+        for (size_t c = 0; c < depth && result; ++c)
+            result = CompareDepthwiseWeights(core, "weights", ld[2]->Weight() + c*area, lg[2]->Weight() + (c*depth + c)*area, area);
+        result = result && CompareDepthwiseWeights(core, "biases", ld[2]->Bias(), lg[2]->Bias(), depth);
+        result = result && CompareDepthwiseWeights(core, "last weights", ld[3]->Weight(), lg[3]->Weight(), out*out*depth * 4);
+        result = result && CompareDepthwiseWeights(core, "last biases", ld[3]->Bias(), lg[3]->Bias(), 4);
+        return result;
+    }
+
+    bool NeuralDepthwiseSpecialTest()
+    {
+        Vectors src(64, Vector(DW_SIZE*DW_SIZE*DW_SRC_DEPTH));
+        for (size_t i = 0; i < src.size(); ++i)
+            for (size_t j = 0; j < src[i].size(); ++j)
+                src[i][j] = float(Random());
+
+        Vectors small(16, Vector(12 * 12 * 2)), dst(small.size(), Vector(4));
+        for (size_t i = 0; i < small.size(); ++i)
+        {
+            for (size_t j = 0; j < small[i].size(); ++j)
+                small[i][j] = float(Random());
+            dst[i][i % 4] = 1.0f;
+        }
+        for (size_t core = 3; core <= 5; ++core)
+        {
+            if (!NeuralDepthwiseSpecialTest(core, core != 3, small, dst))
+                return false;
+        }
+
+        double dense, separable;
+        if (!NeuralDepthwiseSpecialTest(false, src, dense))
+            return false;
+        if (!NeuralDepthwiseSpecialTest(true, src, separable))
+            return false;
+
+        TEST_LOG_SS(Info, std::setprecision(3) << std::fixed << "Predict " << DW_SIZE << "x" << DW_SIZE << "x" << DW_SRC_DEPTH << " -> " << DW_DST_DEPTH 
+            << " (3x3) : dense = " << dense * 1000 << " ms ; depthwise + pointwise = " << separable * 1000 << " ms.");
+
+        return true;
+    }
+
     SIMD_INLINE void Add(const TrainSample & src, size_t index, TrainSample & dst)
     {
         dst.src.push_back(src.src[index]);
@@ -2037,6 +3531,130 @@ namespace Test
         }
     }
 
+    void CreateOptionsNetwork(Network & net, Simd::Neural::Function::Type last)
+    {
+        using namespace Simd::Neural;
+        net.Add(new FullyConnectedLayer(Function::Relu, 16, 32));
+        net.Add(new FullyConnectedLayer(last, 32, 4));
+    }
+
+    // Class of sample is the index of maximal value among its first 4 values.
+    static size_t Accuracy(Network & net, const Vectors & src, const Labels & lbl)
+    {
+        size_t count = 0;
+        for (size_t i = 0; i < src.size(); ++i)
+        {
+            const Vector & dst = net.Predict(src[i]);
+            count += size_t(std::max_element(dst.begin(), dst.end()) - dst.begin()) == lbl[i] ? 1 : 0;
+        }
+        return count;
+    }
+
+    bool NeuralTrainOptionsSpecialTest(const String & desc, const TrainOptions & options, const Vectors & src, const Labels & lbl)
+    {
+        Network net, resumed;
+        CreateOptionsNetwork(net, Simd::Neural::Function::Identity);
+        CreateOptionsNetwork(resumed, Simd::Neural::Function::Identity);
+        net.InitWeight(options);
+        const String path = "options.txt";
+        if (!net.Save(path) || !resumed.Load(path))
+        {
+            TEST_LOG_SS(Error, desc << ": can't copy initial weights of Simd::Neural::Network!");
+            return false;
+        }
+        size_t before = Accuracy(net, src, lbl);
+        TrainOptions train(options);
+        train.epochStart = 1;
+        if (!net.Train(src, lbl, train, [](size_t, double) {}))
+        {
+            TEST_LOG_SS(Error, desc << ": can't train Simd::Neural::Network!");
+            return false;
+        }
+        size_t after = Accuracy(net, src, lbl);
+        TEST_LOG_SS(Info, desc << " : accuracy " << before << " -> " << after << " of " << src.size() << ".");
+        if (after * 10 < src.size() * 8 || after <= before)
+        {
+            TEST_LOG_SS(Error, desc << ": training doesn't improve accuracy enough!");
+            return false;
+        }
+
+        TrainOptions first(train), second(train), other(train);
+        first.epochFinish = second.epochStart = other.epochStart = train.epochFinish / 2;
+        other.updateType = options.updateType == TrainOptions::Adam ? TrainOptions::Momentum : TrainOptions::Adam;
+        Network continued;
+        CreateOptionsNetwork(continued, Simd::Neural::Function::Identity);
+        if (!resumed.Train(src, lbl, first, [](size_t, double) {}) || !resumed.Save(path, true) || !continued.Load(path, true))
+        {
+            TEST_LOG_SS(Error, desc << ": can't save and load training state of Simd::Neural::Network!");
+            return false;
+        }
+        remove(path.c_str());
+        if (continued.Train(src, lbl, other, [](size_t, double) {}))
+        {
+            TEST_LOG_SS(Error, desc << ": training state of other update type is not rejected!");
+            return false;
+        }
+        if (!continued.Train(src, lbl, second, [](size_t, double) {}))
+        {
+            TEST_LOG_SS(Error, desc << ": can't continue training of Simd::Neural::Network!");
+            return false;
+        }
+        for (size_t i = 0; i < src.size(); ++i)
+        {
+            Vector control = net.Predict(src[i]);
+            if (continued.Predict(src[i]) != control)
+            {
+                TEST_LOG_SS(Error, desc << ": resumed training differs from uninterrupted one at sample " << i << "!");
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool NeuralTrainOptionsSpecialTest()
+    {
+        Vectors src(512, Vector(16));
+        Labels lbl(src.size());
+        for (size_t i = 0; i < src.size(); ++i)
+        {
+            for (size_t j = 0; j < src[i].size(); ++j)
+                src[i][j] = float(Random() * 2.0 - 1.0);
+            lbl[i] = std::max_element(src[i].begin(), src[i].begin() + 4) - src[i].begin();
+        }
+
+        TrainOptions options;
+        options.epochFinish = 31;
+        options.batchSize = 16;
+        options.threadNumber = 1;
+
+        bool result = true;
+        result = result && NeuralTrainOptionsSpecialTest("AdaptiveGradient + Mse", options, src, lbl);
+
+        options.initType = TrainOptions::He;
+        options.lossType = TrainOptions::CrossEntropy;
+        options.updateType = TrainOptions::Momentum;
+        options.alpha = 0.01f;
+        result = result && NeuralTrainOptionsSpecialTest("He + Momentum + CrossEntropy", options, src, lbl);
+
+        options.updateType = TrainOptions::Adam;
+        options.alpha = 0.001f;
+        result = result && NeuralTrainOptionsSpecialTest("He + Adam + CrossEntropy", options, src, lbl);
+
+        options.updateType = TrainOptions::AdamW;
+        options.weightDecay = 0.01f;
+        result = result && NeuralTrainOptionsSpecialTest("He + AdamW + CrossEntropy", options, src, lbl);
+
+        Network sigmoid;
+        CreateOptionsNetwork(sigmoid, Simd::Neural::Function::Sigmoid);
+        if (result && sigmoid.Train(src, lbl, options, [](size_t, double) {}))
+        {
+            TEST_LOG_SS(Error, "CrossEntropy loss with Sigmoid output layer is not rejected!");
+            result = false;
+        }
+
+        return result;
+    }
+
     bool NeuralTrainSpecialTest()
     {
         Network net;
@@ -25,6 +25,8 @@
 #include "Test/TestPerformance.h"
 #include "Test/TestData.h"
 
+#include "Simd/SimdParallel.hpp"
+
 namespace Test
 {
 	namespace
@@ -219,6 +221,136 @@ namespace Test
         return result;
     }
 
+    namespace
+    {
+        struct FuncIS
+        {
+            typedef void(*FuncPtr)(const uint8_t * src, size_t srcStride, size_t width, size_t height, const uint8_t * mask, size_t maskStride,
+                uint8_t index, uint32_t flags, size_t rowBegin, size_t rowEnd, SimdImageStatistics * statistics);
+
+            FuncPtr func;
+            String description;
+
+            FuncIS(const FuncPtr & f, const String & d) : func(f), description(d) {}
+
+            void Call(const View & src, const View & mask, uint8_t index, uint32_t flags, SimdImageStatistics & statistics) const
+            {
+                TEST_PERFORMANCE_TEST(description);
+                func(src.data, src.stride, src.width, src.height, mask.data, mask.stride, index, flags, 0, src.height, &statistics);
+            }
+        };
+    }
+
+#define FUNC_IS(function) FuncIS(function, #function)
+
+#define TEST_CHECK_STATISTIC(field) \
+    if(a.field != b.field) \
+    { \
+        TEST_LOG_SS(Error, "Error " << #field << ": (" << uint64_t(a.field) << " != " << uint64_t(b.field) << ")! "); \
+        return false; \
+    } 
+
+    bool Compare(const SimdImageStatistics & a, const SimdImageStatistics & b)
+    {
+        TEST_CHECK_STATISTIC(count);
+        TEST_CHECK_STATISTIC(min);
+        TEST_CHECK_STATISTIC(max);
+        TEST_CHECK_STATISTIC(average);
+        TEST_CHECK_STATISTIC(sum);
+        TEST_CHECK_STATISTIC(squareSum);
+        TEST_CHECK_STATISTIC(x);
+        TEST_CHECK_STATISTIC(y);
+        TEST_CHECK_STATISTIC(xx);
+        TEST_CHECK_STATISTIC(xy);
+        TEST_CHECK_STATISTIC(yy);
+        TEST_CHECK_STATISTIC(laplaceAbsSum);
+        return Compare(a.histogram, b.histogram, 0, true, 32);
+    }
+
+    bool GetImageStatisticsAutoTest(int width, int height, bool masked, uint32_t flags, const FuncIS & f1, const FuncIS & f2)
+    {
+        bool result = true;
+
+        std::stringstream ss;
+        ss << "[" << (masked ? "m" : "") << flags << "]";
+        FuncIS _f1(f1.func, f1.description + ss.str()), _f2(f2.func, f2.description + ss.str());
+
+        TEST_LOG_SS(Info, "Test " << _f1.description << " & " << _f2.description << " [" << width << ", " << height << "].");
+
+        const uint8_t index = 7;
+        View src(width, height, View::Gray8, NULL, TEST_ALIGN(width));
+        FillRandom(src);
+        View mask;
+        if (masked)
+        {
+            mask.Recreate(width, height, View::Gray8, NULL, TEST_ALIGN(width));
+            FillRandomMask(mask, index);
+        }
+
+        SimdImageStatistics s1, s2, s3;
+
+        TEST_EXECUTE_AT_LEAST_MIN_TIME(_f1.Call(src, mask, index, flags, s1));
+
+        TEST_EXECUTE_AT_LEAST_MIN_TIME(_f2.Call(src, mask, index, flags, s2));
+
+        result = result && Compare(s1, s2);
+
+        Simd::GetImageStatistics(src, mask, index, flags, s3);
+
+        result = result && Compare(s1, s3);
+
+        Simd::GetImageStatistics(src, mask, index, flags, s3, 3);
+
+        result = result && Compare(s1, s3);
+
+        if (flags == SimdImageStatisticsAll)
+        {
+            s3 = s1;
+            if (masked)
+                SimdGetMoments(mask.data, mask.stride, width, height, index, &s3.count, &s3.x, &s3.y, &s3.xx, &s3.xy, &s3.yy);
+            else
+            {
+                SimdGetStatistic(src.data, src.stride, width, height, &s3.min, &s3.max, &s3.average);
+                SimdValueSum(src.data, src.stride, width, height, &s3.sum);
+                SimdSquareSum(src.data, src.stride, width, height, &s3.squareSum);
+                SimdHistogram(src.data, width, height, src.stride, s3.histogram);
+                SimdLaplaceAbsSum(src.data, src.stride, width, height, &s3.laplaceAbsSum);
+            }
+            result = result && Compare(s1, s3);
+        }
+
+        return result;
+    }
+
+    bool GetImageStatisticsAutoTest(const FuncIS & f1, const FuncIS & f2)
+    {
+        bool result = true;
+
+        for (int masked = 0; masked <= 1; ++masked)
+        {
+            result = result && GetImageStatisticsAutoTest(W, H, masked != 0, SimdImageStatisticsAll, f1, f2);
+            result = result && GetImageStatisticsAutoTest(W + O, H - O, masked != 0, SimdImageStatisticsAll, f1, f2);
+            result = result && GetImageStatisticsAutoTest(W - O, H + O, masked != 0, SimdImageStatisticsAll, f1, f2);
+        }
+        result = result && GetImageStatisticsAutoTest(W, H, false, SimdImageStatisticsMinMax | SimdImageStatisticsLaplaceAbsSum, f1, f2);
+
+        return result;
+    }
+
+    bool GetImageStatisticsAutoTest()
+    {
+        bool result = true;
+
+        result = result && GetImageStatisticsAutoTest(FUNC_IS(Simd::Base::GetImageStatistics), FUNC_IS(SimdGetImageStatistics));
+
+#ifdef SIMD_AVX2_ENABLE
+        if (Simd::Avx2::Enable)
+            result = result && GetImageStatisticsAutoTest(FUNC_IS(Simd::Avx2::GetImageStatistics), FUNC_IS(SimdGetImageStatistics));
+#endif 
+
+        return result;
+    }
+
     namespace
     {
         struct Func3
@@ -798,6 +930,62 @@ namespace Test
         return result;
     }
 
+    bool GetImageStatisticsDataTest(bool create, int width, int height, const FuncIS & f)
+    {
+        bool result = true;
+
+        Data data(f.description);
+
+        TEST_LOG_SS(Info, (create ? "Create" : "Verify") << " test " << f.description << " [" << width << ", " << height << "].");
+
+        const uint8_t index = 7;
+        View src(width, height, View::Gray8, NULL, TEST_ALIGN(width));
+        View mask(width, height, View::Gray8, NULL, TEST_ALIGN(width));
+
+        SimdImageStatistics s1, s2;
+        std::vector<uint8_t> statistics1(sizeof(SimdImageStatistics)), statistics2(sizeof(SimdImageStatistics));
+
+        if (create)
+        {
+            FillRandom(src);
+            FillRandomMask(mask, index);
+
+            TEST_SAVE(src);
+            TEST_SAVE(mask);
+
+            f.Call(src, mask, index, SimdImageStatisticsAll, s1);
+            memcpy(statistics1.data(), &s1, sizeof(s1));
+
+            TEST_SAVE(statistics1);
+        }
+        else
+        {
+            TEST_LOAD(src);
+            TEST_LOAD(mask);
+
+            TEST_LOAD(statistics1);
+            memcpy(&s1, statistics1.data(), sizeof(s1));
+
+            f.Call(src, mask, index, SimdImageStatisticsAll, s2);
+            memcpy(statistics2.data(), &s2, sizeof(s2));
+
+            TEST_SAVE(statistics2);
+
+            result = result && Compare(s1, s2);
+        }
+
+        return result;
+    }
+
+    bool GetImageStatisticsDataTest(bool create)
+    {
+        bool result = true;
+
+        result = result && GetImageStatisticsDataTest(create, DW, DH, FUNC_IS(SimdGetImageStatistics));
+
+        return result;
+    }
+
     bool GetSumsDataTest(bool create, int width, int height, const Func3 & f, bool isRow)
     {
         bool result = true;
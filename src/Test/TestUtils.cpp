@@ -357,8 +357,11 @@ namespace Test
 
 	bool Compare(const View & a, const View & b, float relativeDifferenceMax, bool printError, int errorCountMax, bool relative, const String & description)
 	{
-		assert(a.width == b.width);
-		return Compare((float*)a.data, (float*)b.data, a.width, relativeDifferenceMax, printError, errorCountMax, relative, description);
+		assert(a.width == b.width && a.height == b.height);
+        for (size_t row = 0; row < a.height; ++row)
+            if (!Compare(&a.At<float>(0, row), &b.At<float>(0, row), a.width, relativeDifferenceMax, printError, errorCountMax, relative, description))
+                return false;
+        return true;
 	}
 
     bool Compare(const float & a, const float & b, float relativeDifferenceMax, bool printError, const String & description)